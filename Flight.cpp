@@ -15,6 +15,8 @@ extern int nondet_int();
 extern float nondet_float();
 extern void __ESBMC_assume(int condition);
 
+#ifndef PX4_BIBLIOTECA
+
 // ================== FUNÇÃO REAL EXTRAÍDA DO PX4 ==================
 /**
  * CÓDIGO ORIGINAL DO PX4 v1.16
@@ -45,6 +47,10 @@ const T expo(const T &value, const T &e)
     return (1 - ec) * x + ec * x * x * x;
 }
 
+#else
+#include "px4_funcoes.h"   // Definições ligadas do GOTO compartilhado
+#endif // PX4_BIBLIOTECA
+
 // ================== TESTES DE VERIFICAÇÃO FORMAL ==================
 
 /**
@@ -165,6 +171,8 @@ void test_expo_monotonicity() {
 }
 
 // ================== MAIN PARA ESBMC ==================
+// Com -DPX4_BIBLIOTECA cada test_* é ponto de entrada próprio (--function)
+#ifndef PX4_BIBLIOTECA
 int main() {
     int test_choice = nondet_int();
     __ESBMC_assume(test_choice >= 0 && test_choice < 5);
@@ -189,6 +197,7 @@ int main() {
     
     return 0;
 }
+#endif // PX4_BIBLIOTECA
 
 /* 
  * ================================================================
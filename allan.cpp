@@ -0,0 +1,864 @@
+/**
+ * @file allan.cpp
+ * @author Dissertação Mestrado - Verificação Formal PX4 v1.16
+ *
+ * OBJETIVO: Verificar o motor de variância de Allan em fluxo (allan.h) e
+ *           caracterizar o ruído do giroscópio em logs longos
+ * MÓDULO TESTADO: Saídas int16_t de processGyroData() gravadas em log
+ *                 (ulog_formato.h, tópico imu_gyro)
+ * MÉTODO: Bounded Model Checking com ESBMC + benchmark nativo (-DMODO_NATIVO)
+ *
+ * MOTIVAÇÃO: ARW e instabilidade de bias só aparecem em τ de minutos a
+ * horas: 10 h a 2 kHz são 72 Mi amostras por eixo (432 MB só de int16_t).
+ * A implementação ingênua guarda a série e faz uma passada por τ; aqui o
+ * estado é O(log n) por eixo, o log é lido por mmap uma vez e as faixas
+ * de blocos são processadas em paralelo com resultado bit a bit igual ao
+ * serial.
+ */
+
+#include <assert.h>
+#include <cstring>
+#include <cstdint>
+
+#include "allan.h"
+
+#ifndef MODO_NATIVO
+
+// ================== FUNÇÕES ESBMC ==================
+extern int nondet_int();
+extern int16_t nondet_int16();
+extern size_t nondet_size_t();
+extern void __ESBMC_assume(int condition);
+
+static bool niveisIguais(const allan_t *a, const allan_t *b, int niveis) {
+    for (int k = 0; k < niveis; k++) {
+        const allan_nivel_t *la = &a->nivel[k], *lb = &b->nivel[k];
+
+        if (la->soma_q != lb->soma_q || la->pares != lb->pares || la->clusters != lb->clusters ||
+            la->tem_pendente != lb->tem_pendente || (la->clusters > 0 && la->anterior != lb->anterior) ||
+            (la->tem_pendente && la->pendente != lb->pendente)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// ================== TESTES DE VERIFICAÇÃO FORMAL ==================
+
+/**
+ * TESTE 1: Verificar a definição
+ * PROPRIEDADE: Para 8 amostras quaisquer, o nível k acumula exatamente
+ * Σ (S_i - S_(i-1))^2 sobre os 8/2^k clusters de 2^k amostras, com
+ * 8/2^k - 1 pares (conta direta, sem estado em cascata)
+ */
+void test_definicao() {
+    int16_t v[8];
+    allan_t a;
+
+    for (int i = 0; i < 8; i++) {
+        v[i] = nondet_int16();
+    }
+
+    allanIniciar(&a, ALLAN_NIVEIS, nullptr, 0);
+    allanAdicionarLote(&a, v, 8);
+
+    for (int k = 0; k < 3; k++) {
+        const int m = 1 << k;
+        const int clusters = 8 / m;
+        allan_acc_t esperado = 0;
+        int64_t anterior = 0;
+
+        for (int c = 0; c < clusters; c++) {
+            int64_t s = 0;
+            for (int j = 0; j < m; j++) {
+                s += v[c * m + j];
+            }
+            if (c > 0) {
+                esperado += allanQuadrado(s - anterior);
+            }
+            anterior = s;
+        }
+
+        assert(a.nivel[k].soma_q == esperado);
+        assert(a.nivel[k].pares == (uint64_t)(clusters - 1));
+    }
+
+    assert(a.nivel[3].clusters == 1 && a.nivel[3].pares == 0);
+    assert(a.amostras == 8);
+}
+
+/**
+ * TESTE 2: Verificar lote contra amostra a amostra
+ * PROPRIEDADE: Qualquer divisão da série em dois lotes deixa o estado
+ * igual ao de allanEmpurrar() uma amostra por vez (pendentes inclusive)
+ */
+void test_lote_igual_empurrar() {
+    int16_t v[6];
+    allan_t lote, um;
+
+    for (int i = 0; i < 6; i++) {
+        v[i] = nondet_int16();
+    }
+
+    size_t corte = nondet_size_t();
+    __ESBMC_assume(corte <= 6);
+
+    allanIniciar(&lote, ALLAN_NIVEIS, nullptr, 0);
+    allanAdicionarLote(&lote, v, corte);
+    allanAdicionarLote(&lote, v + corte, 6 - corte);
+
+    allanIniciar(&um, ALLAN_NIVEIS, nullptr, 0);
+    for (int i = 0; i < 6; i++) {
+        allanEmpurrar(&um, 0, v[i]);
+    }
+
+    assert(niveisIguais(&lote, &um, 4));
+}
+
+/**
+ * TESTE 3: Verificar junção de faixas
+ * PROPRIEDADE: Dividindo 8 amostras numa fronteira múltipla de 2^L (L =
+ * nível de saída), juntar + concluir dá o mesmo estado do motor serial
+ */
+void test_juntar_igual_serial() {
+    int16_t v[8];
+    int64_t saida_a[8], saida_b[8];
+    allan_t a, b, serial;
+
+    for (int i = 0; i < 8; i++) {
+        v[i] = nondet_int16();
+    }
+
+    int nivel = nondet_int();
+    __ESBMC_assume(nivel >= 0 && nivel <= 2);
+    int blocos = nondet_int();
+    __ESBMC_assume(blocos >= 0 && blocos <= (8 >> nivel));
+    const size_t corte = (size_t)blocos << nivel;
+
+    allanIniciar(&a, nivel, saida_a, 8);
+    allanIniciar(&b, nivel, saida_b, 8);
+    allanAdicionarLote(&a, v, corte);
+    allanAdicionarLote(&b, v + corte, 8 - corte);
+    allanJuntar(&a, &b);
+    allanConcluir(&a);
+
+    allanIniciar(&serial, ALLAN_NIVEIS, nullptr, 0);
+    allanAdicionarLote(&serial, v, 8);
+
+    assert(a.saida_descartes == 0);
+    assert(a.amostras == 8);
+    assert(niveisIguais(&a, &serial, 4));
+}
+
+/**
+ * TESTE 4: Verificar limite de saida[]
+ * PROPRIEDADE: Com capacidade menor que o número de clusters do nível de
+ * saída, nada é escrito além dela e o excesso é contado em descartes
+ */
+void test_saida_limitada() {
+    int16_t v[8];
+    int64_t saida[3];
+
+    for (int i = 0; i < 8; i++) {
+        v[i] = nondet_int16();
+    }
+
+    size_t n = nondet_size_t();
+    __ESBMC_assume(n <= 8);
+
+    allan_t a;
+    allanIniciar(&a, 1, saida, 3);
+    allanAdicionarLote(&a, v, n);
+
+    assert(a.saida_n <= 3);
+    assert(a.saida_n + a.saida_descartes == n / 2);
+}
+
+// ================== MAIN PARA ESBMC ==================
+int main() {
+    int test_choice = nondet_int();
+    __ESBMC_assume(test_choice >= 0 && test_choice < 4);
+
+    switch(test_choice) {
+        case 0:
+            test_definicao();
+            break;
+        case 1:
+            test_lote_igual_empurrar();
+            break;
+        case 2:
+            test_juntar_igual_serial();
+            break;
+        case 3:
+            test_saida_limitada();
+            break;
+    }
+
+    return 0;
+}
+
+#else // MODO_NATIVO
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "px4_funcoes.h"
+#include "ulog_formato.h"
+
+static constexpr double GYRO_LSB_POR_GRAU_S = 16.4;        // BMI088 em ±2000 °/s
+static constexpr double TAXA_GYRO_HZ = 2000.0;
+static constexpr int NIVEL_JUNCAO = 16;                    // Faixas alinhadas a 2^16 amostras (32.8 s)
+static constexpr size_t LOTE_LEITURA = 4096;
+
+static uint64_t aleatorio(uint64_t *s) {
+    *s ^= *s << 13;
+    *s ^= *s >> 7;
+    *s ^= *s << 17;
+    return *s;
+}
+
+static double gaussiano(uint64_t *s) {
+    const double u1 = ((aleatorio(s) >> 11) + 1) * (1.0 / 9007199254740993.0);
+    const double u2 = (aleatorio(s) >> 11) * (1.0 / 9007199254740992.0);
+    return sqrt(-2.0 * log(u1)) * cos(2.0 * M_PI * u2);
+}
+
+static int16_t saturar(double x) {
+    return (int16_t)(x > 32767 ? 32767 : x < -32768 ? -32768 : lrint(x));
+}
+
+static double agoraS() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static double cpuS() {
+    struct rusage ru;
+    getrusage(RUSAGE_SELF, &ru);
+    return ru.ru_utime.tv_sec + ru.ru_stime.tv_sec + (ru.ru_utime.tv_usec + ru.ru_stime.tv_usec) * 1e-6;
+}
+
+// ================== CONFERÊNCIAS ==================
+
+static uint64_t falhas = 0;
+
+static void falhar(const char *caso, size_t a, size_t b) {
+    if (falhas++ < 10) {
+        printf("  FALHA %s (%zu, %zu)\n", caso, a, b);
+    }
+}
+
+static bool niveisIguais(const allan_t *a, const allan_t *b) {
+    for (int k = 0; k < ALLAN_NIVEIS; k++) {
+        if (a->nivel[k].soma_q != b->nivel[k].soma_q || a->nivel[k].pares != b->nivel[k].pares) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Contra a definição direta (uma passada por τ sobre a série inteira),
+ * com lotes de tamanho aleatório, amostras nos extremos de int16_t, e
+ * junção de 2 a 7 faixas em cortes aleatórios alinhados a 2^L.
+ */
+static bool conferirMotor() {
+    uint64_t s = 31;
+    const size_t n = (1u << 20) + 12345;
+    std::vector<int16_t> v(n);
+    uint64_t casos = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        v[i] = (i / 50000) % 7 == 3 ? (int16_t)(aleatorio(&s) & 1 ? 32767 : -32768) : saturar(300 * gaussiano(&s));
+    }
+
+    allan_t a;
+    allanIniciar(&a, ALLAN_NIVEIS, nullptr, 0);
+    for (size_t i = 0; i < n;) {
+        const size_t c = std::min<size_t>(n - i, aleatorio(&s) % 3000);
+        allanAdicionarLote(&a, v.data() + i, c);
+        i += c;
+    }
+
+    for (int k = 0; (n >> k) >= 2; k++) {
+        const size_t m = (size_t)1 << k, clusters = n / m;
+        allan_acc_t soma_q = 0;
+        int64_t anterior = 0;
+
+        for (size_t c = 0; c < clusters; c++) {
+            int64_t soma = 0;
+            for (size_t j = 0; j < m; j++) {
+                soma += v[c * m + j];
+            }
+            if (c > 0) {
+                soma_q += allanQuadrado(soma - anterior);
+            }
+            anterior = soma;
+        }
+
+        if (a.nivel[k].soma_q != soma_q || a.nivel[k].pares != clusters - 1) {
+            falhar("definicao", (size_t)k, clusters);
+        }
+        casos++;
+    }
+
+    for (int rep = 0; rep < 40; rep++) {
+        const int nivel = (int)(aleatorio(&s) % 12);
+        const int faixas = 2 + (int)(aleatorio(&s) % 6);
+        std::vector<size_t> cortes(1, 0);
+
+        for (int f = 1; f < faixas; f++) {
+            cortes.push_back((aleatorio(&s) % (n >> nivel)) << nivel);
+        }
+        cortes.push_back(n);
+        std::sort(cortes.begin(), cortes.end());
+
+        std::vector<int64_t> total_saida((n >> nivel) + 1);
+        allan_t total;
+        allanIniciar(&total, nivel, total_saida.data(), total_saida.size());
+
+        for (int f = 0; f < faixas; f++) {
+            std::vector<int64_t> saida((n >> nivel) + 1);
+            allan_t parte;
+            allanIniciar(&parte, nivel, saida.data(), saida.size());
+            allanAdicionarLote(&parte, v.data() + cortes[f], cortes[f + 1] - cortes[f]);
+            allanJuntar(&total, &parte);
+        }
+        allanConcluir(&total);
+
+        if (!niveisIguais(&total, &a) || total.amostras != n || total.saida_descartes != 0) {
+            falhar("juncao", (size_t)nivel, (size_t)faixas);
+        }
+        casos++;
+    }
+
+    printf("conferencia do motor: %llu casos, %llu falhas\n", (unsigned long long)casos,
+           (unsigned long long)falhas);
+    return falhas == 0;
+}
+
+// ================== LOG SINTÉTICO ==================
+
+struct modelo_t {
+    double arw_grau_raiz_h;       // Densidade do ruído branco (ARW), °/√h
+    double bias_grau_h;           // Amplitude do bias correlacionado, °/h
+    double rrw_grau_h_raiz_h;     // Passeio aleatório da taxa, °/h/√h
+};
+
+/**
+ * Giroscópio parado por 'horas' a 2 kHz: ruído branco (ARW da folha de
+ * dados do BMI088, 0.014 °/s/√Hz = 0.84 °/√h), bias correlacionado como
+ * soma de processos de Gauss-Markov de 10 s a 10^4 s (aproxima o patamar
+ * de ruído 1/f) e passeio aleatório da taxa, mais um bias fixo por eixo.
+ * Amostras passam por processGyroData() e vão para um log no layout de
+ * ulog_writer.cpp (256 KB por bloco, só imu_gyro).
+ */
+static bool gerarLog(const char *caminho, double horas, const modelo_t *mod) {
+    const int fd = open(caminho, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        perror(caminho);
+        return false;
+    }
+
+    const uint32_t tamanho_bloco = ULOG_TAMANHO_BLOCO_PADRAO;
+    std::vector<uint8_t> bloco(tamanho_bloco, 0);
+
+    ulog_cabecalho_t cab;
+    ulog_formato_def_t defs[ULOG_MAX_FORMATOS];
+    memcpy(cab.magic, ULOG_MAGIC, sizeof(cab.magic));
+    cab.versao = ULOG_VERSAO;
+    cab.tamanho_bloco = tamanho_bloco;
+    cab.timestamp_inicio_us = 0;
+    cab.num_formatos = (uint32_t)ulogFormatosPadrao(defs);
+    cab.reservado = 0;
+    memcpy(bloco.data(), &cab, sizeof(cab));
+    memcpy(bloco.data() + sizeof(cab), defs, cab.num_formatos * sizeof(ulog_formato_def_t));
+
+    bool ok = write(fd, bloco.data(), tamanho_bloco) == (ssize_t)tamanho_bloco;
+
+    const double fs = TAXA_GYRO_HZ, dt = 1.0 / fs;
+    const double branco_lsb = mod->arw_grau_raiz_h / 60.0 * sqrt(fs) * GYRO_LSB_POR_GRAU_S;
+    const double bias_lsb = mod->bias_grau_h / 3600.0 * GYRO_LSB_POR_GRAU_S;
+    const double rrw_lsb = mod->rrw_grau_h_raiz_h / 3600.0 / 60.0 * GYRO_LSB_POR_GRAU_S;
+    const double fixo[3] = {3.2, -1.7, 0.4};
+
+    // Processos lentos atualizados a 100 Hz (constantes de tempo >= 10 s)
+    const int sub = 20;
+    const double T[4] = {10.0, 100.0, 1000.0, 10000.0};
+    double gm[3][4] = {}, rw[3] = {}, lento[3] = {};
+    uint64_t s = 2024;
+
+    const uint64_t total = (uint64_t)(horas * 3600.0 * fs);
+    const uint32_t reg_bytes = sizeof(ulog_registro_t) + sizeof(ulog_imu_gyro_t);
+    uint64_t sequencia = 0;
+    uint32_t usados = tamanho_bloco;
+
+    for (uint64_t i = 0; i < total && ok; i++) {
+        if (i % sub == 0) {
+            for (int e = 0; e < 3; e++) {
+                lento[e] = fixo[e];
+                for (int j = 0; j < 4; j++) {
+                    const double a = exp(-sub * dt / T[j]);
+                    gm[e][j] = a * gm[e][j] + bias_lsb * sqrt(1 - a * a) * gaussiano(&s);
+                    lento[e] += gm[e][j];
+                }
+                rw[e] += rrw_lsb * sqrt(sub * dt) * gaussiano(&s);
+                lento[e] += rw[e];
+            }
+        }
+
+        if (usados + reg_bytes > tamanho_bloco) {
+            if (sequencia > 0) {
+                const ulog_bloco_t cb = {ULOG_BLOCO_MAGIC, usados, sequencia};
+                memcpy(bloco.data(), &cb, sizeof(cb));
+                memset(bloco.data() + usados, 0, tamanho_bloco - usados);
+                ok = write(fd, bloco.data(), tamanho_bloco) == (ssize_t)tamanho_bloco;
+            }
+            sequencia++;
+            usados = sizeof(ulog_bloco_t);
+        }
+
+        int16_t cru[3];
+        for (int e = 0; e < 3; e++) {
+            cru[e] = saturar(lento[e] + branco_lsb * gaussiano(&s));
+        }
+
+        ulog_imu_gyro_t g;
+        g.timestamp_us = (uint64_t)(i * 1e6 / fs);
+        g.valido = processGyroData(cru[0], cru[1], cru[2], &g.x, &g.y, &g.z) ? 1 : 0;
+
+        const ulog_registro_t reg = {ULOG_MSG_IMU_GYRO, (uint16_t)sizeof(g)};
+        memcpy(bloco.data() + usados, &reg, sizeof(reg));
+        memcpy(bloco.data() + usados + sizeof(reg), &g, sizeof(g));
+        usados += reg_bytes;
+    }
+
+    if (ok && sequencia > 0) {
+        const ulog_bloco_t cb = {ULOG_BLOCO_MAGIC, usados, sequencia};
+        memcpy(bloco.data(), &cb, sizeof(cb));
+        memset(bloco.data() + usados, 0, tamanho_bloco - usados);
+        ok = write(fd, bloco.data(), tamanho_bloco) == (ssize_t)tamanho_bloco;
+    }
+
+    close(fd);
+    return ok;
+}
+
+// ================== ANÁLISE EM FAIXAS ==================
+
+struct log_t {
+    const uint8_t *base;
+    size_t tamanho;
+    uint32_t tamanho_bloco;
+    uint64_t num_blocos;
+};
+
+struct faixa_t {
+    uint64_t bloco_inicio, bloco_fim;
+    uint64_t amostras;            // Fase 1: registros válidos de imu_gyro na faixa
+    uint64_t inicio;              // Índice global da primeira amostra
+    uint64_t alinhado;            // Primeiro índice múltiplo de 2^NIVEL_JUNCAO
+    uint64_t invalidos;
+    allan_t eixo[3];
+    std::vector<int64_t> saida[3];
+    std::vector<int16_t> cabeca[3];   // [inicio, alinhado): vai para a faixa anterior
+};
+
+/**
+ * Visita os registros de imu_gyro válidos dos blocos [b0, b1), em ordem
+ * (mesma varredura de log_analyzer.cpp). Blocos já lidos são devolvidos
+ * ao kernel a cada 256.
+ */
+template <typename F>
+static void visitarGyro(const log_t *log, uint64_t b0, uint64_t b1, uint64_t *invalidos, F &&f) {
+    for (uint64_t b = b0; b < b1; b++) {
+        const uint8_t *bloco = log->base + b * log->tamanho_bloco;
+        ulog_bloco_t cb;
+        memcpy(&cb, bloco, sizeof(cb));
+
+        if (cb.magic != ULOG_BLOCO_MAGIC || cb.bytes_usados < sizeof(ulog_bloco_t) ||
+            cb.bytes_usados > log->tamanho_bloco) {
+            continue;
+        }
+
+        uint32_t offset = sizeof(ulog_bloco_t);
+        const ulog_registro_t *reg = nullptr;
+
+        while (offset < cb.bytes_usados) {
+            const uint32_t proximo = ulogProximoRegistro(bloco, cb.bytes_usados, offset, &reg);
+            if (proximo == 0) {
+                break;
+            }
+
+            if (reg->msg_id == ULOG_MSG_IMU_GYRO && reg->tamanho == sizeof(ulog_imu_gyro_t)) {
+                ulog_imu_gyro_t g;
+                memcpy(&g, bloco + offset + sizeof(ulog_registro_t), sizeof(g));
+
+                if (g.valido) {
+                    f(g);
+                } else {
+                    (*invalidos)++;
+                }
+            }
+
+            offset = proximo;
+        }
+
+        if ((b - b0) % 256 == 255) {
+            madvise((void *)(log->base + (b - 255) * log->tamanho_bloco), 256 * (size_t)log->tamanho_bloco,
+                    MADV_DONTNEED);
+        }
+    }
+}
+
+static void contarFaixa(const log_t *log, faixa_t *f) {
+    uint64_t n = 0, invalidos = 0;
+    visitarGyro(log, f->bloco_inicio, f->bloco_fim, &invalidos, [&](const ulog_imu_gyro_t &) { n++; });
+    f->amostras = n;
+}
+
+static void processarFaixa(const log_t *log, faixa_t *f) {
+    int16_t lote[3][LOTE_LEITURA];
+    size_t no_lote = 0;
+    uint64_t i = f->inicio;
+
+    for (int e = 0; e < 3; e++) {
+        f->saida[e].assign((f->amostras >> NIVEL_JUNCAO) + 2, 0);
+        allanIniciar(&f->eixo[e], NIVEL_JUNCAO, f->saida[e].data(), f->saida[e].size());
+        f->cabeca[e].clear();
+    }
+
+    visitarGyro(log, f->bloco_inicio, f->bloco_fim, &f->invalidos, [&](const ulog_imu_gyro_t &g) {
+        if (i++ < f->alinhado) {
+            f->cabeca[0].push_back(g.x);
+            f->cabeca[1].push_back(g.y);
+            f->cabeca[2].push_back(g.z);
+            return;
+        }
+
+        lote[0][no_lote] = g.x;
+        lote[1][no_lote] = g.y;
+        lote[2][no_lote] = g.z;
+
+        if (++no_lote == LOTE_LEITURA) {
+            for (int e = 0; e < 3; e++) {
+                allanAdicionarLote(&f->eixo[e], lote[e], no_lote);
+            }
+            no_lote = 0;
+        }
+    });
+
+    for (int e = 0; e < 3; e++) {
+        allanAdicionarLote(&f->eixo[e], lote[e], no_lote);
+    }
+}
+
+/**
+ * FUNÇÃO 5: analisarLog()
+ * ESPECIFICAÇÃO: Fase 1 conta as amostras de cada faixa de blocos (em
+ * paralelo); a soma de prefixos dá o índice global de cada faixa. Fase 2:
+ * cada thread alimenta seus motores a partir do primeiro índice alinhado a
+ * 2^NIVEL_JUNCAO e guarda a cabeça, que a thread principal entrega à faixa
+ * anterior antes de juntar tudo em ordem. Resultado idêntico ao serial.
+ */
+static bool analisarLog(const log_t *log, int num_threads, allan_t total[3], uint64_t *invalidos,
+                        std::vector<int64_t> saida_total[3]) {
+    const uint64_t blocos = log->num_blocos - 1;
+    num_threads = (int)std::max<uint64_t>(1, std::min<uint64_t>((uint64_t)num_threads, blocos));
+    std::vector<faixa_t> faixas(num_threads);
+
+    for (int t = 0; t < num_threads; t++) {
+        const uint64_t base = blocos / num_threads, resto = blocos % num_threads, ut = (uint64_t)t;
+        faixas[t].bloco_inicio = 1 + ut * base + std::min(ut, resto);
+        faixas[t].bloco_fim = faixas[t].bloco_inicio + base + (ut < resto ? 1 : 0);
+        faixas[t].invalidos = 0;
+    }
+
+    std::vector<std::thread> threads;
+
+    if (num_threads > 1) {
+        for (int t = 0; t < num_threads; t++) {
+            threads.emplace_back(contarFaixa, log, &faixas[t]);
+        }
+        for (std::thread &th : threads) {
+            th.join();
+        }
+        threads.clear();
+    } else {
+        faixas[0].amostras = 0;     // Sem junção: não precisa contar
+    }
+
+    uint64_t inicio = 0;
+    const uint64_t m = (uint64_t)1 << NIVEL_JUNCAO;
+
+    for (int t = 0; t < num_threads; t++) {
+        faixas[t].inicio = inicio;
+        faixas[t].alinhado = (inicio + m - 1) / m * m;
+        inicio += faixas[t].amostras;
+
+        // Faixa menor que a cabeça: a divisão não serve, refaz em série
+        if (t > 0 && faixas[t].alinhado - faixas[t].inicio >= faixas[t].amostras) {
+            return analisarLog(log, 1, total, invalidos, saida_total);
+        }
+    }
+
+    if (num_threads == 1) {
+        faixas[0].amostras = (uint64_t)log->tamanho / sizeof(ulog_imu_gyro_t);    // Limite para saida[]
+    }
+
+    for (int t = 0; t < num_threads; t++) {
+        threads.emplace_back(processarFaixa, log, &faixas[t]);
+    }
+    for (std::thread &th : threads) {
+        th.join();
+    }
+
+    *invalidos = 0;
+    uint64_t saidas = 0;
+    for (int t = 0; t < num_threads; t++) {
+        saidas += faixas[t].saida[0].size();
+        *invalidos += faixas[t].invalidos;
+    }
+
+    for (int e = 0; e < 3; e++) {
+        saida_total[e].assign(saidas, 0);
+        allanIniciar(&total[e], NIVEL_JUNCAO, saida_total[e].data(), saida_total[e].size());
+
+        for (int t = 0; t < num_threads; t++) {
+            if (t + 1 < num_threads) {
+                const std::vector<int16_t> &cab = faixas[t + 1].cabeca[e];
+                allanAdicionarLote(&faixas[t].eixo[e], cab.data(), cab.size());
+            }
+            allanJuntar(&total[e], &faixas[t].eixo[e]);
+        }
+
+        allanConcluir(&total[e]);
+
+        if (total[e].saida_descartes != 0) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool mapearLog(const char *caminho, log_t *log) {
+    const int fd = open(caminho, O_RDONLY);
+    struct stat st;
+
+    if (fd < 0 || fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(ulog_cabecalho_t)) {
+        perror(caminho);
+        return false;
+    }
+
+    log->base = (const uint8_t *)mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+
+    if (log->base == MAP_FAILED) {
+        perror("mmap");
+        return false;
+    }
+
+    ulog_cabecalho_t cab;
+    memcpy(&cab, log->base, sizeof(cab));
+
+    if (!ulogValidarCabecalho(&cab) || (uint64_t)st.st_size < cab.tamanho_bloco) {
+        fprintf(stderr, "%s: cabecalho invalido\n", caminho);
+        munmap((void *)log->base, (size_t)st.st_size);
+        return false;
+    }
+
+    log->tamanho = (size_t)st.st_size;
+    log->tamanho_bloco = cab.tamanho_bloco;
+    log->num_blocos = (uint64_t)st.st_size / cab.tamanho_bloco;
+    madvise((void *)log->base, log->tamanho, MADV_SEQUENTIAL);
+    return true;
+}
+
+// ================== RESULTADO ==================
+
+// ADEV(τ) em °/s interpolado em log-log entre as oitavas vizinhas
+static double adevEm(const allan_ponto_t *p, int n, double tau) {
+    for (int i = 0; i + 1 < n; i++) {
+        if (p[i].tau_s <= tau && p[i + 1].tau_s >= tau && p[i].adev > 0 && p[i + 1].adev > 0) {
+            const double f = log(tau / p[i].tau_s) / log(p[i + 1].tau_s / p[i].tau_s);
+            return exp(log(p[i].adev) + f * (log(p[i + 1].adev) - log(p[i].adev)));
+        }
+    }
+
+    return 0;
+}
+
+static void relatar(const allan_t total[3], const modelo_t *mod) {
+    allan_ponto_t p[3][ALLAN_NIVEIS];
+    int n[3];
+    const char *nomes[3] = {"x", "y", "z"};
+
+    for (int e = 0; e < 3; e++) {
+        n[e] = allanPontos(&total[e], TAXA_GYRO_HZ, 1.0 / GYRO_LSB_POR_GRAU_S, 8, p[e], ALLAN_NIVEIS);
+    }
+
+    printf("\n%10s %10s %12s %12s %12s %8s\n", "tau (s)", "pares", "adev x", "adev y", "adev z", "+-%");
+    printf("%10s %10s %12s %12s %12s\n", "", "", "(graus/h)", "(graus/h)", "(graus/h)");
+
+    for (int i = 0; i < n[0]; i++) {
+        printf("%10.4f %10llu %12.3f %12.3f %12.3f %8.1f\n", p[0][i].tau_s, (unsigned long long)p[0][i].pares,
+               p[0][i].adev * 3600, i < n[1] ? p[1][i].adev * 3600 : 0, i < n[2] ? p[2][i].adev * 3600 : 0,
+               100 * p[0][i].erro_rel);
+    }
+
+    printf("\n%4s %16s %22s %12s\n", "eixo", "ARW (graus/raiz h)", "inst. de bias (graus/h)", "em tau (s)");
+
+    for (int e = 0; e < 3; e++) {
+        // ARW: ADEV em τ = 1 s (inclinação -1/2); bias: mínimo da curva / 0.664
+        const double arw = adevEm(p[e], n[e], 1.0) * 60.0;
+        int imin = 0;
+        for (int i = 1; i < n[e]; i++) {
+            imin = p[e][i].adev < p[e][imin].adev ? i : imin;
+        }
+        printf("%4s %16.4f %22.3f %12.1f\n", nomes[e], arw, n[e] ? p[e][imin].adev * 3600 / 0.664 : 0,
+               n[e] ? p[e][imin].tau_s : 0);
+    }
+
+    if (mod) {
+        printf("modelo: ARW %.4f graus/raiz h, bias correlacionado %.2f graus/h, RRW %.2f graus/h/raiz h\n",
+               mod->arw_grau_raiz_h, mod->bias_grau_h, mod->rrw_grau_h_raiz_h);
+    }
+}
+
+int main(int argc, char **argv) {
+    const bool motor_ok = conferirMotor();
+
+    // ./allan_bench [horas | log.ulg] [threads]
+    double horas = 10.0;
+    const char *caminho = "/tmp/allan_gyro.ulg";
+    bool gerado = true;
+
+    if (argc > 1) {
+        char *fim = nullptr;
+        const double h = strtod(argv[1], &fim);
+        if (fim && *fim == '\0' && h > 0) {
+            horas = h;
+        } else {
+            caminho = argv[1];
+            gerado = false;
+        }
+    }
+
+    int num_threads = argc > 2 ? atoi(argv[2]) : (int)std::thread::hardware_concurrency();
+    num_threads = num_threads > 0 ? num_threads : 1;
+
+    const modelo_t mod = {0.84, 4.0, 6.0};
+
+    if (gerado) {
+        const double t0 = agoraS();
+        if (!gerarLog(caminho, horas, &mod)) {
+            return 1;
+        }
+        printf("log sintetico: %.1f h a %.0f Hz em %s (%.1f s para gerar)\n", horas, TAXA_GYRO_HZ, caminho,
+               agoraS() - t0);
+    }
+
+    log_t log;
+    if (!mapearLog(caminho, &log)) {
+        return 1;
+    }
+
+    allan_t serial[3], paralelo[3];
+    std::vector<int64_t> saida_s[3], saida_p[3];
+    uint64_t invalidos = 0;
+
+    double t0 = agoraS(), c0 = cpuS();
+    bool ok = analisarLog(&log, 1, serial, &invalidos, saida_s);
+    const double t_serial = agoraS() - t0, c_serial = cpuS() - c0;
+
+    t0 = agoraS();
+    c0 = cpuS();
+    ok = analisarLog(&log, num_threads, paralelo, &invalidos, saida_p) && ok;
+    const double t_par = agoraS() - t0, c_par = cpuS() - c0;
+
+    bool iguais = true;
+    for (int e = 0; e < 3; e++) {
+        iguais = iguais && niveisIguais(&serial[e], &paralelo[e]) && serial[e].amostras == paralelo[e].amostras;
+    }
+
+    const uint64_t amostras = serial[0].amostras;
+    printf("%llu amostras por eixo (%.2f h), %llu invalidas, log de %.2f GB\n", (unsigned long long)amostras,
+           amostras / TAXA_GYRO_HZ / 3600.0, (unsigned long long)invalidos, log.tamanho / 1e9);
+    printf("serial:     %6.2f s (%.2f s CPU), %6.1f Mi amostras/s, %5.2f GB/s de log\n", t_serial, c_serial,
+           3 * amostras / t_serial / 1e6, log.tamanho / t_serial / 1e9);
+    printf("%2d threads: %6.2f s (%.2f s CPU), %6.1f Mi amostras/s, %5.2f GB/s de log\n", num_threads, t_par, c_par,
+           3 * amostras / t_par / 1e6, log.tamanho / t_par / 1e9);
+    printf("estado por eixo: %zu bytes; paralelo == serial: %s\n", sizeof(allan_t), iguais ? "sim" : "NAO");
+
+    relatar(serial, gerado ? &mod : nullptr);
+
+    munmap((void *)log.base, log.tamanho);
+    if (gerado) {
+        unlink(caminho);
+    }
+
+    return motor_ok && ok && iguais ? 0 : 1;
+}
+
+#endif // MODO_NATIVO
+
+/*
+ * ================================================================
+ * DOCUMENTAÇÃO
+ * ================================================================
+ *
+ * VARIÂNCIA DE ALLAN EM FLUXO (allan.h):
+ *
+ * 1. OITAVAS EM CASCATA:
+ *    - τ = 2^k / fs, k = 0..39; nível k recebe somas de clusters de 2^k
+ *      amostras e forma os de 2^(k+1) por pares
+ *    - Allan NÃO sobreposta: a sobreposta precisa de janelas deslizantes
+ *      (estado O(τ) por nível); a não sobreposta tem incerteza maior só
+ *      nos τ altos (coluna +-% do relatório)
+ *    - Somas inteiras e acumulados de 128 bits: exato, independe da ordem
+ *
+ * 2. LOTES:
+ *    - allanAdicionarLote() processa um nível por vez num buffer de 1024
+ *      somas; até k = 11 os quadrados são somados em 64 bits
+ *
+ * 3. FAIXAS PARALELAS:
+ *    - Faixas de blocos do log mapeado; contagem prévia dá o índice
+ *      global de cada faixa, cabeças até a fronteira de 2^16 amostras vão
+ *      para a faixa anterior; allanJuntar() soma a diferença de fronteira
+ *      de cada nível e allanConcluir() sobe os níveis >= 16 em série
+ *
+ * 4. PROPRIEDADES VERIFICADAS (ESBMC):
+ *    - Igual à definição direta em 8 amostras quaisquer
+ *    - Lote em qualquer divisão == amostra a amostra
+ *    - Junção em qualquer fronteira alinhada == serial
+ *    - saida[] nunca escrita além da capacidade
+ *
+ * COMANDOS DE EXECUÇÃO:
+ * esbmc allan.cpp --unwind 9 --overflow-check --bounds-check
+ * g++ -O2 -DMODO_NATIVO -pthread allan.cpp px4_funcoes.cpp -o allan_bench && ./allan_bench [horas | log.ulg] [threads]
+ *
+ * BENCHMARK:
+ * - Log sintético de 10 h a 2 kHz (72 Mi registros imu_gyro, 1.4 GB em
+ *   /tmp, apagado no fim): ruído branco do BMI088, bias correlacionado
+ *   (Gauss-Markov de 10 s a 10^4 s) e passeio aleatório da taxa, via
+ *   processGyroData()
+ * - Tempo serial x paralelo (resultado idêntico exigido), amostras/s e
+ *   GB/s de log, tabela de ADEV por oitava, ARW e instabilidade de bias
+ *   recuperados contra o modelo
+ *
+ * ================================================================
+ */
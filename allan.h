@@ -0,0 +1,306 @@
+/**
+ * @file allan.h
+ * @author Dissertação Mestrado - Verificação Formal PX4 v1.16
+ *
+ * OBJETIVO: Variância de Allan em fluxo para caracterizar ruído de giroscópio
+ *           (ARW, instabilidade de bias) sobre horas de processGyroData()
+ * USO: allan.cpp (verificação, ferramenta sobre logs ulog_formato.h e benchmark)
+ *
+ * MÉTODO: Allan não sobreposta em tempos de cluster em oitavas (m = 2^k
+ * amostras). O nível k guarda só a soma do último cluster, a do cluster
+ * pendente de par e o acumulado de (S_i - S_(i-1))^2: dois clusters
+ * consecutivos do nível k formam um do nível k+1. Estado O(log n), custo
+ * amortizado O(1) por amostra.
+ *
+ * Somas de cluster em int64_t e acumulados em inteiro de 128 bits: o
+ * resultado é exato e não depende da ordem, então a versão em faixas
+ * paralelas (allanJuntar) dá exatamente o mesmo que a serial.
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+// ================== CONSTANTES ==================
+static constexpr int ALLAN_NIVEIS = 40;          // m até 2^39 amostras
+static constexpr size_t ALLAN_LOTE = 1024;       // Amostras por passada no lote
+
+#ifdef __SIZEOF_INT128__
+typedef unsigned __int128 allan_acc_t;
+#else
+typedef long double allan_acc_t;                 // Sem 128 bits: aproximado, não exato
+#endif
+
+// ================== ESTRUTURAS ==================
+
+struct allan_nivel_t {
+    int64_t anterior;             // Soma do último cluster completo
+    int64_t primeiro;             // Soma do primeiro cluster (junção de faixas)
+    int64_t pendente;             // Cluster esperando o par para subir de nível
+    bool tem_pendente;
+    uint64_t clusters;
+    uint64_t pares;               // Diferenças acumuladas (clusters - 1)
+    allan_acc_t soma_q;           // Σ (S_i - S_(i-1))^2, em contagens^2
+};
+
+/**
+ * nivel_saida: níveis a partir dele não são calculados aqui; as somas de
+ * cluster desse nível vão para saida[] (faixa paralela, juntada depois).
+ * ALLAN_NIVEIS = motor completo.
+ */
+struct allan_t {
+    allan_nivel_t nivel[ALLAN_NIVEIS];
+    int nivel_saida;
+    int64_t *saida;
+    size_t saida_n;
+    size_t saida_cap;
+    uint64_t saida_descartes;     // saida[] cheio (capacidade mal dimensionada)
+    uint64_t amostras;
+};
+
+inline void allanIniciar(allan_t *a, int nivel_saida, int64_t *saida, size_t saida_cap) {
+    for (int k = 0; k < ALLAN_NIVEIS; k++) {
+        a->nivel[k] = allan_nivel_t{};
+    }
+
+    a->nivel_saida = nivel_saida < ALLAN_NIVEIS ? nivel_saida : ALLAN_NIVEIS;
+    a->saida = saida;
+    a->saida_n = 0;
+    a->saida_cap = saida_cap;
+    a->saida_descartes = 0;
+    a->amostras = 0;
+}
+
+inline allan_acc_t allanQuadrado(int64_t d) {
+    const uint64_t u = d < 0 ? 0 - (uint64_t)d : (uint64_t)d;
+    return (allan_acc_t)u * (allan_acc_t)u;
+}
+
+// ================== ENTRADA ==================
+
+/**
+ * FUNÇÃO 1: allanEmpurrar()
+ * ESPECIFICAÇÃO: Entrega a soma de um cluster completo do nível k: acumula
+ * a diferença para o anterior e, formando par com o pendente, sobe o
+ * cluster dobrado para k+1 (ou para saida[] no nível de saída).
+ */
+inline void allanEmpurrar(allan_t *a, int k, int64_t soma) {
+    while (k < ALLAN_NIVEIS) {
+        if (k >= a->nivel_saida) {
+            if (a->saida_n < a->saida_cap) {
+                a->saida[a->saida_n++] = soma;
+            } else {
+                a->saida_descartes++;
+            }
+            return;
+        }
+
+        allan_nivel_t *l = &a->nivel[k];
+
+        if (l->clusters > 0) {
+            l->soma_q += allanQuadrado(soma - l->anterior);
+            l->pares++;
+        } else {
+            l->primeiro = soma;
+        }
+
+        l->anterior = soma;
+        l->clusters++;
+
+        if (!l->tem_pendente) {
+            l->pendente = soma;
+            l->tem_pendente = true;
+            return;
+        }
+
+        l->tem_pendente = false;
+        soma += l->pendente;
+        k++;
+    }
+}
+
+/**
+ * FUNÇÃO 2: allanAdicionarLote()
+ * ESPECIFICAÇÃO: Mesmo resultado de allanEmpurrar(a, 0, v[i]) para cada
+ * amostra, processando um nível inteiro do lote por vez: diferenças numa
+ * passada linear (níveis baixos em uint64, sem 128 bits por termo) e
+ * pares somados no próprio buffer, que encolhe pela metade por nível.
+ */
+inline void allanAdicionarLote(allan_t *a, const int16_t *v, size_t n) {
+    int64_t buf[ALLAN_LOTE];
+
+    while (n > 0) {
+        size_t c = n < ALLAN_LOTE ? n : ALLAN_LOTE;
+        for (size_t i = 0; i < c; i++) {
+            buf[i] = v[i];
+        }
+        a->amostras += c;
+        v += c;
+        n -= c;
+
+        for (int k = 0; c > 0 && k < ALLAN_NIVEIS; k++) {
+            if (k >= a->nivel_saida) {
+                for (size_t i = 0; i < c; i++) {
+                    allanEmpurrar(a, k, buf[i]);
+                }
+                break;
+            }
+
+            allan_nivel_t *l = &a->nivel[k];
+            size_t i0 = 0;
+
+            if (l->clusters == 0) {
+                l->primeiro = buf[0];
+                l->anterior = buf[0];
+                l->clusters = 1;
+                i0 = 1;
+            }
+
+            // |S| <= 2^(15+k): d^2 <= 2^(32+2k), 1024 termos cabem em 64 bits até k = 11
+            if (k <= 11) {
+                uint64_t q = 0;
+                int64_t ant = l->anterior;
+                for (size_t i = i0; i < c; i++) {
+                    const int64_t d = buf[i] - ant;
+                    q += (uint64_t)(d * d);
+                    ant = buf[i];
+                }
+                l->soma_q += q;
+            } else {
+                int64_t ant = l->anterior;
+                for (size_t i = i0; i < c; i++) {
+                    l->soma_q += allanQuadrado(buf[i] - ant);
+                    ant = buf[i];
+                }
+            }
+
+            l->pares += c - i0;
+            l->clusters += c - i0;
+            l->anterior = buf[c - 1];
+
+            // Pares para o nível seguinte, começando pelo pendente da chamada anterior
+            size_t saida = 0, i = 0;
+
+            if (l->tem_pendente) {
+                buf[saida++] = l->pendente + buf[0];
+                l->tem_pendente = false;
+                i = 1;
+            }
+
+            for (; i + 1 < c; i += 2) {
+                buf[saida++] = buf[i] + buf[i + 1];
+            }
+
+            if (i < c) {
+                l->pendente = buf[i];
+                l->tem_pendente = true;
+            }
+
+            c = saida;
+        }
+    }
+}
+
+// ================== FAIXAS PARALELAS ==================
+
+/**
+ * FUNÇÃO 3: allanJuntar()
+ * ESPECIFICAÇÃO: a += b, com b começando logo após a. Pré-condição: a
+ * viu um múltiplo de 2^nivel_saida amostras (nenhum cluster aberto abaixo
+ * do nível de saída), e b começa nessa fronteira. Cada nível ganha a
+ * diferença de junção (primeiro de b - último de a); saidas são
+ * concatenadas em a->saida.
+ */
+inline void allanJuntar(allan_t *a, const allan_t *b) {
+    const int topo = a->nivel_saida < b->nivel_saida ? a->nivel_saida : b->nivel_saida;
+
+    for (int k = 0; k < topo; k++) {
+        allan_nivel_t *la = &a->nivel[k];
+        const allan_nivel_t *lb = &b->nivel[k];
+
+        if (lb->clusters == 0) {
+            continue;
+        }
+
+        if (la->clusters == 0) {
+            *la = *lb;
+            continue;
+        }
+
+        la->soma_q += lb->soma_q + allanQuadrado(lb->primeiro - la->anterior);
+        la->pares += lb->pares + 1;
+        la->clusters += lb->clusters;
+        la->anterior = lb->anterior;
+        la->pendente = lb->pendente;
+        la->tem_pendente = lb->tem_pendente;
+    }
+
+    for (size_t i = 0; i < b->saida_n; i++) {
+        if (a->saida_n < a->saida_cap) {
+            a->saida[a->saida_n++] = b->saida[i];
+        } else {
+            a->saida_descartes++;
+        }
+    }
+
+    a->amostras += b->amostras;
+    a->saida_descartes += b->saida_descartes;
+}
+
+/**
+ * Depois de juntar todas as faixas: empurra as somas do nível de saída
+ * pelos níveis de cima, agora em série, e libera o motor (nivel_saida =
+ * ALLAN_NIVEIS).
+ */
+inline void allanConcluir(allan_t *a) {
+    const int k = a->nivel_saida;
+    a->nivel_saida = ALLAN_NIVEIS;
+
+    for (size_t i = 0; i < a->saida_n; i++) {
+        allanEmpurrar(a, k, a->saida[i]);
+    }
+
+    a->saida_n = 0;
+}
+
+// ================== RESULTADO ==================
+
+struct allan_ponto_t {
+    double tau_s;
+    double adev;                  // Desvio de Allan, na unidade de 'escala'
+    double erro_rel;              // 1/sqrt(2(N-1)), incerteza relativa de adev
+    uint64_t pares;
+};
+
+/**
+ * FUNÇÃO 4: allanPontos()
+ * ESPECIFICAÇÃO: Um ponto por nível com pelo menos min_pares diferenças.
+ * AVAR(m) = Σ (S_i - S_(i-1))^2 / (2 · pares · m^2), adev em
+ * contagens · escala.
+ */
+inline int allanPontos(const allan_t *a, double fs_hz, double escala, uint64_t min_pares, allan_ponto_t *out,
+                       int max) {
+    int n = 0;
+
+    for (int k = 0; k < ALLAN_NIVEIS && n < max; k++) {
+        const allan_nivel_t *l = &a->nivel[k];
+
+        if (l->pares < min_pares || l->pares == 0) {
+            continue;
+        }
+
+        const double m = (double)((uint64_t)1 << k);
+        const double avar = (double)l->soma_q / (2.0 * (double)l->pares * m * m);
+        const double adev = avar > 0 ? std::sqrt(avar) : 0.0;
+
+        out[n].tau_s = m / fs_hz;
+        out[n].adev = adev * escala;
+        out[n].erro_rel = 1.0 / std::sqrt(2.0 * (double)l->pares);
+        out[n].pares = l->pares;
+        n++;
+    }
+
+    return n;
+}
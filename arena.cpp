@@ -0,0 +1,591 @@
+/**
+ * @file arena.cpp
+ * @author Dissertação Mestrado - Verificação Formal PX4 v1.16
+ *
+ * OBJETIVO: Verificar e medir a arena de mensagens (arena_mensagens.h)
+ * MÓDULO TESTADO: Armazenamento por ciclo de quadros MAVLink v2 e sentenças
+ *                 GGA decodificadas (mesmo fluxo de dumpGpsData())
+ * MÉTODO: Bounded Model Checking com ESBMC + benchmark nativo (-DMODO_NATIVO)
+ *
+ * MOTIVAÇÃO: Um estágio de protocolo a 100k msg/s que faz new/delete por
+ * mensagem paga o alocador no caminho quente e fragmenta o heap. Com a
+ * arena, o regime permanente não toca o heap: os contadores e o operator
+ * new instrumentado do benchmark comprovam zero alocações por ciclo.
+ */
+
+#include <assert.h>
+#include <cstring>
+#include <cstdint>
+
+#include "arena_mensagens.h"
+#include "nmea_parser.h"
+
+// ================== CONSTANTES DO PROTOCOLO ==================
+static constexpr uint8_t MAVLINK_STX_V2 = 0xFD;
+static constexpr uint32_t MAVLINK_CABECALHO = 10;      // STX..msgid
+static constexpr uint32_t MAVLINK_MAX_PAYLOAD = 255;
+static constexpr uint32_t MAVLINK_ASSINATURA = 13;     // Presente se incompat_flags & 1
+
+static constexpr uint32_t ARENA_MAVLINK_SLOTS = 256;   // Mensagens por ciclo
+
+// ================== ESTRUTURAS ==================
+
+/**
+ * Quadro MAVLink v2 decodificado (payload com zeros finais restaurados,
+ * como no mavlink_message_t, mas sem os campos de assinatura)
+ */
+struct mavlink_mensagem_t {
+    uint32_t msgid;
+    uint8_t seq;
+    uint8_t sysid;
+    uint8_t compid;
+    uint8_t len;
+    uint8_t payload[MAVLINK_MAX_PAYLOAD];
+};
+
+// ================== DECODIFICAÇÃO ==================
+
+// CRC_EXTRA de common.xml para as mensagens aceitas pelo estágio
+static inline bool mavlinkCrcExtra(uint32_t msgid, uint8_t *extra) {
+    switch (msgid) {
+    case 0:  *extra = 50;  return true;     // HEARTBEAT
+    case 22: *extra = 220; return true;     // PARAM_VALUE
+    case 24: *extra = 24;  return true;     // GPS_RAW_INT
+    case 30: *extra = 39;  return true;     // ATTITUDE
+    default: return false;
+    }
+}
+
+static inline uint16_t crcX25(uint16_t crc, uint8_t b) {
+    uint8_t t = b ^ (uint8_t)(crc & 0xFF);
+    t ^= (uint8_t)(t << 4);
+    return (uint16_t)((crc >> 8) ^ ((uint16_t)t << 8) ^ ((uint16_t)t << 3) ^ (t >> 4));
+}
+
+/**
+ * FUNÇÃO 1: mavlinkDecodificar()
+ * ESPECIFICAÇÃO: Procurar um quadro v2 completo no início de buf[0..n).
+ * Retorna os bytes consumidos (0 = quadro incompleto, aguardar mais bytes);
+ * *valido indica se out foi preenchido. Byte que não é STX, msgid
+ * desconhecido ou CRC errado consomem só o STX (ressincronização).
+ */
+size_t mavlinkDecodificar(const uint8_t *buf, size_t n, mavlink_mensagem_t *out, bool *valido) {
+    *valido = false;
+
+    if (n == 0) {
+        return 0;
+    }
+
+    if (buf[0] != MAVLINK_STX_V2) {
+        return 1;
+    }
+
+    if (n < MAVLINK_CABECALHO) {
+        return 0;
+    }
+
+    const uint8_t len = buf[1];
+    const size_t total = MAVLINK_CABECALHO + len + 2 + ((buf[2] & 1) ? MAVLINK_ASSINATURA : 0);
+
+    if (n < total) {
+        return 0;
+    }
+
+    const uint32_t msgid = (uint32_t)buf[7] | ((uint32_t)buf[8] << 8) | ((uint32_t)buf[9] << 16);
+    uint8_t extra;
+
+    if (!mavlinkCrcExtra(msgid, &extra)) {
+        return 1;
+    }
+
+    uint16_t crc = 0xFFFF;
+    for (size_t i = 1; i < MAVLINK_CABECALHO + len; i++) {
+        crc = crcX25(crc, buf[i]);
+    }
+    crc = crcX25(crc, extra);
+
+    const size_t pos_crc = MAVLINK_CABECALHO + len;
+    if (crc != (uint16_t)(buf[pos_crc] | (buf[pos_crc + 1] << 8))) {
+        return 1;
+    }
+
+    out->msgid = msgid;
+    out->seq = buf[4];
+    out->sysid = buf[5];
+    out->compid = buf[6];
+    out->len = len;
+    memcpy(out->payload, buf + MAVLINK_CABECALHO, len);
+    memset(out->payload + len, 0, MAVLINK_MAX_PAYLOAD - len);
+    *valido = true;
+    return total;
+}
+
+#ifndef MODO_NATIVO
+
+// ================== FUNÇÕES ESBMC ==================
+extern int nondet_int();
+extern uint8_t nondet_uint8();
+extern size_t nondet_size_t();
+extern void __ESBMC_assume(int condition);
+
+// ================== TESTES DE VERIFICAÇÃO FORMAL ==================
+
+struct mensagem_pequena_t {
+    uint32_t msgid;
+    uint8_t len;
+};
+
+static arena_t<mensagem_pequena_t, 4> arena_pequena;
+static arena_t<mavlink_mensagem_t, 2> arena_quadros;
+
+/**
+ * TESTE 1: Verificar limites de alocação
+ * PROPRIEDADE: Até N pedidos recebem slots distintos dentro da arena; do
+ * N+1-ésimo em diante a resposta é nullptr e conta como esgotamento
+ */
+void test_arena_alocacao_limites() {
+    arenaReset(&arena_pequena);
+
+    int pedidos = nondet_int();
+    __ESBMC_assume(pedidos >= 0 && pedidos <= 6);
+
+    mensagem_pequena_t *entregues[6];
+    int atendidos = 0;
+
+    for (int i = 0; i < pedidos; i++) {
+        mensagem_pequena_t *m = arenaAlocar(&arena_pequena);
+
+        if (i < 4) {
+            assert(m == &arena_pequena.slots[i]);
+            assert(m->msgid == 0 && m->len == 0);
+            entregues[atendidos++] = m;
+        } else {
+            assert(m == nullptr);
+        }
+    }
+
+    for (int i = 0; i < atendidos; i++) {
+        assert(arenaContem(&arena_pequena, entregues[i]));
+        for (int j = i + 1; j < atendidos; j++) {
+            assert(entregues[i] != entregues[j]);
+        }
+    }
+
+    assert(arena_pequena.usados == (uint32_t)atendidos);
+    assert(arena_pequena.contadores.alocacoes == (uint64_t)atendidos);
+    assert(arena_pequena.contadores.esgotamentos == (uint64_t)(pedidos - atendidos));
+    assert(arenaLivres(&arena_pequena) == 4 - (uint32_t)atendidos);
+}
+
+/**
+ * TESTE 2: Verificar liberação em lote
+ * PROPRIEDADE: Depois de arenaLiberarCiclo() a arena volta a ter N slots,
+ * o próximo ciclo reusa slots[0] zerado e o pico nunca passa de N
+ */
+void test_arena_liberacao_ciclo() {
+    arenaReset(&arena_pequena);
+
+    int ciclos = nondet_int();
+    __ESBMC_assume(ciclos >= 1 && ciclos <= 3);
+
+    for (int c = 0; c < ciclos; c++) {
+        int pedidos = nondet_int();
+        __ESBMC_assume(pedidos >= 0 && pedidos <= 5);
+
+        for (int i = 0; i < pedidos; i++) {
+            mensagem_pequena_t *m = arenaAlocar(&arena_pequena);
+            if (m) {
+                m->msgid = nondet_uint8();
+                m->len = nondet_uint8();
+            }
+        }
+
+        assert(arena_pequena.usados <= 4);
+        assert(arena_pequena.contadores.pico_ciclo <= 4);
+        arenaLiberarCiclo(&arena_pequena);
+        assert(arenaLivres(&arena_pequena) == 4);
+    }
+
+    mensagem_pequena_t *m = arenaAlocar(&arena_pequena);
+    assert(m == &arena_pequena.slots[0]);
+    assert(m->msgid == 0 && m->len == 0);
+    assert(arena_pequena.contadores.ciclos == (uint64_t)ciclos);
+}
+
+/**
+ * TESTE 3: Verificar decodificação para slot da arena
+ * PROPRIEDADE: Bytes arbitrários nunca fazem o decodificador ler além de
+ * n nem escrever além do payload do slot; quadro aceito cabe em n
+ */
+void test_arena_decodificar_quadro() {
+    arenaReset(&arena_quadros);
+
+    uint8_t entrada[16];
+    for (int i = 0; i < 16; i++) {
+        entrada[i] = nondet_uint8();
+    }
+    entrada[0] = MAVLINK_STX_V2;
+
+    size_t n = nondet_size_t();
+    __ESBMC_assume(n <= 16);
+
+    mavlink_mensagem_t *m = arenaAlocar(&arena_quadros);
+    assert(m != nullptr);
+
+    bool valido;
+    size_t consumidos = mavlinkDecodificar(entrada, n, m, &valido);
+
+    assert(consumidos <= n);
+
+    if (valido) {
+        assert(consumidos >= MAVLINK_CABECALHO + 2 + m->len);
+        assert(m->len <= n - MAVLINK_CABECALHO - 2);
+        assert(m->msgid == 0 || m->msgid == 22 || m->msgid == 24 || m->msgid == 30);
+    }
+}
+
+/**
+ * TESTE 4: Verificar sentenças GGA do fluxo GPS em arena própria
+ * PROPRIEDADE: Arena cheia descarta a sentença sem escrever fora dos slots
+ */
+void test_arena_gga_esgotamento() {
+    static arena_t<nmea_gga_t, 2> arena_gga;
+    arenaReset(&arena_gga);
+
+    int sentencas = nondet_int();
+    __ESBMC_assume(sentencas >= 0 && sentencas <= 3);
+
+    int descartadas = 0;
+    for (int i = 0; i < sentencas; i++) {
+        nmea_gga_t *g = arenaAlocar(&arena_gga);
+        if (g == nullptr) {
+            descartadas++;
+            continue;
+        }
+        g->satelites = nondet_uint8();
+    }
+
+    assert(descartadas == (sentencas > 2 ? sentencas - 2 : 0));
+    assert(arena_gga.contadores.esgotamentos == (uint64_t)descartadas);
+}
+
+// ================== MAIN PARA ESBMC ==================
+int main() {
+    int test_choice = nondet_int();
+    __ESBMC_assume(test_choice >= 0 && test_choice < 4);
+
+    switch(test_choice) {
+        case 0:
+            test_arena_alocacao_limites();
+            break;
+        case 1:
+            test_arena_liberacao_ciclo();
+            break;
+        case 2:
+            test_arena_decodificar_quadro();
+            break;
+        case 3:
+            test_arena_gga_esgotamento();
+            break;
+    }
+
+    return 0;
+}
+
+#else // MODO_NATIVO
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <thread>
+#include <vector>
+
+// ================== HEAP INSTRUMENTADO ==================
+// Toda alocação do processo passa por aqui: prova de zero heap no caminho quente.
+// Contador por thread: cada estágio mede só as próprias alocações
+
+static thread_local uint64_t heap_alocacoes = 0;
+
+void *operator new(size_t n) {
+    heap_alocacoes++;
+    void *p = malloc(n ? n : 1);
+    if (!p) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void *p) noexcept { free(p); }
+void operator delete(void *p, size_t) noexcept { free(p); }
+
+// ================== GERAÇÃO DO FLUXO ==================
+
+static void anexarQuadro(std::vector<uint8_t> &fluxo, uint32_t msgid, uint8_t len, uint8_t seq, uint32_t *x) {
+    uint8_t extra = 0;
+    mavlinkCrcExtra(msgid, &extra);
+
+    const size_t inicio = fluxo.size();
+    const uint8_t cab[MAVLINK_CABECALHO] = {MAVLINK_STX_V2, len, 0, 0, seq, 1, 1, (uint8_t)msgid,
+                                             (uint8_t)(msgid >> 8), (uint8_t)(msgid >> 16)};
+    fluxo.insert(fluxo.end(), cab, cab + MAVLINK_CABECALHO);
+
+    for (int i = 0; i < len; i++) {
+        *x = *x * 1103515245u + 12345u;
+        fluxo.push_back((uint8_t)(*x >> 16));
+    }
+
+    uint16_t crc = 0xFFFF;
+    for (size_t i = inicio + 1; i < fluxo.size(); i++) {
+        crc = crcX25(crc, fluxo[i]);
+    }
+    crc = crcX25(crc, extra);
+    fluxo.push_back((uint8_t)crc);
+    fluxo.push_back((uint8_t)(crc >> 8));
+}
+
+// Mistura típica de telemetria: ATTITUDE, GPS_RAW_INT, PARAM_VALUE, HEARTBEAT, com lixo ocasional
+static std::vector<uint8_t> gerarFluxo(size_t quadros, uint32_t semente) {
+    static const uint32_t ids[] = {30, 30, 30, 24, 22, 0};
+    static const uint8_t lens[] = {28, 28, 28, 30, 25, 9};
+    std::vector<uint8_t> fluxo;
+    uint32_t x = semente;
+
+    for (size_t i = 0; i < quadros; i++) {
+        x = x * 1103515245u + 12345u;
+        const int k = (x >> 16) % 6;
+        anexarQuadro(fluxo, ids[k], lens[k], (uint8_t)i, &x);
+
+        if ((x >> 8) % 64 == 0) {
+            fluxo.push_back(0x55);     // Ruído na serial: força ressincronização
+        }
+    }
+
+    return fluxo;
+}
+
+// ================== ESTÁGIOS ==================
+
+struct resultado_t {
+    uint64_t mensagens;
+    uint64_t soma;                 // Consumo do lote (evita que o compilador descarte o trabalho)
+    uint64_t heap_ciclo;           // Alocações de heap no regime permanente
+    double ns_por_msg;
+    arena_contadores_t contadores; // Só no estágio com arena
+};
+
+/**
+ * Estágio com arena: decodifica direto no slot, entrega o lote do ciclo
+ * por ponteiro e devolve tudo de uma vez no fim do ciclo.
+ */
+static resultado_t estagioArena(const std::vector<uint8_t> &fluxo, uint32_t por_ciclo, int repeticoes) {
+    arena_t<mavlink_mensagem_t, ARENA_MAVLINK_SLOTS> *arena = arenaDaThread<mavlink_mensagem_t, ARENA_MAVLINK_SLOTS>();
+    mavlink_mensagem_t *lote[ARENA_MAVLINK_SLOTS];
+    resultado_t r = {0, 0, 0, 0.0, {}};
+    uint64_t heap_inicio = 0;
+
+    arenaReset(arena);
+    auto t0 = std::chrono::steady_clock::now();
+
+    for (int rep = 0; rep < repeticoes; rep++) {
+        if (rep == 1) {
+            heap_inicio = heap_alocacoes;     // Após o aquecimento
+        }
+
+        size_t pos = 0;
+        while (pos < fluxo.size()) {
+            uint32_t n = 0;
+
+            while (n < por_ciclo && pos < fluxo.size()) {
+                mavlink_mensagem_t *m = arenaAlocar(arena);
+                if (!m) {
+                    break;
+                }
+
+                bool valido = false;
+                size_t usados = 0;
+                while (!valido && pos < fluxo.size()) {
+                    usados = mavlinkDecodificar(fluxo.data() + pos, fluxo.size() - pos, m, &valido);
+                    pos += usados ? usados : fluxo.size() - pos;
+                }
+
+                if (valido) {
+                    lote[n++] = m;
+                }
+            }
+
+            for (uint32_t i = 0; i < n; i++) {
+                r.soma += lote[i]->msgid + lote[i]->payload[0];
+            }
+
+            r.mensagens += n;
+            arenaLiberarCiclo(arena);
+        }
+    }
+
+    auto t1 = std::chrono::steady_clock::now();
+    r.heap_ciclo = heap_alocacoes - heap_inicio;
+    r.ns_por_msg = std::chrono::duration<double, std::nano>(t1 - t0).count() / (double)r.mensagens;
+    r.contadores = arena->contadores;
+    return r;
+}
+
+/**
+ * Referência: alocador padrão, um new por mensagem e delete do lote no
+ * fim do ciclo (o vetor do lote é reservado uma vez, como seria no estágio)
+ */
+static resultado_t estagioHeap(const std::vector<uint8_t> &fluxo, uint32_t por_ciclo, int repeticoes) {
+    std::vector<mavlink_mensagem_t *> lote;
+    lote.reserve(por_ciclo);
+    resultado_t r = {0, 0, 0, 0.0, {}};
+    uint64_t heap_inicio = 0;
+
+    auto t0 = std::chrono::steady_clock::now();
+
+    for (int rep = 0; rep < repeticoes; rep++) {
+        if (rep == 1) {
+            heap_inicio = heap_alocacoes;
+        }
+
+        size_t pos = 0;
+        while (pos < fluxo.size()) {
+            while (lote.size() < por_ciclo && pos < fluxo.size()) {
+                mavlink_mensagem_t *m = new mavlink_mensagem_t;
+                bool valido = false;
+                size_t usados = 0;
+
+                while (!valido && pos < fluxo.size()) {
+                    usados = mavlinkDecodificar(fluxo.data() + pos, fluxo.size() - pos, m, &valido);
+                    pos += usados ? usados : fluxo.size() - pos;
+                }
+
+                if (valido) {
+                    lote.push_back(m);
+                } else {
+                    delete m;
+                }
+            }
+
+            for (mavlink_mensagem_t *m : lote) {
+                r.soma += m->msgid + m->payload[0];
+                delete m;
+            }
+
+            r.mensagens += lote.size();
+            lote.clear();
+        }
+    }
+
+    auto t1 = std::chrono::steady_clock::now();
+    r.heap_ciclo = heap_alocacoes - heap_inicio;
+    r.ns_por_msg = std::chrono::duration<double, std::nano>(t1 - t0).count() / (double)r.mensagens;
+    return r;
+}
+
+// ================== BENCHMARK ==================
+
+int main(int argc, char **argv) {
+    const size_t quadros = (argc > 1) ? (size_t)atoi(argv[1]) : 100000;
+    const int threads = (argc > 2) ? atoi(argv[2]) : 4;
+    const uint32_t por_ciclo = 100;          // 100k msg/s com ciclo de 1 ms
+    const int repeticoes = 10;
+
+    if (quadros == 0 || threads <= 0) {
+        fprintf(stderr, "uso: %s [quadros] [threads]\n", argv[0]);
+        return 1;
+    }
+
+    const std::vector<uint8_t> fluxo = gerarFluxo(quadros, 2026);
+    arena_contadores_t contadores = {};
+    const uint64_t ciclos = (uint64_t)repeticoes * ((quadros + por_ciclo - 1) / por_ciclo);
+
+    printf("fluxo=%zu quadros (%.1f KB) lote=%u msg/ciclo (100k msg/s a 1 kHz) repeticoes=%d\n",
+           quadros, fluxo.size() / 1024.0, por_ciclo, repeticoes);
+    printf("%-8s %8s %12s %10s %14s %14s\n", "estagio", "threads", "mensagens", "ns/msg", "CPU@100k msg/s",
+           "heap/ciclo");
+
+    for (int modo = 0; modo < 2; modo++) {
+        for (int t : {1, threads}) {
+            std::vector<resultado_t> rs(t);
+            std::vector<std::thread> ws;
+
+            for (int i = 0; i < t; i++) {
+                ws.emplace_back([&, i]() {
+                    rs[i] = modo == 0 ? estagioArena(fluxo, por_ciclo, repeticoes)
+                                      : estagioHeap(fluxo, por_ciclo, repeticoes);
+                });
+            }
+            for (std::thread &w : ws) {
+                w.join();
+            }
+
+            resultado_t total = {0, 0, 0, 0.0, {}};
+            for (const resultado_t &r : rs) {
+                total.mensagens += r.mensagens;
+                total.soma += r.soma;
+                total.heap_ciclo += r.heap_ciclo;
+                total.ns_por_msg += r.ns_por_msg / t;
+            }
+
+            printf("%-8s %8d %12llu %10.1f %13.2f%% %14.2f\n", modo == 0 ? "arena" : "new", t,
+                   (unsigned long long)total.mensagens, total.ns_por_msg, total.ns_por_msg * 1e5 / 1e9 * 100.0,
+                   (double)total.heap_ciclo / t / (ciclos * (repeticoes - 1) / repeticoes));
+
+            if (rs[0].soma != total.soma / t) {
+                printf("DIVERGENCIA entre threads\n");
+                return 1;
+            }
+
+            if (modo == 0 && t == 1) {
+                contadores = rs[0].contadores;
+            }
+        }
+    }
+
+    printf("arena: slots=%u x %zu B alocacoes=%llu ciclos=%llu pico_ciclo=%u esgotamentos=%llu\n",
+           ARENA_MAVLINK_SLOTS, sizeof(mavlink_mensagem_t), (unsigned long long)contadores.alocacoes,
+           (unsigned long long)contadores.ciclos, contadores.pico_ciclo,
+           (unsigned long long)contadores.esgotamentos);
+    return 0;
+}
+
+#endif // MODO_NATIVO
+
+/*
+ * ================================================================
+ * DOCUMENTAÇÃO
+ * ================================================================
+ *
+ * ARENA DE MENSAGENS:
+ *
+ * 1. ALOCAÇÃO:
+ *    - N slots de tamanho fixo por tipo de mensagem, índice crescente
+ *    - Arena cheia: nullptr + esgotamentos++ (nunca recorre ao heap)
+ *    - Slot entregue zerado; tipo trivial (sem construtor/destrutor)
+ *
+ * 2. LIBERAÇÃO EM LOTE:
+ *    - arenaLiberarCiclo() no fim de cada ciclo de processamento
+ *    - Ponteiros do ciclo anterior não podem ser guardados
+ *    - pico_ciclo dimensiona N (ARENA_MAVLINK_SLOTS)
+ *
+ * 3. THREADS:
+ *    - arenaDaThread<T, N>(): uma arena thread_local por tipo, sem trava
+ *
+ * 4. PROPRIEDADES VERIFICADAS (ESBMC):
+ *    - Slots distintos e dentro da arena; nullptr exatamente quando cheia
+ *    - Liberação devolve os N slots e reusa slots[0] zerado
+ *    - Quadro MAVLink v2 arbitrário não lê além de n nem escreve além do payload
+ *    - Sentenças GGA excedentes são descartadas e contadas
+ *
+ * COMANDOS DE EXECUÇÃO:
+ * esbmc arena.cpp --unwind 17 --overflow-check --bounds-check
+ * g++ -O2 -DMODO_NATIVO -pthread arena.cpp -o arena_bench && ./arena_bench 100000 4
+ *
+ * BENCHMARK:
+ * - ns por mensagem (decodificação + lote + liberação) com arena e com
+ *   new/delete, em 1 e em N threads
+ * - Fração de um núcleo gasta a 100k msg/s e alocações de heap por ciclo
+ *   no regime permanente (arena: 0)
+ *
+ * ================================================================
+ */
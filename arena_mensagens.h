@@ -0,0 +1,123 @@
+/**
+ * @file arena_mensagens.h
+ * @author Dissertação Mestrado - Verificação Formal PX4 v1.16
+ *
+ * OBJETIVO: Arena limitada para mensagens de protocolo decodificadas
+ * MÓDULO: Armazenamento por mensagem dos estágios MAVLink e UBX/NMEA
+ *
+ * Cada estágio de protocolo decodifica quadros em objetos de tamanho fixo
+ * que só vivem durante um ciclo de processamento. A arena é um vetor de N
+ * slots com índice de alocação crescente: alocar é incrementar um contador,
+ * liberar é zerar o contador no fim do ciclo (liberação em lote). Sem heap,
+ * sem free list, sem trava: cada thread usa a sua própria arena.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// ================== ESTRUTURAS ==================
+
+/**
+ * Contadores expostos para telemetria e benchmark. pico_ciclo é o maior
+ * número de slots usados num único ciclo (dimensionamento de N).
+ */
+struct arena_contadores_t {
+    uint64_t alocacoes;      // Alocações atendidas
+    uint64_t esgotamentos;   // Pedidos recusados com a arena cheia
+    uint64_t ciclos;         // Liberações em lote
+    uint32_t pico_ciclo;
+};
+
+/**
+ * Arena de N objetos T. T precisa ser trivial: a liberação em lote não
+ * chama destrutores e o slot é reinicializado por atribuição de T{}.
+ */
+template<typename T, uint32_t N>
+struct arena_t {
+    static_assert(std::is_trivial<T>::value, "arena_t: liberacao em lote exige tipo trivial");
+    static_assert(N > 0, "arena_t: capacidade zero");
+
+    T slots[N];
+    uint32_t usados;                 // Slots entregues no ciclo atual
+    arena_contadores_t contadores;
+};
+
+// ================== OPERAÇÕES ==================
+
+template<typename T, uint32_t N>
+inline void arenaReset(arena_t<T, N> *a) {
+    a->usados = 0;
+    a->contadores.alocacoes = 0;
+    a->contadores.esgotamentos = 0;
+    a->contadores.ciclos = 0;
+    a->contadores.pico_ciclo = 0;
+}
+
+/**
+ * FUNÇÃO 1: arenaAlocar()
+ * ESPECIFICAÇÃO: Próximo slot livre, zerado, ou nullptr se os N slots do
+ * ciclo já foram entregues. Nunca recorre ao heap: mensagem que não cabe
+ * é descartada pelo chamador e contada em esgotamentos.
+ */
+template<typename T, uint32_t N>
+inline T *arenaAlocar(arena_t<T, N> *a) {
+    if (a->usados >= N) {
+        a->contadores.esgotamentos++;
+        return nullptr;
+    }
+
+    T *slot = &a->slots[a->usados];
+    *slot = T{};
+    a->usados++;
+    a->contadores.alocacoes++;
+
+    if (a->usados > a->contadores.pico_ciclo) {
+        a->contadores.pico_ciclo = a->usados;
+    }
+
+    return slot;
+}
+
+/**
+ * FUNÇÃO 2: arenaLiberarCiclo()
+ * ESPECIFICAÇÃO: Devolve todos os slots de uma vez. Ponteiros obtidos no
+ * ciclo deixam de ser válidos (o próximo ciclo reusa os mesmos slots).
+ */
+template<typename T, uint32_t N>
+inline void arenaLiberarCiclo(arena_t<T, N> *a) {
+    a->usados = 0;
+    a->contadores.ciclos++;
+}
+
+template<typename T, uint32_t N>
+inline uint32_t arenaLivres(const arena_t<T, N> *a) {
+    return N - a->usados;
+}
+
+// Slot pertence à arena e foi entregue no ciclo atual
+template<typename T, uint32_t N>
+inline bool arenaContem(const arena_t<T, N> *a, const T *p) {
+    for (uint32_t i = 0; i < a->usados; i++) {
+        if (p == &a->slots[i]) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+#ifdef MODO_NATIVO
+/**
+ * Uma arena por thread e por tipo de mensagem: sem trava e sem
+ * compartilhamento de linha de cache entre estágios em threads diferentes.
+ * Alocada uma vez (estática da thread), nunca no caminho quente.
+ */
+template<typename T, uint32_t N>
+inline arena_t<T, N> *arenaDaThread() {
+    static thread_local arena_t<T, N> arena = {};
+    return &arena;
+}
+#endif // MODO_NATIVO
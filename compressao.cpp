@@ -0,0 +1,571 @@
+/**
+ * @file compressao.cpp
+ * @author Dissertação Mestrado - Verificação Formal PX4 v1.16
+ *
+ * OBJETIVO: Verificar o codec delta + zig-zag + empacotamento de imu_codec.h
+ *           e medir razão e velocidade em séries de IMU
+ * MÓDULO TESTADO: Saídas int16_t de processAccelData()/processGyroData()
+ *                 gravadas em log (ulog_formato.h)
+ * MÉTODO: Bounded Model Checking com ESBMC + benchmark nativo (-DMODO_NATIVO)
+ *
+ * MOTIVAÇÃO: A 1-2 kHz por eixo, amostras cruas de 16 bits enchem o
+ * armazenamento depressa, mas amostras consecutivas diferem pouco: o
+ * delta cabe em poucos bits. O codec precisa ser sem perda e rápido o
+ * bastante (GB/s) para não competir com o escritor de log.
+ */
+
+#include <assert.h>
+#include <cstring>
+#include <cstdint>
+
+#include "imu_codec.h"
+
+#ifndef MODO_NATIVO
+
+// ================== FUNÇÕES ESBMC ==================
+extern int nondet_int();
+extern int16_t nondet_int16();
+extern uint16_t nondet_uint16();
+extern uint8_t nondet_uint8();
+extern size_t nondet_size_t();
+extern void __ESBMC_assume(int condition);
+
+// ================== TESTES DE VERIFICAÇÃO FORMAL ==================
+
+/**
+ * TESTE 1: Verificar zig-zag
+ * PROPRIEDADE: Inversível para qualquer int16_t e |d| pequeno vira
+ * inteiro pequeno (z <= 2|d|), o que torna a largura do bloco pequena
+ */
+void test_zigzag() {
+    int16_t d = nondet_int16();
+    uint16_t z = imuZigZag(d);
+
+    assert(imuDesZigZag(z) == d);
+
+    if (d > INT16_MIN) {
+        const int abs_d = d < 0 ? -d : d;
+        assert((int)z <= 2 * abs_d);
+    }
+}
+
+/**
+ * TESTE 2: Verificar largura
+ * PROPRIEDADE: b é o menor número de bits que representa o OU do bloco
+ */
+void test_largura() {
+    uint16_t ou = nondet_uint16();
+    int b = imuLargura(ou);
+
+    assert(b >= 0 && b <= 16);
+    assert((uint32_t)ou < (1u << b));
+
+    if (b > 0) {
+        assert((uint32_t)ou >= (1u << (b - 1)));
+    }
+}
+
+/**
+ * TESTE 3: Verificar ida e volta de um bloco
+ * PROPRIEDADE: Para quaisquer 16 amostras (2 linhas, todas as 8 lanes) e
+ * qualquer amostra anterior, decodificar(codificar(v)) == v e os dois
+ * lados concordam no tamanho
+ */
+void test_bloco_ida_volta() {
+    int16_t v[IMU_BLOCO], w[IMU_BLOCO];
+    uint8_t buf[IMU_BLOCO_MAX_BYTES];
+
+    for (size_t i = 0; i < 16; i++) {
+        v[i] = nondet_int16();
+    }
+    for (size_t i = 16; i < IMU_BLOCO; i++) {
+        v[i] = v[15];
+    }
+
+    int16_t anterior = nondet_int16();
+    size_t n = imuCodificarBlocoEscalar(anterior, v, buf);
+
+    assert(n == imuTamanhoBloco(buf[0]) && n <= sizeof(buf));
+    assert(imuDecodificarBlocoEscalar(anterior, buf, n, w) == n);
+
+    for (size_t i = 0; i < IMU_BLOCO; i++) {
+        assert(w[i] == v[i]);
+    }
+}
+
+/**
+ * TESTE 4: Verificar decodificação de entrada arbitrária
+ * PROPRIEDADE: Bytes corrompidos ou truncados nunca levam a leitura além
+ * de 'disponivel'; largura > 16 é rejeitada
+ */
+void test_decodificar_robusto() {
+    uint8_t in[40];
+    int16_t v[IMU_BLOCO];
+
+    for (int i = 0; i < 40; i++) {
+        in[i] = nondet_uint8();
+    }
+
+    size_t disponivel = nondet_size_t();
+    __ESBMC_assume(disponivel <= sizeof(in));
+
+    size_t c = imuDecodificarBlocoEscalar(0, in, disponivel, v);
+
+    assert(c <= disponivel);
+
+    if (disponivel > 0 && in[0] > 16) {
+        assert(c == 0);
+    }
+}
+
+// ================== MAIN PARA ESBMC ==================
+int main() {
+    int test_choice = nondet_int();
+    __ESBMC_assume(test_choice >= 0 && test_choice < 4);
+
+    switch(test_choice) {
+        case 0:
+            test_zigzag();
+            break;
+        case 1:
+            test_largura();
+            break;
+        case 2:
+            test_bloco_ida_volta();
+            break;
+        case 3:
+            test_decodificar_robusto();
+            break;
+    }
+
+    return 0;
+}
+
+#else // MODO_NATIVO
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "px4_funcoes.h"
+#include "ulog_formato.h"
+
+typedef std::vector<int16_t> serie_t;
+
+struct conjunto_t {
+    std::string nome;
+    std::vector<serie_t> eixos;
+};
+
+static uint64_t aleatorio(uint64_t *s) {
+    *s ^= *s << 13;
+    *s ^= *s >> 7;
+    *s ^= *s << 17;
+    return *s;
+}
+
+static double gaussiano(uint64_t *s) {
+    const double u1 = ((aleatorio(s) >> 11) + 1) * (1.0 / 9007199254740993.0);
+    const double u2 = (aleatorio(s) >> 11) * (1.0 / 9007199254740992.0);
+    return sqrt(-2.0 * log(u1)) * cos(2.0 * M_PI * u2);
+}
+
+static int16_t saturar(double x) {
+    return (int16_t)(x > 32767 ? 32767 : x < -32768 ? -32768 : lrint(x));
+}
+
+static double agoraS() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// ================== DADOS SINTÉTICOS ==================
+
+/**
+ * Multirrotor em voo pairado: acelerômetro BMI088 (±24 g, 1365 LSB/g) a
+ * 1600 Hz com gravidade em z, harmônicas do rotor (1ª e 2ª) e ruído;
+ * giroscópio (±2000 °/s, 16.4 LSB/(°/s)) a 2000 Hz. As amostras passam
+ * por processAccelData()/processGyroData(), como na saída do driver.
+ */
+static void gerarVoo(size_t n, conjunto_t *acc, conjunto_t *gyr) {
+    uint64_t s = 7;
+    acc->eixos.assign(3, serie_t(n));
+    gyr->eixos.assign(3, serie_t(n));
+
+    for (size_t i = 0; i < n; i++) {
+        const double ta = i / 1600.0, tg = i / 2000.0;
+        const double rotor = 118.0 + 4.0 * sin(2 * M_PI * 0.2 * ta);     // Rotação varia com o controle
+        const double h1 = sin(2 * M_PI * rotor * ta), h2 = sin(4 * M_PI * rotor * ta + 1.0);
+
+        const int16_t ax = saturar(0.25 * 1365 * h1 + 0.08 * 1365 * h2 + 3 * gaussiano(&s));
+        const int16_t ay = saturar(0.20 * 1365 * h2 + 3 * gaussiano(&s));
+        const int16_t az = saturar(-1365 + 0.30 * 1365 * h1 + 4 * gaussiano(&s));
+        int16_t oy, oz;
+        processAccelData(ay, az, &oy, &oz);
+        acc->eixos[0][i] = ax;
+        acc->eixos[1][i] = oy;
+        acc->eixos[2][i] = oz;
+
+        const double g1 = sin(2 * M_PI * rotor * tg);
+        int16_t gx, gy, gz;
+        processGyroData(saturar(16.4 * (2.0 * g1 + 5 * sin(2 * M_PI * 0.5 * tg)) + 2 * gaussiano(&s)),
+                        saturar(16.4 * 1.5 * g1 + 2 * gaussiano(&s)), saturar(16.4 * 0.8 * g1 + 2 * gaussiano(&s)),
+                        &gx, &gy, &gz);
+        gyr->eixos[0][i] = gx;
+        gyr->eixos[1][i] = gy;
+        gyr->eixos[2][i] = gz;
+    }
+}
+
+// Veículo parado na bancada: só ruído do sensor
+static void gerarBancada(size_t n, conjunto_t *c) {
+    uint64_t s = 11;
+    c->eixos.assign(3, serie_t(n));
+
+    for (size_t i = 0; i < n; i++) {
+        c->eixos[0][i] = saturar(2 * gaussiano(&s));
+        c->eixos[1][i] = saturar(2 * gaussiano(&s));
+        c->eixos[2][i] = saturar(-1365 + 2 * gaussiano(&s));
+    }
+}
+
+// Pior caso: 16 bits aleatórios (nada a comprimir; mede o custo do formato)
+static void gerarAleatorio(size_t n, conjunto_t *c) {
+    uint64_t s = 13;
+    c->eixos.assign(1, serie_t(n));
+
+    for (size_t i = 0; i < n; i++) {
+        c->eixos[0][i] = (int16_t)aleatorio(&s);
+    }
+}
+
+// ================== DADOS GRAVADOS (ULOG) ==================
+
+/**
+ * Extrai os eixos de imu_accel e imu_gyro de um log de ulog_writer.cpp
+ * (mesma varredura de blocos de log_analyzer.cpp).
+ */
+static bool lerUlog(const char *caminho, conjunto_t *acc, conjunto_t *gyr) {
+    const int fd = open(caminho, O_RDONLY);
+    struct stat st;
+
+    if (fd < 0 || fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(ulog_cabecalho_t)) {
+        perror(caminho);
+        return false;
+    }
+
+    const uint8_t *base = (const uint8_t *)mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+
+    if (base == MAP_FAILED) {
+        perror("mmap");
+        return false;
+    }
+
+    ulog_cabecalho_t cab;
+    memcpy(&cab, base, sizeof(cab));
+
+    if (!ulogValidarCabecalho(&cab) || (uint64_t)st.st_size < cab.tamanho_bloco) {
+        fprintf(stderr, "%s: cabecalho invalido\n", caminho);
+        munmap((void *)base, (size_t)st.st_size);
+        return false;
+    }
+
+    acc->eixos.assign(3, serie_t());
+    gyr->eixos.assign(3, serie_t());
+    const uint64_t num_blocos = (uint64_t)st.st_size / cab.tamanho_bloco;
+
+    for (uint64_t b = 1; b < num_blocos; b++) {
+        const uint8_t *bloco = base + b * cab.tamanho_bloco;
+        ulog_bloco_t cb;
+        memcpy(&cb, bloco, sizeof(cb));
+
+        if (cb.magic != ULOG_BLOCO_MAGIC || cb.bytes_usados < sizeof(ulog_bloco_t) ||
+            cb.bytes_usados > cab.tamanho_bloco) {
+            continue;
+        }
+
+        uint32_t offset = sizeof(ulog_bloco_t);
+        const ulog_registro_t *reg = nullptr;
+
+        while (offset < cb.bytes_usados) {
+            const uint32_t proximo = ulogProximoRegistro(bloco, cb.bytes_usados, offset, &reg);
+            if (proximo == 0) {
+                break;
+            }
+
+            const uint8_t *payload = bloco + offset + sizeof(ulog_registro_t);
+
+            if (reg->msg_id == ULOG_MSG_IMU_ACCEL && reg->tamanho == sizeof(ulog_imu_accel_t)) {
+                ulog_imu_accel_t r;
+                memcpy(&r, payload, sizeof(r));
+                acc->eixos[0].push_back(r.x);
+                acc->eixos[1].push_back(r.y);
+                acc->eixos[2].push_back(r.z);
+            } else if (reg->msg_id == ULOG_MSG_IMU_GYRO && reg->tamanho == sizeof(ulog_imu_gyro_t)) {
+                ulog_imu_gyro_t r;
+                memcpy(&r, payload, sizeof(r));
+                gyr->eixos[0].push_back(r.x);
+                gyr->eixos[1].push_back(r.y);
+                gyr->eixos[2].push_back(r.z);
+            }
+
+            offset = proximo;
+        }
+    }
+
+    munmap((void *)base, (size_t)st.st_size);
+    return !acc->eixos[0].empty() || !gyr->eixos[0].empty();
+}
+
+// ================== CONFERÊNCIAS ==================
+
+static uint64_t falhas = 0;
+
+static void falhar(const char *caso, size_t a, size_t b) {
+    if (falhas++ < 10) {
+        printf("  FALHA %s (%zu, %zu)\n", caso, a, b);
+    }
+}
+
+/**
+ * Blocos com deltas de cada largura 0..16 (SIMD == escalar byte a byte e
+ * ida e volta), todos os comprimentos 0..1100 (bloco parcial) e entradas
+ * truncadas ou com largura inválida.
+ */
+static bool conferirCodec() {
+    uint64_t s = 99;
+    int16_t v[IMU_BLOCO], w[IMU_BLOCO];
+    uint8_t a[IMU_BLOCO_MAX_BYTES], e[IMU_BLOCO_MAX_BYTES];
+    uint64_t casos = 0;
+
+    for (int b = 0; b <= 16; b++) {
+        for (int rep = 0; rep < 2000; rep++) {
+            int16_t anterior = (int16_t)aleatorio(&s), x = anterior;
+
+            for (size_t i = 0; i < IMU_BLOCO; i++) {
+                const uint16_t z = b ? (uint16_t)(aleatorio(&s) & ((1u << b) - 1)) : 0;
+                x = (int16_t)(uint16_t)((uint16_t)x + (uint16_t)imuDesZigZag(z));
+                v[i] = x;
+            }
+
+            const size_t na = imuCodificarBloco(anterior, v, a);
+            const size_t ne = imuCodificarBlocoEscalar(anterior, v, e);
+
+            if (na != ne || memcmp(a, e, na) != 0) {
+                falhar("SIMD != escalar", (size_t)b, (size_t)rep);
+            }
+            if (imuDecodificarBloco(anterior, a, na, w) != na || memcmp(v, w, sizeof(v)) != 0) {
+                falhar("ida e volta (SIMD)", (size_t)b, (size_t)rep);
+            }
+            if (imuDecodificarBlocoEscalar(anterior, a, na, w) != na || memcmp(v, w, sizeof(v)) != 0) {
+                falhar("ida e volta (escalar)", (size_t)b, (size_t)rep);
+            }
+            if (na > 1 && imuDecodificarBloco(anterior, a, na - 1, w) != 0) {
+                falhar("bloco truncado aceito", (size_t)b, na);
+            }
+            casos++;
+        }
+    }
+
+    std::vector<int16_t> serie(1100), volta(1100);
+    std::vector<uint8_t> buf(imuComprimidoMax(serie.size()));
+
+    for (size_t n = 0; n <= serie.size(); n++) {
+        for (size_t i = 0; i < n; i++) {
+            serie[i] = (int16_t)(i * 37 + (aleatorio(&s) & 0x3F));
+        }
+
+        const size_t c = imuComprimir(serie.data(), n, buf.data());
+        if (c > imuComprimidoMax(n) || !imuDescomprimir(buf.data(), c, volta.data(), n) ||
+            memcmp(serie.data(), volta.data(), n * sizeof(int16_t)) != 0) {
+            falhar("serie", n, c);
+        }
+        if (n > 0 && imuDescomprimir(buf.data(), c - 1, volta.data(), n)) {
+            falhar("serie truncada aceita", n, c);
+        }
+        casos++;
+    }
+
+    a[0] = 17;
+    if (imuDecodificarBloco(0, a, sizeof(a), w) != 0 || imuDecodificarBlocoEscalar(0, a, sizeof(a), w) != 0) {
+        falhar("largura 17 aceita", 17, 0);
+    }
+
+    printf("conferencia do codec: %llu casos, %llu falhas\n", (unsigned long long)casos,
+           (unsigned long long)falhas);
+    return falhas == 0;
+}
+
+// ================== BENCHMARK ==================
+
+typedef size_t (*codificar_t)(int16_t, const int16_t *, uint8_t *);
+typedef size_t (*decodificar_t)(int16_t, const uint8_t *, size_t, int16_t *);
+
+// Série inteira com o codificador dado (mesmo laço de imuComprimir/imuDescomprimir)
+static size_t comprimirCom(codificar_t f, const int16_t *v, size_t n, uint8_t *out) {
+    size_t escritos = 0;
+    int16_t anterior = 0;
+
+    for (size_t i = 0; i + IMU_BLOCO <= n; i += IMU_BLOCO) {
+        escritos += f(anterior, v + i, out + escritos);
+        anterior = v[i + IMU_BLOCO - 1];
+    }
+
+    return escritos;
+}
+
+static bool descomprimirCom(decodificar_t f, const uint8_t *in, size_t len, int16_t *v, size_t n) {
+    size_t lidos = 0;
+    int16_t anterior = 0;
+
+    for (size_t i = 0; i + IMU_BLOCO <= n; i += IMU_BLOCO) {
+        const size_t c = f(anterior, in + lidos, len - lidos, v + i);
+        if (c == 0) {
+            return false;
+        }
+        lidos += c;
+        anterior = v[i + IMU_BLOCO - 1];
+    }
+
+    return true;
+}
+
+struct medida_t {
+    double razao;
+    double bits_por_amostra;
+    double comp_gbs;
+    double desc_gbs;
+    bool integro;
+};
+
+static medida_t medir(const conjunto_t &c, codificar_t cod, decodificar_t dec) {
+    medida_t m = {};
+    size_t bruto = 0, comprimido = 0;
+    double t_comp = 0, t_desc = 0;
+    m.integro = true;
+
+    for (const serie_t &s : c.eixos) {
+        const size_t n = s.size() / IMU_BLOCO * IMU_BLOCO;      // Blocos inteiros: mede o laço principal
+        std::vector<uint8_t> buf(imuComprimidoMax(n));
+        std::vector<int16_t> volta(n);
+        size_t bytes = 0;
+
+        // Repete até ~0.2 s para séries curtas (logs pequenos)
+        const int voltas = n ? (int)(1 + (50u << 20) / (n * sizeof(int16_t))) : 0;
+        double t0 = agoraS();
+        for (int r = 0; r < voltas; r++) {
+            bytes = comprimirCom(cod, s.data(), n, buf.data());
+        }
+        t_comp += (agoraS() - t0) / (voltas ? voltas : 1);
+
+        t0 = agoraS();
+        for (int r = 0; r < voltas; r++) {
+            m.integro = descomprimirCom(dec, buf.data(), bytes, volta.data(), n) && m.integro;
+        }
+        t_desc += (agoraS() - t0) / (voltas ? voltas : 1);
+
+        m.integro = m.integro && memcmp(s.data(), volta.data(), n * sizeof(int16_t)) == 0;
+        bruto += n * sizeof(int16_t);
+        comprimido += bytes;
+    }
+
+    m.razao = comprimido ? (double)bruto / comprimido : 0;
+    m.bits_por_amostra = bruto ? 16.0 * comprimido / bruto : 0;
+    m.comp_gbs = t_comp > 0 ? bruto / t_comp / 1e9 : 0;
+    m.desc_gbs = t_desc > 0 ? bruto / t_desc / 1e9 : 0;
+    return m;
+}
+
+int main(int argc, char **argv) {
+    const bool codec_ok = conferirCodec();
+
+    const size_t n = 8u << 20;      // 8 Mi amostras por eixo (16 MB)
+    std::vector<conjunto_t> conjuntos(4);
+    conjuntos[0].nome = "voo accel";
+    conjuntos[1].nome = "voo gyro";
+    conjuntos[2].nome = "bancada";
+    conjuntos[3].nome = "aleatorio";
+    gerarVoo(n, &conjuntos[0], &conjuntos[1]);
+    gerarBancada(n, &conjuntos[2]);
+    gerarAleatorio(n, &conjuntos[3]);
+
+    for (int i = 1; i < argc; i++) {
+        conjunto_t acc, gyr;
+        if (lerUlog(argv[i], &acc, &gyr)) {
+            acc.nome = std::string("log accel");
+            gyr.nome = std::string("log gyro");
+            printf("%s: %zu amostras de accel, %zu de gyro\n", argv[i], acc.eixos[0].size(), gyr.eixos[0].size());
+            conjuntos.push_back(acc);
+            conjuntos.push_back(gyr);
+        }
+    }
+
+    printf("\n%-11s %-8s %7s %9s %13s %13s %7s\n", "dados", "codec", "razao", "bits/amo", "comprime GB/s",
+           "descomp GB/s", "integro");
+
+    bool integro = true;
+
+    for (const conjunto_t &c : conjuntos) {
+#ifdef IMU_CODEC_SIMD
+        const medida_t simd = medir(c, imuCodificarBloco, imuDecodificarBloco);
+        printf("%-11s %-8s %7.2f %9.2f %13.2f %13.2f %7s\n", c.nome.c_str(), "sse2", simd.razao,
+               simd.bits_por_amostra, simd.comp_gbs, simd.desc_gbs, simd.integro ? "sim" : "NAO");
+        integro = integro && simd.integro;
+#endif
+        const medida_t esc = medir(c, imuCodificarBlocoEscalar, imuDecodificarBlocoEscalar);
+        printf("%-11s %-8s %7.2f %9.2f %13.2f %13.2f %7s\n", c.nome.c_str(), "escalar", esc.razao,
+               esc.bits_por_amostra, esc.comp_gbs, esc.desc_gbs, esc.integro ? "sim" : "NAO");
+        integro = integro && esc.integro;
+    }
+
+    printf("sem perda em todos os conjuntos: %s\n", integro && codec_ok ? "sim" : "NAO");
+    return integro && codec_ok ? 0 : 1;
+}
+
+#endif // MODO_NATIVO
+
+/*
+ * ================================================================
+ * DOCUMENTAÇÃO
+ * ================================================================
+ *
+ * COMPRESSÃO DE SÉRIES DE IMU (imu_codec.h):
+ *
+ * 1. DELTA + ZIG-ZAG:
+ *    - Delta em 16 bits com volta: sem perda para qualquer série int16_t
+ *    - Zig-zag leva deltas negativos pequenos a inteiros pequenos
+ *
+ * 2. EMPACOTAMENTO POR BLOCO (frame-of-reference):
+ *    - 128 amostras por bloco, largura = bits do maior valor (0..16),
+ *      1 byte de cabeçalho + 16·b bytes
+ *    - Layout vertical de 8 lanes: SSE2 empacota/desempacota 8 amostras
+ *      por instrução; uma instância de template por largura
+ *    - Decodificação com soma de prefixos em 3 passos por linha
+ *
+ * 3. PROPRIEDADES VERIFICADAS (ESBMC):
+ *    - Zig-zag inversível e pequeno para deltas pequenos
+ *    - Largura mínima
+ *    - Ida e volta de bloco com quaisquer amostras em todas as lanes
+ *    - Entrada corrompida/truncada nunca lida além do disponível
+ *
+ * COMANDOS DE EXECUÇÃO:
+ * esbmc compressao.cpp --unwind 129 --overflow-check --bounds-check
+ * g++ -O2 -DMODO_NATIVO compressao.cpp px4_funcoes.cpp -o compressao_bench && ./compressao_bench [voo.ulg]
+ *
+ * BENCHMARK:
+ * - Voo pairado sintético (harmônicas do rotor + ruído, via
+ *   processAccelData/processGyroData), bancada (só ruído), pior caso
+ *   aleatório e, se passado, um log de ulog_writer_bench
+ * - Razão, bits por amostra, GB/s de compressão e descompressão (bytes
+ *   crus int16_t), SSE2 vs escalar, conferência sem perda
+ *
+ * ================================================================
+ */
@@ -0,0 +1,1050 @@
+/**
+ * @file concolico.cpp
+ * @author Dissertação Mestrado - Verificação Formal PX4 v1.16
+ *
+ * OBJETIVO: Exploração concólica dos harnesses: velocidade nativa com
+ *           consultas dirigidas para os ramos estreitos que o sorteio do
+ *           falsificador não alcança (dump_data->len >= GPS_DUMP_DATA_SIZE
+ *           com msg_to_gps_device, os três eixos do gyro em INT16_MIN)
+ * MÉTODO: Harness e biblioteca compilados com -fsanitize-coverage=trace-pc,
+ *         trace-cmp: cada bloco básico e cada comparação chamam o rastro
+ *         desta unidade (que não é instrumentada). Uma execução registra as
+ *         entradas nondet consumidas, as arestas e, por comparação, os dois
+ *         operandos e o bloco sucessor: a condição de caminho concreta.
+ *         Inverter um ramo = achar entradas com o outro sucessor naquela
+ *         comparação, uma tarefa por processo filho: heurísticas nativas
+ *         primeiro (FUNÇÃO 3) e, se não inverterem, consulta ao ESBMC com
+ *         o prefixo do caminho e o ramo negado (FUNÇÕES 4 e 5).
+ *
+ * VEREDITOS (mesmas frases do ESBMC, como o falsificador.cpp):
+ *   VERIFICATION FAILED   assert violado ou acesso inválido numa execução
+ *   VERIFICATION UNKNOWN  orçamento esgotado sem violação, com a cobertura
+ *
+ * g++ -O1 -std=c++17 -DMODO_NATIVO -DPX4_BIBLIOTECA -fsanitize-coverage=trace-pc,trace-cmp \
+ *     -c imu.cpp px4_funcoes.cpp
+ * g++ -O1 -std=c++17 -DTESTE_ALVO=test_gyro_data_processing concolico.cpp imu.o px4_funcoes.o -o concolico
+ * ./concolico [segundos] [workers] [esbmc|-]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <poll.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "esbmc_processo.h"
+
+#ifndef TESTE_ALVO
+#error "defina -DTESTE_ALVO=test_xxx"
+#endif
+
+extern void TESTE_ALVO();
+
+#define CONCOLICO_STR2(x) #x
+#define CONCOLICO_STR(x) CONCOLICO_STR2(x)
+
+// ================== ENTRADAS ==================
+
+struct entrada_t {
+    long double valor;         // 80 bits: representa exatamente qualquer int64/uint64
+    uint8_t bits;
+    bool com_sinal;
+    bool flutuante;
+};
+
+static std::vector<entrada_t> entrada;      // Prefixo a reproduzir
+static std::vector<entrada_t> usadas;       // Consumidas na execução corrente
+static uint64_t estado = 0x9E3779B97F4A7C15ULL;
+
+static uint64_t proximo() {
+    // xorshift64*, como no falsificador
+    estado ^= estado >> 12;
+    estado ^= estado << 25;
+    estado ^= estado >> 27;
+    return estado * 0x2545F4914F6CDD1DULL;
+}
+
+// Valor reduzido à largura do tipo (módulo 2^bits), como a conversão em C
+static long double ajustar(long double v, uint8_t bits, bool com_sinal) {
+    const __int128 modulo = (__int128)1 << bits;
+    __int128 x = (__int128)roundl(fmaxl(fminl(v, 1e30L), -1e30L)) % modulo;
+
+    x = x < 0 ? x + modulo : x;
+    if (com_sinal && x >= modulo / 2) {
+        x -= modulo;
+    }
+
+    return (long double)x;
+}
+
+/**
+ * FUNÇÃO 1: nondetValor()
+ * ESPECIFICAÇÃO: A i-ésima chamada nondet devolve a i-ésima entrada do
+ * prefixo; além dele, sorteio (fronteiras, pequenos, uniforme). O valor
+ * usado é anotado com o tipo pedido pelo harness, que é o tipo em que o
+ * resolvedor trabalha.
+ */
+template<typename T>
+static T nondetValor() {
+    constexpr bool flut = std::numeric_limits<T>::is_integer == false;
+    entrada_t e = {0.0L, (uint8_t)(sizeof(T) * 8), std::numeric_limits<T>::is_signed, flut};
+
+    if (usadas.size() < entrada.size()) {
+        e.valor = entrada[usadas.size()].valor;
+    } else {
+        const uint64_t r = proximo();
+        switch (r & 3) {
+        case 0: {
+            const long double fronteiras[] = {(long double)std::numeric_limits<T>::lowest(),
+                                              (long double)std::numeric_limits<T>::max(), 0.0L, 1.0L, -1.0L};
+            e.valor = fronteiras[(r >> 2) % 5];
+            break;
+        }
+        case 1:
+            e.valor = (long double)((int64_t)((r >> 2) % 317) - 16);
+            break;
+        default:
+            e.valor = flut ? (long double)((double)(r >> 11) / (double)(1ULL << 53) * 4.0 - 2.0)
+                           : (long double)(r >> 2);
+            break;
+        }
+    }
+
+    e.valor = flut ? (long double)(T)e.valor : ajustar(e.valor, e.bits, e.com_sinal);
+    usadas.push_back(e);
+    return (T)e.valor;
+}
+
+int nondet_int() { return nondetValor<int>(); }
+unsigned nondet_uint() { return nondetValor<unsigned>(); }
+int8_t nondet_int8() { return nondetValor<int8_t>(); }
+int16_t nondet_int16() { return nondetValor<int16_t>(); }
+int32_t nondet_int32() { return nondetValor<int32_t>(); }
+int64_t nondet_int64() { return nondetValor<int64_t>(); }
+uint8_t nondet_uint8() { return nondetValor<uint8_t>(); }
+uint16_t nondet_uint16() { return nondetValor<uint16_t>(); }
+uint32_t nondet_uint32() { return nondetValor<uint32_t>(); }
+uint64_t nondet_uint64() { return nondetValor<uint64_t>(); }
+size_t nondet_size_t() { return nondetValor<size_t>(); }
+bool nondet_bool() { return nondetValor<uint8_t>() & 1; }
+float nondet_float() { return nondetValor<float>(); }
+double nondet_double() { return nondetValor<double>(); }
+
+// ================== RASTRO ==================
+
+struct evento_t {
+    uintptr_t sitio;           // Endereço de retorno da chamada de comparação
+    uint32_t ocorrencia;       // n-ésima execução do mesmo sítio neste caminho
+    long double a;
+    long double b;
+    uintptr_t sucessor;        // Primeiro bloco após a comparação (0 = nenhum)
+};
+
+static constexpr size_t MAX_EVENTOS = 1 << 14;
+static constexpr size_t NUM_ARESTAS = 1 << 16;
+
+static evento_t eventos[MAX_EVENTOS];
+static size_t num_eventos = 0;
+static uint8_t arestas_vistas[NUM_ARESTAS];
+static std::vector<uint16_t> arestas;
+static uintptr_t bloco_anterior = 0;
+static uint64_t caminho = 1469598103934665603ULL;
+static bool rastreando = false;
+
+// Sucessores sintéticos de __ESBMC_assume (endereços reais nunca valem 1 ou 2)
+static constexpr uintptr_t ASSUME_ACEITA = 1;
+static constexpr uintptr_t ASSUME_REJEITADA = 2;
+
+static void anotarComparacao(uintptr_t sitio, long double a, long double b) {
+    if (rastreando && num_eventos < MAX_EVENTOS) {
+        eventos[num_eventos++] = {sitio, 0, a, b, 0};
+    }
+}
+
+struct assume_rejeitada_t {};
+
+// A condição chega como valor, sem desvio no harness: as comparações ainda
+// sem sucessor (mesmo bloco da chamada) recebem o resultado da assume
+void __ESBMC_assume(int condition) {
+    for (size_t i = num_eventos; rastreando && i-- > 0 && eventos[i].sucessor == 0;) {
+        eventos[i].sucessor = condition ? ASSUME_ACEITA : ASSUME_REJEITADA;
+    }
+
+    caminho = (caminho ^ (condition ? ASSUME_ACEITA : ASSUME_REJEITADA)) * 1099511628211ULL;
+
+    if (!condition) {
+        throw assume_rejeitada_t();
+    }
+}
+
+extern "C" {
+
+// Início de cada bloco básico: aresta (estilo AFL) e sucessor da última comparação
+void __sanitizer_cov_trace_pc() {
+    if (!rastreando) {
+        return;
+    }
+
+    const uintptr_t pc = (uintptr_t)__builtin_return_address(0);
+    const uint16_t aresta = (uint16_t)((pc ^ (bloco_anterior >> 1)) * 0x9E3779B1u >> 16);
+    bloco_anterior = pc;
+
+    if (!arestas_vistas[aresta]) {
+        arestas_vistas[aresta] = 1;
+        arestas.push_back(aresta);
+    }
+
+    caminho = (caminho ^ aresta) * 1099511628211ULL;
+
+    if (num_eventos > 0 && eventos[num_eventos - 1].sucessor == 0) {
+        eventos[num_eventos - 1].sucessor = pc;
+    }
+}
+
+// Operandos chegam sem sinal: interpretados com sinal na largura da comparação
+#define CONCOLICO_CMP(nome, T, S)                                                                         \
+    void nome(T a, T b) {                                                                                 \
+        anotarComparacao((uintptr_t)__builtin_return_address(0), (long double)(S)a, (long double)(S)b); \
+    }
+
+CONCOLICO_CMP(__sanitizer_cov_trace_cmp1, uint8_t, int8_t)
+CONCOLICO_CMP(__sanitizer_cov_trace_cmp2, uint16_t, int16_t)
+CONCOLICO_CMP(__sanitizer_cov_trace_cmp4, uint32_t, int32_t)
+CONCOLICO_CMP(__sanitizer_cov_trace_cmp8, uint64_t, int64_t)
+CONCOLICO_CMP(__sanitizer_cov_trace_const_cmp1, uint8_t, int8_t)
+CONCOLICO_CMP(__sanitizer_cov_trace_const_cmp2, uint16_t, int16_t)
+CONCOLICO_CMP(__sanitizer_cov_trace_const_cmp4, uint32_t, int32_t)
+CONCOLICO_CMP(__sanitizer_cov_trace_const_cmp8, uint64_t, int64_t)
+CONCOLICO_CMP(__sanitizer_cov_trace_cmpf, float, float)
+CONCOLICO_CMP(__sanitizer_cov_trace_cmpd, double, double)
+
+// switch: uma comparação por caso (casos[0] = quantidade, casos[1] = largura)
+void __sanitizer_cov_trace_switch(uint64_t valor, uint64_t *casos) {
+    const uintptr_t sitio = (uintptr_t)__builtin_return_address(0);
+
+    for (uint64_t i = 0; i < casos[0]; i++) {
+        anotarComparacao(sitio + i, (long double)valor, (long double)casos[2 + i]);
+    }
+}
+
+}  // extern "C"
+
+// ================== EXECUÇÃO ==================
+
+struct execucao_t {
+    bool rejeitada;
+    uint64_t caminho;
+    std::vector<entrada_t> usadas;
+    std::vector<evento_t> eventos;
+    std::vector<uint16_t> arestas;
+};
+
+static unsigned long long execucoes = 0;
+
+/**
+ * FUNÇÃO 2: executar()
+ * ESPECIFICAÇÃO: Uma execução nativa do TESTE_ALVO com o prefixo dado.
+ * Ocorrências numeradas depois (o rastro fica barato durante a execução);
+ * uma violação não volta daqui: o tratador de sinal relata e encerra.
+ */
+static execucao_t executar(const std::vector<entrada_t> &prefixo) {
+    entrada = prefixo;
+    usadas.clear();
+    arestas.clear();
+    memset(arestas_vistas, 0, sizeof(arestas_vistas));
+    num_eventos = 0;
+    bloco_anterior = 0;
+    caminho = 1469598103934665603ULL;
+    execucoes++;
+
+    execucao_t r;
+    r.rejeitada = false;
+    rastreando = true;
+
+    try {
+        TESTE_ALVO();
+    } catch (const assume_rejeitada_t &) {
+        r.rejeitada = true;
+    }
+
+    rastreando = false;
+
+    std::map<uintptr_t, uint32_t> vistos;
+    for (size_t i = 0; i < num_eventos; i++) {
+        eventos[i].ocorrencia = vistos[eventos[i].sitio]++;
+    }
+
+    r.caminho = caminho;
+    r.usadas = usadas;
+    r.eventos.assign(eventos, eventos + num_eventos);
+    r.arestas = arestas;
+    return r;
+}
+
+static const evento_t *buscarEvento(const execucao_t &x, uintptr_t sitio, uint32_t ocorrencia) {
+    for (const evento_t &e : x.eventos) {
+        if (e.sitio == sitio && e.ocorrencia == ocorrencia) {
+            return &e;
+        }
+    }
+
+    return nullptr;
+}
+
+// ================== RESOLVEDOR POR RAMO ==================
+
+/**
+ * FUNÇÃO 3: candidatosInversao()
+ * ESPECIFICAÇÃO: Consulta dirigida para a comparação (sitio, ocorrencia)
+ * do caminho base, sobre a distância d(x) = a - b, uma entrada por vez:
+ *   entrada-para-estado  o operando a ou b é a própria entrada (módulo a
+ *                        largura): troca pelo outro operando, ±1
+ *   Newton               g = Δd/Δx medido reexecutando com x+δ; candidatos
+ *                        x - (d - t)/g para t em {-1, 0, +1}, que cobrem
+ *                        ==, !=, <, <=, >, >= sem conhecer o operador
+ * As demais entradas ficam iguais: o prefixo do caminho tende a se manter.
+ */
+static std::vector<std::vector<entrada_t>> candidatosInversao(const execucao_t &base, const evento_t &alvo) {
+    std::vector<std::vector<entrada_t>> candidatos;
+    const long double d0 = alvo.a - alvo.b;
+
+    auto propor = [&](size_t j, long double v) {
+        std::vector<entrada_t> c = base.usadas;
+        const entrada_t &e = c[j];
+        c[j].valor = e.flutuante ? v : ajustar(v, e.bits, e.com_sinal);
+
+        if (c[j].valor != base.usadas[j].valor) {
+            candidatos.push_back(c);
+        }
+    };
+
+    for (size_t j = 0; j < base.usadas.size(); j++) {
+        const entrada_t &e = base.usadas[j];
+
+        for (const long double lado : {alvo.a, alvo.b}) {
+            const long double outro = lado == alvo.a ? alvo.b : alvo.a;
+            if (!e.flutuante && ajustar(e.valor, 32, true) == ajustar(lado, 32, true)) {
+                for (int t = -1; t <= 1; t++) {
+                    propor(j, e.valor + (outro - lado) + t);
+                }
+            }
+        }
+
+        const long double delta = e.flutuante ? fmaxl(fabsl(e.valor) * 1e-3L, 1e-3L) : 1.0L;
+        std::vector<entrada_t> perturbada = base.usadas;
+        perturbada[j].valor += delta;
+
+        const execucao_t p = executar(perturbada);
+        const evento_t *ep = buscarEvento(p, alvo.sitio, alvo.ocorrencia);
+
+        if (!ep) {
+            continue;
+        }
+
+        const long double g = ((ep->a - ep->b) - d0) / delta;
+        if (g == 0.0L || !std::isfinite((double)g)) {
+            continue;
+        }
+
+        for (int t = -1; t <= 1; t++) {
+            propor(j, e.valor - (d0 - t) / g);
+        }
+    }
+
+    return candidatos;
+}
+
+// ================== CONSULTA AO SOLVER ==================
+
+static constexpr double SOLVER_TIMEOUT_S = 4.0;
+static constexpr size_t MAX_PREFIXO = 64;                   // Comparações do prefixo na consulta
+
+static std::string esbmc = "esbmc";                         // "" = só as heurísticas
+static std::string dir_consultas = "concolico_consultas";
+
+// d(x) = d0 + Σ g[j] (x_j - x_j da base), g medido por reexecução
+struct restricao_linear_t {
+    long double d0;
+    std::vector<long double> g;
+};
+
+/**
+ * FUNÇÃO 4: linearizar()
+ * ESPECIFICAÇÃO: Condição de caminho da base até o evento 'indice' (o
+ * alvo, último do vetor): cada comparação com sucessor e o alvo, com a
+ * derivada discreta de d = a - b em relação a cada entrada (uma
+ * reexecução por entrada). Comparações que não dependem de nenhuma
+ * entrada ficam de fora; do prefixo, as MAX_PREFIXO mais próximas.
+ */
+static std::vector<restricao_linear_t> linearizar(const execucao_t &base, size_t indice) {
+    std::vector<size_t> eventos;
+    for (size_t k = 0; k <= indice; k++) {
+        if (base.eventos[k].sucessor != 0 || k == indice) {
+            eventos.push_back(k);
+        }
+    }
+
+    std::vector<restricao_linear_t> r(eventos.size());
+    for (size_t i = 0; i < eventos.size(); i++) {
+        const evento_t &e = base.eventos[eventos[i]];
+        r[i] = {e.a - e.b, std::vector<long double>(base.usadas.size(), 0.0L)};
+    }
+
+    for (size_t j = 0; j < base.usadas.size(); j++) {
+        const entrada_t &e = base.usadas[j];
+        const long double delta = e.flutuante ? fmaxl(fabsl(e.valor) * 1e-3L, 1e-3L) : 1.0L;
+        std::vector<entrada_t> perturbada = base.usadas;
+        perturbada[j].valor += delta;
+
+        const execucao_t p = executar(perturbada);
+
+        for (size_t i = 0; i < eventos.size(); i++) {
+            const evento_t &b = base.eventos[eventos[i]];
+            const evento_t *ep = buscarEvento(p, b.sitio, b.ocorrencia);
+            const long double g = ep ? ((ep->a - ep->b) - r[i].d0) / delta : 0.0L;
+            r[i].g[j] = std::isfinite((double)g) ? g : 0.0L;
+        }
+    }
+
+    std::vector<restricao_linear_t> prefixo;
+    for (size_t i = 0; i + 1 < r.size(); i++) {
+        if (std::any_of(r[i].g.begin(), r[i].g.end(), [](long double g) { return g != 0.0L; })) {
+            prefixo.push_back(r[i]);
+        }
+    }
+
+    if (prefixo.size() > MAX_PREFIXO) {
+        prefixo.erase(prefixo.begin(), prefixo.end() - MAX_PREFIXO);
+    }
+
+    prefixo.push_back(r.back());
+    return prefixo;
+}
+
+static const char *tipoC(const entrada_t &e) {
+    if (e.flutuante) {
+        return e.bits == 32 ? "float" : "double";
+    }
+
+    static const char *tipos[2][4] = {{"uint8_t", "uint16_t", "uint32_t", "uint64_t"},
+                                      {"int8_t", "int16_t", "int32_t", "int64_t"}};
+    const int k = e.bits == 8 ? 0 : e.bits == 16 ? 1 : e.bits == 32 ? 2 : 3;
+    return tipos[e.com_sinal][k];
+}
+
+// Inteiro exato como literal long long (uint64 acima de 2^63 entra com o módulo, como a conversão)
+static std::string inteiroC(long double v) {
+    char buf[64];
+
+    if (v >= 9223372036854775808.0L) {
+        snprintf(buf, sizeof(buf), "(long long)%.0LfULL", v);
+    } else if (v <= -9223372036854775808.0L) {
+        snprintf(buf, sizeof(buf), "(-9223372036854775807LL - 1)");
+    } else {
+        snprintf(buf, sizeof(buf), "%.0LfLL", v);
+    }
+
+    return buf;
+}
+
+// d(x) em C: long long se todos os termos são inteiros, senão double
+static std::string expressaoC(const restricao_linear_t &r, const std::vector<entrada_t> &base) {
+    bool inteira = roundl(r.d0) == r.d0;
+    for (size_t j = 0; j < base.size(); j++) {
+        inteira = inteira && (r.g[j] == 0.0L || (!base[j].flutuante && roundl(r.g[j]) == r.g[j]));
+    }
+
+    char buf[160];
+    std::string s = "(";
+
+    if (inteira) {
+        s += inteiroC(r.d0);
+    } else {
+        snprintf(buf, sizeof(buf), "%.21Lg", r.d0);
+        s += buf;
+    }
+
+    for (size_t j = 0; j < base.size(); j++) {
+        if (r.g[j] == 0.0L) {
+            continue;
+        }
+
+        if (inteira) {
+            s += " + " + inteiroC(r.g[j]) + " * ((long long)concolico_x" + std::to_string(j) + " - " +
+                 inteiroC(base[j].valor) + ")";
+        } else {
+            snprintf(buf, sizeof(buf), " + %.21Lg * ((double)concolico_x%zu - %.21Lg)", r.g[j], j, base[j].valor);
+            s += buf;
+        }
+    }
+
+    return s + ")";
+}
+
+/**
+ * FUNÇÃO 5: consultarSolver()
+ * ESPECIFICAÇÃO: Programa C com as entradas da base como nondet do tipo
+ * anotado, o prefixo como __ESBMC_assume(d_k(x) com o sinal da base) e o
+ * alvo como __ESBMC_assume(d(x) <relacao>), seguido de __ESBMC_assert(0):
+ * VERIFICATION FAILED = satisfazível, e o contraexemplo (linhas
+ * "concolico_x<j> = v") é o modelo. A linearização é exata para operandos
+ * afins nas entradas (os ramos dos harnesses); fora disso o modelo é só
+ * um candidato, confirmado pela reexecução nativa.
+ */
+static bool consultarSolver(const std::vector<restricao_linear_t> &rs, const std::vector<entrada_t> &base,
+                            const char *relacao, std::vector<entrada_t> *modelo) {
+    std::string q = "// Consulta gerada por concolico.cpp: prefixo do caminho e ramo negado. Não editar.\n"
+                    "#include <stdint.h>\n\n"
+                    "extern void __ESBMC_assume(int condition);\n"
+                    "extern void __ESBMC_assert(int condition, const char *descricao);\n\n";
+
+    for (size_t j = 0; j < base.size(); j++) {
+        q += std::string(tipoC(base[j])) + " nondet_concolico_x" + std::to_string(j) + "(void);\n";
+    }
+
+    q += "\nint main(void) {\n";
+    for (size_t j = 0; j < base.size(); j++) {
+        q += "    " + std::string(tipoC(base[j])) + " concolico_x" + std::to_string(j) + " = nondet_concolico_x" +
+             std::to_string(j) + "();\n";
+    }
+
+    q += "\n";
+    for (size_t k = 0; k + 1 < rs.size(); k++) {
+        const char *sinal = rs[k].d0 < 0 ? "< 0" : rs[k].d0 > 0 ? "> 0" : "== 0";
+        q += "    __ESBMC_assume(" + expressaoC(rs[k], base) + " " + sinal + ");\n";
+    }
+
+    q += "    __ESBMC_assume(" + expressaoC(rs.back(), base) + " " + relacao + ");      // Ramo negado\n"
+         "    __ESBMC_assert(0, \"modelo\");\n    return 0;\n}\n";
+
+    const std::string nome = dir_consultas + "/" + std::to_string(getpid());
+    std::ofstream(nome + ".c", std::ios::trunc) << q;
+
+    const processo_t r = executarProcesso({esbmc, nome + ".c", "--no-bounds-check", "--no-pointer-check",
+                                           "--no-div-by-zero-check"}, SOLVER_TIMEOUT_S, nome + ".log");
+    std::string log;
+    lerArquivo(nome + ".log", &log);
+    unlink((nome + ".c").c_str());
+    unlink((nome + ".log").c_str());
+
+    if (r.timeout || log.find("VERIFICATION FAILED") == std::string::npos) {
+        return false;
+    }
+
+    std::istringstream linhas(log);
+    std::string linha;
+    *modelo = base;
+
+    while (std::getline(linhas, linha)) {
+        const size_t p = linha.find("concolico_x");
+        unsigned j;
+        long double v;
+
+        if (p != std::string::npos && sscanf(linha.c_str() + p, "concolico_x%u = %Lg", &j, &v) == 2 &&
+            j < modelo->size()) {
+            entrada_t &e = (*modelo)[j];
+            e.valor = e.flutuante ? v : ajustar(v, e.bits, e.com_sinal);
+        }
+    }
+
+    return true;
+}
+
+// ================== PROCESSO FILHO (TAREFA) ==================
+
+struct tarefa_t {
+    std::vector<entrada_t> entrada;
+    uintptr_t sitio;           // 0 = só executar (semente)
+    uint32_t ocorrencia;
+    uint64_t semente;
+};
+
+static int fd_relatorio = -1;
+
+static void escreverEntradas(std::string *s, const std::vector<entrada_t> &v) {
+    char buf[96];
+
+    *s += " " + std::to_string(v.size());
+    for (const entrada_t &e : v) {
+        snprintf(buf, sizeof(buf), " %u:%d:%d:%.21Lg", e.bits, e.com_sinal, e.flutuante, e.valor);
+        *s += buf;
+    }
+}
+
+/**
+ * FUNÇÃO 6: relatarExecucao()
+ * ESPECIFICAÇÃO: Uma linha por caminho novo para o coordenador:
+ *   R <caminho> <inverteu> <rejeitada> <n> bits:sinal:flut:valor ...
+ *     <na> aresta ... <nr> sitio:ocorrencia:sucessor ...
+ * Dos ramos vai só a primeira ocorrência de cada (sítio, sucessor): é o
+ * que o coordenador usa para criar tarefas.
+ */
+static void relatarExecucao(const execucao_t &x, bool inverteu) {
+    char buf[96];
+    std::string s = "R " + std::to_string(x.caminho) + (inverteu ? " 1" : " 0") + (x.rejeitada ? " 1" : " 0");
+    escreverEntradas(&s, x.usadas);
+
+    s += " " + std::to_string(x.arestas.size());
+    for (uint16_t a : x.arestas) {
+        s += " " + std::to_string(a);
+    }
+
+    std::set<std::pair<uintptr_t, uintptr_t>> ramos;
+    std::string lista;
+    for (const evento_t &e : x.eventos) {
+        if (ramos.insert({e.sitio, e.sucessor}).second) {
+            snprintf(buf, sizeof(buf), " %lx:%u:%lx", (unsigned long)e.sitio, e.ocorrencia, (unsigned long)e.sucessor);
+            lista += buf;
+        }
+    }
+
+    s += " " + std::to_string(ramos.size()) + lista + "\n";
+    (void)!write(fd_relatorio, s.data(), s.size());
+}
+
+static void reportarViolacao(int sinal) {
+    // Mesmo cuidado do falsificador: buffer fixo, write() direto
+    char buf[4096];
+    int n = snprintf(buf, sizeof(buf), "V %s", sinal == SIGABRT ? "assert" : "acesso_invalido");
+
+    for (const entrada_t &e : usadas) {
+        if (n < (int)sizeof(buf) - 64) {
+            n += snprintf(buf + n, sizeof(buf) - n, " %s%d=%.9Lg", e.flutuante ? "float" : (e.com_sinal ? "int" : "uint"),
+                          e.bits, e.valor);
+        }
+    }
+
+    buf[n++] = '\n';
+    (void)!write(fd_relatorio, buf, n);
+    _exit(1);
+}
+
+/**
+ * FUNÇÃO 7: executarTarefa()
+ * ESPECIFICAÇÃO: No processo filho. Semente: uma execução. Inversão:
+ * caminho base, candidatos da FUNÇÃO 3 e um segundo passo de Newton a
+ * partir de cada candidato que manteve o sucessor (caminho rápido); sem
+ * inversão, consultas ao solver (FUNÇÃO 5), uma por relação que nega o
+ * ramo. Relata cada caminho distinto; "inverteu" marca os que trocaram o
+ * sucessor do alvo. Cada consulta relata "C <modelo>".
+ */
+static void executarTarefa(const tarefa_t &t) {
+    estado ^= t.semente * 0xBF58476D1CE4E5B9ULL;
+    const execucao_t base = executar(t.entrada);
+    std::set<uint64_t> relatados = {base.caminho};
+
+    if (t.sitio == 0) {
+        relatarExecucao(base, false);
+        return;
+    }
+
+    const evento_t *alvo = buscarEvento(base, t.sitio, t.ocorrencia);
+    if (!alvo) {
+        return;
+    }
+
+    std::vector<std::vector<entrada_t>> fila = candidatosInversao(base, *alvo);
+
+    for (int passo = 0; passo < 2 && !fila.empty(); passo++) {
+        std::vector<std::vector<entrada_t>> proximos;
+
+        for (const std::vector<entrada_t> &c : fila) {
+            const execucao_t x = executar(c);
+            const evento_t *e = buscarEvento(x, alvo->sitio, alvo->ocorrencia);
+            const bool inverteu = e && e->sucessor != alvo->sucessor;
+
+            if (relatados.insert(x.caminho).second) {
+                relatarExecucao(x, inverteu);
+            }
+
+            if (inverteu) {
+                return;
+            }
+
+            if (passo == 0 && e && proximos.size() < 8) {
+                const std::vector<std::vector<entrada_t>> mais = candidatosInversao(x, *e);
+                proximos.insert(proximos.end(), mais.begin(), mais.end());
+            }
+        }
+
+        fila.swap(proximos);
+    }
+
+    if (esbmc.empty()) {
+        return;
+    }
+
+    // Alvo sem dependência medida de nenhuma entrada: a consulta não teria como mudar o ramo
+    const std::vector<restricao_linear_t> rs = linearizar(base, (size_t)(alvo - base.eventos.data()));
+    if (std::none_of(rs.back().g.begin(), rs.back().g.end(), [](long double g) { return g != 0.0L; })) {
+        return;
+    }
+
+    // Operador desconhecido: sinal oposto nega <, <=, >, >=; "== 0" nega != (e <, > com igualdade)
+    const long double d0 = alvo->a - alvo->b;
+    const std::vector<const char *> relacoes = d0 < 0 ? std::vector<const char *>{"> 0", "== 0"}
+                                             : d0 > 0 ? std::vector<const char *>{"< 0", "== 0"}
+                                                      : std::vector<const char *>{"!= 0"};
+
+    for (const char *relacao : relacoes) {
+        std::vector<entrada_t> modelo;
+        const bool sat = consultarSolver(rs, base.usadas, relacao, &modelo);
+        const std::string linha = sat ? "C 1\n" : "C 0\n";
+        (void)!write(fd_relatorio, linha.data(), linha.size());
+
+        if (!sat) {
+            continue;
+        }
+
+        const execucao_t x = executar(modelo);
+        const evento_t *e = buscarEvento(x, alvo->sitio, alvo->ocorrencia);
+        const bool inverteu = e && e->sucessor != alvo->sucessor;
+
+        if (relatados.insert(x.caminho).second) {
+            relatarExecucao(x, inverteu);
+        }
+
+        if (inverteu) {
+            return;
+        }
+    }
+}
+
+// ================== COORDENADOR ==================
+
+struct filho_t {
+    pid_t pid;
+    int fd;
+    std::string saida;
+};
+
+static bool lerEntradas(const char **p, std::vector<entrada_t> *v) {
+    int n = 0, k = 0;
+
+    if (sscanf(*p, " %d%n", &n, &k) != 1) {
+        return false;
+    }
+
+    *p += k;
+    for (int i = 0; i < n; i++) {
+        unsigned bits;
+        int sinal, flut;
+        long double valor;
+
+        if (sscanf(*p, " %u:%d:%d:%Lg%n", &bits, &sinal, &flut, &valor, &k) != 4) {
+            return false;
+        }
+
+        *p += k;
+        v->push_back({valor, (uint8_t)bits, sinal != 0, flut != 0});
+    }
+
+    return true;
+}
+
+struct exploracao_t {
+    std::set<uint64_t> caminhos;
+    std::set<uint16_t> arestas;
+    std::map<uintptr_t, std::set<uintptr_t>> sucessores;
+    std::map<uintptr_t, int> tentativas;
+    std::deque<tarefa_t> fronteira;
+    std::string violacao;
+    unsigned long long tarefas = 0;
+    unsigned long long inversoes = 0;
+    unsigned long long rejeitadas = 0;
+    unsigned long long abortadas = 0;
+    unsigned long long rodadas = 0;
+    unsigned long long consultas = 0;
+    unsigned long long modelos = 0;
+};
+
+/**
+ * FUNÇÃO 8: absorverLinha()
+ * ESPECIFICAÇÃO: Caminho inédito entra no corpus; cada comparação dele
+ * com um lado só observado até agora vira tarefa de inversão (no máximo
+ * 4 tentativas por sítio, para laços não monopolizarem a fronteira).
+ * Assume rejeitada também vira tarefa: invertê-la é achar entrada válida.
+ */
+static void absorverLinha(exploracao_t *x, const std::string &linha) {
+    if (linha.compare(0, 2, "V ") == 0) {
+        x->violacao = x->violacao.empty() ? linha.substr(2) : x->violacao;
+        return;
+    }
+
+    if (linha.compare(0, 2, "C ") == 0) {
+        x->consultas++;
+        x->modelos += linha.compare(2, 1, "1") == 0 ? 1 : 0;
+        return;
+    }
+
+    unsigned long long hash;
+    int inverteu, rejeitada, k;
+    if (sscanf(linha.c_str(), "R %llu %d %d%n", &hash, &inverteu, &rejeitada, &k) != 3) {
+        return;
+    }
+
+    const char *p = linha.c_str() + k;
+    std::vector<entrada_t> usadas_linha;
+    int na = 0;
+    if (!lerEntradas(&p, &usadas_linha) || sscanf(p, " %d%n", &na, &k) != 1) {
+        return;
+    }
+
+    p += k;
+    for (int i = 0; i < na; i++) {
+        unsigned a;
+        if (sscanf(p, " %u%n", &a, &k) == 1) {
+            p += k;
+            x->arestas.insert((uint16_t)a);
+        }
+    }
+
+    x->inversoes += inverteu;
+    x->rejeitadas += rejeitada;
+
+    if (!x->caminhos.insert(hash).second) {
+        return;
+    }
+
+    int nr = 0;
+    sscanf(p, " %d%n", &nr, &k);
+    p += k;
+
+    std::vector<std::pair<uintptr_t, uint32_t>> ramos;
+    for (int i = 0; i < nr; i++) {
+        unsigned long sitio, sucessor;
+        unsigned ocorrencia;
+        if (sscanf(p, " %lx:%u:%lx%n", &sitio, &ocorrencia, &sucessor, &k) != 3) {
+            break;
+        }
+
+        p += k;
+        x->sucessores[sitio].insert(sucessor);
+        ramos.push_back({sitio, ocorrencia});
+    }
+
+    for (const auto &r : ramos) {
+        const std::set<uintptr_t> &lados = x->sucessores[r.first];
+
+        // Sem desvio (setcc/cmov) não há o que inverter; assume aceita não se inverte
+        if (lados.count(0) || lados.count(ASSUME_ACEITA)) {
+            continue;
+        }
+
+        if (lados.size() < 2 && x->tentativas[r.first] < 4) {
+            x->tentativas[r.first]++;
+            x->fronteira.push_back({usadas_linha, r.first, r.second, x->tarefas + x->fronteira.size()});
+        }
+    }
+}
+
+static bool lancarFilho(const tarefa_t &t, double limite_s, filho_t *f) {
+    int tubo[2];
+
+    if (pipe(tubo) != 0) {
+        return false;
+    }
+
+    f->pid = fork();
+    if (f->pid == 0) {
+        close(tubo[0]);
+        fd_relatorio = tubo[1];
+        signal(SIGABRT, reportarViolacao);
+        signal(SIGSEGV, reportarViolacao);
+        signal(SIGBUS, reportarViolacao);
+        alarm((unsigned)std::max(1.0, limite_s));     // Laço infinito: SIGALRM encerra a tarefa
+        executarTarefa(t);
+        _exit(0);
+    }
+
+    close(tubo[1]);
+    f->fd = tubo[0];
+    f->saida.clear();
+    return f->pid > 0;
+}
+
+int main(int argc, char **argv) {
+    const double segundos = argc > 1 ? atof(argv[1]) : 10.0;
+    long nucleos = sysconf(_SC_NPROCESSORS_ONLN);
+    const int workers = argc > 2 ? atoi(argv[2]) : (int)std::max(1L, nucleos);
+    esbmc = argc > 3 ? argv[3] : "esbmc";
+
+    // Sem ESBMC executável: só as heurísticas, com aviso
+    if (esbmc != "-") {
+        criarDiretorios(dir_consultas);
+        const processo_t v = executarProcesso({esbmc, "--version"}, 30.0, dir_consultas + "/versao.log");
+        unlink((dir_consultas + "/versao.log").c_str());
+
+        if (v.status != 0) {
+            fprintf(stderr, "%s indisponivel: inversao so pelas heuristicas\n", esbmc.c_str());
+            esbmc.clear();
+        }
+    } else {
+        esbmc.clear();
+    }
+
+    exploracao_t x;
+    std::vector<filho_t> filhos;
+
+    const auto inicio = std::chrono::steady_clock::now();
+    auto decorrido = [&]() { return std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count(); };
+
+    while (x.violacao.empty() && decorrido() < segundos) {
+        // Sementes (prefixo vazio, tudo sorteado) no início e sempre que a fronteira
+        // esvazia com orçamento sobrando; o limite de tentativas por sítio recomeça
+        if (x.fronteira.empty() && filhos.empty()) {
+            x.tentativas.clear();
+            x.rodadas++;
+            for (int i = 0; i < workers; i++) {
+                x.fronteira.push_back({{}, 0, 0, (uint64_t)getpid() * 1000003ULL + x.tarefas + (uint64_t)i});
+            }
+        }
+
+        while ((int)filhos.size() < workers && !x.fronteira.empty() && decorrido() < segundos) {
+            filho_t f;
+            if (!lancarFilho(x.fronteira.front(), esbmc.empty() ? 5.0 : 5.0 + 2 * SOLVER_TIMEOUT_S, &f)) {
+                perror("fork");
+                return 2;
+            }
+
+            x.fronteira.pop_front();
+            x.tarefas++;
+            filhos.push_back(f);
+        }
+
+        std::vector<pollfd> pfds;
+        for (const filho_t &f : filhos) {
+            pfds.push_back({f.fd, POLLIN, 0});
+        }
+
+        poll(pfds.data(), pfds.size(), 200);
+
+        for (size_t i = filhos.size(); i-- > 0;) {
+            if (!(pfds[i].revents & (POLLIN | POLLHUP))) {
+                continue;
+            }
+
+            char buf[65536];
+            const ssize_t n = read(filhos[i].fd, buf, sizeof(buf));
+
+            if (n > 0) {
+                filhos[i].saida.append(buf, n);
+                size_t fim;
+                while ((fim = filhos[i].saida.find('\n')) != std::string::npos) {
+                    absorverLinha(&x, filhos[i].saida.substr(0, fim));
+                    filhos[i].saida.erase(0, fim + 1);
+                }
+                continue;
+            }
+
+            // EOF: filho terminou
+            int status = 0;
+            close(filhos[i].fd);
+            waitpid(filhos[i].pid, &status, 0);
+            x.abortadas += WIFSIGNALED(status) ? 1 : 0;
+            filhos.erase(filhos.begin() + i);
+        }
+    }
+
+    for (const filho_t &f : filhos) {
+        kill(f.pid, SIGKILL);
+        waitpid(f.pid, nullptr, 0);
+        close(f.fd);
+    }
+
+    rmdir(dir_consultas.c_str());
+
+    size_t dois_lados = 0;
+    for (const auto &s : x.sucessores) {
+        dois_lados += s.second.size() >= 2 ? 1 : 0;
+    }
+
+    printf("%s: %zu caminhos, %zu arestas, %zu de %zu comparacoes com os dois lados, %llu tarefas "
+           "(%llu ramos invertidos, %llu abortadas), %llu consultas ao solver (%llu com modelo), "
+           "%llu rodadas de sementes, %.1f s, %d workers\n",
+           CONCOLICO_STR(TESTE_ALVO), x.caminhos.size(), x.arestas.size(), dois_lados, x.sucessores.size(), x.tarefas,
+           x.inversoes, x.abortadas, x.consultas, x.modelos, x.rodadas, decorrido(), workers);
+
+    if (!x.violacao.empty()) {
+        printf("\nVERIFICATION FAILED (%s) em %s\nentradas:%s\n", x.violacao.substr(0, x.violacao.find(' ')).c_str(),
+               CONCOLICO_STR(TESTE_ALVO), x.violacao.substr(x.violacao.find(' ')).c_str());
+        return 1;
+    }
+
+    printf("VERIFICATION UNKNOWN: %s sem violacao no orcamento\n", CONCOLICO_STR(TESTE_ALVO));
+    return 0;
+}
+
+/*
+ * ================================================================
+ * DOCUMENTAÇÃO
+ * ================================================================
+ *
+ * EXPLORAÇÃO CONCÓLICA:
+ *
+ * 1. CONDIÇÃO DE CAMINHO CONCRETA:
+ *    - O GCC chama __sanitizer_cov_trace_cmp* com os operandos de cada
+ *      comparação inteira/float e __sanitizer_cov_trace_pc no início de
+ *      cada bloco; o bloco seguinte a uma comparação identifica o lado
+ *    - Não há expressão simbólica: a relação entrada -> operandos é medida
+ *      reexecutando (entrada-para-estado e derivada discreta)
+ *    - __ESBMC_assume recebe a condição como valor: as comparações que a
+ *      formaram ganham o sucessor sintético aceita/rejeitada, e só o lado
+ *      rejeitado gera tarefa
+ *
+ * 2. CONSULTAS POR RAMO:
+ *    - Um ramo por vez, mantendo as outras entradas: a consulta é pequena
+ *      e responde em poucas execuções nativas (microssegundos cada)
+ *    - len >= GPS_DUMP_DATA_SIZE: operando = entrada uint8 -> troca direta
+ *    - gyro_x == INT16_MIN após nondet_int() truncado: Newton com g = 1
+ *      acerta em um passo; as três comparações em cadeia caem uma por
+ *      tarefa, cada uma partindo do caminho que inverteu a anterior
+ *    - Caminho rápido: essas heurísticas, só execuções nativas
+ *
+ * 3. CONSULTA AO SOLVER (heurísticas sem inversão):
+ *    - Prefixo do caminho até o ramo: cada comparação com sucessor vira
+ *      __ESBMC_assume(d_k(x) com o mesmo sinal da base), d_k linearizado
+ *      pelas derivadas discretas; o ramo entra negado e o
+ *      __ESBMC_assert(0) final faz o contraexemplo ser o modelo
+ *    - Operador desconhecido: até duas consultas (sinal oposto, depois
+ *      d == 0); o modelo é reexecutado nativo, que decide se inverteu
+ *    - Exata para operandos afins nas entradas; máscaras e divisões dão
+ *      modelo só aproximado e podem não inverter: ficam para o BMC, que
+ *      continua sendo a prova
+ *    - Timeout de 4 s por consulta; sem ESBMC (ou argumento "-"), só o
+ *      caminho rápido
+ *
+ * 4. PARALELISMO:
+ *    - Uma tarefa por processo filho (fork, sem exec: mesmos endereços
+ *      de sítio); até [workers] filhos, resultados por pipe
+ *    - Assert/SIGSEGV no filho relata as entradas e encerra tudo com
+ *      VERIFICATION FAILED, como o falsificador
+ *    - Filho preso em laço morre por SIGALRM (5 s, mais o tempo das
+ *      consultas) e conta como abortado
+ *    - Fronteira esgotada antes do orçamento: nova rodada de sementes
+ *      sorteadas, com o limite de tentativas por sítio zerado
+ *
+ * COMANDOS DE EXECUÇÃO:
+ * g++ -O1 -std=c++17 -DMODO_NATIVO -DPX4_BIBLIOTECA -fsanitize-coverage=trace-pc,trace-cmp \
+ *     -c gpsdrive.cpp px4_funcoes.cpp
+ * g++ -O1 -std=c++17 -DTESTE_ALVO=test_gps_real_bit_operation concolico.cpp gpsdrive.o px4_funcoes.o \
+ *     -o concolico && ./concolico 10 4
+ * ./concolico 10 4 -                  (sem consultas ao ESBMC)
+ *
+ * ================================================================
+ */
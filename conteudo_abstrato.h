@@ -0,0 +1,47 @@
+/**
+ * @file conteudo_abstrato.h
+ * @author Dissertação Mestrado - Verificação Formal PX4 v1.16
+ *
+ * OBJETIVO: Abstrair o conteúdo dos buffers de bytes do GPS: as
+ *           propriedades são de comprimento e índice, não dos bytes
+ * USO: dumpGpsData() em gpsdrive.cpp e px4_funcoes.cpp
+ *
+ * MODOS (escolhidos por -D na compilação/front end):
+ *   padrão               memcpy real: o solver rastreia cada byte copiado
+ *                        (claims de string.c linha 278)
+ *   -DABSTRAIR_CONTEUDO  COPIAR_BYTES só acessa o primeiro e o último byte
+ *                        de origem e destino: os limites continuam checados,
+ *                        o conteúdo do destino fica sem restrição
+ *
+ * Solidez: test_gps_conteudo_independente (gpsdrive.cpp, sem a flag) prova
+ * que len/instance/timestamp não dependem dos bytes de entrada para
+ * input_len até 300; com isso as propriedades dos testes GPS valem igual
+ * nos dois modos. Teste novo com a flag e entrada maior exige ampliar o
+ * domínio daquele teste.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * FUNÇÃO 1: copiaSemConteudo()
+ * ESPECIFICAÇÃO: Mesmos acessos válidos que memcpy(dst, src, n): os dois
+ * intervalos são contíguos, então o primeiro e o último byte dentro do
+ * objeto implicam o intervalo inteiro dentro dele. Os n-2 bytes do meio
+ * não entram na fórmula.
+ */
+inline void copiaSemConteudo(uint8_t *dst, const uint8_t *src, size_t n) {
+    if (n > 0) {
+        dst[0] = src[0];
+        dst[n - 1] = src[n - 1];
+    }
+}
+
+#ifdef ABSTRAIR_CONTEUDO
+#define COPIAR_BYTES(dst, src, n) copiaSemConteudo((dst), (src), (n))
+#else
+#define COPIAR_BYTES(dst, src, n) memcpy((dst), (src), (n))
+#endif
@@ -0,0 +1,882 @@
+/**
+ * @file corrotinas.cpp
+ * @author Dissertação Mestrado - Verificação Formal PX4 v1.16
+ *
+ * OBJETIVO: Verificar o heap de temporizadores de corrotinas.h e medir
+ *           drivers escritos como corrotinas contra uma thread por dispositivo
+ * MÓDULO TESTADO: Configuração UBX do GPS (-> dumpGpsData) e leitura da FIFO
+ *                 do acelerômetro BMI088 (fifoReadCount, processAccelData,
+ *                 updateTemperature)
+ * MÉTODO: Bounded Model Checking com ESBMC + benchmark nativo (-DMODO_NATIVO, -std=c++20)
+ *
+ * MOTIVAÇÃO: Os drivers são sequências "escreve, espera, confere": reset e
+ * espera de partida da IMU, comando UBX e espera do ACK com nova tentativa.
+ * Com uma thread por dispositivo, cada espera é uma troca de contexto e
+ * cada dispositivo reserva uma pilha; como máquina de estados à mão, o
+ * código perde a forma linear. Como corrotina, o driver continua linear e
+ * todos os dispositivos dividem uma thread.
+ */
+
+#include <assert.h>
+#include <cstring>
+#include <cstdint>
+
+#include "corrotinas.h"
+#include "px4_funcoes.h"
+
+// ================== FIFO DO ACELERÔMETRO (BMI088) ==================
+static constexpr uint8_t BMI_ACC_SOFTRESET = 0x7E;
+static constexpr uint8_t BMI_ACC_PWR_CTRL = 0x7D;
+static constexpr uint8_t BMI_TEMP_MSB = 0x22;
+static constexpr uint8_t BMI_FIFO_LENGTH_0 = 0x24;
+static constexpr uint8_t BMI_FIFO_DATA = 0x26;
+static constexpr uint8_t BMI_FIFO_QUADRO_ACC = 0x84;   // Cabeçalho + x, y, z (LSB, MSB)
+static constexpr uint8_t BMI_FIFO_QUADRO_SKIP = 0x40;  // Cabeçalho + contagem de quadros perdidos
+static constexpr size_t BMI_FIFO_BYTES = 1024;
+static constexpr size_t BMI_QUADRO_BYTES = 7;
+
+/**
+ * FUNÇÃO 1: decodificarFifoAccel()
+ * ESPECIFICAÇÃO: Percorre quadros de 7 bytes (0x84) e de 2 bytes (0x40)
+ * até o fim do buffer, um cabeçalho desconhecido ou max amostras. Nunca lê
+ * além de n nem escreve além de max.
+ */
+static int decodificarFifoAccel(const uint8_t *buf, size_t n, int16_t *y, int16_t *z, int max) {
+    size_t i = 0;
+    int k = 0;
+
+    while (k < max && i < n) {
+        if (buf[i] == BMI_FIFO_QUADRO_ACC && n - i >= BMI_QUADRO_BYTES) {
+            y[k] = combine(buf[i + 4], buf[i + 3]);
+            z[k] = combine(buf[i + 6], buf[i + 5]);
+            k++;
+            i += BMI_QUADRO_BYTES;
+        } else if (buf[i] == BMI_FIFO_QUADRO_SKIP && n - i >= 2) {
+            i += 2;
+        } else {
+            break;
+        }
+    }
+
+    return k;
+}
+
+#ifndef MODO_NATIVO
+
+// ================== FUNÇÕES ESBMC ==================
+extern int nondet_int();
+extern uint8_t nondet_uint8();
+extern uint64_t nondet_uint64();
+extern size_t nondet_size_t();
+extern void __ESBMC_assume(int condition);
+
+static corr_heap_t heap;
+
+// ================== TESTES DE VERIFICAÇÃO FORMAL ==================
+
+/**
+ * TESTE 1: Verificar ordem de retomada
+ * PROPRIEDADE: Quaisquer 5 prazos saem em ordem não decrescente e, no
+ * empate, na ordem de inserção (retomadas determinísticas)
+ */
+void test_heap_ordem() {
+    corrHeapReset(&heap);
+
+    for (uintptr_t i = 1; i <= 5; i++) {
+        uint64_t prazo = nondet_uint64();
+        __ESBMC_assume(prazo < 4);      // Poucos valores: força empates
+        assert(corrHeapInserir(&heap, prazo, (void *)i));
+    }
+
+    corr_temporizador_t anterior;
+    assert(corrHeapRemover(&heap, &anterior));
+
+    for (int i = 1; i < 5; i++) {
+        corr_temporizador_t t;
+        assert(corrHeapRemover(&heap, &t));
+        assert(t.prazo_us >= anterior.prazo_us);
+
+        if (t.prazo_us == anterior.prazo_us) {
+            assert((uintptr_t)t.alvo > (uintptr_t)anterior.alvo);
+        }
+
+        anterior = t;
+    }
+
+    assert(heap.n == 0);
+}
+
+/**
+ * TESTE 2: Verificar inserções e remoções intercaladas
+ * PROPRIEDADE: n acompanha as operações, remover do heap vazio falha sem
+ * escrever e o mínimo removido nunca é maior que o que fica no topo
+ */
+void test_heap_intercalado() {
+    corrHeapReset(&heap);
+    int esperado = 0;
+
+    for (int passo = 0; passo < 6; passo++) {
+        if (nondet_int() & 1) {
+            assert(corrHeapInserir(&heap, nondet_uint64(), nullptr));
+            esperado++;
+        } else {
+            corr_temporizador_t t = {7, 7, nullptr};
+            bool ok = corrHeapRemover(&heap, &t);
+            assert(ok == (esperado > 0));
+
+            if (ok) {
+                esperado--;
+                if (heap.n > 0) {
+                    assert(!corrAntes(heap.itens[0], t));
+                }
+            } else {
+                assert(t.prazo_us == 7 && t.seq == 7);
+            }
+        }
+
+        assert(heap.n == esperado);
+    }
+}
+
+/**
+ * TESTE 3: Verificar decodificação da FIFO com bytes arbitrários
+ * PROPRIEDADE: Conteúdo e tamanho lidos do sensor (não confiáveis) nunca
+ * levam a acesso fora de buf[] nem de y[]/z[]
+ */
+void test_fifo_limites() {
+    uint8_t buf[16];
+    int16_t y[2], z[2];
+
+    for (int i = 0; i < 16; i++) {
+        buf[i] = nondet_uint8();
+    }
+
+    size_t n = nondet_size_t();
+    int max = nondet_int();
+    __ESBMC_assume(n <= sizeof(buf));
+    __ESBMC_assume(max >= 0 && max <= 2);
+
+    int k = decodificarFifoAccel(buf, n, y, z, max);
+
+    assert(k >= 0 && k <= max);
+    assert((size_t)k * BMI_QUADRO_BYTES <= n);
+}
+
+/**
+ * TESTE 4: Verificar leitura de um quadro conhecido
+ * PROPRIEDADE: 0x84 seguido de x, y, z (LSB primeiro) produz y e z
+ * montados por combine(); quadro de descarte é pulado
+ */
+void test_fifo_quadro() {
+    uint8_t ylsb = nondet_uint8(), ymsb = nondet_uint8(), zlsb = nondet_uint8(), zmsb = nondet_uint8();
+    uint8_t buf[9] = {BMI_FIFO_QUADRO_SKIP, 0x01, BMI_FIFO_QUADRO_ACC, 0, 0, ylsb, ymsb, zlsb, zmsb};
+    int16_t y[1], z[1];
+
+    assert(decodificarFifoAccel(buf, sizeof(buf), y, z, 1) == 1);
+    assert(y[0] == combine(ymsb, ylsb));
+    assert(z[0] == combine(zmsb, zlsb));
+}
+
+// ================== MAIN PARA ESBMC ==================
+int main() {
+    int test_choice = nondet_int();
+    __ESBMC_assume(test_choice >= 0 && test_choice < 4);
+
+    switch(test_choice) {
+        case 0:
+            test_heap_ordem();
+            break;
+        case 1:
+            test_heap_intercalado();
+            break;
+        case 2:
+            test_fifo_limites();
+            break;
+        case 3:
+            test_fifo_quadro();
+            break;
+    }
+
+    return 0;
+}
+
+#else // MODO_NATIVO
+
+#if __cplusplus < 202002L
+#error "corrotinas.cpp nativo exige -std=c++20"
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include <pthread.h>
+#include <sys/prctl.h>
+#include <sys/resource.h>
+
+// ================== CONTAGEM DE ALOCAÇÕES ==================
+
+static std::atomic<uint64_t> heap_alocacoes{0};
+
+void *operator new(size_t n) {
+    heap_alocacoes.fetch_add(1, std::memory_order_relaxed);
+    void *p = malloc(n ? n : 1);
+    if (!p) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void *p) noexcept { free(p); }
+void operator delete(void *p, size_t) noexcept { free(p); }
+
+// ================== MODELO DA IMU ==================
+static constexpr uint32_t IMU_ODR_HZ = 1600;
+static constexpr uint64_t IMU_PERIODO_US = 1000;      // Driver lê a FIFO a 1 kHz
+static constexpr uint32_t IMU_CICLOS_TEMPERATURA = 100;
+
+struct imu_sim_t {
+    // Sensor
+    uint64_t ligado_us;
+    bool ligado;
+    uint64_t quadros_lidos;
+    uint64_t quadros_perdidos;
+
+    // Driver
+    corr_barramento_t spi;
+    uint8_t buf[BMI_FIFO_BYTES];
+    int16_t y[BMI_FIFO_BYTES / BMI_QUADRO_BYTES];
+    int16_t z[BMI_FIFO_BYTES / BMI_QUADRO_BYTES];
+    uint64_t amostras;
+    uint64_t ciclos;
+    uint64_t atraso_soma_us;
+    uint64_t atraso_max_us;
+    int64_t soma;                 // Conferência entre modos
+    float temperatura;
+};
+
+static size_t imuResponder(void *dev, uint8_t reg, uint8_t *buf, size_t n, uint64_t agora_us) {
+    imu_sim_t *d = (imu_sim_t *)dev;
+    const size_t cabem = BMI_FIFO_BYTES / BMI_QUADRO_BYTES;
+    uint64_t disponiveis = 0;
+
+    if (d->ligado) {
+        const uint64_t produzidos = (agora_us - d->ligado_us) * IMU_ODR_HZ / 1000000u;
+        if (produzidos - d->quadros_lidos > cabem) {
+            d->quadros_perdidos += produzidos - d->quadros_lidos - cabem;
+            d->quadros_lidos = produzidos - cabem;      // FIFO em modo stream: descarta os mais antigos
+        }
+        disponiveis = produzidos - d->quadros_lidos;
+    }
+
+    switch (reg) {
+        case BMI_ACC_SOFTRESET:
+            d->ligado = false;
+            return n;
+
+        case BMI_ACC_PWR_CTRL:
+            d->ligado = true;
+            d->ligado_us = agora_us;
+            d->quadros_lidos = 0;
+            return n;
+
+        case BMI_TEMP_MSB:
+            buf[0] = 0x05;
+            buf[1] = (uint8_t)(agora_us >> 10);
+            return 2;
+
+        case BMI_FIFO_LENGTH_0: {
+            const uint16_t bytes = (uint16_t)(disponiveis * BMI_QUADRO_BYTES);
+            buf[0] = (uint8_t)bytes;
+            buf[1] = (uint8_t)(bytes >> 8);
+            return 2;
+        }
+
+        case BMI_FIFO_DATA: {
+            size_t q = n / BMI_QUADRO_BYTES;
+            q = q < disponiveis ? q : (size_t)disponiveis;
+
+            for (size_t i = 0; i < q; i++) {
+                const uint64_t seq = d->quadros_lidos + i;
+                const int16_t ay = (int16_t)(seq * 37u), az = (int16_t)(seq * 91u - 16384u);
+                uint8_t *f = buf + i * BMI_QUADRO_BYTES;
+                f[0] = BMI_FIFO_QUADRO_ACC;
+                f[1] = 0;
+                f[2] = 0;
+                f[3] = (uint8_t)ay;
+                f[4] = (uint8_t)((uint16_t)ay >> 8);
+                f[5] = (uint8_t)az;
+                f[6] = (uint8_t)((uint16_t)az >> 8);
+            }
+
+            d->quadros_lidos += q;
+            return q * BMI_QUADRO_BYTES;
+        }
+    }
+
+    return 0;
+}
+
+static void imuProcessar(imu_sim_t *d, size_t n) {
+    const int k = decodificarFifoAccel(d->buf, n, d->y, d->z, (int)(sizeof(d->y) / sizeof(d->y[0])));
+
+    for (int i = 0; i < k; i++) {
+        int16_t y, z;
+        processAccelData(d->y[i], d->z[i], &y, &z);
+        d->soma += y + z;
+    }
+
+    d->amostras += (uint64_t)k;
+}
+
+static void imuRegistrarAtraso(imu_sim_t *d, uint64_t agora_us, uint64_t prazo_us) {
+    const uint64_t atraso = agora_us > prazo_us ? agora_us - prazo_us : 0;
+    d->atraso_soma_us += atraso;
+    d->atraso_max_us = atraso > d->atraso_max_us ? atraso : d->atraso_max_us;
+    d->ciclos++;
+}
+
+// ================== MODELO DO GPS (u-blox por SPI) ==================
+static constexpr uint8_t GPS_REG_LEITURA = 0x00;
+static constexpr uint8_t GPS_REG_ESCRITA = 0x01;
+static constexpr uint64_t GPS_LATENCIA_ACK_US = 25000;
+static constexpr uint64_t GPS_TIMEOUT_ACK_US = 100000;
+static constexpr uint64_t GPS_POLL_ACK_US = 10000;
+static constexpr uint64_t GPS_PERIODO_US = 100000;    // 10 Hz
+static constexpr uint64_t GPS_BYTES_POR_S = 1500;
+static constexpr uint64_t GPS_BUFFER_TX = 4096;
+static constexpr int GPS_TENTATIVAS = 3;
+
+static const char GPS_NMEA[] =
+    "$GPGGA,123519.00,2330.12345,S,04638.54321,W,1,08,0.9,760.4,M,-5.1,M,,*5C\r\n"
+    "$GPRMC,123519.00,A,2330.12345,S,04638.54321,W,0.013,0.00,181026,,,A*4F\r\n";
+
+struct gps_sim_t {
+    // Receptor
+    int rejeitar;                 // Comandos descartados antes do primeiro ACK (enlace ruidoso)
+    bool ack_pendente;
+    uint8_t ack_id;
+    uint64_t ack_pronto_us;
+    bool fluxo;
+    uint64_t inicio_fluxo_us;
+    uint64_t bytes_lidos;
+    uint64_t bytes_perdidos;
+
+    // Driver
+    corr_barramento_t spi;
+    uint8_t cmd[32];
+    uint8_t buf[256];
+    gps_dump_s dump;
+    uint64_t bytes;
+    uint32_t comandos;
+    uint32_t tentativas;
+    bool configurado;
+    bool falhou;
+};
+
+static size_t ubxMontar(uint8_t cls, uint8_t id, const uint8_t *payload, uint16_t len, uint8_t *out) {
+    out[0] = 0xB5;
+    out[1] = 0x62;
+    out[2] = cls;
+    out[3] = id;
+    out[4] = (uint8_t)len;
+    out[5] = (uint8_t)(len >> 8);
+    memcpy(out + 6, payload, len);
+
+    uint8_t a = 0, b = 0;
+    for (size_t i = 2; i < 6u + len; i++) {
+        a += out[i];
+        b += a;
+    }
+
+    out[6 + len] = a;
+    out[7 + len] = b;
+    return 8u + len;
+}
+
+static bool ubxValido(const uint8_t *f, size_t n) {
+    if (n < 8 || f[0] != 0xB5 || f[1] != 0x62 || (size_t)(f[4] | f[5] << 8) + 8 != n) {
+        return false;
+    }
+
+    uint8_t a = 0, b = 0;
+    for (size_t i = 2; i < n - 2; i++) {
+        a += f[i];
+        b += a;
+    }
+
+    return f[n - 2] == a && f[n - 1] == b;
+}
+
+// Sequência de configuração: porta (só UBX+NMEA), taxa de 10 Hz, habilita GGA/RMC (inicia o fluxo)
+static size_t gpsComando(gps_sim_t *g, int indice) {
+    static const uint8_t prt[20] = {1, 0, 0, 0, 0xC0, 0x08, 0, 0, 0, 0x96, 0, 0, 3, 0, 3, 0, 0, 0, 0, 0};
+    static const uint8_t rate[6] = {100, 0, 1, 0, 1, 0};
+    static const uint8_t msg[3] = {0xF0, 0x00, 1};
+
+    switch (indice) {
+        case 0:
+            return ubxMontar(0x06, 0x00, prt, sizeof(prt), g->cmd);
+        case 1:
+            return ubxMontar(0x06, 0x08, rate, sizeof(rate), g->cmd);
+        default:
+            return ubxMontar(0x06, 0x01, msg, sizeof(msg), g->cmd);
+    }
+}
+
+static size_t gpsResponder(void *dev, uint8_t reg, uint8_t *buf, size_t n, uint64_t agora_us) {
+    gps_sim_t *g = (gps_sim_t *)dev;
+
+    if (reg == GPS_REG_ESCRITA) {
+        if (ubxValido(buf, n) && buf[2] == 0x06) {
+            if (g->rejeitar > 0) {
+                g->rejeitar--;
+                return n;
+            }
+            g->ack_pendente = true;
+            g->ack_id = buf[3];
+            g->ack_pronto_us = agora_us + GPS_LATENCIA_ACK_US;
+        }
+        return n;
+    }
+
+    if (g->ack_pendente) {
+        if (agora_us < g->ack_pronto_us || n < 10) {
+            return 0;
+        }
+
+        const uint8_t ack[2] = {0x06, g->ack_id};
+        g->ack_pendente = false;
+
+        if (g->ack_id == 0x01 && !g->fluxo) {
+            g->fluxo = true;
+            g->inicio_fluxo_us = agora_us;
+        }
+
+        return ubxMontar(0x05, 0x01, ack, sizeof(ack), buf);
+    }
+
+    if (!g->fluxo) {
+        return 0;
+    }
+
+    const uint64_t produzidos = (agora_us - g->inicio_fluxo_us) * GPS_BYTES_POR_S / 1000000u;
+    if (produzidos - g->bytes_lidos > GPS_BUFFER_TX) {
+        g->bytes_perdidos += produzidos - g->bytes_lidos - GPS_BUFFER_TX;
+        g->bytes_lidos = produzidos - GPS_BUFFER_TX;
+    }
+
+    size_t k = (size_t)(produzidos - g->bytes_lidos);
+    k = k < n ? k : n;
+
+    for (size_t i = 0; i < k; i++) {
+        buf[i] = (uint8_t)GPS_NMEA[(g->bytes_lidos + i) % (sizeof(GPS_NMEA) - 1)];
+    }
+
+    g->bytes_lidos += k;
+    return k;
+}
+
+static bool gpsAckConfere(const gps_sim_t *g, size_t n) {
+    return n == 10 && ubxValido(g->buf, n) && g->buf[2] == 0x05 && g->buf[3] == 0x01 && g->buf[6] == 0x06 &&
+           g->buf[7] == g->cmd[3];
+}
+
+static void gpsConsumir(gps_sim_t *g, size_t n) {
+    dumpGpsData(g->buf, n, gps_dump_comm_mode_t::Full, false, &g->dump, gps_dump_comm_mode_t::Full);
+    g->bytes += n;
+}
+
+// ================== DRIVERS COMO CORROTINAS ==================
+
+/**
+ * FUNÇÃO 2: imuCorrotina()
+ * ESPECIFICAÇÃO: Reset, 1 ms, liga o acelerômetro, 5 ms (tempos do
+ * datasheet) e depois, a cada período: comprimento da FIFO, dados,
+ * decodificação; temperatura a cada 100 ciclos.
+ */
+static corr_tarefa_t imuCorrotina(corr_laco_t *l, imu_sim_t *d) {
+    uint8_t r[2] = {0xB6, 0};
+
+    co_await corrTransferir(l, &d->spi, BMI_ACC_SOFTRESET, r, 1);
+    co_await corrDormir(l, 1000);
+    r[0] = 0x04;
+    co_await corrTransferir(l, &d->spi, BMI_ACC_PWR_CTRL, r, 1);
+    co_await corrDormir(l, 5000);
+
+    uint64_t prazo = corrAgora(l);
+
+    for (uint32_t ciclo = 0;; ciclo++) {
+        prazo += IMU_PERIODO_US;
+        co_await corrAte(l, prazo);
+        imuRegistrarAtraso(d, corrAgora(l), prazo);
+
+        co_await corrTransferir(l, &d->spi, BMI_FIFO_LENGTH_0, r, 2);
+        size_t bytes = fifoReadCount(r[0], r[1]);
+        bytes = bytes < sizeof(d->buf) ? bytes : sizeof(d->buf);
+
+        if (bytes > 0) {
+            const size_t n = co_await corrTransferir(l, &d->spi, BMI_FIFO_DATA, d->buf, bytes);
+            imuProcessar(d, n);
+        }
+
+        if (ciclo % IMU_CICLOS_TEMPERATURA == 0) {
+            co_await corrTransferir(l, &d->spi, BMI_TEMP_MSB, r, 2);
+            d->temperatura = updateTemperature(r[0], r[1]);
+        }
+    }
+}
+
+/**
+ * FUNÇÃO 3: gpsCorrotina()
+ * ESPECIFICAÇÃO: Cada comando UBX é enviado e o ACK é consultado a cada
+ * 10 ms até 100 ms; sem ACK, reenvia (3 tentativas) ou desiste. Depois,
+ * lê o fluxo a 10 Hz para dumpGpsData().
+ */
+static corr_tarefa_t gpsCorrotina(corr_laco_t *l, gps_sim_t *g) {
+    for (int c = 0; c < 3; c++) {
+        bool ack = false;
+
+        for (int t = 0; t < GPS_TENTATIVAS && !ack; t++) {
+            g->tentativas++;
+            co_await corrTransferir(l, &g->spi, GPS_REG_ESCRITA, g->cmd, gpsComando(g, c));
+            const uint64_t limite = corrAgora(l) + GPS_TIMEOUT_ACK_US;
+
+            while (!ack && corrAgora(l) < limite) {
+                co_await corrDormir(l, GPS_POLL_ACK_US);
+                ack = gpsAckConfere(g, co_await corrTransferir(l, &g->spi, GPS_REG_LEITURA, g->buf, 10));
+            }
+        }
+
+        if (!ack) {
+            g->falhou = true;
+            co_return;
+        }
+
+        g->comandos++;
+    }
+
+    g->configurado = true;
+    uint64_t prazo = corrAgora(l);
+
+    while (true) {
+        prazo += GPS_PERIODO_US;
+        co_await corrAte(l, prazo);
+        gpsConsumir(g, co_await corrTransferir(l, &g->spi, GPS_REG_LEITURA, g->buf, sizeof(g->buf)));
+    }
+}
+
+// ================== REFERÊNCIA: UMA THREAD POR DISPOSITIVO ==================
+
+static std::chrono::steady_clock::time_point t0_threads;
+static std::atomic<bool> parar{false};
+
+static uint64_t agoraThreads() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() -
+                                                                           t0_threads).count();
+}
+
+static void dormirAteThreads(uint64_t prazo_us) {
+    std::this_thread::sleep_until(t0_threads + std::chrono::microseconds(prazo_us));
+}
+
+// Transferência bloqueante: a thread dorme durante o DMA, como num driver com wait_for_completion
+static size_t transferirThreads(corr_barramento_t *b, uint8_t reg, uint8_t *buf, size_t n) {
+    dormirAteThreads(agoraThreads() + corrDuracaoTransferencia(b, n));
+    return b->responder(b->dev, reg, buf, n, agoraThreads());
+}
+
+static void imuThread(imu_sim_t *d) {
+    uint8_t r[2] = {0xB6, 0};
+
+    transferirThreads(&d->spi, BMI_ACC_SOFTRESET, r, 1);
+    dormirAteThreads(agoraThreads() + 1000);
+    r[0] = 0x04;
+    transferirThreads(&d->spi, BMI_ACC_PWR_CTRL, r, 1);
+    dormirAteThreads(agoraThreads() + 5000);
+
+    uint64_t prazo = agoraThreads();
+
+    for (uint32_t ciclo = 0; !parar.load(std::memory_order_relaxed); ciclo++) {
+        prazo += IMU_PERIODO_US;
+        dormirAteThreads(prazo);
+        imuRegistrarAtraso(d, agoraThreads(), prazo);
+
+        transferirThreads(&d->spi, BMI_FIFO_LENGTH_0, r, 2);
+        size_t bytes = fifoReadCount(r[0], r[1]);
+        bytes = bytes < sizeof(d->buf) ? bytes : sizeof(d->buf);
+
+        if (bytes > 0) {
+            imuProcessar(d, transferirThreads(&d->spi, BMI_FIFO_DATA, d->buf, bytes));
+        }
+
+        if (ciclo % IMU_CICLOS_TEMPERATURA == 0) {
+            transferirThreads(&d->spi, BMI_TEMP_MSB, r, 2);
+            d->temperatura = updateTemperature(r[0], r[1]);
+        }
+    }
+}
+
+static void gpsThread(gps_sim_t *g) {
+    for (int c = 0; c < 3; c++) {
+        bool ack = false;
+
+        for (int t = 0; t < GPS_TENTATIVAS && !ack; t++) {
+            g->tentativas++;
+            transferirThreads(&g->spi, GPS_REG_ESCRITA, g->cmd, gpsComando(g, c));
+            const uint64_t limite = agoraThreads() + GPS_TIMEOUT_ACK_US;
+
+            while (!ack && agoraThreads() < limite) {
+                dormirAteThreads(agoraThreads() + GPS_POLL_ACK_US);
+                ack = gpsAckConfere(g, transferirThreads(&g->spi, GPS_REG_LEITURA, g->buf, 10));
+            }
+        }
+
+        if (!ack) {
+            g->falhou = true;
+            return;
+        }
+
+        g->comandos++;
+    }
+
+    g->configurado = true;
+    uint64_t prazo = agoraThreads();
+
+    while (!parar.load(std::memory_order_relaxed)) {
+        prazo += GPS_PERIODO_US;
+        dormirAteThreads(prazo);
+        gpsConsumir(g, transferirThreads(&g->spi, GPS_REG_LEITURA, g->buf, sizeof(g->buf)));
+    }
+}
+
+// ================== BENCHMARK ==================
+
+enum modo_t { MODO_CORROTINAS = 0, MODO_THREADS = 1, MODO_SIMULADO = 2 };
+
+struct frota_t {
+    std::vector<imu_sim_t> imus;
+    std::vector<gps_sim_t> gps;
+};
+
+static void montarFrota(frota_t *f, int dispositivos) {
+    f->imus.assign((size_t)(dispositivos / 2), imu_sim_t{});
+    f->gps.assign((size_t)(dispositivos - dispositivos / 2), gps_sim_t{});
+
+    for (imu_sim_t &d : f->imus) {
+        d.spi = corr_barramento_t{10000000, 2, imuResponder, &d};
+    }
+
+    for (size_t i = 0; i < f->gps.size(); i++) {
+        gps_sim_t &g = f->gps[i];
+        g.spi = corr_barramento_t{1000000, 5, gpsResponder, &g};
+        g.rejeitar = (int)(i % 3);      // Parte dos receptores perde os primeiros comandos
+    }
+}
+
+struct medida_t {
+    double parede_s;
+    double cpu_s;
+    uint64_t trocas_contexto;
+    uint64_t alocacoes;
+    uint64_t amostras;
+    uint64_t ciclos;
+    uint64_t perdidos;
+    uint64_t gps_bytes;
+    int gps_configurados;
+    uint64_t tentativas;
+    double atraso_medio_us;
+    uint64_t atraso_max_us;
+    uint64_t hash;
+};
+
+static void medirFrota(const frota_t *f, medida_t *m) {
+    uint64_t atraso = 0;
+    m->hash = 1469598103934665603ull;
+
+    for (const imu_sim_t &d : f->imus) {
+        m->amostras += d.amostras;
+        m->ciclos += d.ciclos;
+        m->perdidos += d.quadros_perdidos;
+        atraso += d.atraso_soma_us;
+        m->atraso_max_us = d.atraso_max_us > m->atraso_max_us ? d.atraso_max_us : m->atraso_max_us;
+        m->hash = (m->hash ^ (uint64_t)d.soma ^ d.amostras) * 1099511628211ull;
+    }
+
+    for (const gps_sim_t &g : f->gps) {
+        m->gps_bytes += g.bytes;
+        m->gps_configurados += g.configurado ? 1 : 0;
+        m->tentativas += g.tentativas;
+        m->hash = (m->hash ^ g.bytes ^ ((uint64_t)g.tentativas << 32)) * 1099511628211ull;
+    }
+
+    m->atraso_medio_us = m->ciclos ? (double)atraso / m->ciclos : 0.0;
+}
+
+static double cpuProcesso(uint64_t *trocas) {
+    struct rusage r;
+    getrusage(RUSAGE_SELF, &r);
+    *trocas = (uint64_t)(r.ru_nvcsw + r.ru_nivcsw);
+    return r.ru_utime.tv_sec + r.ru_stime.tv_sec + (r.ru_utime.tv_usec + r.ru_stime.tv_usec) / 1e6;
+}
+
+static medida_t executar(modo_t modo, int dispositivos, double segundos) {
+    frota_t f;
+    montarFrota(&f, dispositivos);
+    medida_t m = {};
+    const uint64_t duracao_us = (uint64_t)(segundos * 1e6);
+
+    uint64_t trocas0, trocas1;
+    const double cpu0 = cpuProcesso(&trocas0);
+    const uint64_t aloc0 = heap_alocacoes.load();
+    const std::chrono::steady_clock::time_point p0 = std::chrono::steady_clock::now();
+
+    if (modo == MODO_THREADS) {
+        std::vector<std::thread> threads;
+        threads.reserve((size_t)dispositivos);
+        parar.store(false);
+        t0_threads = std::chrono::steady_clock::now();
+
+        for (imu_sim_t &d : f.imus) {
+            threads.emplace_back(imuThread, &d);
+        }
+        for (gps_sim_t &g : f.gps) {
+            threads.emplace_back(gpsThread, &g);
+        }
+
+        std::this_thread::sleep_until(t0_threads + std::chrono::microseconds(duracao_us));
+        parar.store(true);
+
+        for (std::thread &t : threads) {
+            t.join();
+        }
+    } else {
+        static corr_laco_t laco;      // Heap de temporizadores fixo: fora da pilha
+        corrLacoReset(&laco, modo == MODO_SIMULADO);
+
+        for (imu_sim_t &d : f.imus) {
+            corrIniciar(&laco, imuCorrotina(&laco, &d));
+        }
+        for (gps_sim_t &g : f.gps) {
+            corrIniciar(&laco, gpsCorrotina(&laco, &g));
+        }
+
+        corrExecutar(&laco, duracao_us);
+        corrEncerrar(&laco);
+    }
+
+    m.parede_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - p0).count();
+    m.cpu_s = cpuProcesso(&trocas1) - cpu0;
+    m.trocas_contexto = trocas1 - trocas0;
+    m.alocacoes = heap_alocacoes.load() - aloc0;
+    medirFrota(&f, &m);
+    return m;
+}
+
+int main(int argc, char **argv) {
+    const double segundos = argc > 1 ? atof(argv[1]) : 2.0;
+    int dispositivos = argc > 2 ? atoi(argv[2]) : 100;
+    dispositivos = dispositivos < 2 ? 2 : dispositivos;
+
+    if (dispositivos > CORR_QUADROS || dispositivos > CORR_MAX_TEMPORIZADORES) {
+        printf("no maximo %d dispositivos (CORR_QUADROS)\n", CORR_QUADROS);
+        return 1;
+    }
+
+    // Folga de temporizador mínima (herdada pelas threads): os dois modelos acordam no prazo pedido
+    prctl(PR_SET_TIMERSLACK, 1UL, 0, 0, 0);
+
+    printf("%d dispositivos (%d IMU BMI088 a 1 kHz, %d GPS u-blox a 10 Hz), %.1f s\n\n", dispositivos,
+           dispositivos / 2, dispositivos - dispositivos / 2, segundos);
+
+    const char *nomes[] = {"corrotinas", "threads"};
+    medida_t r[2];
+
+    printf("%-11s %8s %9s %11s %9s %10s %9s %11s %10s %6s\n", "modelo", "CPU(s)", "CPU/ciclo", "trocas ctx",
+           "alocacoes", "amostras", "perdidas", "atraso(us)", "atraso max", "GPS ok");
+
+    for (int i = 0; i < 2; i++) {
+        r[i] = executar((modo_t)i, dispositivos, segundos);
+        printf("%-11s %8.3f %7.2fus %11llu %9llu %10llu %9llu %11.1f %10llu %3d/%-3zu\n", nomes[i], r[i].cpu_s,
+               r[i].ciclos ? r[i].cpu_s * 1e6 / r[i].ciclos : 0.0, (unsigned long long)r[i].trocas_contexto,
+               (unsigned long long)r[i].alocacoes, (unsigned long long)r[i].amostras,
+               (unsigned long long)r[i].perdidos, r[i].atraso_medio_us, (unsigned long long)r[i].atraso_max_us,
+               r[i].gps_configurados, (size_t)(dispositivos - dispositivos / 2));
+    }
+
+    size_t pilha = 0;
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_getstacksize(&attr, &pilha);
+    pthread_attr_destroy(&attr);
+
+    const corr_pool_t *pool = corrPool();
+    printf("\nmemoria por dispositivo: quadro %zu B (pool, %llu do heap) vs pilha de thread %zu KB reservados\n",
+           pool->maior_quadro, (unsigned long long)pool->quadros_heap, pilha / 1024);
+
+    // Relógio simulado: mesmos drivers, tempo salta entre prazos (reprodutível)
+    medida_t s1 = executar(MODO_SIMULADO, dispositivos, 10.0);
+    medida_t s2 = executar(MODO_SIMULADO, dispositivos, 10.0);
+    printf("simulado 10 s: %.3f s de parede, %llu amostras, GPS %d configurados, %llu tentativas, hash %016llx %s\n",
+           s1.parede_s, (unsigned long long)s1.amostras, s1.gps_configurados, (unsigned long long)s1.tentativas,
+           (unsigned long long)s1.hash, s1.hash == s2.hash ? "(reprodutivel)" : "(DIVERGIU)");
+
+    const bool ok = r[0].alocacoes == 0 && pool->quadros_heap == 0 && s1.hash == s2.hash && s1.perdidos == 0 &&
+                    r[0].gps_configurados == dispositivos - dispositivos / 2;
+    printf("corrotinas sem heap, sem perda e reprodutiveis: %s\n", ok ? "sim" : "NAO");
+    return ok ? 0 : 1;
+}
+
+#endif // MODO_NATIVO
+
+/*
+ * ================================================================
+ * DOCUMENTAÇÃO
+ * ================================================================
+ *
+ * DRIVERS COMO CORROTINAS (corrotinas.h):
+ *
+ * 1. LAÇO DE EVENTOS DE UMA THREAD:
+ *    - Heap mínimo de temporizadores por (prazo, seq), capacidade fixa
+ *    - Relógio real: dorme até o próximo prazo; simulado: salta para ele
+ *    - co_await corrAte()/corrDormir() e co_await corrTransferir() (duração
+ *      da transferência no barramento, resposta do dispositivo ao retomar)
+ *
+ * 2. SEM HEAP POR SUSPENSÃO:
+ *    - O awaitable vive no quadro da corrotina; suspender é inserir no heap
+ *    - Quadros vêm de um pool estático de blocos de 1 KB (promise_type com
+ *      operator new próprio); quadro maior que o bloco cai no heap e é contado
+ *
+ * 3. DRIVERS LINEARES:
+ *    - IMU: reset, 1 ms, liga, 5 ms, laço de FIFO a 1 kHz com temperatura
+ *      a cada 100 ciclos
+ *    - GPS: CFG-PRT, CFG-RATE, CFG-MSG, cada um com consulta de ACK a cada
+ *      10 ms, timeout de 100 ms e 3 tentativas; depois fluxo a 10 Hz
+ *    - Mesma lógica escrita em estilo bloqueante para a referência com
+ *      uma thread por dispositivo
+ *
+ * 4. PROPRIEDADES VERIFICADAS (ESBMC):
+ *    - Ordem de retomada por prazo, empates na ordem de inserção
+ *    - Inserções/remoções intercaladas mantêm n e o mínimo no topo
+ *    - Decodificação da FIFO nunca sai de buf[], y[], z[]
+ *    - Quadro conhecido decodificado com combine()
+ *    (o runtime C++20 em si não passa pelo ESBMC: só a parte C do header)
+ *
+ * COMANDOS DE EXECUÇÃO:
+ * esbmc corrotinas.cpp --unwind 7 --overflow-check --bounds-check
+ * g++ -O2 -std=c++20 -DMODO_NATIVO -pthread corrotinas.cpp px4_funcoes.cpp -o corrotinas_bench && ./corrotinas_bench 2 100
+ *
+ * BENCHMARK:
+ * - 100 dispositivos simulados (50 IMU, 50 GPS) em relógio real, como
+ *   corrotinas numa thread e como uma thread por dispositivo
+ * - CPU total e por ciclo de IMU, trocas de contexto, alocações no heap
+ *   durante a execução, amostras, quadros perdidos na FIFO, atraso de
+ *   acordar em relação ao período
+ * - Quadro de corrotina vs pilha reservada por thread
+ * - 10 s em relógio simulado, duas vezes: hash igual (reprodutível)
+ *
+ * ================================================================
+ */
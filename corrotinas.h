@@ -0,0 +1,360 @@
+/**
+ * @file corrotinas.h
+ * @author Dissertação Mestrado - Verificação Formal PX4 v1.16
+ *
+ * OBJETIVO: Execução de drivers como corrotinas C++20 num laço de eventos
+ *           de uma thread
+ * MÓDULO: Modelo assíncrono para configuração GPS, leitura de FIFO da IMU
+ *         e demais sequências "faz, espera, confere"
+ *
+ * A lógica de driver que seria uma máquina de estados escrita à mão vira
+ * código linear com co_await em temporizadores e transferências de
+ * barramento. Nenhuma suspensão aloca: o awaitable vive no quadro da
+ * corrotina e entra num heap de temporizadores de capacidade fixa. Os
+ * quadros vêm de um pool estático de blocos (heap só se o quadro não
+ * couber, contado em quadros_heap).
+ *
+ * O heap de temporizadores é C puro (verificável pelo ESBMC); o runtime de
+ * corrotinas exige -std=c++20 e -DMODO_NATIVO.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// ================== CONSTANTES ==================
+static constexpr int CORR_MAX_TEMPORIZADORES = 1024;
+static constexpr int CORR_QUADROS = 512;              // Corrotinas vivas ao mesmo tempo
+static constexpr size_t CORR_QUADRO_BYTES = 1024;
+static constexpr uint64_t CORR_FOLGA_US = 50;          // Prazo mais próximo que isso não vale um sleep
+
+// ================== HEAP DE TEMPORIZADORES ==================
+
+/**
+ * Entrada do heap: prazo e número de sequência (empate por ordem de
+ * inserção: retomadas determinísticas). alvo = endereço do
+ * coroutine_handle (void * para o heap não depender de <coroutine>).
+ */
+struct corr_temporizador_t {
+    uint64_t prazo_us;
+    uint32_t seq;
+    void *alvo;
+};
+
+struct corr_heap_t {
+    corr_temporizador_t itens[CORR_MAX_TEMPORIZADORES];
+    int n;
+    uint32_t seq;
+};
+
+inline bool corrAntes(const corr_temporizador_t &a, const corr_temporizador_t &b) {
+    return a.prazo_us < b.prazo_us || (a.prazo_us == b.prazo_us && (int32_t)(a.seq - b.seq) < 0);
+}
+
+inline void corrHeapReset(corr_heap_t *h) {
+    h->n = 0;
+    h->seq = 0;
+}
+
+/**
+ * FUNÇÃO 1: corrHeapInserir()
+ * ESPECIFICAÇÃO: Insere mantendo a propriedade de heap mínimo por
+ * (prazo, seq). Heap cheio retorna false sem escrever.
+ */
+inline bool corrHeapInserir(corr_heap_t *h, uint64_t prazo_us, void *alvo) {
+    if (h->n >= CORR_MAX_TEMPORIZADORES) {
+        return false;
+    }
+
+    int i = h->n++;
+    const corr_temporizador_t novo = {prazo_us, h->seq++, alvo};
+
+    while (i > 0) {
+        const int pai = (i - 1) / 2;
+        if (!corrAntes(novo, h->itens[pai])) {
+            break;
+        }
+        h->itens[i] = h->itens[pai];
+        i = pai;
+    }
+
+    h->itens[i] = novo;
+    return true;
+}
+
+/**
+ * FUNÇÃO 2: corrHeapRemover()
+ * ESPECIFICAÇÃO: Remove o menor (prazo, seq) em *out. Heap vazio retorna false.
+ */
+inline bool corrHeapRemover(corr_heap_t *h, corr_temporizador_t *out) {
+    if (h->n <= 0) {
+        return false;
+    }
+
+    *out = h->itens[0];
+    const corr_temporizador_t ultimo = h->itens[--h->n];
+    int i = 0;
+
+    while (true) {
+        int menor = 2 * i + 1;
+        if (menor >= h->n) {
+            break;
+        }
+        if (menor + 1 < h->n && corrAntes(h->itens[menor + 1], h->itens[menor])) {
+            menor++;
+        }
+        if (!corrAntes(h->itens[menor], ultimo)) {
+            break;
+        }
+        h->itens[i] = h->itens[menor];
+        i = menor;
+    }
+
+    if (h->n > 0) {
+        h->itens[i] = ultimo;
+    }
+
+    return true;
+}
+
+#if defined(MODO_NATIVO) && __cplusplus >= 202002L
+
+#include <chrono>
+#include <coroutine>
+#include <exception>
+#include <new>
+#include <thread>
+
+// ================== POOL DE QUADROS ==================
+
+struct corr_pool_t {
+    alignas(std::max_align_t) unsigned char blocos[CORR_QUADROS][CORR_QUADRO_BYTES];
+    int livres[CORR_QUADROS];
+    int n_livres;
+    bool iniciado;
+    uint64_t quadros_pool;        // Quadros servidos pelo pool
+    uint64_t quadros_heap;        // Quadro maior que o bloco ou pool vazio
+    size_t maior_quadro;
+};
+
+inline corr_pool_t *corrPool() {
+    static corr_pool_t pool;
+
+    if (!pool.iniciado) {
+        for (int i = 0; i < CORR_QUADROS; i++) {
+            pool.livres[i] = CORR_QUADROS - 1 - i;
+        }
+        pool.n_livres = CORR_QUADROS;
+        pool.iniciado = true;
+    }
+
+    return &pool;
+}
+
+inline void *corrAlocarQuadro(size_t n) {
+    corr_pool_t *p = corrPool();
+    p->maior_quadro = n > p->maior_quadro ? n : p->maior_quadro;
+
+    if (n <= CORR_QUADRO_BYTES && p->n_livres > 0) {
+        p->quadros_pool++;
+        return p->blocos[p->livres[--p->n_livres]];
+    }
+
+    p->quadros_heap++;
+    return ::operator new(n);
+}
+
+inline void corrLiberarQuadro(void *q) {
+    corr_pool_t *p = corrPool();
+    unsigned char *b = (unsigned char *)q;
+
+    if (b >= &p->blocos[0][0] && b < &p->blocos[0][0] + sizeof(p->blocos)) {
+        p->livres[p->n_livres++] = (int)((b - &p->blocos[0][0]) / CORR_QUADRO_BYTES);
+        return;
+    }
+
+    ::operator delete(q);
+}
+
+// ================== TAREFA ==================
+
+/**
+ * Corrotina de driver. Começa suspensa (o laço decide quando roda) e
+ * termina suspensa (o laço destrói o quadro ao ver done()).
+ */
+struct corr_tarefa_t {
+    struct promise_type {
+        corr_tarefa_t get_return_object() {
+            return corr_tarefa_t{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+
+        static void *operator new(size_t n) { return corrAlocarQuadro(n); }
+        static void operator delete(void *q) { corrLiberarQuadro(q); }
+    };
+
+    std::coroutine_handle<promise_type> h;
+};
+
+// ================== LAÇO DE EVENTOS ==================
+
+struct corr_estatistica_t {
+    uint64_t suspensoes;
+    uint64_t retomadas;
+    uint64_t atraso_soma_us;      // Retomada real - prazo (só relógio real)
+    uint64_t atraso_max_us;
+    uint64_t estouros_heap;       // Temporizador recusado (heap cheio)
+};
+
+struct corr_laco_t {
+    corr_heap_t temporizadores;
+    bool simulado;                // true: o tempo salta para o próximo prazo
+    uint64_t folga_us;            // Relógio real: retoma até folga_us antes do prazo
+    uint64_t agora_sim_us;
+    std::chrono::steady_clock::time_point t0;
+    int vivas;
+    corr_estatistica_t est;
+};
+
+inline void corrLacoReset(corr_laco_t *l, bool simulado) {
+    corrHeapReset(&l->temporizadores);
+    l->simulado = simulado;
+    l->folga_us = CORR_FOLGA_US;
+    l->agora_sim_us = 0;
+    l->t0 = std::chrono::steady_clock::now();
+    l->vivas = 0;
+    l->est = corr_estatistica_t{};
+}
+
+inline uint64_t corrAgora(const corr_laco_t *l) {
+    if (l->simulado) {
+        return l->agora_sim_us;
+    }
+
+    return (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - l->t0)
+        .count();
+}
+
+// co_await corrAte(l, prazo): retoma no prazo absoluto (microssegundos do laço)
+struct corr_espera_t {
+    corr_laco_t *l;
+    uint64_t prazo_us;
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> h) {
+        l->est.suspensoes++;
+        if (!corrHeapInserir(&l->temporizadores, prazo_us, h.address())) {
+            l->est.estouros_heap++;
+            std::terminate();      // Capacidade é parâmetro de projeto: estouro é erro
+        }
+    }
+    void await_resume() const noexcept {}
+};
+
+inline corr_espera_t corrAte(corr_laco_t *l, uint64_t prazo_us) {
+    return corr_espera_t{l, prazo_us};
+}
+
+inline corr_espera_t corrDormir(corr_laco_t *l, uint64_t us) {
+    return corr_espera_t{l, corrAgora(l) + us};
+}
+
+/**
+ * Barramento (SPI/I2C/UART) com um dispositivo: a transferência ocupa
+ * sobrecarga + bits / taxa; no fim, o modelo do dispositivo responde.
+ */
+typedef size_t (*corr_dispositivo_t)(void *dev, uint8_t reg, uint8_t *buf, size_t n, uint64_t agora_us);
+
+struct corr_barramento_t {
+    uint32_t bits_por_s;
+    uint32_t sobrecarga_us;
+    corr_dispositivo_t responder;
+    void *dev;
+};
+
+inline uint64_t corrDuracaoTransferencia(const corr_barramento_t *b, size_t n) {
+    return b->sobrecarga_us + (uint64_t)n * 8u * 1000000u / b->bits_por_s;
+}
+
+// co_await corrTransferir(...): suspende pela duração da transferência e devolve os bytes lidos
+struct corr_transferencia_t {
+    corr_laco_t *l;
+    corr_barramento_t *b;
+    uint8_t reg;
+    uint8_t *buf;
+    size_t n;
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> h) {
+        corr_espera_t{l, corrAgora(l) + corrDuracaoTransferencia(b, n)}.await_suspend(h);
+    }
+    size_t await_resume() { return b->responder(b->dev, reg, buf, n, corrAgora(l)); }
+};
+
+inline corr_transferencia_t corrTransferir(corr_laco_t *l, corr_barramento_t *b, uint8_t reg, uint8_t *buf, size_t n) {
+    return corr_transferencia_t{l, b, reg, buf, n};
+}
+
+inline void corrIniciar(corr_laco_t *l, corr_tarefa_t t) {
+    l->vivas++;
+    corrHeapInserir(&l->temporizadores, corrAgora(l), t.h.address());
+}
+
+/**
+ * FUNÇÃO 3: corrExecutar()
+ * ESPECIFICAÇÃO: Retoma as corrotinas em ordem de prazo até ate_us ou até
+ * não haver corrotina viva. Relógio real: dorme até o prazo (uma chamada
+ * de sistema por espera, nenhuma por corrotina pronta); prazo a menos de
+ * folga_us é retomado sem dormir, senão a folga do temporizador do kernel
+ * (~50 us) em cada transferência curta atrasaria o laço inteiro.
+ * Simulado: salta.
+ */
+inline void corrExecutar(corr_laco_t *l, uint64_t ate_us) {
+    corr_temporizador_t t;
+
+    while (l->vivas > 0 && l->temporizadores.n > 0) {
+        if (l->temporizadores.itens[0].prazo_us >= ate_us) {
+            break;
+        }
+
+        corrHeapRemover(&l->temporizadores, &t);
+
+        if (l->simulado) {
+            l->agora_sim_us = t.prazo_us > l->agora_sim_us ? t.prazo_us : l->agora_sim_us;
+        } else {
+            uint64_t agora = corrAgora(l);
+            if (agora + l->folga_us < t.prazo_us) {
+                std::this_thread::sleep_until(l->t0 + std::chrono::microseconds(t.prazo_us));
+                agora = corrAgora(l);
+            }
+            const uint64_t atraso = agora > t.prazo_us ? agora - t.prazo_us : 0;
+            l->est.atraso_soma_us += atraso;
+            l->est.atraso_max_us = atraso > l->est.atraso_max_us ? atraso : l->est.atraso_max_us;
+        }
+
+        std::coroutine_handle<> h = std::coroutine_handle<>::from_address(t.alvo);
+        l->est.retomadas++;
+        h.resume();
+
+        if (h.done()) {
+            h.destroy();
+            l->vivas--;
+        }
+    }
+}
+
+// Destrói as corrotinas ainda suspensas (fim do benchmark)
+inline void corrEncerrar(corr_laco_t *l) {
+    corr_temporizador_t t;
+
+    while (corrHeapRemover(&l->temporizadores, &t)) {
+        std::coroutine_handle<>::from_address(t.alvo).destroy();
+        l->vivas--;
+    }
+}
+
+#endif // MODO_NATIVO && C++20
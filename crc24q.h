@@ -0,0 +1,313 @@
+/**
+ * @file crc24q.h
+ * @author Dissertação Mestrado - Verificação Formal PX4 v1.16
+ *
+ * OBJETIVO: CRC-24Q (Qualcomm, usado pelo RTCM 3) em três níveis de
+ *           desempenho e validação em lote de capturas RTCM
+ * USO: rtcm.cpp (verificação, equivalência e benchmark)
+ *
+ * POLINÔMIO: 0x864CFB (x^24 + x^23 + x^18 + x^17 + x^14 + x^11 + x^10 +
+ * x^7 + x^6 + x^5 + x^4 + x^3 + x + 1), sem reflexão, início 0, sem XOR
+ * final. Quadro RTCM 3: 0xD3, 6 bits reservados + 10 bits de comprimento,
+ * payload, CRC-24Q de 3 bytes sobre cabeçalho + payload.
+ *
+ * NÍVEIS:
+ * - crc24qBits(): referência bit a bit (verificada pelo ESBMC)
+ * - crc24qFatias8(): slice-by-8 portátil, 8 bytes por iteração
+ * - crc24qClmul(): dobramento com multiplicação sem vai-um (PCLMULQDQ),
+ *   64 bytes por iteração em 4 acumuladores de 128 bits; compilado só com
+ *   -mpclmul -mssse3 (senão crc24qRapido() usa slice-by-8)
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// ================== CONSTANTES ==================
+static constexpr uint32_t CRC24Q_POLI = 0x864CFB;
+static constexpr uint32_t CRC24Q_MASCARA = 0xFFFFFF;
+static constexpr uint8_t RTCM_PREAMBULO = 0xD3;
+static constexpr size_t RTCM_CABECALHO = 3;
+static constexpr size_t RTCM_CRC = 3;
+static constexpr size_t RTCM_PAYLOAD_MAX = 1023;
+
+// ================== REFERÊNCIA BIT A BIT ==================
+
+/**
+ * FUNÇÃO 1: crc24qBits()
+ * ESPECIFICAÇÃO: CRC-24Q de data[0..len) continuando de crc (0 para
+ * começar). Definição direta: um deslocamento por bit, MSB primeiro.
+ */
+inline uint32_t crc24qBits(uint32_t crc, const uint8_t *data, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        crc ^= (uint32_t)data[i] << 16;
+
+        for (int b = 0; b < 8; b++) {
+            crc <<= 1;
+            if (crc & 0x1000000) {
+                crc ^= 0x1000000 | CRC24Q_POLI;
+            }
+        }
+    }
+
+    return crc & CRC24Q_MASCARA;
+}
+
+// x^n mod P (grau < 24): constantes do dobramento, calculadas pela própria definição
+inline constexpr uint32_t crc24qPotencia(unsigned n) {
+    uint32_t r = 1;
+
+    for (unsigned i = 0; i < n; i++) {
+        r <<= 1;
+        if (r & 0x1000000) {
+            r ^= 0x1000000 | CRC24Q_POLI;
+        }
+    }
+
+    return r;
+}
+
+// ================== SLICE-BY-8 ==================
+
+/**
+ * Tabelas MSB primeiro com o CRC nos 24 bits altos de um registrador de
+ * 32 bits: t[0] é a tabela byte a byte (Sarwate), t[k][b] = efeito do byte
+ * b seguido de k bytes zero.
+ */
+struct crc24q_tabelas_t {
+    uint32_t t[8][256];
+};
+
+inline void crc24qIniciarTabelas(crc24q_tabelas_t *tab) {
+    for (uint32_t b = 0; b < 256; b++) {
+        uint32_t crc = b << 24;
+
+        for (int k = 0; k < 8; k++) {
+            crc = (crc & 0x80000000u) ? (crc << 1) ^ (CRC24Q_POLI << 8) : crc << 1;
+        }
+
+        tab->t[0][b] = crc;
+    }
+
+    for (int k = 1; k < 8; k++) {
+        for (uint32_t b = 0; b < 256; b++) {
+            const uint32_t anterior = tab->t[k - 1][b];
+            tab->t[k][b] = (anterior << 8) ^ tab->t[0][anterior >> 24];
+        }
+    }
+}
+
+inline uint32_t crc24qBytes(const crc24q_tabelas_t *tab, uint32_t crc, const uint8_t *data, size_t len) {
+    uint32_t r = crc << 8;
+
+    for (size_t i = 0; i < len; i++) {
+        r = (r << 8) ^ tab->t[0][(r >> 24) ^ data[i]];
+    }
+
+    return r >> 8;
+}
+
+/**
+ * FUNÇÃO 2: crc24qFatias8()
+ * ESPECIFICAÇÃO: Mesmo resultado de crc24qBits() consumindo 8 bytes por
+ * iteração (8 consultas independentes); resto byte a byte.
+ */
+inline uint32_t crc24qFatias8(const crc24q_tabelas_t *tab, uint32_t crc, const uint8_t *data, size_t len) {
+    uint32_t r = crc << 8;
+
+    while (len >= 8) {
+        const uint32_t a = r ^ ((uint32_t)data[0] << 24 | (uint32_t)data[1] << 16 | (uint32_t)data[2] << 8 | data[3]);
+        r = tab->t[7][a >> 24] ^ tab->t[6][(a >> 16) & 0xFF] ^ tab->t[5][(a >> 8) & 0xFF] ^ tab->t[4][a & 0xFF] ^
+            tab->t[3][data[4]] ^ tab->t[2][data[5]] ^ tab->t[1][data[6]] ^ tab->t[0][data[7]];
+        data += 8;
+        len -= 8;
+    }
+
+    return crc24qBytes(tab, r >> 8, data, len);
+}
+
+// ================== DOBRAMENTO COM PCLMULQDQ ==================
+
+#if defined(MODO_NATIVO) && defined(__PCLMUL__) && defined(__SSSE3__)
+#include <immintrin.h>
+
+#define CRC24Q_CLMUL 1
+
+static constexpr size_t CRC24Q_CLMUL_MIN = 64;
+
+/**
+ * Registrador de 128 bits R = H·x^64 + L congruente (mod P) à mensagem já
+ * consumida. Acrescentar d bits: R·x^d = H·x^(d+64) + L·x^d, trocando as
+ * potências por x^n mod P (24 bits): dois produtos de 64x24 bits cabem
+ * em 128. Os bytes são invertidos na carga para que o bit 127 seja o
+ * primeiro bit da mensagem (CRC não refletido).
+ */
+inline __m128i crc24qDobrar(__m128i r, __m128i k) {
+    return _mm_xor_si128(_mm_clmulepi64_si128(r, k, 0x11), _mm_clmulepi64_si128(r, k, 0x00));
+}
+
+inline __m128i crc24qConstante(unsigned d) {
+    // Lane 0: x^d mod P (multiplica L); lane 1: x^(d+64) mod P (multiplica H)
+    return _mm_set_epi64x((long long)crc24qPotencia(d + 64), (long long)crc24qPotencia(d));
+}
+
+/**
+ * FUNÇÃO 3: crc24qClmul()
+ * ESPECIFICAÇÃO: Mesmo resultado de crc24qBits(). O crc inicial entra como
+ * XOR nos 3 primeiros bytes; 4 acumuladores dobram 64 bytes por iteração,
+ * são reduzidos a um, que dobra os blocos de 16 restantes. Os 16 bytes
+ * finais do registrador + a cauda vão para o slice-by-8.
+ */
+inline uint32_t crc24qClmul(const crc24q_tabelas_t *tab, uint32_t crc, const uint8_t *data, size_t len) {
+    if (len < CRC24Q_CLMUL_MIN) {
+        return crc24qFatias8(tab, crc, data, len);
+    }
+
+    static const __m128i k512 = crc24qConstante(512);
+    static const __m128i k128 = crc24qConstante(128);
+    const __m128i inverte = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+
+    __m128i r[4];
+    for (int i = 0; i < 4; i++) {
+        r[i] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(data + 16 * i)), inverte);
+    }
+    r[0] = _mm_xor_si128(r[0], _mm_set_epi32((int)((crc & CRC24Q_MASCARA) << 8), 0, 0, 0));
+    data += 64;
+    len -= 64;
+
+    while (len >= 64) {
+        for (int i = 0; i < 4; i++) {
+            const __m128i b = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(data + 16 * i)), inverte);
+            r[i] = _mm_xor_si128(crc24qDobrar(r[i], k512), b);
+        }
+        data += 64;
+        len -= 64;
+    }
+
+    __m128i a = r[0];
+    for (int i = 1; i < 4; i++) {
+        a = _mm_xor_si128(crc24qDobrar(a, k128), r[i]);
+    }
+
+    while (len >= 16) {
+        const __m128i b = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)data), inverte);
+        a = _mm_xor_si128(crc24qDobrar(a, k128), b);
+        data += 16;
+        len -= 16;
+    }
+
+    uint8_t final[16];
+    _mm_storeu_si128((__m128i *)final, _mm_shuffle_epi8(a, inverte));
+    return crc24qFatias8(tab, crc24qFatias8(tab, 0, final, sizeof(final)), data, len);
+}
+#endif
+
+// Melhor implementação compilada
+inline uint32_t crc24qRapido(const crc24q_tabelas_t *tab, uint32_t crc, const uint8_t *data, size_t len) {
+#ifdef CRC24Q_CLMUL
+    return crc24qClmul(tab, crc, data, len);
+#else
+    return crc24qFatias8(tab, crc, data, len);
+#endif
+}
+
+// ================== VALIDAÇÃO DE QUADROS RTCM ==================
+
+struct rtcm_resultado_t {
+    uint64_t quadros;            // CRC confere
+    uint64_t crc_invalidos;      // Cabeçalho plausível, CRC não confere
+    uint64_t bytes_validos;
+    uint64_t bytes_descartados;  // Lixo entre quadros e quadros inválidos
+    uint64_t truncados;          // Quadro cortado no fim da captura (0 ou 1)
+};
+
+typedef uint32_t (*crc24q_fn_t)(const crc24q_tabelas_t *tab, uint32_t crc, const uint8_t *data, size_t len);
+
+// Referência com a assinatura comum (tabelas ignoradas)
+inline uint32_t crc24qReferencia(const crc24q_tabelas_t *, uint32_t crc, const uint8_t *data, size_t len) {
+    return crc24qBits(crc, data, len);
+}
+
+// Primeiro j em [de, n) onde começa um quadro inteiro dentro de buf[] com CRC certo; n se nenhum
+inline size_t rtcmProximoQuadro(const crc24q_tabelas_t *tab, crc24q_fn_t crc, const uint8_t *buf, size_t n,
+                                size_t de) {
+    for (size_t j = de; j + RTCM_CABECALHO <= n; j++) {
+        if (buf[j] != RTCM_PREAMBULO || (buf[j + 1] & 0xFC) != 0) {
+            continue;
+        }
+
+        const size_t total = RTCM_CABECALHO + ((size_t)(buf[j + 1] & 0x03) << 8 | buf[j + 2]) + RTCM_CRC;
+        if (n - j < total) {
+            continue;
+        }
+
+        const uint8_t *q = buf + j;
+        const uint32_t esperado = (uint32_t)q[total - 3] << 16 | (uint32_t)q[total - 2] << 8 | q[total - 1];
+
+        if (crc(tab, 0, q, total - RTCM_CRC) == esperado) {
+            return j;
+        }
+    }
+
+    return n;
+}
+
+/**
+ * FUNÇÃO 4: rtcmValidar()
+ * ESPECIFICAÇÃO: Percorre buf[0..n) procurando 0xD3 com bits reservados
+ * zerados; quadro com CRC certo é contado e pulado inteiro, senão o
+ * preâmbulo era falso e a busca recomeça no byte seguinte. Comprimento que
+ * passa do fim só é quadro truncado se nenhum quadro íntegro começa depois
+ * do preâmbulo; havendo um, o preâmbulo era falso e também ressincroniza.
+ * Nunca lê fora de buf[]; todo byte termina em exatamente um de
+ * bytes_validos, bytes_descartados ou no quadro truncado.
+ */
+inline void rtcmValidar(const crc24q_tabelas_t *tab, crc24q_fn_t crc, const uint8_t *buf, size_t n,
+                        rtcm_resultado_t *r) {
+    size_t i = 0;
+    size_t seguinte = 0;         // Próximo quadro íntegro já achado adiante de i (busca só no fim da captura)
+
+    while (i < n) {
+        if (buf[i] != RTCM_PREAMBULO || n - i < RTCM_CABECALHO || (buf[i + 1] & 0xFC) != 0) {
+            if (buf[i] == RTCM_PREAMBULO && n - i < RTCM_CABECALHO) {
+                r->truncados++;
+                return;
+            }
+            r->bytes_descartados++;
+            i++;
+            continue;
+        }
+
+        const size_t payload = (size_t)(buf[i + 1] & 0x03) << 8 | buf[i + 2];
+        const size_t total = RTCM_CABECALHO + payload + RTCM_CRC;
+
+        if (n - i < total) {
+            if (seguinte <= i) {
+                seguinte = rtcmProximoQuadro(tab, crc, buf, n, i + 1);
+            }
+
+            if (seguinte == n) {
+                r->truncados++;
+                return;
+            }
+
+            r->bytes_descartados++;
+            i++;
+            continue;
+        }
+
+        const uint8_t *q = buf + i;
+        const uint32_t esperado = (uint32_t)q[total - 3] << 16 | (uint32_t)q[total - 2] << 8 | q[total - 1];
+
+        if (crc(tab, 0, q, total - RTCM_CRC) == esperado) {
+            r->quadros++;
+            r->bytes_validos += total;
+            i += total;
+        } else {
+            r->crc_invalidos++;
+            r->bytes_descartados++;
+            i++;
+        }
+    }
+}
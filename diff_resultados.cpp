@@ -0,0 +1,322 @@
+/**
+ * @file diff_resultados.cpp
+ * @author Dissertação Mestrado - Verificação Formal PX4 v1.16
+ *
+ * OBJETIVO: Comparar duas rodadas do esbmc_runner (TSV de resultados)
+ *           claim a claim, em vez de comparar os logs de texto a olho
+ * MÉTODO: Identidade estável do claim = teste + função:linha:propriedade
+ *         (ocorrências repetidas numeradas pelo número do claim); vereditos
+ *         e tempos da rodada nova confrontados com os da antiga
+ *
+ * RELATÓRIO:
+ *   NOVA FALHA    era SUCESSO, agora FALHA/TIMEOUT/INCONCLUSIVO/ERRO
+ *   CORRIGIDA     não era SUCESSO, agora é
+ *   MUDOU         não-sucesso para outro não-sucesso (ex.: TIMEOUT -> FALHA)
+ *   MAIS LENTO    mesmo veredito, tempo acima de +X% (e de --min-s)
+ *   NOVO/REMOVIDO claim só numa das rodadas
+ *
+ * Ferramenta nativa (não é alvo de verificação):
+ * g++ -O2 -std=c++17 diff_resultados.cpp -o diff_resultados
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// ================== LEITURA ==================
+
+struct resultado_t {
+    std::string id;            // teste|funcao:linha:propriedade[#n]
+    std::string veredito;
+    double tempo_s;
+};
+
+static std::vector<std::string> separarCampos(const std::string &linha) {
+    std::vector<std::string> campos;
+    std::istringstream ss(linha);
+    std::string c;
+
+    while (std::getline(ss, c, '\t')) {
+        campos.push_back(c);
+    }
+
+    return campos;
+}
+
+/**
+ * FUNÇÃO 1: lerResultados()
+ * ESPECIFICAÇÃO: Colunas localizadas pelo cabeçalho (TSVs de versões
+ * anteriores do runner, sem estrategia/previsto_s, também servem). Job
+ * por teste (claim 0) tem identidade só pelo nome do teste.
+ */
+static bool lerResultados(const std::string &caminho, std::map<std::string, resultado_t> *saida) {
+    std::ifstream in(caminho);
+
+    if (!in) {
+        fprintf(stderr, "nao consegui ler %s\n", caminho.c_str());
+        return false;
+    }
+
+    std::string linha;
+    std::map<std::string, size_t> coluna;
+    std::map<std::string, int> repeticoes;
+
+    if (!std::getline(in, linha)) {
+        return true;
+    }
+
+    const std::vector<std::string> cab = separarCampos(linha);
+    for (size_t i = 0; i < cab.size(); i++) {
+        coluna[cab[i]] = i;
+    }
+
+    for (const char *obrigatoria : {"teste", "claim", "funcao", "linha", "propriedade", "veredito", "tempo_s"}) {
+        if (coluna.find(obrigatoria) == coluna.end()) {
+            fprintf(stderr, "%s: coluna %s ausente\n", caminho.c_str(), obrigatoria);
+            return false;
+        }
+    }
+
+    struct linha_t {
+        resultado_t r;
+        long claim;
+        long linha_fonte;
+    };
+
+    std::vector<linha_t> linhas;
+
+    while (std::getline(in, linha)) {
+        const std::vector<std::string> c = separarCampos(linha);
+
+        if (c.size() < cab.size()) {
+            continue;
+        }
+
+        linha_t l;
+        l.r.id = c[coluna["teste"]];
+
+        if (c[coluna["claim"]] != "0") {
+            l.r.id += "|" + c[coluna["funcao"]] + ":" + c[coluna["linha"]] + ":" + c[coluna["propriedade"]];
+        }
+
+        l.r.veredito = c[coluna["veredito"]];
+        l.r.tempo_s = atof(c[coluna["tempo_s"]].c_str());
+        l.claim = atol(c[coluna["claim"]].c_str());
+        l.linha_fonte = atol(c[coluna["linha"]].c_str());
+        linhas.push_back(l);
+    }
+
+    // A ordem das linhas varia entre rodadas (LPT, retomados primeiro, descartados no fim): repetições
+    // do mesmo id são numeradas pelo número do claim, que é estável para o mesmo código
+    std::stable_sort(linhas.begin(), linhas.end(), [](const linha_t &a, const linha_t &b) {
+        if (a.r.id != b.r.id) {
+            return a.r.id < b.r.id;
+        }
+        if (a.claim != b.claim) {
+            return a.claim < b.claim;
+        }
+        return a.linha_fonte < b.linha_fonte;
+    });
+
+    for (linha_t &l : linhas) {
+        const int n = ++repeticoes[l.r.id];
+        l.r.id += n > 1 ? "#" + std::to_string(n) : "";
+        (*saida)[l.r.id] = l.r;
+    }
+
+    return true;
+}
+
+// ================== COMPARAÇÃO ==================
+
+struct mudanca_t {
+    std::string categoria;
+    std::string id;
+    std::string antes;
+    std::string depois;
+    double tempo_antes;
+    double tempo_depois;
+};
+
+/**
+ * FUNÇÃO 2: comparar()
+ * ESPECIFICAÇÃO: Uma mudança por claim que mudou de categoria. Tempo só é
+ * comparado com o mesmo veredito (SUCESSO lento contra FALHA rápida não
+ * é regressão de desempenho) e só se algum dos tempos passa de min_s,
+ * para não reportar ruído de claims de milissegundos.
+ */
+static std::vector<mudanca_t> comparar(const std::map<std::string, resultado_t> &antes,
+                                       const std::map<std::string, resultado_t> &depois, double limiar_pct,
+                                       double min_s) {
+    std::vector<mudanca_t> m;
+
+    for (const auto &kv : depois) {
+        const resultado_t &d = kv.second;
+        const auto it = antes.find(kv.first);
+
+        if (it == antes.end()) {
+            m.push_back({"NOVO", d.id, "-", d.veredito, 0.0, d.tempo_s});
+            continue;
+        }
+
+        const resultado_t &a = it->second;
+        const bool ok_antes = a.veredito == "SUCESSO";
+        const bool ok_depois = d.veredito == "SUCESSO";
+
+        if (ok_antes && !ok_depois) {
+            m.push_back({"NOVA FALHA", d.id, a.veredito, d.veredito, a.tempo_s, d.tempo_s});
+        } else if (!ok_antes && ok_depois) {
+            m.push_back({"CORRIGIDA", d.id, a.veredito, d.veredito, a.tempo_s, d.tempo_s});
+        } else if (a.veredito != d.veredito) {
+            m.push_back({"MUDOU", d.id, a.veredito, d.veredito, a.tempo_s, d.tempo_s});
+        } else if (std::max(a.tempo_s, d.tempo_s) >= min_s && d.tempo_s > a.tempo_s * (1.0 + limiar_pct / 100.0)) {
+            m.push_back({"MAIS LENTO", d.id, a.veredito, d.veredito, a.tempo_s, d.tempo_s});
+        } else if (std::max(a.tempo_s, d.tempo_s) >= min_s && a.tempo_s > d.tempo_s * (1.0 + limiar_pct / 100.0)) {
+            m.push_back({"MAIS RAPIDO", d.id, a.veredito, d.veredito, a.tempo_s, d.tempo_s});
+        }
+    }
+
+    for (const auto &kv : antes) {
+        if (depois.find(kv.first) == depois.end()) {
+            m.push_back({"REMOVIDO", kv.first, kv.second.veredito, "-", kv.second.tempo_s, 0.0});
+        }
+    }
+
+    // Ordem do relatório: categorias por gravidade, dentro delas maior variação de tempo primeiro
+    const std::vector<std::string> ordem = {"NOVA FALHA", "MUDOU", "MAIS LENTO", "CORRIGIDA", "MAIS RAPIDO", "NOVO",
+                                            "REMOVIDO"};
+    auto posto = [&](const mudanca_t &x) {
+        return (size_t)(std::find(ordem.begin(), ordem.end(), x.categoria) - ordem.begin());
+    };
+
+    std::stable_sort(m.begin(), m.end(), [&](const mudanca_t &x, const mudanca_t &y) {
+        if (posto(x) != posto(y)) {
+            return posto(x) < posto(y);
+        }
+        return fabs(x.tempo_depois - x.tempo_antes) > fabs(y.tempo_depois - y.tempo_antes);
+    });
+
+    return m;
+}
+
+// ================== MAIN ==================
+
+static void uso(const char *prog) {
+    fprintf(stderr,
+            "uso: %s [opcoes] antes.tsv depois.tsv\n"
+            "  --limiar P   regressao de tempo acima de P%% (padrao: 25)\n"
+            "  --min-s S    ignora variacao de tempo se ambos < S segundos (padrao: 1)\n"
+            "  --tsv F      tambem grava as mudancas em TSV\n"
+            "saida 1 se houver NOVA FALHA, MUDOU ou MAIS LENTO\n",
+            prog);
+}
+
+int main(int argc, char **argv) {
+    std::vector<std::string> arquivos;
+    std::string tsv;
+    double limiar_pct = 25.0;
+    double min_s = 1.0;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string a = argv[i];
+
+        if (a == "--limiar" && i + 1 < argc) {
+            limiar_pct = atof(argv[++i]);
+        } else if (a == "--min-s" && i + 1 < argc) {
+            min_s = atof(argv[++i]);
+        } else if (a == "--tsv" && i + 1 < argc) {
+            tsv = argv[++i];
+        } else if (a == "-h" || a == "--help") {
+            uso(argv[0]);
+            return 0;
+        } else if (a[0] != '-') {
+            arquivos.push_back(a);
+        } else {
+            uso(argv[0]);
+            return 2;
+        }
+    }
+
+    if (arquivos.size() != 2) {
+        uso(argv[0]);
+        return 2;
+    }
+
+    std::map<std::string, resultado_t> antes, depois;
+
+    if (!lerResultados(arquivos[0], &antes) || !lerResultados(arquivos[1], &depois)) {
+        return 2;
+    }
+
+    const std::vector<mudanca_t> m = comparar(antes, depois, limiar_pct, min_s);
+    std::map<std::string, int> contagem;
+
+    for (const mudanca_t &x : m) {
+        contagem[x.categoria]++;
+        printf("%-11s  %-12s -> %-12s  %8.2fs -> %8.2fs  %s\n", x.categoria.c_str(), x.antes.c_str(),
+               x.depois.c_str(), x.tempo_antes, x.tempo_depois, x.id.c_str());
+    }
+
+    printf("\n%zu claims antes, %zu depois:", antes.size(), depois.size());
+    for (const auto &kv : contagem) {
+        printf(" %s %d,", kv.first.c_str(), kv.second);
+    }
+    printf(" iguais %zu\n", depois.size() - (m.size() - contagem["REMOVIDO"]));
+
+    if (!tsv.empty()) {
+        FILE *f = fopen(tsv.c_str(), "w");
+
+        if (!f) {
+            perror(tsv.c_str());
+            return 2;
+        }
+
+        fprintf(f, "categoria\tid\tantes\tdepois\ttempo_antes_s\ttempo_depois_s\n");
+        for (const mudanca_t &x : m) {
+            fprintf(f, "%s\t%s\t%s\t%s\t%.3f\t%.3f\n", x.categoria.c_str(), x.id.c_str(), x.antes.c_str(),
+                    x.depois.c_str(), x.tempo_antes, x.tempo_depois);
+        }
+
+        fclose(f);
+    }
+
+    return contagem["NOVA FALHA"] + contagem["MUDOU"] + contagem["MAIS LENTO"] > 0 ? 1 : 0;
+}
+
+/*
+ * ================================================================
+ * DOCUMENTAÇÃO
+ * ================================================================
+ *
+ * DIFF ENTRE RODADAS:
+ *
+ * 1. IDENTIDADE DO CLAIM:
+ *    - teste + função:linha:propriedade, a mesma chave que o runner usa
+ *      no histórico de custo; o número do claim (--claim N) não entra,
+ *      pois muda quando qualquer outro claim aparece ou some
+ *    - Mudança de linha na fonte vira REMOVIDO + NOVO
+ *
+ * 2. CATEGORIAS:
+ *    - NOVA FALHA e MUDOU primeiro: são as que bloqueiam o commit
+ *    - MAIS LENTO só com o mesmo veredito, acima de --limiar % e com
+ *      algum dos tempos acima de --min-s
+ *
+ * 3. USO EM SCRIPT:
+ *    - Código de saída 1 em regressão (falha ou tempo), 0 caso contrário
+ *    - --tsv grava as mudanças para outras ferramentas
+ *
+ * COMANDOS DE EXECUÇÃO:
+ * g++ -O2 -std=c++17 diff_resultados.cpp -o diff_resultados
+ * ./esbmc_runner --saida resultados_antes.tsv -- --unwind 8
+ * (git checkout ...)
+ * ./esbmc_runner --saida resultados_depois.tsv -- --unwind 8
+ * ./diff_resultados --limiar 20 resultados_antes.tsv resultados_depois.tsv
+ *
+ * ================================================================
+ */
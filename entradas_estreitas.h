@@ -0,0 +1,193 @@
+/**
+ * @file entradas_estreitas.h
+ * @author Dissertação Mestrado - Verificação Formal PX4 v1.16
+ *
+ * OBJETIVO: Sortear entradas não-determinísticas na menor largura que as
+ *           assumptions do teste permitem (menos bits para o solver)
+ * USO: gpsdrive.cpp (input_len: size_t <= 300 sorteado em 16 bits em vez de 64)
+ *
+ * Só vale para faixas menores que o tipo de destino: se as assumptions já
+ * cobrem o tipo inteiro (ex.: eixos int16 do BMI088 em imu.cpp), sorteie
+ * direto nesse tipo; ESTREITO_CHECAR() não teria o que provar.
+ *
+ * A faixa passada à macro é a única fonte do limite: a própria macro faz
+ * a __ESBMC_assume(min <= v <= max) em todos os modos; o teste só
+ * acrescenta restrições a mais (ex.: input_len > 0).
+ *
+ * MODOS (escolhidos por -D na compilação/front end):
+ *   padrão                   sorteio original, largura do tipo declarado
+ *   -DENTRADAS_ESTREITAS     sorteio em 8/16/32 bits + extensão para o tipo
+ *   -DVERIFICAR_ESTREITAMENTO sorteio original; ESTREITO_CHECAR() prova que,
+ *                            sob as assumptions do teste, todo valor cabe na
+ *                            largura que o modo estreito sortearia (nenhum
+ *                            comportamento perdido)
+ *
+ * Solidez: com a mesma assume nos dois modos, o domínio estreito estendido
+ * está contido no original; o modo de verificação prova a inclusão
+ * inversa. Juntos, os dois modos exploram o mesmo conjunto de entradas.
+ */
+
+#pragma once
+
+#include <assert.h>
+#include <cstdint>
+
+extern uint8_t nondet_uint8();
+extern uint16_t nondet_uint16();
+extern uint32_t nondet_uint32();
+extern uint64_t nondet_uint64();
+extern int8_t nondet_int8();
+extern int16_t nondet_int16();
+extern int32_t nondet_int32();
+extern int64_t nondet_int64();
+extern void __ESBMC_assume(int condition);
+
+// ================== SORTEIO ESTREITO ==================
+
+/**
+ * FUNÇÃO 1: nondetEstreitoU()
+ * ESPECIFICAÇÃO: Valor sem sinal sorteado no menor tipo que contém [0, max].
+ * 'max' é constante em cada chamada, então os ramos somem na simbólica.
+ */
+// Maior valor do tipo que nondetEstreitoU(max) sorteia
+inline uint64_t larguraEstreitaU(uint64_t max) {
+    return max <= UINT8_MAX ? UINT8_MAX : max <= UINT16_MAX ? UINT16_MAX : max <= UINT32_MAX ? UINT32_MAX : UINT64_MAX;
+}
+
+inline uint64_t nondetEstreitoU(uint64_t max) {
+    if (max <= UINT8_MAX) {
+        return nondet_uint8();
+    }
+
+    if (max <= UINT16_MAX) {
+        return nondet_uint16();
+    }
+
+    if (max <= UINT32_MAX) {
+        return nondet_uint32();
+    }
+
+    return nondet_uint64();
+}
+
+/**
+ * FUNÇÃO 2: nondetEstreitoS()
+ * ESPECIFICAÇÃO: Valor com sinal sorteado no menor tipo que contém [min, max]
+ */
+// Faixa do tipo que nondetEstreitoS(min, max) sorteia
+inline void larguraEstreitaS(int64_t min, int64_t max, int64_t *lo, int64_t *hi) {
+    if (min >= INT8_MIN && max <= INT8_MAX) {
+        *lo = INT8_MIN;
+        *hi = INT8_MAX;
+    } else if (min >= INT16_MIN && max <= INT16_MAX) {
+        *lo = INT16_MIN;
+        *hi = INT16_MAX;
+    } else if (min >= INT32_MIN && max <= INT32_MAX) {
+        *lo = INT32_MIN;
+        *hi = INT32_MAX;
+    } else {
+        *lo = INT64_MIN;
+        *hi = INT64_MAX;
+    }
+}
+
+inline int64_t nondetEstreitoS(int64_t min, int64_t max) {
+    if (min >= INT8_MIN && max <= INT8_MAX) {
+        return nondet_int8();
+    }
+
+    if (min >= INT16_MIN && max <= INT16_MAX) {
+        return nondet_int16();
+    }
+
+    if (min >= INT32_MIN && max <= INT32_MAX) {
+        return nondet_int32();
+    }
+
+    return nondet_int64();
+}
+
+// Limite da faixa, o mesmo em todos os modos
+inline uint64_t estreitoAssumirU(uint64_t valor, uint64_t max) {
+    __ESBMC_assume(valor <= max);
+    return valor;
+}
+
+inline int64_t estreitoAssumirS(int64_t valor, int64_t min, int64_t max) {
+    __ESBMC_assume(valor >= min && valor <= max);
+    return valor;
+}
+
+// ================== VERIFICAÇÃO DE SOLIDEZ ==================
+
+static constexpr int ESTREITO_MAX_ENTRADAS = 8;
+
+struct estreito_registro_t {
+    int64_t valor[ESTREITO_MAX_ENTRADAS];
+    int64_t min[ESTREITO_MAX_ENTRADAS];
+    uint64_t max[ESTREITO_MAX_ENTRADAS];
+    bool com_sinal[ESTREITO_MAX_ENTRADAS];
+    int n;
+};
+
+static estreito_registro_t estreito_registro;
+
+// Registra o valor original com a faixa do tipo que o modo estreito sortearia
+inline uint64_t estreitoRegistrarU(uint64_t valor, uint64_t max) {
+    const int i = estreito_registro.n++;
+    assert(i < ESTREITO_MAX_ENTRADAS);
+    estreito_registro.valor[i] = (int64_t)valor;
+    estreito_registro.max[i] = larguraEstreitaU(max);
+    estreito_registro.com_sinal[i] = false;
+    return valor;
+}
+
+inline int64_t estreitoRegistrarS(int64_t valor, int64_t min, int64_t max) {
+    const int i = estreito_registro.n++;
+    assert(i < ESTREITO_MAX_ENTRADAS);
+    int64_t lo, hi;
+    larguraEstreitaS(min, max, &lo, &hi);
+    estreito_registro.valor[i] = valor;
+    estreito_registro.min[i] = lo;
+    estreito_registro.max[i] = (uint64_t)hi;
+    estreito_registro.com_sinal[i] = true;
+    return valor;
+}
+
+/**
+ * FUNÇÃO 3: estreitoChecar()
+ * ESPECIFICAÇÃO: Chamada depois das assumptions do teste: cada entrada
+ * sorteada na largura original cabe no tipo que o modo estreito sorteia.
+ */
+inline void estreitoChecar() {
+    for (int i = 0; i < estreito_registro.n && i < ESTREITO_MAX_ENTRADAS; i++) {
+        if (estreito_registro.com_sinal[i]) {
+            assert(estreito_registro.valor[i] >= estreito_registro.min[i] &&
+                   estreito_registro.valor[i] <= (int64_t)estreito_registro.max[i]);
+        } else {
+            assert((uint64_t)estreito_registro.valor[i] <= estreito_registro.max[i]);
+        }
+    }
+
+    estreito_registro.n = 0;
+}
+
+// ================== MACROS DOS HARNESSES ==================
+// tipo: tipo declarado da variável; largo: sorteio original do teste;
+// max / min..max: faixa da entrada, assumida pela própria macro
+
+#if defined(VERIFICAR_ESTREITAMENTO)
+#define NONDET_ESTREITO_U(tipo, largo, max) \
+    ((tipo)estreitoRegistrarU(estreitoAssumirU((uint64_t)(tipo)(largo), (max)), (max)))
+#define NONDET_ESTREITO_S(tipo, largo, min, max) \
+    ((tipo)estreitoRegistrarS(estreitoAssumirS((int64_t)(tipo)(largo), (min), (max)), (min), (max)))
+#define ESTREITO_CHECAR()                         estreitoChecar()
+#elif defined(ENTRADAS_ESTREITAS)
+#define NONDET_ESTREITO_U(tipo, largo, max)       ((tipo)estreitoAssumirU(nondetEstreitoU((max)), (max)))
+#define NONDET_ESTREITO_S(tipo, largo, min, max)  ((tipo)estreitoAssumirS(nondetEstreitoS((min), (max)), (min), (max)))
+#define ESTREITO_CHECAR()                         ((void)0)
+#else
+#define NONDET_ESTREITO_U(tipo, largo, max)       ((tipo)estreitoAssumirU((uint64_t)(tipo)(largo), (max)))
+#define NONDET_ESTREITO_S(tipo, largo, min, max)  ((tipo)estreitoAssumirS((int64_t)(tipo)(largo), (min), (max)))
+#define ESTREITO_CHECAR()                         ((void)0)
+#endif
@@ -0,0 +1,308 @@
+/**
+ * @file esbmc_custo.h
+ * @author Dissertação Mestrado - Verificação Formal PX4 v1.16
+ *
+ * OBJETIVO: Prever o tempo de solver de cada claim para escalonar os jobs
+ *           do esbmc_runner do mais caro para o mais barato (LPT)
+ * USO: esbmc_runner.cpp
+ *
+ * HISTÓRICO: <cache>/historico.tsv, uma linha por claim resolvido:
+ *   chave  classe  fp  profundidade  unwind  vcc  tempo_s
+ * chave = função:linha:propriedade (identidade estável entre execuções)
+ *
+ * MODELO: regressão linear em log(tempo) sobre
+ *   [1, log(1+vcc), fp, profundidade*log(unwind), classe limites, classe overflow]
+ * ajustada por mínimos quadrados (com regularização leve) sobre o histórico.
+ * Claims já vistos usam a média móvel do próprio tempo.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+// ================== CARACTERÍSTICAS DE UM CLAIM ==================
+
+struct claim_features_t {
+    std::string classe;      // "limites", "overflow", "assercao", "outro"
+    bool fp;                 // Teoria de ponto flutuante (float no teste)
+    int profundidade;        // Laços abertos na linha do claim
+    int unwind;              // --unwind da execução
+    double vcc;              // VCCs restantes após simplificação (<0 = desconhecido)
+};
+
+struct custo_amostra_t {
+    std::string chave;
+    claim_features_t f;
+    double tempo_s;
+};
+
+static constexpr int CUSTO_NUM_COEF = 6;
+static constexpr double CUSTO_EWMA_ALFA = 0.5;
+static constexpr size_t CUSTO_MIN_AMOSTRAS = 8;
+
+struct custo_modelo_t {
+    std::vector<custo_amostra_t> amostras;
+    std::map<std::string, double> ewma_por_chave;      // log(tempo)
+    std::map<std::string, claim_features_t> ultima_por_chave;
+    std::map<std::string, double> log_vcc_por_classe;  // Média, para claims novos
+    double coef[CUSTO_NUM_COEF];
+    bool ajustado;
+};
+
+inline std::string custoClasse(const std::string &propriedade) {
+    if (propriedade.find("overflow") != std::string::npos) {
+        return "overflow";
+    }
+
+    if (propriedade.find("bounds") != std::string::npos ||
+        propriedade.find("dereference") != std::string::npos ||
+        propriedade.find("memcpy") != std::string::npos ||
+        propriedade.find("pointer") != std::string::npos) {
+        return "limites";
+    }
+
+    if (propriedade.find("assertion") != std::string::npos) {
+        return "assercao";
+    }
+
+    return "outro";
+}
+
+/**
+ * FUNÇÃO 1: custoProfundidadeLaco()
+ * ESPECIFICAÇÃO: Quantos laços (for/while/do) estão abertos na linha
+ * 'linha' do texto. Contagem de chaves simples: suficiente para o estilo
+ * dos harnesses (chave de abertura na mesma linha do laço).
+ */
+inline int custoProfundidadeLaco(const std::string &texto, int linha) {
+    std::vector<bool> pilha;     // true = chave aberta por laço
+    int atual = 1;
+    int profundidade = 0;
+    bool laco_pendente = false;
+
+    for (size_t i = 0; i < texto.size() && atual <= linha; i++) {
+        const char c = texto[i];
+
+        if (c == '\n') {
+            atual++;
+            continue;
+        }
+
+        if ((texto.compare(i, 6, "while ") == 0 || texto.compare(i, 6, "while(") == 0 ||
+             texto.compare(i, 4, "for ") == 0 || texto.compare(i, 4, "for(") == 0 ||
+             texto.compare(i, 3, "do ") == 0 || texto.compare(i, 3, "do{") == 0) &&
+            (i == 0 || !(isalnum((unsigned char)texto[i - 1]) || texto[i - 1] == '_'))) {
+            laco_pendente = true;
+        } else if (c == '{') {
+            pilha.push_back(laco_pendente);
+            profundidade += laco_pendente ? 1 : 0;
+            laco_pendente = false;
+        } else if (c == '}' && !pilha.empty()) {
+            profundidade -= pilha.back() ? 1 : 0;
+            pilha.pop_back();
+        } else if (c == ';') {
+            laco_pendente = false;
+        }
+    }
+
+    return profundidade;
+}
+
+inline void custoVetor(const claim_features_t &f, double log_vcc, double x[CUSTO_NUM_COEF]) {
+    x[0] = 1.0;
+    x[1] = log_vcc;
+    x[2] = f.fp ? 1.0 : 0.0;
+    x[3] = f.profundidade * log((double)std::max(f.unwind, 1) + 1.0);
+    x[4] = f.classe == "limites" ? 1.0 : 0.0;
+    x[5] = f.classe == "overflow" ? 1.0 : 0.0;
+}
+
+// ================== HISTÓRICO ==================
+
+inline void custoRegistrar(custo_modelo_t *m, const custo_amostra_t &a) {
+    const double lt = log(std::max(a.tempo_s, 1e-3));
+    auto it = m->ewma_por_chave.find(a.chave);
+
+    if (it == m->ewma_por_chave.end()) {
+        m->ewma_por_chave[a.chave] = lt;
+    } else {
+        it->second = CUSTO_EWMA_ALFA * lt + (1.0 - CUSTO_EWMA_ALFA) * it->second;
+    }
+
+    m->ultima_por_chave[a.chave] = a.f;
+    m->amostras.push_back(a);
+}
+
+inline void custoCarregar(custo_modelo_t *m, const std::string &caminho) {
+    m->amostras.clear();
+    m->ewma_por_chave.clear();
+    m->ultima_por_chave.clear();
+    m->ajustado = false;
+
+    FILE *f = fopen(caminho.c_str(), "r");
+    if (!f) {
+        return;
+    }
+
+    char linha[1024];
+    while (fgets(linha, sizeof(linha), f)) {
+        char chave[512], classe[32];
+        int fp, prof, unwind;
+        double vcc, tempo;
+
+        if (sscanf(linha, "%511[^\t]\t%31[^\t]\t%d\t%d\t%d\t%lf\t%lf", chave, classe, &fp, &prof, &unwind,
+                   &vcc, &tempo) == 7) {
+            custo_amostra_t a = {chave, {classe, fp != 0, prof, unwind, vcc}, tempo};
+            custoRegistrar(m, a);
+        }
+    }
+
+    fclose(f);
+}
+
+inline void custoAnexar(const std::string &caminho, const custo_amostra_t &a) {
+    FILE *f = fopen(caminho.c_str(), "a");
+    if (!f) {
+        return;
+    }
+
+    fprintf(f, "%s\t%s\t%d\t%d\t%d\t%.0f\t%.3f\n", a.chave.c_str(), a.f.classe.c_str(), a.f.fp ? 1 : 0,
+            a.f.profundidade, a.f.unwind, a.f.vcc, a.tempo_s);
+    fclose(f);
+}
+
+// ================== AJUSTE ==================
+
+/**
+ * FUNÇÃO 2: custoAjustar()
+ * ESPECIFICAÇÃO: Mínimos quadrados regularizados (A'A + λI) c = A'y por
+ * eliminação de Gauss com pivoteamento parcial. Amostras sem VCC conhecido
+ * usam a média da classe.
+ */
+inline void custoAjustar(custo_modelo_t *m) {
+    std::map<std::string, std::pair<double, int>> soma_vcc;
+
+    for (const custo_amostra_t &a : m->amostras) {
+        if (a.f.vcc >= 0) {
+            auto &s = soma_vcc[a.f.classe];
+            s.first += log1p(a.f.vcc);
+            s.second++;
+        }
+    }
+
+    m->log_vcc_por_classe.clear();
+    for (const auto &kv : soma_vcc) {
+        m->log_vcc_por_classe[kv.first] = kv.second.first / kv.second.second;
+    }
+
+    m->ajustado = false;
+    if (m->amostras.size() < CUSTO_MIN_AMOSTRAS) {
+        return;
+    }
+
+    double ata[CUSTO_NUM_COEF][CUSTO_NUM_COEF + 1] = {};
+
+    for (const custo_amostra_t &a : m->amostras) {
+        double x[CUSTO_NUM_COEF];
+        const auto cls = m->log_vcc_por_classe.find(a.f.classe);
+        const double lv = a.f.vcc >= 0 ? log1p(a.f.vcc) : (cls != m->log_vcc_por_classe.end() ? cls->second : 0.0);
+        custoVetor(a.f, lv, x);
+        const double y = log(std::max(a.tempo_s, 1e-3));
+
+        for (int i = 0; i < CUSTO_NUM_COEF; i++) {
+            for (int j = 0; j < CUSTO_NUM_COEF; j++) {
+                ata[i][j] += x[i] * x[j];
+            }
+            ata[i][CUSTO_NUM_COEF] += x[i] * y;
+        }
+    }
+
+    for (int i = 1; i < CUSTO_NUM_COEF; i++) {
+        ata[i][i] += 1e-3;       // Regularização: colunas constantes (ex.: sem FP no histórico)
+    }
+
+    for (int c = 0; c < CUSTO_NUM_COEF; c++) {
+        int piv = c;
+        for (int r = c + 1; r < CUSTO_NUM_COEF; r++) {
+            if (fabs(ata[r][c]) > fabs(ata[piv][c])) {
+                piv = r;
+            }
+        }
+
+        if (fabs(ata[piv][c]) < 1e-12) {
+            return;
+        }
+
+        for (int k = 0; k <= CUSTO_NUM_COEF; k++) {
+            std::swap(ata[c][k], ata[piv][k]);
+        }
+
+        for (int r = 0; r < CUSTO_NUM_COEF; r++) {
+            if (r == c) {
+                continue;
+            }
+
+            const double fator = ata[r][c] / ata[c][c];
+            for (int k = c; k <= CUSTO_NUM_COEF; k++) {
+                ata[r][k] -= fator * ata[c][k];
+            }
+        }
+    }
+
+    for (int i = 0; i < CUSTO_NUM_COEF; i++) {
+        m->coef[i] = ata[i][CUSTO_NUM_COEF] / ata[i][i];
+    }
+
+    m->ajustado = true;
+}
+
+// ================== PREVISÃO ==================
+
+/**
+ * FUNÇÃO 3: custoPrever()
+ * ESPECIFICAÇÃO: Tempo previsto (s) de um claim.
+ *   1. chave conhecida com mesmo unwind: média móvel do próprio tempo
+ *   2. modelo ajustado: exp(c·x), com VCC da última execução da chave ou
+ *      média da classe
+ *   3. sem histórico: heurística por classe/teoria/laço
+ */
+inline double custoPrever(const custo_modelo_t *m, const std::string &chave, const claim_features_t &f) {
+    const auto ew = m->ewma_por_chave.find(chave);
+    const auto ult = m->ultima_por_chave.find(chave);
+
+    if (ew != m->ewma_por_chave.end() && ult != m->ultima_por_chave.end() && ult->second.unwind == f.unwind) {
+        return exp(ew->second);
+    }
+
+    if (m->ajustado) {
+        double lv = 0.0;
+
+        if (ult != m->ultima_por_chave.end() && ult->second.vcc >= 0) {
+            lv = log1p(ult->second.vcc);
+        } else {
+            const auto cls = m->log_vcc_por_classe.find(f.classe);
+            lv = cls != m->log_vcc_por_classe.end() ? cls->second : 0.0;
+        }
+
+        double x[CUSTO_NUM_COEF];
+        custoVetor(f, lv, x);
+
+        double s = 0.0;
+        for (int i = 0; i < CUSTO_NUM_COEF; i++) {
+            s += m->coef[i] * x[i];
+        }
+
+        return exp(std::min(s, 12.0));
+    }
+
+    double base = f.classe == "limites" ? 20.0 : (f.classe == "overflow" ? 1.0 : 3.0);
+    base *= f.fp ? 10.0 : 1.0;
+    base *= pow((double)std::max(f.unwind, 1), (double)f.profundidade * 0.5);
+    return base;
+}
@@ -0,0 +1,100 @@
+/**
+ * @file esbmc_fila.h
+ * @author Dissertação Mestrado - Verificação Formal PX4 v1.16
+ *
+ * OBJETIVO: Fila de jobs persistente do esbmc_runner: uma rodada
+ *           interrompida (timeout da sessão, suspensão do notebook,
+ *           reinício do WSL) retoma do ponto onde parou
+ * USO: esbmc_runner.cpp
+ *
+ * DIÁRIO: <cache>/filas/<goto>_<config>.tsv, só acrescentado, uma linha
+ * por job concluído, gravada com fsync antes do job contar como feito:
+ *   id  estrategia  veredito  tempo_s  vcc  log
+ * id = teste|claim|modo (modo = bmc, fp-<níveis> ou portfolio)
+ * Uma linha truncada por queda no meio da escrita é ignorada na leitura.
+ */
+
+#pragma once
+
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <string>
+
+#include <unistd.h>
+
+struct fila_registro_t {
+    std::string estrategia;
+    std::string veredito;
+    double tempo_s;
+    double vcc;
+    std::string log;
+};
+
+struct fila_t {
+    std::string caminho;
+    std::map<std::string, fila_registro_t> feitos;
+    std::mutex mtx;
+};
+
+/**
+ * FUNÇÃO 1: filaCarregar()
+ * ESPECIFICAÇÃO: Ler o diário existente. ERRO não conta como feito (falha
+ * de ambiente, não do claim): volta para a fila na retomada.
+ */
+inline void filaCarregar(fila_t *fila, const std::string &caminho) {
+    fila->caminho = caminho;
+    fila->feitos.clear();
+
+    FILE *f = fopen(caminho.c_str(), "r");
+    if (!f) {
+        return;
+    }
+
+    char linha[2048];
+    while (fgets(linha, sizeof(linha), f)) {
+        char id[512], estrategia[64], veredito[32], log[1024];
+        double tempo, vcc;
+
+        if (strchr(linha, '\n') == nullptr) {
+            continue;       // Última linha sem '\n': escrita interrompida
+        }
+
+        if (sscanf(linha, "%511[^\t]\t%63[^\t]\t%31[^\t]\t%lf\t%lf\t%1023[^\n]", id, estrategia, veredito, &tempo,
+                   &vcc, log) == 6 &&
+            strcmp(veredito, "ERRO") != 0) {
+            fila->feitos[id] = {estrategia, veredito, tempo, vcc, log};
+        }
+    }
+
+    fclose(f);
+}
+
+inline const fila_registro_t *filaBuscar(const fila_t *fila, const std::string &id) {
+    const auto it = fila->feitos.find(id);
+    return it == fila->feitos.end() ? nullptr : &it->second;
+}
+
+/**
+ * FUNÇÃO 2: filaRegistrar()
+ * ESPECIFICAÇÃO: Acrescentar um job concluído e forçar para o disco
+ * (fsync): depois do retorno, uma queda não perde o resultado.
+ */
+inline void filaRegistrar(fila_t *fila, const std::string &id, const fila_registro_t &r) {
+    std::lock_guard<std::mutex> lock(fila->mtx);
+    FILE *f = fopen(fila->caminho.c_str(), "a");
+
+    if (!f) {
+        perror(fila->caminho.c_str());
+        return;
+    }
+
+    fprintf(f, "%s\t%s\t%s\t%.3f\t%.0f\t%s\n", id.c_str(), r.estrategia.c_str(), r.veredito.c_str(), r.tempo_s,
+            r.vcc, r.log.c_str());
+    fflush(f);
+    fsync(fileno(f));
+    fclose(f);
+
+    fila->feitos[id] = r;
+}
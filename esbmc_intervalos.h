@@ -0,0 +1,858 @@
+/**
+ * @file esbmc_intervalos.h
+ * @author Dissertação Mestrado - Verificação Formal PX4 v1.16
+ *
+ * OBJETIVO: Descartar estaticamente claims de --overflow-check que a
+ *           análise de intervalos prova seguros, antes de chamar o solver
+ * USO: esbmc_runner.cpp (--intervalos)
+ *
+ * ENTRADA: a expressão do claim impressa por --show-claims, com as
+ * conversões já explícitas pelo front end do ESBMC:
+ *   !overflow("-", 200, (signed int)dump_data->len)
+ *   !overflow("shl", (signed int)msb, 8)
+ * Folhas sem conversão recebem o tipo declarado nas fontes (parâmetros,
+ * locais, campos de struct) e, quando a variável não é reatribuída, o
+ * intervalo das __ESBMC_assume(v <op> expressão) anteriores ao claim no
+ * mesmo bloco ou num bloco que o contém; "v = NONDET_ESTREITO_U/S(...)"
+ * conta como a assume da faixa que a macro faz (entradas_estreitas.h).
+ *
+ * VEREDITO: intervalo exato da operação contido no tipo = DESCARTADO;
+ * qualquer coisa não entendida = INCERTO (vai para o solver).
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <climits>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+typedef __int128 intervalo_int_t;
+
+struct intervalo_t {
+    intervalo_int_t lo;
+    intervalo_int_t hi;
+    bool valido;
+};
+
+struct tipo_int_t {
+    std::string nome;
+    intervalo_int_t lo;
+    intervalo_int_t hi;
+};
+
+static const intervalo_int_t INTERVALO_U64_MAX = (intervalo_int_t)UINT64_MAX;
+static const intervalo_int_t INTERVALO_LIMITE = (intervalo_int_t)1 << 125;    // Operandos e produtos: +, -, | cabem em __int128
+
+inline bool tipoInteiro(const std::string &nome, tipo_int_t *t) {
+    static const std::map<std::string, std::pair<intervalo_int_t, intervalo_int_t>> tipos = {
+        {"bool", {0, 1}},
+        {"_Bool", {0, 1}},
+        {"uint8_t", {0, UINT8_MAX}},
+        {"unsigned char", {0, UINT8_MAX}},
+        {"int8_t", {INT8_MIN, INT8_MAX}},
+        {"signed char", {INT8_MIN, INT8_MAX}},
+        {"char", {INT8_MIN, INT8_MAX}},
+        {"uint16_t", {0, UINT16_MAX}},
+        {"unsigned short int", {0, UINT16_MAX}},
+        {"int16_t", {INT16_MIN, INT16_MAX}},
+        {"signed short int", {INT16_MIN, INT16_MAX}},
+        {"uint32_t", {0, UINT32_MAX}},
+        {"unsigned int", {0, UINT32_MAX}},
+        {"unsigned", {0, UINT32_MAX}},
+        {"int32_t", {INT32_MIN, INT32_MAX}},
+        {"int", {INT32_MIN, INT32_MAX}},
+        {"signed int", {INT32_MIN, INT32_MAX}},
+        {"uint64_t", {0, INTERVALO_U64_MAX}},
+        {"size_t", {0, INTERVALO_U64_MAX}},
+        {"unsigned long int", {0, INTERVALO_U64_MAX}},
+        {"unsigned long", {0, INTERVALO_U64_MAX}},
+        {"int64_t", {INT64_MIN, INT64_MAX}},
+        {"long int", {INT64_MIN, INT64_MAX}},
+        {"signed long int", {INT64_MIN, INT64_MAX}},
+        {"long", {INT64_MIN, INT64_MAX}},
+    };
+
+    const auto it = tipos.find(nome);
+    if (it == tipos.end()) {
+        return false;
+    }
+
+    *t = {nome, it->second.first, it->second.second};
+    return true;
+}
+
+// ================== TABELA DE SÍMBOLOS ==================
+
+// (função, nome) -> tipo; função "" = campo de struct ou global
+typedef std::map<std::pair<std::string, std::string>, std::string> simbolos_t;
+
+// __ESBMC_assume(variavel op direita); 'direita' é avaliada inteira no uso
+struct restricao_t {
+    std::string funcao;
+    std::string variavel;
+    int linha;
+    int bloco;                  // Bloco { } em que a assume está
+    std::string op;
+    std::string direita;
+};
+
+struct fonte_intervalos_t {
+    simbolos_t simbolos;
+    std::vector<restricao_t> restricoes;
+    std::vector<int> fim_bloco;                             // Linha do '}' de cada bloco
+    std::map<std::string, std::vector<int>> atribuicoes;    // "funcao|var" -> linhas
+    std::map<std::string, intervalo_int_t> constantes;      // #define N 200
+};
+
+inline bool intervaloIdent(char c) { return isalnum((unsigned char)c) || c == '_'; }
+
+/**
+ * FUNÇÃO 1: intervalosLerFonte()
+ * ESPECIFICAÇÃO: Uma passada por linha, no estilo dos harnesses: função =
+ * linha em nível 0 com "nome(" seguida de '{'; declarações "tipo nome"
+ * com tipos inteiros conhecidos; atribuições "v =", "v +=", "v++";
+ * __ESBMC_assume com conjunções "v <op> expressão", sozinha na linha e
+ * não controlada por if/else sem chaves; "v = NONDET_ESTREITO_U(tipo,
+ * largo, max)" vira v <= max e a versão _S, v >= min e v <= max.
+ */
+inline void intervalosLerFonte(const std::string &texto, fonte_intervalos_t *f) {
+    std::istringstream linhas(texto);
+    std::string linha, funcao, candidata, anterior;
+    std::vector<int> blocos;
+    int num = 0, prof = 0;
+
+    while (std::getline(linhas, linha)) {
+        num++;
+
+        unsigned n_def = 0;
+        intervalo_int_t v_def = 0;
+        char nome_def[128];
+        if (sscanf(linha.c_str(), "#define %127s %u", nome_def, &n_def) == 2) {
+            v_def = n_def;
+            f->constantes[nome_def] = v_def;
+        }
+
+        if (prof == 0 && (linha.find(';') != std::string::npos || linha.find("struct") != std::string::npos ||
+                          linha.find("enum") != std::string::npos)) {
+            candidata.clear();      // Protótipo, global ou tipo: não abre função
+        }
+
+        if (prof == 0) {
+            const size_t par = linha.find('(');
+            if (par != std::string::npos && linha.find(';') == std::string::npos && linha[0] != ' ' &&
+                linha[0] != '#' && linha[0] != '/' && linha[0] != '*') {
+                size_t ini = par;
+                while (ini > 0 && intervaloIdent(linha[ini - 1])) {
+                    ini--;
+                }
+                candidata = linha.substr(ini, par - ini);
+            }
+        }
+
+        for (char c : linha) {
+            if (c == '{') {
+                if (prof == 0) {
+                    funcao = candidata;
+                }
+                prof++;
+                blocos.push_back((int)f->fim_bloco.size());
+                f->fim_bloco.push_back(INT_MAX);
+            } else if (c == '}') {
+                if (!blocos.empty()) {
+                    f->fim_bloco[blocos.back()] = num;
+                    blocos.pop_back();
+                }
+                prof--;
+                if (prof == 0) {
+                    funcao.clear();
+                    candidata.clear();
+                }
+            }
+        }
+
+        const std::string escopo = prof > 0 ? funcao : candidata;
+        const bool em_struct = prof > 0 && funcao.empty();
+
+        // Declarações: "<tipo> [*]nome" para cada tipo inteiro conhecido
+        for (const char *tn : {"uint8_t", "int8_t", "uint16_t", "int16_t", "uint32_t", "int32_t", "uint64_t",
+                               "int64_t", "size_t", "int", "unsigned", "bool"}) {
+            const std::string t = tn;
+
+            for (size_t p = linha.find(t); p != std::string::npos; p = linha.find(t, p + 1)) {
+                if ((p > 0 && intervaloIdent(linha[p - 1])) || (p + t.size() < linha.size() &&
+                                                                 intervaloIdent(linha[p + t.size()]))) {
+                    continue;
+                }
+
+                // Lista "int16_t a, b, c;" em nível 0 de parênteses da declaração
+                size_t q = p + t.size();
+                for (;;) {
+                    while (q < linha.size() && (linha[q] == ' ' || linha[q] == '*' || linha[q] == '&')) {
+                        q++;
+                    }
+
+                    size_t fim = q;
+                    while (fim < linha.size() && intervaloIdent(linha[fim])) {
+                        fim++;
+                    }
+
+                    if (fim == q || isdigit((unsigned char)linha[q])) {
+                        break;
+                    }
+
+                    const bool ponteiro = linha.find('*', p + t.size()) < q;
+                    if (!ponteiro) {
+                        f->simbolos[{em_struct ? "" : escopo, linha.substr(q, fim - q)}] = t;
+                    }
+
+                    // Continua na vírgula seguinte só se não houver '=' ou '(' antes dela
+                    const size_t virgula = linha.find(',', fim);
+                    const size_t corte = linha.find_first_of("=()[;", fim);
+                    if (virgula == std::string::npos || (corte != std::string::npos && corte < virgula) ||
+                        linha.compare(fim, 1, ")") == 0) {
+                        break;
+                    }
+                    q = virgula + 1;
+                }
+            }
+        }
+
+        // Atribuições
+        for (size_t p = 0; p < linha.size(); p++) {
+            const bool atrib = linha[p] == '=' && (p + 1 >= linha.size() || linha[p + 1] != '=') &&
+                               (p == 0 || std::string("=!<>").find(linha[p - 1]) == std::string::npos ||
+                                (p >= 2 && (linha[p - 1] == '<' || linha[p - 1] == '>') &&
+                                 linha[p - 2] == linha[p - 1]));
+            const bool incr = linha.compare(p, 2, "++") == 0 || linha.compare(p, 2, "--") == 0;
+            const bool endereco = linha[p] == '&' && p + 1 < linha.size() && intervaloIdent(linha[p + 1]) &&
+                                  (p == 0 || linha[p - 1] != '&');
+
+            if (endereco) {
+                // &x: quem recebe o ponteiro pode escrever; conta como atribuição
+                size_t fim = p + 1;
+                while (fim < linha.size() && intervaloIdent(linha[fim])) {
+                    fim++;
+                }
+                f->atribuicoes[escopo + "|" + linha.substr(p + 1, fim - p - 1)].push_back(num);
+                continue;
+            }
+
+            if (!atrib && !incr) {
+                continue;
+            }
+
+            // Variável (último componente) à esquerda; ++x/x++ pega o vizinho
+            size_t fim = p;
+            while (fim > 0 && std::string("+-*/%&|^<> ").find(linha[fim - 1]) != std::string::npos) {
+                fim--;
+            }
+            size_t ini = fim;
+            while (ini > 0 && intervaloIdent(linha[ini - 1])) {
+                ini--;
+            }
+
+            if (incr && ini == fim) {
+                ini = fim = p + 2;
+                while (fim < linha.size() && intervaloIdent(linha[fim])) {
+                    fim++;
+                }
+            }
+
+            if (fim > ini) {
+                f->atribuicoes[escopo + "|" + linha.substr(ini, fim - ini)].push_back(num);
+            }
+
+            p += incr ? 1 : 0;
+        }
+
+        // __ESBMC_assume(a && b && ...): conjunções "v op expressão". Só a
+        // assume que vale para o resto do bloco: sozinha na linha (sem { }) e
+        // não sob "if (...)"/"else" sem chaves na linha anterior
+        const size_t as = linha.find("__ESBMC_assume(");
+        const bool condicional = !anterior.empty() && (anterior.back() == ')' ||
+                                 (anterior.size() >= 4 && anterior.compare(anterior.size() - 4, 4, "else") == 0));
+
+        if (as != std::string::npos && linha.find("||") == std::string::npos && linha.find_first_of("{}") ==
+            std::string::npos && linha.find_first_not_of(" \t") == as && !condicional && !blocos.empty()) {
+            // Parêntese que fecha a assume (comentário no fim da linha fica de fora)
+            size_t fecha = as + 15;
+            for (int nivel = 0; fecha < linha.size(); fecha++) {
+                if (linha[fecha] == '(') {
+                    nivel++;
+                } else if (linha[fecha] == ')') {
+                    if (nivel == 0) {
+                        break;
+                    }
+                    nivel--;
+                }
+            }
+
+            const std::string corpo = fecha < linha.size() ? linha.substr(as + 15, fecha - as - 15) : "";
+            size_t ini = 0;
+
+            while (!corpo.empty() && ini <= corpo.size()) {
+                size_t fim = corpo.find("&&", ini);
+                fim = fim == std::string::npos ? corpo.size() : fim;
+                const std::string c = corpo.substr(ini, fim - ini);
+                ini = fim + 2;
+
+                size_t q = c.find_first_not_of(' ');
+                if (q == std::string::npos || !intervaloIdent(c[q]) || isdigit((unsigned char)c[q])) {
+                    continue;
+                }
+
+                size_t fim_v = q;
+                while (fim_v < c.size() && intervaloIdent(c[fim_v])) {
+                    fim_v++;
+                }
+                const std::string v = c.substr(q, fim_v - q);
+
+                // Campos (x.len, p->len) ficam de fora: chamadas podem alterá-los via ponteiro
+                size_t o = c.find_first_not_of(' ', fim_v);
+                if (o == std::string::npos || c[o] == '.' || c.compare(o, 2, "->") == 0) {
+                    continue;
+                }
+
+                size_t fim_o = o;
+                while (fim_o < c.size() && fim_o - o < 3 && std::string("<>=!").find(c[fim_o]) != std::string::npos) {
+                    fim_o++;
+                }
+
+                const std::string op = c.substr(o, fim_o - o);
+                if (op != "<" && op != "<=" && op != ">" && op != ">=" && op != "==") {
+                    continue;
+                }
+
+                f->restricoes.push_back({escopo, v, num, blocos.back(), op, c.substr(fim_o)});
+            }
+        }
+
+        // v = NONDET_ESTREITO_U(tipo, largo, max) / _S(tipo, largo, min, max):
+        // a macro assume a faixa; mesmas condições da assume acima
+        const size_t ne = linha.find("NONDET_ESTREITO_");
+        const size_t igual = linha.find('=');
+
+        if (ne != std::string::npos && ne + 18 <= linha.size() && linha[ne + 17] == '(' &&
+            (linha[ne + 16] == 'U' || linha[ne + 16] == 'S') && igual != std::string::npos && igual < ne &&
+            linha.find_first_of("{}") == std::string::npos && !condicional && !blocos.empty()) {
+            // Argumentos em nível 0 de parênteses
+            std::vector<std::string> args(1);
+            size_t fecha = ne + 18;
+            for (int nivel = 0; fecha < linha.size(); fecha++) {
+                const char c = linha[fecha];
+                if (c == ')' && nivel == 0) {
+                    break;
+                }
+                nivel += c == '(' ? 1 : c == ')' ? -1 : 0;
+                if (c == ',' && nivel == 0) {
+                    args.emplace_back();
+                } else {
+                    args.back() += c;
+                }
+            }
+
+            size_t fim_v = igual;
+            while (fim_v > 0 && linha[fim_v - 1] == ' ') {
+                fim_v--;
+            }
+            size_t ini_v = fim_v;
+            while (ini_v > 0 && intervaloIdent(linha[ini_v - 1])) {
+                ini_v--;
+            }
+
+            const bool com_sinal = linha[ne + 16] == 'S';
+            if (fecha < linha.size() && fim_v > ini_v && args.size() == (com_sinal ? 4u : 3u)) {
+                const std::string v = linha.substr(ini_v, fim_v - ini_v);
+                if (com_sinal) {
+                    f->restricoes.push_back({escopo, v, num, blocos.back(), ">=", args[2]});
+                }
+                f->restricoes.push_back({escopo, v, num, blocos.back(), "<=", args.back()});
+            }
+        }
+
+        const std::string codigo = linha.substr(0, linha.find("//"));
+        const size_t conteudo = codigo.find_first_not_of(" \t");
+        if (conteudo != std::string::npos) {
+            anterior = codigo.substr(conteudo, codigo.find_last_not_of(" \t") + 1 - conteudo);
+        }
+    }
+}
+
+// ================== AVALIAÇÃO ==================
+
+struct avaliador_t {
+    const fonte_intervalos_t *f;
+    std::string funcao;
+    int linha;
+    std::string s;
+    size_t i;
+    bool ok;
+};
+
+inline void intervalosEspacos(avaliador_t *a) {
+    while (a->i < a->s.size() && a->s[a->i] == ' ') {
+        a->i++;
+    }
+}
+
+inline intervalo_t intervaloDoTipo(const tipo_int_t &t) { return {t.lo, t.hi, true}; }
+
+inline intervalo_t intervaloConverter(const intervalo_t &v, const tipo_int_t &t) {
+    if (v.lo >= t.lo && v.hi <= t.hi) {
+        return v;
+    }
+    return intervaloDoTipo(t);      // Conversão com perda: qualquer valor do tipo
+}
+
+// Promoção inteira: o que cabe em int vira int
+inline tipo_int_t intervalosPromover(const tipo_int_t &t) {
+    tipo_int_t r = t;
+    if (!t.nome.empty() && t.lo >= INT32_MIN && t.hi <= INT32_MAX) {
+        tipoInteiro("int", &r);
+    }
+    return r;
+}
+
+/**
+ * Tipo da operação pelas conversões aritméticas usuais: promove os dois;
+ * o mais largo vence e, na mesma largura, o sem sinal. Vazio se algum
+ * lado não tem tipo conhecido.
+ */
+inline tipo_int_t intervalosTipoComum(const tipo_int_t &x, const tipo_int_t &y) {
+    if (x.nome.empty() || y.nome.empty()) {
+        return {"", 0, 0};
+    }
+
+    const tipo_int_t px = intervalosPromover(x), py = intervalosPromover(y);
+    const intervalo_int_t lx = px.hi - px.lo, ly = py.hi - py.lo;
+
+    if (lx != ly) {
+        return lx > ly ? px : py;
+    }
+    return px.lo == 0 ? px : py;
+}
+
+/**
+ * Tipo do literal inteiro como em C: sem sufixo, int/long (e, em hexa ou
+ * octal, unsigned int/unsigned long no caminho); 'u', 'l' e 'ul' restringem
+ * a lista de candidatos ao sinal e à largura pedidos.
+ */
+inline void intervalosTipoLiteral(unsigned long long k, bool sem_sinal, bool longo, bool decimal, tipo_int_t *t) {
+    const char *candidatos[4] = {"int", "unsigned int", "long int", "unsigned long int"};
+
+    for (int c = longo ? 2 : 0; c < 4; c++) {
+        const bool cand_sem_sinal = c % 2 == 1;
+        if ((sem_sinal && !cand_sem_sinal) || (!sem_sinal && decimal && cand_sem_sinal && c < 3)) {
+            continue;
+        }
+
+        tipoInteiro(candidatos[c], t);
+        if ((intervalo_int_t)k <= t->hi) {
+            return;
+        }
+    }
+
+    tipoInteiro("unsigned long int", t);
+}
+
+inline intervalo_t intervalosExpressao(avaliador_t *a, int precedencia_min, tipo_int_t *tipo = nullptr);
+
+/**
+ * FUNÇÃO 2: intervaloDaVariavel()
+ * ESPECIFICAÇÃO: Tipo declarado (local/parâmetro da função do claim ou,
+ * para acesso a membro, campo de struct; depois o outro escopo),
+ * refinado pelas assumes anteriores ao claim cujo bloco ainda está aberto
+ * no claim, quando a variável não é reatribuída entre a assume e o claim.
+ * Restrições são do caminho inteiro (p->len não herda a de len); o lado
+ * direito que não é avaliado até o fim não restringe nada.
+ */
+inline intervalo_t intervaloDaVariavel(const avaliador_t *a, const std::string &nome, const std::string &caminho,
+                                       bool membro, tipo_int_t *tipo) {
+    // p->len é o campo, não o parâmetro len da mesma função
+    auto it = a->f->simbolos.find({membro ? "" : a->funcao, nome});
+    if (it == a->f->simbolos.end()) {
+        it = a->f->simbolos.find({membro ? a->funcao : "", nome});
+    }
+
+    if (it == a->f->simbolos.end() || !tipoInteiro(it->second, tipo)) {
+        return {0, 0, false};
+    }
+
+    intervalo_t r = intervaloDoTipo(*tipo);
+    const auto atr = a->f->atribuicoes.find(a->funcao + "|" + caminho);
+
+    for (const restricao_t &c : a->f->restricoes) {
+        if (c.funcao != a->funcao || c.variavel != caminho || c.linha >= a->linha ||
+            a->linha >= a->f->fim_bloco[c.bloco]) {
+            continue;
+        }
+
+        bool reatribuida = false;
+        if (atr != a->f->atribuicoes.end()) {
+            for (int l : atr->second) {
+                reatribuida = reatribuida || (l > c.linha && l <= a->linha);
+            }
+        }
+
+        if (reatribuida) {
+            continue;
+        }
+
+        // Lado direito na linha da assume: usa só o que valia antes dela
+        avaliador_t d = {a->f, a->funcao, c.linha, c.direita, 0, true};
+        const intervalo_t k = intervalosExpressao(&d, 0);
+        intervalosEspacos(&d);
+
+        if (!d.ok || !k.valido || d.i != d.s.size()) {
+            continue;
+        }
+
+        if (c.op == "<") {
+            r.hi = std::min(r.hi, k.hi - 1);
+        } else if (c.op == "<=") {
+            r.hi = std::min(r.hi, k.hi);
+        } else if (c.op == ">") {
+            r.lo = std::max(r.lo, k.lo + 1);
+        } else if (c.op == ">=") {
+            r.lo = std::max(r.lo, k.lo);
+        } else {
+            r.lo = std::max(r.lo, k.lo);
+            r.hi = std::min(r.hi, k.hi);
+        }
+    }
+
+    return r.lo <= r.hi ? r : intervalo_t{0, 0, false};
+}
+
+inline intervalo_t intervalosPrimario(avaliador_t *a, tipo_int_t *tipo) {
+    intervalosEspacos(a);
+    tipo->nome.clear();
+
+    if (a->i >= a->s.size()) {
+        a->ok = false;
+        return {0, 0, false};
+    }
+
+    // Conversão "(tipo)expr" ou parênteses
+    if (a->s[a->i] == '(') {
+        const size_t fecha = a->s.find(')', a->i);
+        tipo_int_t t;
+
+        if (fecha != std::string::npos && tipoInteiro(a->s.substr(a->i + 1, fecha - a->i - 1), &t)) {
+            a->i = fecha + 1;
+            tipo_int_t interno;
+            const intervalo_t v = intervalosPrimario(a, &interno);
+            *tipo = t;
+            return v.valido ? intervaloConverter(v, t) : intervaloDoTipo(t);
+        }
+
+        a->i++;
+        const intervalo_t v = intervalosExpressao(a, 0, tipo);
+        intervalosEspacos(a);
+        a->ok = a->ok && a->i < a->s.size() && a->s[a->i] == ')';
+        a->i++;
+        return v;
+    }
+
+    if (a->s[a->i] == '-') {
+        a->i++;
+        const intervalo_t v = intervalosPrimario(a, tipo);
+        *tipo = intervalosPromover(*tipo);
+        return {-v.hi, -v.lo, v.valido};
+    }
+
+    if (isdigit((unsigned char)a->s[a->i])) {
+        char *fim = nullptr;
+        const bool decimal = a->s[a->i] != '0' || a->i + 1 >= a->s.size() || !isalnum((unsigned char)a->s[a->i + 1]);
+        const unsigned long long k = strtoull(a->s.c_str() + a->i, &fim, 0);
+        bool sem_sinal = false, longo = false;
+
+        a->i = fim - a->s.c_str();
+        while (a->i < a->s.size() && (a->s[a->i] == 'u' || a->s[a->i] == 'U' || a->s[a->i] == 'l' ||
+                                      a->s[a->i] == 'L')) {
+            sem_sinal = sem_sinal || a->s[a->i] == 'u' || a->s[a->i] == 'U';
+            longo = longo || a->s[a->i] == 'l' || a->s[a->i] == 'L';
+            a->i++;
+        }
+
+        intervalosTipoLiteral(k, sem_sinal, longo, decimal, tipo);
+        return {(intervalo_int_t)k, (intervalo_int_t)k, true};
+    }
+
+    if (intervaloIdent(a->s[a->i])) {
+        // a->b.c: tipo do último componente (campos são únicos nos harnesses)
+        std::string nome;
+        bool membro = false;
+        const size_t inicio = a->i;
+        for (;;) {
+            const size_t ini = a->i;
+            while (a->i < a->s.size() && intervaloIdent(a->s[a->i])) {
+                a->i++;
+            }
+            nome = a->s.substr(ini, a->i - ini);
+
+            if (a->s.compare(a->i, 2, "->") == 0) {
+                a->i += 2;
+                membro = true;
+            } else if (a->s.compare(a->i, 1, ".") == 0) {
+                a->i += 1;
+                membro = true;
+            } else {
+                break;
+            }
+        }
+
+        const auto cst = a->f->constantes.find(nome);
+        if (!membro && cst != a->f->constantes.end()) {
+            tipoInteiro("int", tipo);
+            return {cst->second, cst->second, true};
+        }
+
+        const intervalo_t v = intervaloDaVariavel(a, nome, a->s.substr(inicio, a->i - inicio), membro, tipo);
+        a->ok = a->ok && v.valido;
+        return v;
+    }
+
+    a->ok = false;
+    return {0, 0, false};
+}
+
+inline intervalo_t intervalosBinario(const std::string &op, const intervalo_t &x, const intervalo_t &y, bool *ok) {
+    if (!x.valido || !y.valido || std::max(x.hi, -x.lo) > INTERVALO_LIMITE ||
+        std::max(y.hi, -y.lo) > INTERVALO_LIMITE) {
+        *ok = false;
+        return {0, 0, false};
+    }
+
+    if (op == "+") {
+        return {x.lo + y.lo, x.hi + y.hi, true};
+    }
+    if (op == "-") {
+        return {x.lo - y.hi, x.hi - y.lo, true};
+    }
+    if (op == "*") {
+        // Produto acima de INTERVALO_LIMITE: recusa em vez de estourar o __int128
+        const intervalo_int_t mx = std::max(std::max(x.hi, -x.lo), (intervalo_int_t)1);
+        const intervalo_int_t my = std::max(y.hi, -y.lo);
+        if (my > INTERVALO_LIMITE / mx) {
+            *ok = false;
+            return {0, 0, false};
+        }
+        const intervalo_int_t p[4] = {x.lo * y.lo, x.lo * y.hi, x.hi * y.lo, x.hi * y.hi};
+        return {*std::min_element(p, p + 4), *std::max_element(p, p + 4), true};
+    }
+    if ((op == "shl" || op == "<<") && x.lo >= 0 && y.lo >= 0 && y.hi < 64 &&
+        x.hi <= (INTERVALO_LIMITE >> (int)y.hi)) {
+        return {x.lo << (int)y.lo, x.hi << (int)y.hi, true};
+    }
+    if (op == ">>" && x.lo >= 0 && y.lo >= 0 && y.hi < 64) {
+        return {x.lo >> (int)y.hi, x.hi >> (int)y.lo, true};
+    }
+    if (op == "/" && y.lo > 0) {
+        const intervalo_int_t p[4] = {x.lo / y.lo, x.lo / y.hi, x.hi / y.lo, x.hi / y.hi};
+        return {*std::min_element(p, p + 4), *std::max_element(p, p + 4), true};
+    }
+    if (op == "&" && (x.lo >= 0 || y.lo >= 0)) {
+        const intervalo_int_t teto = x.lo >= 0 && y.lo >= 0 ? std::min(x.hi, y.hi) : (x.lo >= 0 ? x.hi : y.hi);
+        return {0, teto, true};
+    }
+    if (op == "|" && x.lo >= 0 && y.lo >= 0) {
+        intervalo_int_t teto = 1;
+        while (teto <= std::max(x.hi, y.hi)) {
+            teto <<= 1;
+        }
+        return {std::max(x.lo, y.lo), teto - 1, true};
+    }
+
+    *ok = false;
+    return {0, 0, false};
+}
+
+inline int intervalosPrecedencia(const std::string &op) {
+    if (op == "|") return 1;
+    if (op == "^") return 2;
+    if (op == "&") return 3;
+    if (op == "<<" || op == ">>") return 4;
+    if (op == "+" || op == "-") return 5;
+    if (op == "*" || op == "/" || op == "%") return 6;
+    return -1;
+}
+
+inline intervalo_t intervalosExpressao(avaliador_t *a, int precedencia_min, tipo_int_t *tipo_saida) {
+    tipo_int_t tipo;
+    intervalo_t esq = intervalosPrimario(a, &tipo);
+
+    for (;;) {
+        intervalosEspacos(a);
+        if (a->i >= a->s.size()) {
+            break;
+        }
+
+        std::string op = a->s.substr(a->i, 2);
+        if (op != "<<" && op != ">>") {
+            op = a->s.substr(a->i, 1);
+        }
+
+        const int p = intervalosPrecedencia(op);
+        if (p < 0 || p < precedencia_min) {
+            break;
+        }
+
+        a->i += op.size();
+        tipo_int_t tipo_dir;
+        const intervalo_t dir = intervalosExpressao(a, p + 1, &tipo_dir);
+        esq = intervalosBinario(op, esq, dir, &a->ok);
+
+        // Deslocamento tem o tipo do operando esquerdo; fora do tipo, o valor real dá a volta
+        tipo = op == "<<" || op == ">>" ? intervalosPromover(tipo) : intervalosTipoComum(tipo, tipo_dir);
+        if (esq.valido && !tipo.nome.empty() && (esq.lo < tipo.lo || esq.hi > tipo.hi)) {
+            esq = intervaloDoTipo(tipo);
+        }
+    }
+
+    if (tipo_saida) {
+        *tipo_saida = tipo;
+    }
+    return esq;
+}
+
+// Próximo operando de uma lista separada por vírgulas em nível 0
+inline std::string intervalosOperando(const std::string &s, size_t *i) {
+    int prof = 0;
+    const size_t ini = *i;
+
+    for (; *i < s.size(); (*i)++) {
+        const char c = s[*i];
+        if (c == '(') {
+            prof++;
+        } else if (c == ')') {
+            if (prof == 0) {
+                break;
+            }
+            prof--;
+        } else if (c == ',' && prof == 0) {
+            break;
+        }
+    }
+
+    const std::string r = s.substr(ini, *i - ini);
+    (*i)++;
+    return r;
+}
+
+/**
+ * FUNÇÃO 3: intervalosDescartavel()
+ * ESPECIFICAÇÃO: true se a expressão do claim é !overflow("op", a, b) e o
+ * intervalo exato de a op b (em precisão de 128 bits) cabe no tipo da
+ * operação: o tipo comum dos dois lados pelas conversões aritméticas
+ * usuais (literais tipados pelo sufixo), ou o de 'a' promovido em shl.
+ */
+inline bool intervalosDescartavel(const fonte_intervalos_t &f, const std::string &funcao, int linha,
+                                  const std::string &expressao, std::string *motivo) {
+    const size_t p = expressao.find("!overflow(\"");
+    if (p == std::string::npos) {
+        *motivo = "forma nao suportada";
+        return false;
+    }
+
+    const size_t aspas = expressao.find('"', p + 11);
+    const std::string op = expressao.substr(p + 11, aspas - p - 11);
+    size_t i = expressao.find(',', aspas) + 1;
+    const std::string txt_a = intervalosOperando(expressao, &i);
+    const std::string txt_b = intervalosOperando(expressao, &i);
+
+    avaliador_t a = {&f, funcao, linha, txt_a, 0, true};
+    tipo_int_t tipo_a;
+    const intervalo_t va = intervalosExpressao(&a, 0, &tipo_a);
+
+    avaliador_t b = {&f, funcao, linha, txt_b, 0, true};
+    tipo_int_t tipo_b;
+    const intervalo_t vb = intervalosExpressao(&b, 0, &tipo_b);
+
+    // Tipo da operação: conversões usuais dos dois lados (200u - x é unsigned int, não int)
+    const tipo_int_t tipo_op = op == "shl" || op == "<<" || op == ">>" ? intervalosPromover(tipo_a)
+                                                                       : intervalosTipoComum(tipo_a, tipo_b);
+
+    if (!a.ok || !b.ok || tipo_op.nome.empty()) {
+        *motivo = "operando desconhecido";
+        return false;
+    }
+
+    bool ok = true;
+    const intervalo_t r = intervalosBinario(op, va, vb, &ok);
+
+    if (!ok) {
+        *motivo = "operador " + op;
+        return false;
+    }
+
+    if (r.lo < tipo_op.lo || r.hi > tipo_op.hi) {
+        *motivo = "intervalo excede " + tipo_op.nome;
+        return false;
+    }
+
+    *motivo = "cabe em " + tipo_op.nome;
+    return true;
+}
+
+/**
+ * FUNÇÃO 4: intervalosAutoteste()
+ * ESPECIFICAÇÃO: confere intervalosDescartavel() contra claims de veredito
+ * conhecido sobre uma fonte mínima; devolve o número de divergências.
+ * USO: esbmc_runner --autoteste-intervalos
+ */
+inline int intervalosAutoteste() {
+    static const char *fonte =
+        "struct dump_t {\n"
+        "    uint8_t len;\n"
+        "};\n"
+        "void f(struct dump_t *dump_data, uint8_t instance, int32_t n) {\n"
+        "    __ESBMC_assume(n >= 0);\n"
+        "    __ESBMC_assume(n <= 100);\n"
+        "    size_t m = NONDET_ESTREITO_U(size_t, nondet_size_t(), 300);\n"
+        "    x = 0;\n"
+        "}\n";
+
+    static const struct {
+        const char *claim;
+        bool descartavel;
+    } casos[] = {
+        {"!overflow(\"-\", 200, (signed int)dump_data->len)", true},
+        {"!overflow(\"-\", 200u, (unsigned int)dump_data->len)", false},    // Dá a volta com len > 200
+        {"!overflow(\"-\", 0u, (unsigned int)instance)", false},
+        {"!overflow(\"-\", 0, (signed int)instance)", true},
+        {"!overflow(\"+\", 255u, (unsigned int)instance)", true},
+        {"!overflow(\"-\", (unsigned int)n, 1u)", false},                    // n = 0 dá a volta
+        {"!overflow(\"-\", n, 1)", true},
+        {"!overflow(\"*\", 0xFFFFFF, (signed int)instance)", false},         // Hexa cabe em int, produto não
+        {"!overflow(\"+\", 4294967295, 1)", true},                          // Decimal sem sufixo: long int
+        {"!overflow(\"+\", 0xFFFFFFFF, 1)", false},                         // Hexa sem sufixo: unsigned int
+        {"!overflow(\"shl\", (signed int)instance, 23)", true},
+        {"!overflow(\"shl\", (signed int)instance, 24)", false},
+        {"!overflow(\"+\", m, 1)", true},                                    // Faixa da macro: m <= 300
+        {"!overflow(\"*\", m, m)", true},
+    };
+
+    fonte_intervalos_t f;
+    intervalosLerFonte(fonte, &f);
+
+    int falhas = 0;
+    for (const auto &c : casos) {
+        std::string motivo;
+        const bool obtido = intervalosDescartavel(f, "f", 8, c.claim, &motivo);
+        if (obtido != c.descartavel) {
+            printf("FALHA %s: esperado %s, obtido %s (%s)\n", c.claim, c.descartavel ? "descartado" : "incerto",
+                   obtido ? "descartado" : "incerto", motivo.c_str());
+            falhas++;
+        }
+    }
+
+    return falhas;
+}
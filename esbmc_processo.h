@@ -0,0 +1,190 @@
+/**
+ * @file esbmc_processo.h
+ * @author Dissertação Mestrado - Verificação Formal PX4 v1.16
+ *
+ * OBJETIVO: Execução de processos verificadores (ESBMC, solvers, binários
+ *           nativos) com log em arquivo, timeout e cancelamento
+ * USO: esbmc_runner.cpp, smt_bench.cpp
+ *
+ * Cada filho roda em grupo de processos próprio: matar o grupo derruba
+ * também os solvers que o ESBMC tenha lançado.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+struct processo_t {
+    int status;            // Código de saída (-1 se morto por sinal/timeout)
+    int sinal;             // Sinal que terminou o processo (0 = saída normal)
+    bool timeout;
+    double tempo_s;
+};
+
+inline bool lerArquivo(const std::string &caminho, std::string *conteudo) {
+    std::ifstream in(caminho, std::ios::binary);
+
+    if (!in) {
+        return false;
+    }
+
+    std::ostringstream ss;
+    ss << in.rdbuf();
+    *conteudo = ss.str();
+    return true;
+}
+
+// mkdir -p; true se no fim o caminho é um diretório
+inline bool criarDiretorios(const std::string &caminho) {
+    for (size_t i = 1; i <= caminho.size(); i++) {
+        if (i == caminho.size() || caminho[i] == '/') {
+            mkdir(caminho.substr(0, i).c_str(), 0755);
+        }
+    }
+
+    struct stat st;
+    return stat(caminho.c_str(), &st) == 0 && S_ISDIR(st.st_mode);
+}
+
+/**
+ * FUNÇÃO 1: iniciarProcesso()
+ * ESPECIFICAÇÃO: fork/exec com stdout+stderr no arquivo de log, em grupo
+ * de processos próprio. Retorna o pid (-1 em erro).
+ */
+inline pid_t iniciarProcesso(const std::vector<std::string> &args, const std::string &log) {
+    const pid_t pid = fork();
+
+    if (pid < 0) {
+        perror("fork");
+        return -1;
+    }
+
+    if (pid == 0) {
+        setpgid(0, 0);
+
+        const int fd = open(log.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd >= 0) {
+            dup2(fd, STDOUT_FILENO);
+            dup2(fd, STDERR_FILENO);
+            close(fd);
+        }
+
+        std::vector<char *> argv;
+        for (const std::string &a : args) {
+            argv.push_back(const_cast<char *>(a.c_str()));
+        }
+        argv.push_back(nullptr);
+
+        execvp(argv[0], argv.data());
+        fprintf(stderr, "exec %s: %s\n", argv[0], strerror(errno));
+        _exit(127);
+    }
+
+    setpgid(pid, pid);
+    return pid;
+}
+
+inline void preencherStatus(processo_t *r, int status) {
+    r->status = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+    r->sinal = WIFSIGNALED(status) ? WTERMSIG(status) : 0;
+}
+
+/**
+ * FUNÇÃO 2: processoTerminou()
+ * ESPECIFICAÇÃO: Consulta não bloqueante; preenche status/sinal quando o
+ * processo já terminou.
+ */
+inline bool processoTerminou(pid_t pid, processo_t *r) {
+    int status = 0;
+
+    if (waitpid(pid, &status, WNOHANG) != pid) {
+        return false;
+    }
+
+    preencherStatus(r, status);
+    return true;
+}
+
+inline void cancelarProcesso(pid_t pid) {
+    int status = 0;
+    kill(-pid, SIGKILL);
+    waitpid(pid, &status, 0);
+}
+
+inline void esperarUmPouco() {
+    const struct timespec espera = {0, 5 * 1000 * 1000};
+    nanosleep(&espera, nullptr);
+}
+
+/**
+ * FUNÇÃO 3: executarProcesso()
+ * ESPECIFICAÇÃO: Executar até terminar ou até timeout_s (0 = sem limite);
+ * no timeout o grupo inteiro é morto.
+ */
+inline processo_t executarProcesso(const std::vector<std::string> &args, double timeout_s, const std::string &log) {
+    processo_t r = {-1, 0, false, 0.0};
+    const auto inicio = std::chrono::steady_clock::now();
+    const pid_t pid = iniciarProcesso(args, log);
+
+    if (pid < 0) {
+        return r;
+    }
+
+    while (!processoTerminou(pid, &r)) {
+        r.tempo_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+
+        if (timeout_s > 0 && r.tempo_s > timeout_s) {
+            cancelarProcesso(pid);
+            r.timeout = true;
+            break;
+        }
+
+        esperarUmPouco();
+    }
+
+    r.tempo_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+    return r;
+}
+
+inline std::string saidaDeComando(const std::vector<std::string> &args, const std::string &tmp) {
+    executarProcesso(args, 30.0, tmp);
+    std::string s;
+    lerArquivo(tmp, &s);
+    unlink(tmp.c_str());
+    return s;
+}
+
+// Índices 0..n-1 distribuídos dinamicamente entre 'workers' threads
+inline void paraCada(size_t n, int workers, const std::function<void(size_t)> &fn) {
+    std::atomic<size_t> proximo(0);
+    std::vector<std::thread> threads;
+
+    for (int w = 0; w < workers; w++) {
+        threads.emplace_back([&]() {
+            for (size_t i = proximo.fetch_add(1); i < n; i = proximo.fetch_add(1)) {
+                fn(i);
+            }
+        });
+    }
+
+    for (std::thread &t : threads) {
+        t.join();
+    }
+}
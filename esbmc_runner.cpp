@@ -0,0 +1,1414 @@
+/**
+ * @file esbmc_runner.cpp
+ * @author Dissertação Mestrado - Verificação Formal PX4 v1.16
+ *
+ * OBJETIVO: Executar os testes dos harnesses como jobs ESBMC independentes
+ *           sem repetir o front end (parse + conversão GOTO) em cada job
+ * MÉTODO: 1. px4_funcoes.cpp + harnesses (-DPX4_BIBLIOTECA) convertidos uma
+ *            única vez para um programa GOTO (--output-goto), guardado em
+ *            cache pelo hash FNV-1a das fontes, flags e versão do ESBMC
+ *         2. Cada test_* é dividido nos seus claims (--show-claims) e cada
+ *            claim vira um job: esbmc --binary <goto> --function test_* --claim N
+ *         3. Custo de cada claim previsto pelo histórico (esbmc_custo.h) e
+ *            jobs despachados do mais caro para o mais barato entre workers
+ *         4. Alternativa --portfolio: por teste, BMC incremental, k-indução
+ *            e falsificação nativa disputam; o primeiro veredito vence
+ *         5. --refinar-fp: claims de float tentam --ir/--fixedbv antes do
+ *            float32 completo
+ *
+ * SAÍDA: TSV com uma linha por job (harness, teste, claim, função, linha,
+ *        propriedade, estratégia, veredito, tempo, previsto) e o log
+ *        completo de cada execução em <cache>/logs/<hash>/
+ *
+ * Ferramenta nativa (não é alvo de verificação):
+ * g++ -O2 -std=c++17 -pthread esbmc_runner.cpp -o esbmc_runner
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "esbmc_custo.h"
+#include "esbmc_fila.h"
+#include "esbmc_intervalos.h"
+#include "esbmc_processo.h"
+
+// ================== CONFIGURAÇÃO ==================
+
+struct config_t {
+    std::string esbmc = "esbmc";
+    std::string cache = ".esbmc_cache";
+    std::string biblioteca = "px4_funcoes.cpp";
+    std::vector<std::string> harnesses;
+    std::vector<std::string> flags_front;      // Afetam o GOTO (-D, -I, ...)
+    std::vector<std::string> flags_verif;      // Só afetam a verificação
+    std::string saida = "resultados.tsv";
+    std::string filtro;
+    int workers = 0;
+    double timeout_s = 900.0;
+    bool por_claim = true;
+    bool portfolio = false;
+    int max_k = 50;                            // --max-k-step das estratégias incrementais
+    std::string falsificador = "falsificador.cpp";
+    std::vector<std::string> niveis_fp;        // Abstrações tentadas antes do float32 (ir, fixedbv)
+    double timeout_abstrato_s = 60.0;
+    std::string dir_smt;                       // --exportar-smt: só gera as consultas
+    std::vector<std::string> prioridades;      // Testes que contêm estes textos vão na frente
+    bool do_zero = false;                      // Descartar o diário da fila e refazer tudo
+    bool intervalos = false;                   // Descartar claims de overflow provados por intervalos
+};
+
+struct job_t {
+    std::string harness;
+    std::string teste;
+
+    // Claim (0 = teste inteiro, sem --claim)
+    int claim;
+    std::string arquivo;
+    int linha;
+    std::string funcao;
+    std::string propriedade;
+    std::string expressao;         // Condição do claim, ex.: !overflow("-", 200, (signed int)p->len)
+    std::string chave;             // funcao:linha:propriedade
+    claim_features_t features;
+    double previsto_s;
+
+    // Resultado
+    std::string estrategia;
+    std::string veredito;
+    double tempo_s;
+    std::string log;
+};
+
+// ================== HASH DAS FONTES ==================
+
+static uint64_t fnv1a(const void *dados, size_t n, uint64_t h = 1469598103934665603ULL) {
+    const uint8_t *p = (const uint8_t *)dados;
+
+    for (size_t i = 0; i < n; i++) {
+        h ^= p[i];
+        h *= 1099511628211ULL;
+    }
+
+    return h;
+}
+
+static std::string diretorioDe(const std::string &caminho) {
+    const size_t barra = caminho.rfind('/');
+    return barra == std::string::npos ? "" : caminho.substr(0, barra + 1);
+}
+
+/**
+ * FUNÇÃO 1: hashFontes()
+ * ESPECIFICAÇÃO: Hash de um arquivo e, recursivamente, dos #include "..."
+ * locais que ele usa (px4_funcoes.h, ulog_formato.h, ...), procurados
+ * como o front end: ao lado de quem inclui, depois nos -I. Cada arquivo
+ * entra uma vez só.
+ */
+static uint64_t hashFontes(const std::string &caminho, uint64_t h, std::vector<std::string> *vistos,
+                           const std::vector<std::string> &flags_front) {
+    for (const std::string &v : *vistos) {
+        if (v == caminho) {
+            return h;
+        }
+    }
+
+    vistos->push_back(caminho);
+
+    std::string conteudo;
+    if (!lerArquivo(caminho, &conteudo)) {
+        return fnv1a(caminho.data(), caminho.size(), h);
+    }
+
+    h = fnv1a(caminho.data(), caminho.size(), h);
+    h = fnv1a(conteudo.data(), conteudo.size(), h);
+
+    std::istringstream linhas(conteudo);
+    std::string linha;
+
+    while (std::getline(linhas, linha)) {
+        const size_t inc = linha.find("#include \"");
+
+        if (inc != std::string::npos) {
+            const size_t ini = inc + 10;
+            const size_t fim = linha.find('"', ini);
+
+            if (fim != std::string::npos) {
+                const std::string nome = linha.substr(ini, fim - ini);
+                std::string incluido = diretorioDe(caminho) + nome;
+                struct stat st;
+
+                for (size_t k = 0; k < flags_front.size() && stat(incluido.c_str(), &st) != 0; k++) {
+                    if (flags_front[k].compare(0, 2, "-I") == 0 && flags_front[k].size() > 2) {
+                        const std::string candidato = flags_front[k].substr(2) + "/" + nome;
+                        if (stat(candidato.c_str(), &st) == 0) {
+                            incluido = candidato;
+                        }
+                    }
+                }
+
+                h = hashFontes(incluido, h, vistos, flags_front);
+            }
+        }
+    }
+
+    return h;
+}
+
+// ================== PROGRAMA GOTO EM CACHE ==================
+
+/**
+ * FUNÇÃO 2: garantirGoto()
+ * ESPECIFICAÇÃO: Devolver o caminho do programa GOTO da biblioteca +
+ * harnesses, convertendo só quando a chave (fontes, flags de front end,
+ * versão do ESBMC) mudou. A escrita é atômica (tmp + rename) para que
+ * execuções concorrentes nunca leiam um GOTO pela metade.
+ */
+static bool garantirGoto(const config_t &cfg, std::string *goto_path, std::string *chave, double *tempo_front) {
+    criarDiretorios(cfg.cache);
+
+    const std::string versao = saidaDeComando({cfg.esbmc, "--version"}, cfg.cache + "/versao.tmp");
+
+    std::vector<std::string> vistos;
+    uint64_t h = fnv1a(versao.data(), versao.size());
+    h = hashFontes(cfg.biblioteca, h, &vistos, cfg.flags_front);
+
+    for (const std::string &f : cfg.harnesses) {
+        h = hashFontes(f, h, &vistos, cfg.flags_front);
+    }
+
+    for (const std::string &f : cfg.flags_front) {
+        h = fnv1a(f.data(), f.size() + 1, h);
+    }
+
+    char hex[17];
+    snprintf(hex, sizeof(hex), "%016llx", (unsigned long long)h);
+    *chave = hex;
+    *goto_path = cfg.cache + "/px4_" + *chave + ".goto";
+    *tempo_front = 0.0;
+
+    struct stat st;
+    if (stat(goto_path->c_str(), &st) == 0 && st.st_size > 0) {
+        return true;
+    }
+
+    const std::string tmp = *goto_path + ".tmp." + std::to_string(getpid());
+    std::vector<std::string> args = {cfg.esbmc, cfg.biblioteca};
+    args.insert(args.end(), cfg.harnesses.begin(), cfg.harnesses.end());
+    args.push_back("-DPX4_BIBLIOTECA");
+    args.insert(args.end(), cfg.flags_front.begin(), cfg.flags_front.end());
+    args.push_back("--output-goto");
+    args.push_back(tmp);
+
+    const std::string log = cfg.cache + "/front_" + *chave + ".log";
+    const processo_t p = executarProcesso(args, 0.0, log);
+    *tempo_front = p.tempo_s;
+
+    if (p.status != 0 || stat(tmp.c_str(), &st) != 0) {
+        fprintf(stderr, "front end falhou (status %d), ver %s\n", p.status, log.c_str());
+        unlink(tmp.c_str());
+        return false;
+    }
+
+    return rename(tmp.c_str(), goto_path->c_str()) == 0;
+}
+
+// ================== DESCOBERTA DE TESTES ==================
+
+/**
+ * FUNÇÃO 3: descobrirTestes()
+ * ESPECIFICAÇÃO: Cada definição "void test_xxx()" no início de linha é um
+ * ponto de entrada (convenção de todos os harnesses do repositório). O
+ * corpo do teste indica a teoria: "float" no corpo = claims de FP.
+ */
+static std::vector<job_t> descobrirTestes(const config_t &cfg) {
+    std::vector<job_t> jobs;
+
+    for (const std::string &f : cfg.harnesses) {
+        std::string conteudo;
+
+        if (!lerArquivo(f, &conteudo)) {
+            fprintf(stderr, "nao consegui ler %s\n", f.c_str());
+            continue;
+        }
+
+        std::istringstream linhas(conteudo);
+        std::string linha;
+        job_t *atual = nullptr;
+
+        while (std::getline(linhas, linha)) {
+            if (atual) {
+                atual->features.fp = atual->features.fp || linha.find("float") != std::string::npos;
+                atual = (linha.compare(0, 1, "}") == 0) ? nullptr : atual;
+                continue;
+            }
+
+            if (linha.compare(0, 10, "void test_") != 0) {
+                continue;
+            }
+
+            const size_t par = linha.find('(');
+            if (par == std::string::npos) {
+                continue;
+            }
+
+            job_t j = {};
+            j.harness = f;
+            j.teste = linha.substr(5, par - 5);
+            j.chave = j.teste;
+            j.features.classe = "teste";
+            j.features.vcc = -1;
+
+            if (cfg.filtro.empty() || j.teste.find(cfg.filtro) != std::string::npos) {
+                jobs.push_back(j);
+                atual = &jobs.back();
+            }
+        }
+    }
+
+    return jobs;
+}
+
+static int unwindDasFlags(const std::vector<std::string> &flags) {
+    for (size_t i = 0; i + 1 < flags.size(); i++) {
+        if (flags[i] == "--unwind") {
+            return atoi(flags[i + 1].c_str());
+        }
+    }
+
+    return 1;
+}
+
+static std::string nomeBase(const std::string &caminho) {
+    const size_t barra = caminho.rfind('/');
+    return barra == std::string::npos ? caminho : caminho.substr(barra + 1);
+}
+
+// ================== CLAIMS ==================
+
+/**
+ * FUNÇÃO 4: lerClaims()
+ * ESPECIFICAÇÃO: Interpretar a saída de --show-claims:
+ *   Claim 3:
+ *     file gpsdrive.cpp line 71 column 9 function dumpGpsData
+ *     arithmetic overflow on add
+ *     !overflow("+", (signed int)dump_data->len, 1)
+ * Um job por claim, herdando harness/teste/teoria do teste.
+ */
+static std::vector<job_t> lerClaims(const std::string &saida, const job_t &teste) {
+    std::vector<job_t> claims;
+    std::istringstream linhas(saida);
+    std::string linha;
+    bool pendente = false;      // Linha já lida é o "Claim N:" seguinte (claim sem expressão)
+
+    while (pendente || std::getline(linhas, linha)) {
+        int num = 0;
+        pendente = false;
+
+        if (sscanf(linha.c_str(), "Claim %d:", &num) != 1) {
+            continue;
+        }
+
+        std::string local, propriedade, expressao;
+        std::getline(linhas, local);
+        std::getline(linhas, propriedade);
+
+        int prox = 0;
+        if (std::getline(linhas, expressao) && sscanf(expressao.c_str(), "Claim %d:", &prox) == 1) {
+            linha = expressao;
+            expressao.clear();
+            pendente = true;
+        }
+
+        job_t c = teste;
+        c.claim = num;
+        c.propriedade = propriedade.substr(std::min(propriedade.find_first_not_of(' '), propriedade.size()));
+        c.expressao = expressao.substr(std::min(expressao.find_first_not_of(' '), expressao.size()));
+
+        std::istringstream campos(local);
+        std::string chave_campo;
+        while (campos >> chave_campo) {
+            if (chave_campo == "file") {
+                campos >> c.arquivo;
+            } else if (chave_campo == "line") {
+                campos >> c.linha;
+            } else if (chave_campo == "function") {
+                campos >> c.funcao;
+            }
+        }
+
+        claims.push_back(c);
+    }
+
+    return claims;
+}
+
+/**
+ * FUNÇÃO 5: expandirClaims()
+ * ESPECIFICAÇÃO: Trocar cada teste pelos seus claims (--show-claims não faz
+ * execução simbólica, é barato) e calcular as características de custo.
+ * Teste sem claims listados continua como job único.
+ */
+static std::vector<job_t> expandirClaims(const config_t &cfg, const std::string &goto_path, const std::string &dir_logs,
+                                         const std::vector<job_t> &testes) {
+    std::vector<std::vector<job_t>> por_teste(testes.size());
+
+    paraCada(testes.size(), cfg.workers, [&](size_t i) {
+        std::vector<std::string> args = {cfg.esbmc, "--binary", goto_path, "--function", testes[i].teste, "--show-claims"};
+        args.insert(args.end(), cfg.flags_verif.begin(), cfg.flags_verif.end());
+
+        const std::string log = dir_logs + "/" + testes[i].teste + ".claims";
+        executarProcesso(args, 60.0, log);
+
+        std::string saida;
+        lerArquivo(log, &saida);
+        por_teste[i] = lerClaims(saida, testes[i]);
+
+        if (por_teste[i].empty()) {
+            por_teste[i].push_back(testes[i]);
+        }
+    });
+
+    std::map<std::string, std::string> fontes;
+    std::vector<std::string> arquivos = cfg.harnesses;
+    arquivos.push_back(cfg.biblioteca);
+
+    for (const std::string &f : arquivos) {
+        lerArquivo(f, &fontes[nomeBase(f)]);
+    }
+
+    const int unwind = unwindDasFlags(cfg.flags_verif);
+    std::map<std::string, int> repeticoes;
+    std::vector<job_t> jobs;
+
+    for (std::vector<job_t> &lista : por_teste) {
+        for (job_t &j : lista) {
+            if (j.claim > 0) {
+                j.chave = j.funcao + ":" + std::to_string(j.linha) + ":" + j.propriedade;
+                const int n = ++repeticoes[j.teste + "|" + j.chave];
+                j.chave += n > 1 ? "#" + std::to_string(n) : "";
+                j.features.classe = custoClasse(j.propriedade);
+
+                // Claims fora das nossas fontes vêm dos modelos da libc do ESBMC
+                // (memcpy em string.c): laço próprio, profundidade 1
+                const auto fonte = fontes.find(nomeBase(j.arquivo));
+                j.features.profundidade = fonte != fontes.end() ? custoProfundidadeLaco(fonte->second, j.linha) : 1;
+            }
+
+            j.features.unwind = unwind;
+            j.features.vcc = -1;
+            jobs.push_back(j);
+        }
+    }
+
+    return jobs;
+}
+
+/**
+ * FUNÇÃO 6: descartarPorIntervalos()
+ * ESPECIFICAÇÃO: Claims "arithmetic overflow" cuja expressão a análise de
+ * intervalos prova segura (esbmc_intervalos.h) saem da lista com
+ * SUCESSO/estratégia "intervalos" e vão para a lista devolvida; os
+ * incertos seguem para o solver. Tipos de campo e #define vêm também dos
+ * headers incluídos, que valem ainda como fonte de claims próprios.
+ */
+static std::vector<job_t> descartarPorIntervalos(const config_t &cfg, std::vector<job_t> *jobs, int *overflow) {
+    std::map<std::string, fonte_intervalos_t> fontes;
+    std::vector<std::string> arquivos = cfg.harnesses;
+    arquivos.push_back(cfg.biblioteca);
+
+    for (const std::string &a : arquivos) {
+        std::string texto;
+        lerArquivo(a, &texto);
+        fonte_intervalos_t &f = fontes[nomeBase(a)];
+        intervalosLerFonte(texto, &f);
+
+        // Um nível de #include "...": px4_funcoes.h (gps_dump_s), entradas_estreitas.h
+        std::istringstream linhas(texto);
+        std::string linha;
+        while (std::getline(linhas, linha)) {
+            const size_t inc = linha.find("#include \"");
+            if (inc == std::string::npos) {
+                continue;
+            }
+
+            const size_t ini = inc + 10;
+            std::string header;
+            lerArquivo(diretorioDe(a) + linha.substr(ini, linha.find('"', ini) - ini), &header);
+
+            fonte_intervalos_t h;
+            intervalosLerFonte(header, &h);
+            f.simbolos.insert(h.simbolos.begin(), h.simbolos.end());
+            f.constantes.insert(h.constantes.begin(), h.constantes.end());
+
+            // Claims no próprio header (combine em px4_funcoes.h)
+            fontes.insert({nomeBase(linha.substr(ini, linha.find('"', ini) - ini)), h});
+        }
+    }
+
+    std::vector<job_t> restantes, descartados;
+    *overflow = 0;
+
+    for (job_t &j : *jobs) {
+        const auto fonte = fontes.find(nomeBase(j.arquivo));
+        std::string motivo;
+
+        if (j.claim == 0 || j.propriedade.find("overflow") == std::string::npos) {
+            restantes.push_back(j);
+            continue;
+        }
+
+        (*overflow)++;
+        if (fonte == fontes.end() ||
+            !intervalosDescartavel(fonte->second, j.funcao, j.linha, j.expressao, &motivo)) {
+            restantes.push_back(j);
+            continue;
+        }
+
+        j.estrategia = "intervalos";
+        j.veredito = "SUCESSO";
+        j.tempo_s = 0.0;
+        j.log = motivo;
+        descartados.push_back(j);
+    }
+
+    jobs->swap(restantes);
+    return descartados;
+}
+
+// ================== ESCALONAMENTO ==================
+
+// O mesmo claim (ex.: memcpy em string.c) custa diferente em cada teste
+static std::string chaveCusto(const job_t &j) {
+    return j.teste + "|" + j.chave;
+}
+
+/**
+ * FUNÇÃO 7: escalonarLPT()
+ * ESPECIFICAÇÃO: Ordenar pelo custo previsto, maior primeiro. Com a fila
+ * compartilhada, cada worker livre pega o próximo mais caro: é a regra
+ * LPT de Graham (makespan <= 4/3 do ótimo com custos exatos). Retorna o
+ * makespan previsto simulando a fila.
+ */
+static double escalonarLPT(std::vector<job_t> *jobs, const custo_modelo_t &modelo, int workers) {
+    for (job_t &j : *jobs) {
+        j.previsto_s = custoPrever(&modelo, chaveCusto(j), j.features);
+    }
+
+    std::stable_sort(jobs->begin(), jobs->end(), [](const job_t &a, const job_t &b) {
+        return a.previsto_s > b.previsto_s;
+    });
+
+    std::vector<double> livre(std::max(workers, 1), 0.0);
+
+    for (const job_t &j : *jobs) {
+        auto w = std::min_element(livre.begin(), livre.end());
+        *w += j.previsto_s;
+    }
+
+    return *std::max_element(livre.begin(), livre.end());
+}
+
+// ================== FILA PERSISTENTE ==================
+
+static std::string modoDaRodada(const config_t &cfg) {
+    if (cfg.portfolio) {
+        return "portfolio";
+    }
+
+    std::string modo = cfg.niveis_fp.empty() ? "bmc" : "fp";
+    for (const std::string &n : cfg.niveis_fp) {
+        modo += "-" + n;
+    }
+
+    return modo;
+}
+
+static std::string idFila(const config_t &cfg, const job_t &j) {
+    return j.teste + "|" + std::to_string(j.claim) + "|" + modoDaRodada(cfg);
+}
+
+/**
+ * FUNÇÃO 8: abrirFila()
+ * ESPECIFICAÇÃO: Diário da rodada em <cache>/filas/. O nome combina a
+ * chave do GOTO com as flags de verificação, o modo e os limites: só
+ * retoma a mesma rodada, nunca mistura resultados de configurações
+ * diferentes.
+ */
+static void abrirFila(const config_t &cfg, const std::string &chave, fila_t *fila) {
+    uint64_t h = fnv1a(chave.data(), chave.size());
+    for (const std::string &f : cfg.flags_verif) {
+        h = fnv1a(f.data(), f.size() + 1, h);
+    }
+
+    const std::string modo = modoDaRodada(cfg) + "|" + std::to_string(cfg.timeout_s) + "|" +
+                             std::to_string(cfg.max_k) + "|" + std::to_string(cfg.timeout_abstrato_s);
+    h = fnv1a(modo.data(), modo.size(), h);
+
+    char hex[17];
+    snprintf(hex, sizeof(hex), "%016llx", (unsigned long long)h);
+
+    const std::string dir = cfg.cache + "/filas";
+    criarDiretorios(dir);
+
+    const std::string caminho = dir + "/" + chave + "_" + hex + ".tsv";
+    if (cfg.do_zero) {
+        unlink(caminho.c_str());
+    }
+
+    filaCarregar(fila, caminho);
+}
+
+/**
+ * FUNÇÃO 9: separarPendentes()
+ * ESPECIFICAÇÃO: Jobs com resultado no diário recebem esse resultado; os
+ * demais são movidos para a lista devolvida, para execução.
+ */
+static std::vector<job_t> separarPendentes(const config_t &cfg, const fila_t *fila, std::vector<job_t> *jobs) {
+    std::vector<job_t> pendentes, feitos;
+
+    for (job_t &j : *jobs) {
+        const fila_registro_t *r = filaBuscar(fila, idFila(cfg, j));
+
+        if (!r) {
+            pendentes.push_back(j);
+            continue;
+        }
+
+        j.estrategia = r->estrategia;
+        j.veredito = r->veredito;
+        j.tempo_s = r->tempo_s;
+        j.features.vcc = r->vcc;
+        j.log = r->log;
+        feitos.push_back(j);
+    }
+
+    jobs->swap(feitos);
+    return pendentes;
+}
+
+// Prioridade explícita (--prioridade) na frente da ordem por custo
+static void ordenarPrioridade(const config_t &cfg, std::vector<job_t> *jobs) {
+    auto posto = [&](const job_t &j) {
+        for (size_t p = 0; p < cfg.prioridades.size(); p++) {
+            if (j.teste.find(cfg.prioridades[p]) != std::string::npos) {
+                return p;
+            }
+        }
+        return cfg.prioridades.size();
+    };
+
+    std::stable_sort(jobs->begin(), jobs->end(), [&](const job_t &a, const job_t &b) { return posto(a) < posto(b); });
+}
+
+// ================== VEREDITO ==================
+
+static std::string classificar(const processo_t &p, const std::string &saida) {
+    if (p.timeout) {
+        return "TIMEOUT";
+    }
+
+    if (saida.find("VERIFICATION FAILED") != std::string::npos) {
+        return "FALHA";
+    }
+
+    if (saida.find("VERIFICATION SUCCESSFUL") != std::string::npos) {
+        return "SUCESSO";
+    }
+
+    if (saida.find("VERIFICATION UNKNOWN") != std::string::npos) {
+        return "INCONCLUSIVO";
+    }
+
+    return "ERRO";
+}
+
+static double vccsDoLog(const std::string &saida) {
+    const size_t p = saida.find("Generated ");
+    int geradas = 0, restantes = 0;
+
+    if (p != std::string::npos && sscanf(saida.c_str() + p, "Generated %d VCC(s), %d remaining", &geradas, &restantes) == 2) {
+        return restantes;
+    }
+
+    return -1;
+}
+
+// Nível da escada FP com GOTO próprio: --fixedbv decide a codificação de float no front end
+struct goto_nivel_t {
+    std::string caminho;
+    std::map<std::string, int> claims;     // "teste|chave" -> número do claim neste GOTO
+};
+
+/**
+ * Converte o GOTO de cada nível que muda o front end (só fixedbv: --ir é
+ * do solver e usa o GOTO principal). A flag entra na chave do cache como
+ * qualquer flag de front end; no modo por claim, os claims dos testes com
+ * float são renumerados pela chave funcao:linha:propriedade.
+ */
+static bool prepararNiveisFp(const config_t &cfg, const std::vector<job_t> &testes, const std::string &dir_logs,
+                             std::map<std::string, goto_nivel_t> *gotos) {
+    if (std::find(cfg.niveis_fp.begin(), cfg.niveis_fp.end(), "fixedbv") == cfg.niveis_fp.end()) {
+        return true;
+    }
+
+    config_t cfg_nivel = cfg;
+    cfg_nivel.flags_front.push_back("--fixedbv");
+
+    goto_nivel_t &g = (*gotos)["fixedbv"];
+    std::string chave;
+    double tempo_front = 0.0;
+
+    if (!garantirGoto(cfg_nivel, &g.caminho, &chave, &tempo_front)) {
+        return false;
+    }
+
+    printf("GOTO fixedbv %s (%s)\n", g.caminho.c_str(),
+           tempo_front > 0.0 ? ("convertido em " + std::to_string(tempo_front) + " s").c_str() : "cache");
+
+    if (!cfg.por_claim) {
+        return true;
+    }
+
+    std::vector<job_t> com_fp;
+    for (const job_t &t : testes) {
+        if (t.features.fp) {
+            com_fp.push_back(t);
+        }
+    }
+
+    const std::string dir = dir_logs + "/fixedbv";
+    criarDiretorios(dir);
+
+    for (const job_t &c : expandirClaims(cfg, g.caminho, dir, com_fp)) {
+        if (c.claim > 0) {
+            g.claims[c.teste + "|" + c.chave] = c.claim;
+        }
+    }
+
+    return true;
+}
+
+static void rodarJobs(const config_t &cfg, const std::string &goto_path,
+                      const std::map<std::string, goto_nivel_t> &gotos_nivel, const std::string &dir_logs,
+                      const std::string &historico, fila_t *fila, std::vector<job_t> *jobs) {
+    std::mutex mtx;
+
+    paraCada(jobs->size(), cfg.workers, [&](size_t i) {
+        job_t &j = (*jobs)[i];
+
+        auto comando = [&](const std::string &caminho, int claim) {
+            std::vector<std::string> args = {cfg.esbmc, "--binary", caminho, "--function", j.teste};
+
+            if (claim > 0) {
+                args.push_back("--claim");
+                args.push_back(std::to_string(claim));
+            }
+
+            args.insert(args.end(), cfg.flags_verif.begin(), cfg.flags_verif.end());
+            return args;
+        };
+
+        // Escada de precisão: abstrações baratas primeiro, float32 ("") por último
+        std::vector<std::string> niveis = j.features.fp ? cfg.niveis_fp : std::vector<std::string>();
+        niveis.push_back("");
+
+        const std::string prefixo = dir_logs + "/" + j.teste + (j.claim > 0 ? "_c" + std::to_string(j.claim) : "");
+        std::string saida;
+        j.tempo_s = 0.0;
+
+        for (const std::string &nivel : niveis) {
+            std::vector<std::string> args = comando(goto_path, j.claim);
+            double limite = cfg.timeout_s;
+
+            const auto g = gotos_nivel.find(nivel);
+            if (g != gotos_nivel.end()) {
+                // Mesmo claim no GOTO do nível; sem correspondente, o nível não se aplica
+                const auto c = g->second.claims.find(j.teste + "|" + j.chave);
+                if (j.claim > 0 && c == g->second.claims.end()) {
+                    continue;
+                }
+                args = comando(g->second.caminho, j.claim > 0 ? c->second : 0);
+            }
+
+            if (!nivel.empty()) {
+                args.push_back("--" + nivel);
+                limite = std::min(cfg.timeout_s, cfg.timeout_abstrato_s);
+            }
+
+            j.log = prefixo + (nivel.empty() ? "" : "_" + nivel) + ".log";
+            const processo_t p = executarProcesso(args, limite, j.log);
+
+            lerArquivo(j.log, &saida);
+            j.veredito = classificar(p, saida);
+            j.tempo_s += p.tempo_s;
+
+            // Prova abstrata basta; FALHA abstrata pode ser espúria e sobe de nível
+            if (nivel.empty() || j.veredito == "SUCESSO") {
+                j.estrategia = nivel.empty() ? (niveis.size() > 1 ? "fp-float32" : "bmc") : "fp-" + nivel;
+                break;
+            }
+        }
+
+        j.features.vcc = vccsDoLog(saida);
+        filaRegistrar(fila, idFila(cfg, j), {j.estrategia, j.veredito, j.tempo_s, j.features.vcc, j.log});
+
+        std::lock_guard<std::mutex> lock(mtx);
+
+        // TIMEOUT também entra: é limite inferior do custo e mantém o claim no topo
+        if (j.veredito != "ERRO") {
+            custoAnexar(historico, {chaveCusto(j), j.features, j.tempo_s});
+        }
+
+        printf("  %-8s %8.2fs (prev %7.2fs)  %s %s\n", j.veredito.c_str(), j.tempo_s, j.previsto_s,
+               j.teste.c_str(), j.claim > 0 ? j.chave.c_str() : "");
+        fflush(stdout);
+    });
+}
+
+// ================== PORTFÓLIO DE ESTRATÉGIAS ==================
+
+struct estrategia_t {
+    std::string nome;
+    std::vector<std::string> args;
+};
+
+struct corredor_t {
+    estrategia_t estrategia;
+    pid_t pid;
+    std::string log;
+    bool iniciado;
+    bool terminado;
+};
+
+// Memória de vencedores: <cache>/estrategias.tsv (teste, estratégia, tempo)
+struct vencedor_t {
+    std::string estrategia;
+    double tempo_s;
+};
+
+static std::map<std::string, vencedor_t> carregarVencedores(const std::string &caminho) {
+    std::map<std::string, vencedor_t> m;
+    FILE *f = fopen(caminho.c_str(), "r");
+
+    if (!f) {
+        return m;
+    }
+
+    char teste[256], estrategia[64];
+    double tempo;
+
+    while (fscanf(f, "%255s %63s %lf", teste, estrategia, &tempo) == 3) {
+        m[teste] = {estrategia, tempo};     // Última linha vale
+    }
+
+    fclose(f);
+    return m;
+}
+
+static std::vector<std::string> flagsSemLimite(const std::vector<std::string> &flags) {
+    std::vector<std::string> r;
+
+    for (size_t i = 0; i < flags.size(); i++) {
+        if (flags[i] == "--unwind" || flags[i] == "--max-k-step") {
+            i++;
+        } else if (flags[i] != "--k-induction" && flags[i] != "--incremental-bmc" && flags[i] != "--falsification") {
+            r.push_back(flags[i]);
+        }
+    }
+
+    return r;
+}
+
+static std::string binarioNativo(const config_t &cfg, const std::string &chave, const job_t &j) {
+    return cfg.cache + "/nativo/" + chave + "_" + j.teste;
+}
+
+/**
+ * FUNÇÃO 10: garantirNativo()
+ * ESPECIFICAÇÃO: Compilar harness + biblioteca + falsificador.cpp para o
+ * teste, uma vez por chave do GOTO (mesmas fontes e flags -D/-I). Feito
+ * antes das disputas: uma compilação cancelada no meio não deixa lixo.
+ */
+static void garantirNativo(const config_t &cfg, const std::string &chave, const job_t &j) {
+    const std::string bin = binarioNativo(cfg, chave, j);
+    struct stat st;
+
+    if (stat(bin.c_str(), &st) == 0) {
+        return;
+    }
+
+    const std::string tmp = bin + ".tmp." + std::to_string(getpid());
+    std::vector<std::string> args = {"g++", "-O1", "-std=c++17", "-DMODO_NATIVO", "-DPX4_BIBLIOTECA",
+                                     "-DTESTE_ALVO=" + j.teste};
+    args.insert(args.end(), cfg.flags_front.begin(), cfg.flags_front.end());
+    args.insert(args.end(), {cfg.falsificador, j.harness, cfg.biblioteca, "-o", tmp});
+
+    const processo_t p = executarProcesso(args, 0.0, bin + ".log");
+
+    if (p.status != 0 || rename(tmp.c_str(), bin.c_str()) != 0) {
+        fprintf(stderr, "  compilacao nativa de %s falhou, ver %s.log\n", j.teste.c_str(), bin.c_str());
+        unlink(tmp.c_str());
+    }
+}
+
+/**
+ * FUNÇÃO 11: estrategiasDoTeste()
+ * ESPECIFICAÇÃO: As três estratégias do portfólio para um teste:
+ *   incremental  --incremental-bmc: limite crescente, acha bugs profundos
+ *   k-inducao    --k-induction: prova sem depender de --unwind suficiente
+ *   nativa       falsificador.cpp: execuções concretas, só conclui FALHA
+ * Sem binário nativo (compilação falhou) a disputa fica só com as duas
+ * simbólicas.
+ */
+static std::vector<estrategia_t> estrategiasDoTeste(const config_t &cfg, const std::string &goto_path,
+                                                    const std::string &chave, const job_t &j) {
+    const std::vector<std::string> base = flagsSemLimite(cfg.flags_verif);
+    const std::string k = std::to_string(cfg.max_k);
+    std::vector<estrategia_t> e;
+
+    for (const char *modo : {"incremental", "k-inducao"}) {
+        estrategia_t s = {modo, {cfg.esbmc, "--binary", goto_path, "--function", j.teste}};
+        s.args.push_back(s.nome == "incremental" ? "--incremental-bmc" : "--k-induction");
+        s.args.insert(s.args.end(), {"--max-k-step", k});
+        s.args.insert(s.args.end(), base.begin(), base.end());
+        e.push_back(s);
+    }
+
+    const std::string bin = binarioNativo(cfg, chave, j);
+    struct stat st;
+
+    if (stat(bin.c_str(), &st) == 0) {
+        const uint64_t semente = fnv1a(j.teste.data(), j.teste.size()) & 0xFFFF;
+        e.push_back({"nativa", {bin, std::to_string((long long)cfg.timeout_s), std::to_string(semente)}});
+    }
+
+    return e;
+}
+
+/**
+ * FUNÇÃO 12: correrPortfolio()
+ * ESPECIFICAÇÃO: Disputa entre as estratégias de um teste. A primeira
+ * resposta conclusiva (SUCESSO ou FALHA) vence e as outras são canceladas.
+ * Se o teste já tem vencedor registrado, ele sai sozinho na frente por
+ * 2x o seu tempo anterior (mínimo 1 s) antes de liberar as demais.
+ */
+static void correrPortfolio(const config_t &cfg, const std::string &goto_path, const std::string &chave,
+                            const std::string &dir_logs, const std::map<std::string, vencedor_t> &vencedores,
+                            job_t *j) {
+    std::vector<corredor_t> corredores;
+
+    for (const estrategia_t &e : estrategiasDoTeste(cfg, goto_path, chave, *j)) {
+        corredores.push_back({e, -1, dir_logs + "/" + j->teste + "_" + e.nome + ".log", false, false});
+    }
+
+    double graca = 0.0;
+    const auto lembrado = vencedores.find(j->teste);
+
+    if (lembrado != vencedores.end()) {
+        for (size_t i = 1; i < corredores.size(); i++) {
+            if (corredores[i].estrategia.nome == lembrado->second.estrategia) {
+                std::swap(corredores[0], corredores[i]);
+            }
+        }
+
+        graca = std::max(1.0, 2.0 * lembrado->second.tempo_s);
+    }
+
+    const auto inicio = std::chrono::steady_clock::now();
+    int vencedor = -1;
+    bool estourou = false;
+
+    for (;;) {
+        const double t = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+
+        for (size_t i = 0; i < corredores.size(); i++) {
+            corredor_t &c = corredores[i];
+
+            if (!c.iniciado && (i == 0 || t >= graca)) {
+                c.pid = iniciarProcesso(c.estrategia.args, c.log);
+                c.iniciado = true;
+                c.terminado = c.pid < 0;
+            }
+        }
+
+        bool todos_terminados = true;
+
+        for (size_t i = 0; i < corredores.size() && vencedor < 0; i++) {
+            corredor_t &c = corredores[i];
+            processo_t p = {-1, 0, false, t};
+
+            if (c.iniciado && !c.terminado && processoTerminou(c.pid, &p)) {
+                c.terminado = true;
+
+                std::string saida;
+                lerArquivo(c.log, &saida);
+                const std::string v = classificar(p, saida);
+
+                if (v == "SUCESSO" || v == "FALHA") {
+                    vencedor = (int)i;
+                    j->veredito = v;
+                }
+            }
+
+            todos_terminados = todos_terminados && c.iniciado && c.terminado;
+        }
+
+        if (vencedor >= 0 || todos_terminados) {
+            break;
+        }
+
+        if (t > cfg.timeout_s) {
+            estourou = true;
+            break;
+        }
+
+        esperarUmPouco();
+    }
+
+    for (corredor_t &c : corredores) {
+        if (c.iniciado && !c.terminado) {
+            cancelarProcesso(c.pid);
+        }
+    }
+
+    j->tempo_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+
+    if (vencedor >= 0) {
+        j->estrategia = corredores[vencedor].estrategia.nome;
+        j->log = corredores[vencedor].log;
+    } else {
+        j->estrategia = "-";
+        j->veredito = estourou ? "TIMEOUT" : "INCONCLUSIVO";
+        j->log = corredores[0].log;
+    }
+}
+
+static void rodarPortfolio(const config_t &cfg, const std::string &goto_path, const std::string &chave,
+                           const std::string &dir_logs, fila_t *fila, std::vector<job_t> *jobs) {
+    const std::string memoria = cfg.cache + "/estrategias.tsv";
+    const std::map<std::string, vencedor_t> vencedores = carregarVencedores(memoria);
+    std::mutex mtx;
+
+    criarDiretorios(cfg.cache + "/nativo");
+    paraCada(jobs->size(), cfg.workers, [&](size_t i) { garantirNativo(cfg, chave, (*jobs)[i]); });
+
+    // Cada disputa ocupa até 3 processos
+    paraCada(jobs->size(), std::max(1, cfg.workers / 3), [&](size_t i) {
+        job_t &j = (*jobs)[i];
+        correrPortfolio(cfg, goto_path, chave, dir_logs, vencedores, &j);
+        filaRegistrar(fila, idFila(cfg, j), {j.estrategia, j.veredito, j.tempo_s, -1, j.log});
+
+        std::lock_guard<std::mutex> lock(mtx);
+
+        if (j.estrategia != "-") {
+            FILE *f = fopen(memoria.c_str(), "a");
+            if (f) {
+                fprintf(f, "%s\t%s\t%.3f\n", j.teste.c_str(), j.estrategia.c_str(), j.tempo_s);
+                fclose(f);
+            }
+        }
+
+        const auto lembrado = vencedores.find(j.teste);
+        printf("  %-12s %8.2fs  %-11s %s%s\n", j.veredito.c_str(), j.tempo_s, j.estrategia.c_str(), j.teste.c_str(),
+               lembrado != vencedores.end() ? (" (lembrado: " + lembrado->second.estrategia + ")").c_str() : "");
+        fflush(stdout);
+    });
+}
+
+// ================== EXPORTAÇÃO SMT-LIB ==================
+
+/**
+ * FUNÇÃO 13: exportarSmt()
+ * ESPECIFICAÇÃO: Para cada claim, pedir ao ESBMC só a fórmula SMT-LIB2
+ * (--smtlib --smt-formula-only) em <dir>/<teste>_c<N>.smt2, sem resolver.
+ * O arquivo ganha um cabeçalho de comentários com a origem do claim; o
+ * índice <dir>/indice.tsv tem o mesmo formato do TSV de resultados, com a
+ * coluna log apontando para o .smt2 (entrada do smt_bench).
+ */
+static void exportarSmt(const config_t &cfg, const std::string &goto_path, std::vector<job_t> *jobs) {
+    criarDiretorios(cfg.dir_smt);
+
+    paraCada(jobs->size(), cfg.workers, [&](size_t i) {
+        job_t &j = (*jobs)[i];
+        const std::string nome = cfg.dir_smt + "/" + j.teste + (j.claim > 0 ? "_c" + std::to_string(j.claim) : "");
+        std::vector<std::string> args = {cfg.esbmc, "--binary", goto_path, "--function", j.teste};
+
+        if (j.claim > 0) {
+            args.push_back("--claim");
+            args.push_back(std::to_string(j.claim));
+        }
+
+        args.insert(args.end(), cfg.flags_verif.begin(), cfg.flags_verif.end());
+        args.insert(args.end(), {"--smtlib", "--smt-formula-only", "--output", nome + ".smt2"});
+
+        const processo_t p = executarProcesso(args, cfg.timeout_s, nome + ".log");
+        std::string formula;
+        j.tempo_s = p.tempo_s;
+        j.estrategia = "smtlib";
+        j.log = nome + ".smt2";
+
+        if (p.timeout || p.status != 0 || !lerArquivo(j.log, &formula) || formula.empty()) {
+            j.veredito = p.timeout ? "TIMEOUT" : "ERRO";
+        } else {
+            std::ofstream out(j.log, std::ios::binary | std::ios::trunc);
+            out << "; harness: " << j.harness << "\n; teste: " << j.teste << "\n; claim: " << j.claim
+                << "\n; origem: " << (j.chave.empty() ? j.teste : j.chave) << "\n; flags:";
+            for (const std::string &f : cfg.flags_verif) {
+                out << " " << f;
+            }
+            out << "\n" << formula;
+            j.veredito = out ? "EXPORTADO" : "ERRO";
+        }
+
+        printf("  %-9s %7.2fs  %s\n", j.veredito.c_str(), j.tempo_s, j.log.c_str());
+        fflush(stdout);
+    });
+}
+
+static bool escreverTsv(const std::string &caminho, const std::vector<job_t> &jobs) {
+    FILE *f = fopen(caminho.c_str(), "w");
+
+    if (!f) {
+        perror(caminho.c_str());
+        return false;
+    }
+
+    fprintf(f, "harness\tteste\tclaim\tfuncao\tlinha\tpropriedade\testrategia\tveredito\ttempo_s\tprevisto_s\tlog\n");
+
+    for (const job_t &j : jobs) {
+        fprintf(f, "%s\t%s\t%d\t%s\t%d\t%s\t%s\t%s\t%.3f\t%.3f\t%s\n", j.harness.c_str(), j.teste.c_str(), j.claim,
+                j.funcao.c_str(), j.linha, j.propriedade.c_str(), j.estrategia.c_str(), j.veredito.c_str(), j.tempo_s,
+                j.previsto_s, j.log.c_str());
+    }
+
+    fclose(f);
+    return true;
+}
+
+// ================== MAIN ==================
+
+static void uso(const char *prog) {
+    fprintf(stderr,
+            "uso: %s [opcoes] [harness.cpp ...] [-- flags de verificacao]\n"
+            "  --esbmc BIN        executavel do ESBMC (padrao: esbmc)\n"
+            "  --cache DIR        cache de programas GOTO e historico (padrao: .esbmc_cache)\n"
+            "  --biblioteca F     funcoes compartilhadas (padrao: px4_funcoes.cpp)\n"
+            "  -D.../-I...        flags de front end (entram na chave do cache)\n"
+            "  --workers N        jobs em paralelo (padrao: nucleos)\n"
+            "  --timeout S        timeout por job em segundos (padrao: 900)\n"
+            "  --por-teste        um job por teste (padrao: um job por claim)\n"
+            "  --portfolio        por teste, disputa incremental x k-inducao x nativa\n"
+            "  --max-k N          --max-k-step do portfolio (padrao: 50)\n"
+            "  --refinar-fp L     testes com float: tenta as abstracoes L (ex.: ir,fixedbv)\n"
+            "                     antes do float32 completo\n"
+            "  --timeout-abstrato S  timeout de cada abstracao (padrao: 60)\n"
+            "  --exportar-smt DIR consultas SMT-LIB2 por claim em DIR (sem resolver)\n"
+            "  --prioridade S     testes que contem S primeiro (repetivel, em ordem)\n"
+            "  --do-zero          ignora o diario da fila e refaz todos os jobs\n"
+            "  --intervalos       claims de overflow provados por intervalos nao vao ao solver\n"
+            "  --autoteste-intervalos  confere a analise de intervalos em claims conhecidos e sai\n"
+            "  --filtro S         so testes cujo nome contem S\n"
+            "  --saida F          TSV de resultados (padrao: resultados.tsv)\n",
+            prog);
+}
+
+int main(int argc, char **argv) {
+    config_t cfg;
+    bool depois_separador = false;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string a = argv[i];
+
+        if (depois_separador) {
+            cfg.flags_verif.push_back(a);
+        } else if (a == "--") {
+            depois_separador = true;
+        } else if (a == "--esbmc" && i + 1 < argc) {
+            cfg.esbmc = argv[++i];
+        } else if (a == "--cache" && i + 1 < argc) {
+            cfg.cache = argv[++i];
+        } else if (a == "--biblioteca" && i + 1 < argc) {
+            cfg.biblioteca = argv[++i];
+        } else if (a == "--workers" && i + 1 < argc) {
+            cfg.workers = atoi(argv[++i]);
+        } else if (a == "--timeout" && i + 1 < argc) {
+            cfg.timeout_s = atof(argv[++i]);
+        } else if (a == "--por-teste") {
+            cfg.por_claim = false;
+        } else if (a == "--portfolio") {
+            cfg.portfolio = true;
+            cfg.por_claim = false;
+        } else if (a == "--max-k" && i + 1 < argc) {
+            cfg.max_k = atoi(argv[++i]);
+        } else if (a == "--refinar-fp" && i + 1 < argc) {
+            std::istringstream niveis(argv[++i]);
+            std::string nivel;
+            while (std::getline(niveis, nivel, ',')) {
+                cfg.niveis_fp.push_back(nivel);
+            }
+        } else if (a == "--timeout-abstrato" && i + 1 < argc) {
+            cfg.timeout_abstrato_s = atof(argv[++i]);
+        } else if (a == "--exportar-smt" && i + 1 < argc) {
+            cfg.dir_smt = argv[++i];
+        } else if (a == "--prioridade" && i + 1 < argc) {
+            cfg.prioridades.push_back(argv[++i]);
+        } else if (a == "--do-zero") {
+            cfg.do_zero = true;
+        } else if (a == "--intervalos") {
+            cfg.intervalos = true;
+        } else if (a == "--autoteste-intervalos") {
+            const int falhas = intervalosAutoteste();
+            printf("autoteste de intervalos: %d falha(s)\n", falhas);
+            return falhas == 0 ? 0 : 1;
+        } else if (a == "--filtro" && i + 1 < argc) {
+            cfg.filtro = argv[++i];
+        } else if (a == "--saida" && i + 1 < argc) {
+            cfg.saida = argv[++i];
+        } else if (a.compare(0, 2, "-D") == 0 || a.compare(0, 2, "-I") == 0) {
+            cfg.flags_front.push_back(a);
+        } else if (a == "-h" || a == "--help") {
+            uso(argv[0]);
+            return 0;
+        } else if (a[0] != '-') {
+            cfg.harnesses.push_back(a);
+        } else {
+            uso(argv[0]);
+            return 1;
+        }
+    }
+
+    if (cfg.harnesses.empty()) {
+        cfg.harnesses = {"gpsdrive.cpp", "imu.cpp", "Flight.cpp"};
+    }
+
+    if (cfg.flags_verif.empty()) {
+        cfg.flags_verif = {"--unwind", "8"};
+    }
+
+    if (cfg.workers <= 0) {
+        cfg.workers = (int)std::thread::hardware_concurrency();
+        cfg.workers = cfg.workers > 0 ? cfg.workers : 1;
+    }
+
+    std::string goto_path, chave;
+    double tempo_front = 0.0;
+
+    if (!garantirGoto(cfg, &goto_path, &chave, &tempo_front)) {
+        return 1;
+    }
+
+    printf("GOTO %s (%s)\n", goto_path.c_str(),
+           tempo_front > 0.0 ? ("convertido em " + std::to_string(tempo_front) + " s").c_str() : "cache");
+
+    const std::string dir_logs = cfg.cache + "/logs/" + chave;
+    criarDiretorios(dir_logs);
+
+    std::vector<job_t> jobs = descobrirTestes(cfg);
+
+    if (cfg.portfolio) {
+        fila_t fila;
+        abrirFila(cfg, chave, &fila);
+        std::vector<job_t> pendentes = separarPendentes(cfg, &fila, &jobs);
+        ordenarPrioridade(cfg, &pendentes);
+
+        printf("%zu testes em portfolio (%zu retomados do diario), %d disputas simultaneas\n",
+               jobs.size() + pendentes.size(), jobs.size(), std::max(1, cfg.workers / 3));
+        rodarPortfolio(cfg, goto_path, chave, dir_logs, &fila, &pendentes);
+        jobs.insert(jobs.end(), pendentes.begin(), pendentes.end());
+
+        int falhas = 0;
+        for (const job_t &j : jobs) {
+            falhas += j.veredito == "SUCESSO" ? 0 : 1;
+        }
+
+        return escreverTsv(cfg.saida, jobs) && falhas == 0 ? 0 : 2;
+    }
+
+    std::map<std::string, goto_nivel_t> gotos_nivel;
+    if (cfg.dir_smt.empty() && !prepararNiveisFp(cfg, jobs, dir_logs, &gotos_nivel)) {
+        return 1;
+    }
+
+    if (cfg.por_claim) {
+        jobs = expandirClaims(cfg, goto_path, dir_logs, jobs);
+    }
+
+    std::vector<job_t> descartados;
+    if (cfg.intervalos && cfg.por_claim) {
+        int overflow = 0;
+        descartados = descartarPorIntervalos(cfg, &jobs, &overflow);
+        printf("intervalos: %zu de %d claims de overflow descartados estaticamente, %d para o solver\n",
+               descartados.size(), overflow, overflow - (int)descartados.size());
+    }
+
+    if (!cfg.dir_smt.empty()) {
+        exportarSmt(cfg, goto_path, &jobs);
+        return escreverTsv(cfg.dir_smt + "/indice.tsv", jobs) ? 0 : 1;
+    }
+
+    const std::string historico = cfg.cache + "/historico.tsv";
+    custo_modelo_t modelo;
+    custoCarregar(&modelo, historico);
+    custoAjustar(&modelo);
+
+    fila_t fila;
+    abrirFila(cfg, chave, &fila);
+    std::vector<job_t> pendentes = separarPendentes(cfg, &fila, &jobs);
+
+    const double makespan = escalonarLPT(&pendentes, modelo, cfg.workers);
+    ordenarPrioridade(cfg, &pendentes);
+
+    double soma_prev = 0.0;
+    for (const job_t &j : pendentes) {
+        soma_prev += j.previsto_s;
+    }
+
+    printf("%zu jobs (%zu retomados do diario %s), %d workers, historico %zu amostras (%s)\n",
+           jobs.size() + pendentes.size(), jobs.size(), fila.caminho.c_str(), cfg.workers, modelo.amostras.size(),
+           modelo.ajustado ? "modelo ajustado" : "heuristica");
+    printf("previsto: makespan LPT %.1f s, limite inferior %.1f s\n", makespan,
+           std::max(soma_prev / cfg.workers, pendentes.empty() ? 0.0 : pendentes.front().previsto_s));
+
+    const auto t0 = std::chrono::steady_clock::now();
+    rodarJobs(cfg, goto_path, gotos_nivel, dir_logs, historico, &fila, &pendentes);
+    const double total = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    jobs.insert(jobs.end(), pendentes.begin(), pendentes.end());
+    jobs.insert(jobs.end(), descartados.begin(), descartados.end());
+
+    int falhas = 0;
+    double soma = 0.0, maior = 0.0;
+
+    for (const job_t &j : jobs) {
+        falhas += j.veredito == "SUCESSO" ? 0 : 1;
+    }
+
+    for (const job_t &j : pendentes) {
+        soma += j.tempo_s;
+        maior = std::max(maior, j.tempo_s);
+    }
+
+    printf("total: %.2f s parede (limite inferior %.2f s), %.2f s somados, %d nao-sucesso -> %s\n", total,
+           std::max(soma / cfg.workers, maior), soma, falhas, cfg.saida.c_str());
+    return escreverTsv(cfg.saida, jobs) && falhas == 0 ? 0 : 2;
+}
+
+/*
+ * ================================================================
+ * DOCUMENTAÇÃO
+ * ================================================================
+ *
+ * BIBLIOTECA GOTO COMPARTILHADA:
+ *
+ * 1. FRONT END UMA VEZ:
+ *    - px4_funcoes.cpp contém dumpGpsData, combine, updateTemperature,
+ *      fifoReadCount, processAccelData, processGyroData e expo<float>
+ *    - Com -DPX4_BIBLIOTECA os harnesses trocam as cópias locais pelo
+ *      header e deixam de definir main(): cada test_* é um ponto de entrada
+ *    - O GOTO resultante fica em <cache>/px4_<hash>.goto; qualquer mudança
+ *      em fonte, header incluído, flag -D/-I ou versão do ESBMC gera outro
+ *
+ * 2. JOBS:
+ *    - esbmc --binary px4_<hash>.goto --function test_xxx <flags>
+ *    - Sem parse de C++ nem conversão GOTO por job: o custo fixo passa a
+ *      ser só a leitura do binário
+ *
+ * 3. ISOLAMENTO:
+ *    - Cada job em grupo de processos próprio; timeout mata o grupo
+ *    - Logs por claim para inspeção do contraexemplo
+ *
+ * 4. ESCALONAMENTO POR CUSTO:
+ *    - Características: teoria (float no teste), classe da propriedade,
+ *      laços abertos na linha do claim, --unwind e VCCs da última execução
+ *    - <cache>/historico.tsv cresce a cada execução; o modelo é reajustado
+ *      no início de cada rodada (esbmc_custo.h)
+ *    - Maior previsto primeiro: os claims de memcpy de 140-163 s começam
+ *      logo, em vez de ficarem para o fim e decidirem o tempo de parede
+ *
+ * 5. PORTFÓLIO (--portfolio):
+ *    - Por teste, três estratégias em paralelo: --incremental-bmc,
+ *      --k-induction (ambas até --max-k-step) e falsificador.cpp nativo
+ *    - Primeiro veredito conclusivo vence; as outras são mortas (grupo)
+ *    - A nativa só conclui FALHA; sem violação ela sai UNKNOWN e a
+ *      disputa continua com as simbólicas
+ *    - <cache>/estrategias.tsv guarda o vencedor de cada teste: na rodada
+ *      seguinte ele larga sozinho por 2x o tempo anterior (mínimo 1 s)
+ *    - Binários nativos em <cache>/nativo/, compilados uma vez por chave
+ *      antes das disputas
+ *
+ * 6. REFINAMENTO DE PRECISÃO FP (--refinar-fp ir,fixedbv):
+ *    - Só testes com float (expo, updateTemperature, tolerâncias 1e-6)
+ *    - Cada nível é uma codificação mais barata que IEEE-754 float32:
+ *      --ir (aritmética real/inteira) e --fixedbv (ponto fixo)
+ *    - --ir muda só a codificação no solver e roda sobre o GOTO principal;
+ *      --fixedbv muda a conversão de float no front end, então o nível
+ *      tem GOTO próprio (--fixedbv na chave do cache) e o claim é
+ *      reencontrado nele pela chave funcao:linha:propriedade (sem
+ *      correspondente, o nível é pulado)
+ *    - SUCESSO num nível encerra o job (estratégia fp-ir / fp-fixedbv no
+ *      TSV); FALHA, INCONCLUSIVO ou timeout (--timeout-abstrato) sobe
+ *      para o nível seguinte, até o float32 completo
+ *    - A prova abstrata vale para a semântica abstrata: propriedades que
+ *      dependem de arredondamento (ex.: |a-b| < 1e-6 perto do epsilon)
+ *      devem rodar sem --refinar-fp para a resposta final em float32
+ *
+ * 7. CORPUS SMT-LIB (--exportar-smt DIR):
+ *    - Um .smt2 por claim, com cabeçalho "; teste/claim/origem/flags"
+ *    - DIR/indice.tsv no formato do TSV de resultados (log = .smt2)
+ *    - smt_bench.cpp repete o corpus em qualquer solver instalado
+ *
+ * 8. FILA PERSISTENTE (esbmc_fila.h):
+ *    - Cada job concluído vai para <cache>/filas/<goto>_<config>.tsv com
+ *      fsync; uma rodada interrompida (Ctrl-C, suspensão, reinício do
+ *      WSL) retoma só com os jobs que faltam, sem flag nenhuma
+ *    - O diário é por configuração: mudar fonte, flags, modo ou timeout
+ *      começa outro diário; --do-zero descarta o da configuração atual
+ *    - Jobs com ERRO voltam para a fila na retomada
+ *    - --prioridade S (repetível) põe os testes que contêm S na frente,
+ *      mantendo a ordem por custo dentro de cada grupo
+ *
+ * 9. DESCARTE POR INTERVALOS (--intervalos, esbmc_intervalos.h):
+ *    - Só claims "arithmetic overflow" de --overflow-check, no modo por claim
+ *    - A expressão do --show-claims já traz as conversões do front end:
+ *      !overflow("-", 200, (signed int)dump_data->len) cabe em signed int
+ *      porque len é uint8_t em gps_dump_s, então nem vai ao solver
+ *    - O tipo da operação segue as conversões usuais de C, com literais
+ *      tipados pelo sufixo: !overflow("-", 200u, (unsigned int)len) é
+ *      unsigned int e fica INCERTO (dá a volta com len > 200)
+ *    - Intervalos de folha: tipo declarado, #define numérico e
+ *      __ESBMC_assume(v <op> expressão) de variável local não reatribuída
+ *      (nem passada por &) até a linha do claim, no mesmo bloco do claim
+ *      ou num que o contém; lado direito que não é entendido inteiro não
+ *      restringe nada
+ *    - Descartados entram no TSV com estratégia "intervalos", tempo 0 e
+ *      o motivo no lugar do log; não vão para o diário da fila nem para
+ *      o histórico de custo
+ *
+ * COMANDOS DE EXECUÇÃO:
+ * g++ -O2 -std=c++17 -pthread esbmc_runner.cpp -o esbmc_runner
+ * ./esbmc_runner --workers 4 -- --unwind 8 --overflow-check
+ * ./esbmc_runner --filtro test_gps_real gpsdrive.cpp -- --unwind 12
+ * ./esbmc_runner -DENTRADAS_ESTREITAS -- --unwind 8        (entradas estreitas)
+ * ./esbmc_runner -DVERIFICAR_ESTREITAMENTO -- --unwind 8   (solidez do estreitamento)
+ * ./esbmc_runner -DABSTRAIR_CONTEUDO -- --unwind 8        (bytes do GPS abstraídos)
+ * ./esbmc_runner --portfolio --max-k 30 --timeout 300      (disputa de estratégias)
+ * ./esbmc_runner --refinar-fp ir,fixedbv Flight.cpp -- --unwind 8  (FP abstrata primeiro)
+ * ./esbmc_runner --exportar-smt corpus -- --unwind 8       (consultas para o smt_bench)
+ * ./esbmc_runner --workers 2 --prioridade test_gps_real_buffer -- --unwind 8  (retoma se interrompido)
+ * ./esbmc_runner --intervalos -- --unwind 8 --overflow-check   (overflow seguro sem solver)
+ * ./esbmc_runner --autoteste-intervalos                    (vereditos conhecidos da análise)
+ *
+ * ================================================================
+ */
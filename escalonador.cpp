@@ -0,0 +1,397 @@
+/**
+ * @file escalonador.cpp
+ * @author Dissertação Mestrado - Verificação Formal PX4 v1.16
+ *
+ * OBJETIVO: Verificar e medir a emulação de work queues (fila_trabalho.h)
+ * MÓDULO TESTADO: Escalonamento de GPS (dumpGpsData), IMU
+ *                 (processAccelData/processGyroData) e telemetria
+ * MÉTODO: Bounded Model Checking com ESBMC + benchmark nativo (-DMODO_NATIVO)
+ *
+ * MOTIVAÇÃO: As funções extraídas são verificadas isoladas, mas a latência
+ * sensor-publicação depende de quem divide o worker com quem. O mesmo
+ * cenário roda com relógio simulado (reprodutível, compara políticas) e
+ * com threads reais (confere o modelo de custo).
+ */
+
+#include <assert.h>
+#include <cstring>
+#include <cstdint>
+
+#include "fila_trabalho.h"
+
+#ifndef MODO_NATIVO
+
+// ================== FUNÇÕES ESBMC ==================
+extern int nondet_int();
+extern uint8_t nondet_uint8();
+extern uint16_t nondet_uint16();
+extern bool nondet_bool();
+extern void __ESBMC_assume(int condition);
+
+// ================== TESTES DE VERIFICAÇÃO FORMAL ==================
+
+static wq_t wq;
+
+static void montarTarefasArbitrarias(int n) {
+    wqReset(&wq, 2, (wq_politica_t)(nondet_uint8() % 3));
+
+    for (int i = 0; i < n; i++) {
+        wq_tarefa_t t = {};
+        t.nome = "t";
+        t.prioridade = nondet_uint8();
+        t.fila = nondet_uint8() % WQ_MAX_FILAS;
+        t.encadeia = -1;
+        wqAdicionar(&wq, t);
+
+        wq.tarefas[i].pendente = nondet_bool();
+        wq.tarefas[i].executando = nondet_bool();
+        wq.tarefas[i].liberacao_us = nondet_uint16();
+    }
+}
+
+/**
+ * TESTE 1: Verificar escolha do próximo item
+ * PROPRIEDADE: Resultado é -1 ou tarefa elegível para o worker; nenhuma
+ * outra elegível é mais prioritária (PRIORIDADE/FILAS_PX4) ou mais antiga (FIFO)
+ */
+void test_wq_escolha_elegivel() {
+    montarTarefasArbitrarias(3);
+
+    int worker = nondet_int();
+    __ESBMC_assume(worker >= 0 && worker < wq.workers);
+    uint64_t agora = nondet_uint16();
+
+    int i = wqEscolher(&wq, worker, agora);
+    assert(i >= -1 && i < wq.num_tarefas);
+
+    for (int j = 0; j < wq.num_tarefas; j++) {
+        const wq_tarefa_t *t = &wq.tarefas[j];
+        bool elegivel = t->pendente && !t->executando && t->liberacao_us <= agora &&
+                        (wq.politica != wq_politica_t::FILAS_PX4 || t->fila % wq.workers == worker);
+
+        if (i < 0) {
+            assert(!elegivel);
+            continue;
+        }
+
+        if (j == i) {
+            assert(elegivel);
+        } else if (elegivel && wq.politica == wq_politica_t::FIFO) {
+            assert(t->liberacao_us >= wq.tarefas[i].liberacao_us);
+        } else if (elegivel) {
+            assert(t->prioridade <= wq.tarefas[i].prioridade);
+        }
+    }
+}
+
+/**
+ * TESTE 2: Verificar ScheduleNow repetido
+ * PROPRIEDADE: Item pendente não é duplicado e mantém a liberação mais antiga
+ */
+void test_wq_agendar_coalesce() {
+    montarTarefasArbitrarias(1);
+    wq.tarefas[0].pendente = false;
+
+    uint64_t t1 = nondet_uint16();
+    uint64_t t2 = nondet_uint16();
+    __ESBMC_assume(t1 <= t2);
+
+    wqAgendarAgora(&wq, 0, t1, t1);
+    wqAgendarAgora(&wq, 0, t2, t2);
+
+    assert(wq.tarefas[0].pendente);
+    assert(wq.tarefas[0].liberacao_us == t1);
+    assert(wq.tarefas[0].est.liberacoes == 1);
+    assert(wq.tarefas[0].est.coalescidas == 1);
+}
+
+/**
+ * TESTE 3: Verificar contabilidade de uma simulação curta
+ * PROPRIEDADE: Execuções nunca excedem liberações, perdas de prazo nunca
+ * excedem execuções e a encadeada só roda depois da raiz publicar
+ */
+void test_wq_simulacao_contagens() {
+    wqReset(&wq, 1, (wq_politica_t)(nondet_uint8() % 3));
+
+    wq_tarefa_t raiz = {};
+    raiz.nome = "raiz";
+    raiz.prioridade = nondet_uint8();
+    raiz.periodo_us = 4;
+    raiz.prazo_us = 3;
+    raiz.custo_us = nondet_uint8() % 4;
+    raiz.encadeia = 1;
+
+    wq_tarefa_t filha = {};
+    filha.nome = "filha";
+    filha.prioridade = nondet_uint8();
+    filha.prazo_us = 6;
+    filha.custo_us = nondet_uint8() % 4;
+    filha.encadeia = -1;
+
+    wqAdicionar(&wq, raiz);
+    wqAdicionar(&wq, filha);
+    wqSimular(&wq, 12);
+
+    for (int i = 0; i < 2; i++) {
+        const wq_estatistica_t *e = &wq.tarefas[i].est;
+        assert(e->execucoes <= e->liberacoes);
+        assert(e->perdas_prazo <= e->execucoes);
+        assert(e->exec_max_us <= 3);
+    }
+
+    assert(wq.tarefas[1].est.liberacoes <= wq.tarefas[0].est.execucoes);
+    assert(wq.tarefas[1].est.e2e_amostras == wq.tarefas[1].est.execucoes);
+}
+
+// ================== MAIN PARA ESBMC ==================
+int main() {
+    int test_choice = nondet_int();
+    __ESBMC_assume(test_choice >= 0 && test_choice < 3);
+
+    switch(test_choice) {
+        case 0:
+            test_wq_escolha_elegivel();
+            break;
+        case 1:
+            test_wq_agendar_coalesce();
+            break;
+        case 2:
+            test_wq_simulacao_contagens();
+            break;
+    }
+
+    return 0;
+}
+
+#else // MODO_NATIVO
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+#include "px4_funcoes.h"
+
+// ================== CORPOS DAS TAREFAS ==================
+// Funções reais (px4_funcoes.cpp) sobre amostras sintéticas
+
+struct imu_ctx_t {
+    uint32_t x;                    // LCG das amostras
+    int16_t saida[3];
+    float temperatura;
+    uint64_t saturadas;
+};
+
+struct gps_ctx_t {
+    uint8_t serial[256];
+    uint32_t x;
+    gps_dump_s dump;
+    uint64_t bytes;
+};
+
+struct consumidor_ctx_t {
+    const imu_ctx_t *imu;
+    float acumulado;
+};
+
+static inline int16_t amostra(uint32_t *x) {
+    *x = *x * 1103515245u + 12345u;
+    // 1 em 512 amostras no fundo de escala negativo (INT16_MIN), como em saturação do BMI088
+    return ((*x >> 7) % 512 == 0) ? INT16_MIN : (int16_t)(*x >> 16);
+}
+
+static bool corpoGyro(void *ctx, uint64_t) {
+    imu_ctx_t *c = (imu_ctx_t *)ctx;
+    int16_t gx = amostra(&c->x), gy = amostra(&c->x), gz = amostra(&c->x);
+    bool ok = processGyroData(gx, gy, gz, &c->saida[0], &c->saida[1], &c->saida[2]);
+    c->saturadas += ok ? 0 : 1;
+    return ok;                     // Amostra descartada não publica sensor_gyro
+}
+
+static bool corpoAccel(void *ctx, uint64_t) {
+    imu_ctx_t *c = (imu_ctx_t *)ctx;
+    processAccelData(amostra(&c->x), amostra(&c->x), &c->saida[1], &c->saida[2]);
+    c->temperatura = updateTemperature((uint8_t)(c->x >> 8), (uint8_t)(c->x >> 16));
+    return true;
+}
+
+static bool corpoGps(void *ctx, uint64_t) {
+    gps_ctx_t *c = (gps_ctx_t *)ctx;
+    c->x = c->x * 1103515245u + 12345u;
+    size_t n = 32 + (c->x >> 16) % 200;      // Uma leitura da serial por ciclo
+    for (size_t i = 0; i < n; i++) {
+        c->serial[i] = (uint8_t)(c->x >> (i % 24));
+    }
+    dumpGpsData(c->serial, n, gps_dump_comm_mode_t::Full, false, &c->dump, gps_dump_comm_mode_t::Full);
+    c->bytes += n;
+    return true;
+}
+
+static bool corpoConsumidor(void *ctx, uint64_t) {
+    consumidor_ctx_t *c = (consumidor_ctx_t *)ctx;
+    const float escala = 1.0f / 32768.0f;
+    c->acumulado += expo(c->imu->saida[0] * escala, 0.3f) + constrain(c->imu->saida[1] * escala, -0.5f, 0.5f);
+    return true;
+}
+
+static bool corpoCarga(void *, uint64_t) { return true; }
+
+// ================== CENÁRIO ==================
+
+static imu_ctx_t g_gyro = {11, {0, 0, 0}, 0.0f, 0};
+static imu_ctx_t g_accel = {29, {0, 0, 0}, 0.0f, 0};
+static gps_ctx_t g_gps = {{0}, 7, {}, 0};
+static consumidor_ctx_t g_rate = {&g_gyro, 0.0f};
+static consumidor_ctx_t g_sensors = {&g_accel, 0.0f};
+
+enum { FILA_SPI0 = 0, FILA_RATE_CTRL, FILA_NAV, FILA_TTYS, FILA_LP };
+
+/**
+ * Cadeias como no PX4: bmi088_gyro -> rate_ctrl (fim = actuator_controls),
+ * bmi088_accel -> sensors -> ekf2; gps lê a serial a 100 Hz; mavlink e
+ * logger pesados e de baixa prioridade disputam os workers.
+ */
+static void montarCenario(wq_t *wq) {
+    wqReset(wq, 1, wq_politica_t::PRIORIDADE);
+
+    //               nome          corpo            ctx         prio fila            periodo prazo custo jitter encadeia
+    wqAdicionar(wq, {"bmi088_gyro", corpoGyro, &g_gyro, 250, FILA_SPI0, 1000, 500, 40, 10, 1});
+    wqAdicionar(wq, {"rate_ctrl", corpoConsumidor, &g_rate, 240, FILA_RATE_CTRL, 0, 1000, 90, 20, -1});
+    wqAdicionar(wq, {"bmi088_accel", corpoAccel, &g_accel, 250, FILA_SPI0, 2500, 1250, 40, 10, 3});
+    wqAdicionar(wq, {"sensors", corpoConsumidor, &g_sensors, 220, FILA_NAV, 0, 2500, 120, 30, 4});
+    wqAdicionar(wq, {"ekf2", corpoCarga, nullptr, 210, FILA_NAV, 0, 5000, 350, 100, -1});
+    wqAdicionar(wq, {"gps", corpoGps, &g_gps, 150, FILA_TTYS, 10000, 10000, 200, 50, -1});
+    wqAdicionar(wq, {"mavlink", corpoCarga, nullptr, 80, FILA_LP, 4000, 20000, 600, 200, -1});
+    wqAdicionar(wq, {"logger", corpoCarga, nullptr, 40, FILA_LP, 10000, 50000, 1800, 400, -1});
+}
+
+static const char *nomePolitica(wq_politica_t p) {
+    return p == wq_politica_t::PRIORIDADE ? "prioridade" : (p == wq_politica_t::FIFO ? "fifo" : "filas_px4");
+}
+
+static void imprimir(const wq_t *wq, const char *relogio, int workers) {
+    printf("\n[%s] politica=%s workers=%d\n", relogio, nomePolitica(wq->politica), workers);
+    printf("  %-13s %7s %10s %10s %10s %7s %11s %11s\n", "tarefa", "execs", "fila_med", "fila_max", "exec_med",
+           "prazo", "e2e_med", "e2e_max");
+
+    for (int i = 0; i < wq->num_tarefas; i++) {
+        const wq_tarefa_t *t = &wq->tarefas[i];
+        const wq_estatistica_t *e = &t->est;
+        const double n = e->execucoes ? (double)e->execucoes : 1.0;
+
+        printf("  %-13s %7llu %8.1fus %8lluus %8.1fus %7llu", t->nome, (unsigned long long)e->execucoes,
+               e->latencia_soma_us / n, (unsigned long long)e->latencia_max_us, e->exec_soma_us / n,
+               (unsigned long long)e->perdas_prazo);
+
+        if (e->e2e_amostras > 0) {
+            printf(" %9.1fus %9lluus\n", (double)e->e2e_soma_us / e->e2e_amostras, (unsigned long long)e->e2e_max_us);
+        } else {
+            printf(" %11s %11s\n", "-", "-");
+        }
+    }
+}
+
+// Resumo para comparar execuções: toda estatística de todas as tarefas
+static uint64_t impressao(const wq_t *wq) {
+    uint64_t h = 1469598103934665603ull;
+    for (int i = 0; i < wq->num_tarefas; i++) {
+        const uint8_t *p = (const uint8_t *)&wq->tarefas[i].est;
+        for (size_t k = 0; k < sizeof(wq_estatistica_t); k++) {
+            h = (h ^ p[k]) * 1099511628211ull;
+        }
+    }
+    return h;
+}
+
+// ================== BENCHMARK ==================
+
+int main(int argc, char **argv) {
+    const uint64_t duracao_ms = (argc > 1) ? (uint64_t)atoi(argv[1]) : 2000;
+    const int workers_max = (argc > 2) ? atoi(argv[2]) : 2;
+    const bool real = !(argc > 3 && strcmp(argv[3], "--so-simulado") == 0);
+
+    if (duracao_ms == 0 || workers_max <= 0 || workers_max > WQ_MAX_WORKERS) {
+        fprintf(stderr, "uso: %s [duracao_ms] [workers<=%d] [--so-simulado]\n", argv[0], WQ_MAX_WORKERS);
+        return 1;
+    }
+
+    static wq_t wq;
+    montarCenario(&wq);
+
+    const wq_politica_t politicas[] = {wq_politica_t::PRIORIDADE, wq_politica_t::FIFO, wq_politica_t::FILAS_PX4};
+    bool reprodutivel = true;
+
+    printf("cenario: %d tarefas, %llu ms simulados; prazo = perdas de prazo; e2e = amostra do sensor ate o fim da cadeia\n",
+           wq.num_tarefas, (unsigned long long)duracao_ms);
+
+    // 1) Relógio simulado: cada configuração roda duas vezes e precisa dar o mesmo resultado
+    for (int workers = 1; workers <= workers_max; workers++) {
+        for (wq_politica_t p : politicas) {
+            wqReiniciar(&wq, (uint8_t)workers, p);
+            wqRodar(&wq, wq_relogio_t::SIMULADO, duracao_ms * 1000);
+            const uint64_t h = impressao(&wq);
+            imprimir(&wq, "simulado", workers);
+
+            wqReiniciar(&wq, (uint8_t)workers, p);
+            wqRodar(&wq, wq_relogio_t::SIMULADO, duracao_ms * 1000);
+            reprodutivel = reprodutivel && impressao(&wq) == h;
+        }
+    }
+
+    printf("\nsimulado reprodutivel: %s\n", reprodutivel ? "sim" : "NAO");
+
+    // 2) Relógio real: mesmas políticas, custo declarado como carga ocupada
+    if (real) {
+        for (wq_politica_t p : politicas) {
+            wqReiniciar(&wq, (uint8_t)workers_max, p);
+            wqRodar(&wq, wq_relogio_t::REAL, duracao_ms * 1000 / 4);
+            imprimir(&wq, "real", workers_max);
+        }
+    }
+
+    printf("\nchecksum: gyro_saturadas=%llu gps_bytes=%llu rate=%.3f sensors=%.3f temp=%.2f\n",
+           (unsigned long long)g_gyro.saturadas, (unsigned long long)g_gps.bytes, g_rate.acumulado,
+           g_sensors.acumulado, g_accel.temperatura);
+    return reprodutivel ? 0 : 1;
+}
+
+#endif // MODO_NATIVO
+
+/*
+ * ================================================================
+ * DOCUMENTAÇÃO
+ * ================================================================
+ *
+ * EMULAÇÃO DE WORK QUEUES:
+ *
+ * 1. MODELO:
+ *    - WorkItem periódico (ScheduleOnInterval) ou encadeado por publicação
+ *      (callback uORB -> ScheduleNow); pendente duas vezes = uma execução
+ *    - Worker executa até o fim, sem preempção
+ *    - Políticas: PRIORIDADE (fila global), FIFO (fila global) e FILAS_PX4
+ *      (fila i atendida pelo worker i % workers, prioridade da fila)
+ *
+ * 2. RELÓGIOS:
+ *    - SIMULADO: eventos discretos com custo declarado + jitter xorshift;
+ *      mesma entrada = mesmas estatísticas (conferido a cada rodada)
+ *    - REAL: threads + steady_clock; custo declarado vira carga ocupada
+ *
+ * 3. MÉTRICAS POR TAREFA:
+ *    - Latência de fila (início - liberação), tempo de execução, perdas
+ *      de prazo, latência sensor-publicação no fim de cada cadeia
+ *
+ * 4. PROPRIEDADES VERIFICADAS (ESBMC):
+ *    - wqEscolher devolve só item elegível e respeita a política
+ *    - ScheduleNow repetido não duplica o item
+ *    - Contagens da simulação consistentes (execuções <= liberações,
+ *      encadeada só após publicação da raiz)
+ *
+ * COMANDOS DE EXECUÇÃO:
+ * esbmc escalonador.cpp --unwind 17 --overflow-check --bounds-check
+ * g++ -O2 -DMODO_NATIVO -pthread escalonador.cpp px4_funcoes.cpp -o escalonador && ./escalonador 2000 2
+ *
+ * BENCHMARK:
+ * - Tabela por tarefa para cada política com 1..N workers (simulado)
+ * - Mesmas políticas com N threads reais por 1/4 da duração
+ *
+ * ================================================================
+ */
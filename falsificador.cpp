@@ -0,0 +1,224 @@
+/**
+ * @file falsificador.cpp
+ * @author Dissertação Mestrado - Verificação Formal PX4 v1.16
+ *
+ * OBJETIVO: Estratégia de falsificação nativa do portfólio do esbmc_runner
+ * MÉTODO: O harness é compilado nativamente junto com esta unidade, que
+ *         implementa nondet_*() com sorteio enviesado para valores de
+ *         fronteira e __ESBMC_assume() como rejeição da execução. O teste
+ *         TESTE_ALVO roda em laço até o tempo acabar ou um assert falhar.
+ *
+ * VEREDITOS (mesmas frases do ESBMC, para o runner classificar igual):
+ *   VERIFICATION FAILED   assert violado ou acesso inválido (SIGSEGV/SIGBUS)
+ *   VERIFICATION UNKNOWN  orçamento esgotado sem violação (nunca prova nada)
+ *
+ * g++ -O1 -DMODO_NATIVO -DPX4_BIBLIOTECA -DTESTE_ALVO=test_xxx \
+ *     falsificador.cpp gpsdrive.cpp px4_funcoes.cpp -o falsificar
+ * ./falsificar [segundos] [semente]
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+#include <signal.h>
+#include <unistd.h>
+
+#ifndef TESTE_ALVO
+#error "defina -DTESTE_ALVO=test_xxx"
+#endif
+
+extern void TESTE_ALVO();
+
+#define FALSIFICADOR_STR2(x) #x
+#define FALSIFICADOR_STR(x) FALSIFICADOR_STR2(x)
+
+// ================== GERADOR ==================
+
+static uint64_t estado = 0x9E3779B97F4A7C15ULL;
+
+static uint64_t proximo() {
+    // xorshift64*
+    estado ^= estado >> 12;
+    estado ^= estado << 25;
+    estado ^= estado >> 27;
+    return estado * 0x2545F4914F6CDD1DULL;
+}
+
+// Entradas sorteadas na execução corrente, para o relatório do contraexemplo
+static constexpr int MAX_ENTRADAS = 64;
+static char entradas[MAX_ENTRADAS][48];
+static int num_entradas = 0;
+
+static void anotar(const char *tipo, long double v) {
+    if (num_entradas < MAX_ENTRADAS) {
+        snprintf(entradas[num_entradas], sizeof(entradas[0]), "%s=%.9Lg", tipo, v);
+    }
+
+    num_entradas++;
+}
+
+/**
+ * FUNÇÃO 1: sortearInteiro()
+ * ESPECIFICAÇÃO: 1/4 fronteiras (min, max, 0, ±1, min+1, max-1),
+ * 1/4 pequenos [-16, 300], 1/2 uniforme na largura do tipo. Os pequenos
+ * cobrem as faixas típicas das assumptions (input_len <= 300).
+ */
+template<typename T>
+static T sortearInteiro(const char *tipo) {
+    const T min = std::numeric_limits<T>::min();
+    const T max = std::numeric_limits<T>::max();
+    const uint64_t r = proximo();
+    T v;
+
+    switch (r & 3) {
+    case 0: {
+        const T fronteiras[] = {min, max, (T)0, (T)1, (T)(min + 1), (T)(max - 1), (T)-1};
+        v = fronteiras[(r >> 2) % (sizeof(fronteiras) / sizeof(fronteiras[0]))];
+        break;
+    }
+    case 1:
+        v = (T)((int64_t)((r >> 2) % 317) - 16);
+        break;
+    default:
+        v = (T)(r >> 2);
+        break;
+    }
+
+    anotar(tipo, (long double)v);
+    return v;
+}
+
+static float sortearFloat() {
+    const uint64_t r = proximo();
+    float v;
+
+    switch (r & 7) {
+    case 0: {
+        const float fronteiras[] = {0.0f, -0.0f, 1.0f, -1.0f, 0.5f, -0.5f, 1e-6f, -1e-6f,
+                                    std::numeric_limits<float>::denorm_min(), std::numeric_limits<float>::max(),
+                                    INFINITY, NAN};
+        v = fronteiras[(r >> 3) % (sizeof(fronteiras) / sizeof(fronteiras[0]))];
+        break;
+    }
+    case 1: {
+        const uint32_t bits = (uint32_t)(r >> 3);
+        memcpy(&v, &bits, sizeof(v));
+        break;
+    }
+    default:
+        v = (float)((double)(r >> 11) / (double)(1ULL << 53) * 4.0 - 2.0);   // [-2, 2)
+        break;
+    }
+
+    anotar("float", v);
+    return v;
+}
+
+// ================== MODELO DAS FUNÇÕES ESBMC ==================
+
+int nondet_int() { return sortearInteiro<int>("int"); }
+unsigned nondet_uint() { return sortearInteiro<unsigned>("uint"); }
+int8_t nondet_int8() { return sortearInteiro<int8_t>("int8"); }
+int16_t nondet_int16() { return sortearInteiro<int16_t>("int16"); }
+int32_t nondet_int32() { return sortearInteiro<int32_t>("int32"); }
+int64_t nondet_int64() { return sortearInteiro<int64_t>("int64"); }
+uint8_t nondet_uint8() { return sortearInteiro<uint8_t>("uint8"); }
+uint16_t nondet_uint16() { return sortearInteiro<uint16_t>("uint16"); }
+uint32_t nondet_uint32() { return sortearInteiro<uint32_t>("uint32"); }
+uint64_t nondet_uint64() { return sortearInteiro<uint64_t>("uint64"); }
+size_t nondet_size_t() { return sortearInteiro<size_t>("size_t"); }
+bool nondet_bool() { return sortearInteiro<uint8_t>("bool") & 1; }
+float nondet_float() { return sortearFloat(); }
+double nondet_double() { return sortearFloat(); }
+
+struct assume_rejeitada_t {};
+
+void __ESBMC_assume(int condition) {
+    if (!condition) {
+        throw assume_rejeitada_t();
+    }
+}
+
+// ================== CONTRAEXEMPLO ==================
+
+static unsigned long long execucoes = 0;
+
+static void reportarViolacao(int sinal) {
+    // Só funções async-signal-safe: o assert pode ter falhado em qualquer ponto
+    char buf[128];
+    int n = snprintf(buf, sizeof(buf), "\nVERIFICATION FAILED (%s) em %s, execucao %llu\nentradas:",
+                     sinal == SIGABRT ? "assert" : "acesso invalido", FALSIFICADOR_STR(TESTE_ALVO), execucoes);
+    (void)!write(STDOUT_FILENO, buf, n);
+
+    for (int i = 0; i < num_entradas && i < MAX_ENTRADAS; i++) {
+        (void)!write(STDOUT_FILENO, " ", 1);
+        (void)!write(STDOUT_FILENO, entradas[i], strlen(entradas[i]));
+    }
+
+    (void)!write(STDOUT_FILENO, "\n", 1);
+    _exit(1);
+}
+
+int main(int argc, char **argv) {
+    const double segundos = argc > 1 ? atof(argv[1]) : 10.0;
+    estado ^= argc > 2 ? strtoull(argv[2], nullptr, 10) * 0xBF58476D1CE4E5B9ULL : (uint64_t)getpid();
+
+    signal(SIGABRT, reportarViolacao);
+    signal(SIGSEGV, reportarViolacao);
+    signal(SIGBUS, reportarViolacao);
+
+    unsigned long long rejeitadas = 0;
+    const auto inicio = std::chrono::steady_clock::now();
+
+    for (;;) {
+        // Relógio consultado a cada 1024 execuções
+        for (int k = 0; k < 1024; k++) {
+            num_entradas = 0;
+            execucoes++;
+
+            try {
+                TESTE_ALVO();
+            } catch (const assume_rejeitada_t &) {
+                rejeitadas++;
+            }
+        }
+
+        if (std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count() > segundos) {
+            break;
+        }
+    }
+
+    printf("VERIFICATION UNKNOWN: %s sem violacao em %llu execucoes (%llu rejeitadas por assume)\n",
+           FALSIFICADOR_STR(TESTE_ALVO), execucoes, rejeitadas);
+    return 0;
+}
+
+/*
+ * ================================================================
+ * DOCUMENTAÇÃO
+ * ================================================================
+ *
+ * FALSIFICAÇÃO NATIVA:
+ *
+ * 1. MESMO HARNESS, OUTRA SEMÂNTICA DE nondet:
+ *    - O ESBMC trata nondet_*() como qualquer valor; aqui cada chamada
+ *      sorteia um valor concreto (fronteiras, pequenos e uniforme)
+ *    - __ESBMC_assume() falso descarta a execução (exceção)
+ *    - assert() do harness vira abort(): capturado e reportado com as
+ *      entradas sorteadas
+ *
+ * 2. PAPEL NO PORTFÓLIO:
+ *    - Só conclui FALHA; ausência de violação é UNKNOWN
+ *    - Milhões de execuções por segundo: acha bugs rasos antes do BMC
+ *
+ * COMANDOS DE EXECUÇÃO:
+ * g++ -O1 -DMODO_NATIVO -DPX4_BIBLIOTECA -DTESTE_ALVO=test_gyro_data_processing \
+ *     falsificador.cpp imu.cpp px4_funcoes.cpp -o falsificar && ./falsificar 5
+ *
+ * ================================================================
+ */
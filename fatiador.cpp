@@ -0,0 +1,1019 @@
+/**
+ * @file fatiador.cpp
+ * @author Dissertação Mestrado - Verificação Formal PX4 v1.16
+ *
+ * OBJETIVO: Fatiar cada test_* dos harnesses em harnesses mínimos, um por
+ *           assert e um por chamada de função do PX4 (sítios dos claims de
+ *           --overflow-check dentro de dumpGpsData, combine, expo, ...)
+ * MÉTODO: Fatiamento para trás no corpo do teste: a partir do alvo, mantém
+ *         só os comandos que definem variáveis das quais o alvo depende
+ *         (dados) e os cabeçalhos de if/for que o controlam (controle).
+ *         Comandos depois do alvo saem; asserts anteriores viram
+ *         __ESBMC_assume (assume-garantia: cada um é provado na sua fatia)
+ *
+ * SAÍDA: <dir>/<teste>__a<k>_<hash>.cpp (assert k) e __c<k> (chamada k),
+ *        com prelúdio do harness, a fatia e main() próprio; diretivas
+ *        #line mantêm arquivo:linha do original nos claims do ESBMC.
+ *        <dir>/fatias.tsv indexa as fatias. O hash é do conteúdo: fatia
+ *        que não mudou mantém o nome (e o resultado em cache).
+ *
+ * Ferramenta nativa (não é alvo de verificação):
+ * g++ -O2 -std=c++17 fatiador.cpp -o fatiador
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <sys/stat.h>
+
+// Funções de px4_funcoes.h: cada chamada é um sítio de claims de overflow/limites
+static const std::set<std::string> FUNCOES_PX4 = {
+    "dumpGpsData", "updateTemperature", "fifoReadCount", "processAccelData",
+    "processGyroData", "combine", "expo", "constrain",
+};
+
+static const std::set<std::string> PALAVRAS_RESERVADAS = {
+    "int", "float", "double", "bool", "char", "unsigned", "signed", "long", "short", "const", "static",
+    "true", "false", "return", "sizeof", "struct", "void", "auto", "if", "else", "for", "while", "do",
+    "break", "continue", "nullptr",
+};
+
+// ================== ÁRVORE DE COMANDOS ==================
+
+struct comando_t {
+    std::string texto;                      // Folha: comando inteiro, sem comentários em volta
+    int linha;                              // Linha do primeiro caractere no arquivo original
+    bool composto;
+
+    // Composto: ramos (if / else if / else) ou um ramo só (for, while, bloco)
+    std::vector<std::string> cabecas;
+    std::vector<int> linhas_cabeca;
+    std::vector<std::vector<comando_t>> ramos;
+    bool laco;
+
+    // Análise
+    std::set<std::string> defs;
+    std::set<std::string> usos;
+    bool manter;
+};
+
+struct leitor_t {
+    const std::string &s;
+    size_t i;
+    int linha;
+};
+
+static void avancar(leitor_t *r, size_t n) {
+    for (size_t k = 0; k < n && r->i < r->s.size(); k++) {
+        r->linha += r->s[r->i] == '\n' ? 1 : 0;
+        r->i++;
+    }
+}
+
+static void pularEspacosEComentarios(leitor_t *r) {
+    for (;;) {
+        while (r->i < r->s.size() && isspace((unsigned char)r->s[r->i])) {
+            avancar(r, 1);
+        }
+
+        if (r->s.compare(r->i, 2, "//") == 0) {
+            while (r->i < r->s.size() && r->s[r->i] != '\n') {
+                avancar(r, 1);
+            }
+        } else if (r->s.compare(r->i, 2, "/*") == 0) {
+            const size_t fim = r->s.find("*/", r->i + 2);
+            avancar(r, (fim == std::string::npos ? r->s.size() : fim + 2) - r->i);
+        } else {
+            return;
+        }
+    }
+}
+
+// Texto até o delimitador 'fim' no nível 0 de parênteses/chaves (inclusive)
+static std::string lerAte(leitor_t *r, char fim) {
+    const size_t ini = r->i;
+    int prof = 0;
+
+    while (r->i < r->s.size()) {
+        const char c = r->s[r->i];
+
+        if (r->s.compare(r->i, 2, "//") == 0 || r->s.compare(r->i, 2, "/*") == 0) {
+            pularEspacosEComentarios(r);
+            continue;
+        }
+
+        avancar(r, 1);
+
+        if (c == '(' || c == '[' || c == '{') {
+            prof++;
+        } else if (c == ')' || c == ']' || c == '}') {
+            prof--;
+        }
+
+        if (prof == 0 && c == fim) {
+            break;
+        }
+    }
+
+    return r->s.substr(ini, r->i - ini);
+}
+
+static bool comecaCom(const leitor_t *r, const char *palavra) {
+    const size_t n = strlen(palavra);
+    return r->s.compare(r->i, n, palavra) == 0 &&
+           (r->i + n >= r->s.size() || !(isalnum((unsigned char)r->s[r->i + n]) || r->s[r->i + n] == '_'));
+}
+
+static std::vector<comando_t> lerBloco(leitor_t *r);
+static comando_t lerComando(leitor_t *r);
+
+static std::vector<comando_t> lerCorpo(leitor_t *r) {
+    pularEspacosEComentarios(r);
+
+    if (r->i < r->s.size() && r->s[r->i] == '{') {
+        avancar(r, 1);
+        std::vector<comando_t> filhos = lerBloco(r);
+        avancar(r, 1);      // '}'
+        return filhos;
+    }
+
+    // Corpo sem chaves: um comando só
+    return {lerComando(r)};
+}
+
+/**
+ * FUNÇÃO 1: lerComando()
+ * ESPECIFICAÇÃO: Um comando a partir da posição atual (já sem espaços).
+ * if/else if/else viram um composto com vários ramos; for/while e
+ * blocos soltos, composto de um ramo; o resto é folha até o ';'.
+ */
+static comando_t lerComando(leitor_t *r) {
+    comando_t c = {};
+    c.linha = r->linha;
+
+    if (!(comecaCom(r, "if") || comecaCom(r, "for") || comecaCom(r, "while") || r->s[r->i] == '{')) {
+        c.texto = lerAte(r, ';');
+        return c;
+    }
+
+    c.composto = true;
+    c.laco = !comecaCom(r, "if") && r->s[r->i] != '{';
+
+    if (r->s[r->i] == '{') {
+        c.cabecas.push_back("");
+    } else {
+        const size_t par = r->s.find('(', r->i);
+        const std::string palavra = r->s.substr(r->i, par - r->i);
+        avancar(r, par - r->i);
+        c.cabecas.push_back(palavra + lerAte(r, ')'));
+    }
+
+    c.linhas_cabeca.push_back(c.linha);
+    c.ramos.push_back(lerCorpo(r));
+
+    // Cadeia else if / else
+    while (!c.laco && c.cabecas.front() != "") {
+        leitor_t olhar = *r;
+        pularEspacosEComentarios(&olhar);
+
+        if (!comecaCom(&olhar, "else")) {
+            break;
+        }
+
+        r->i = olhar.i;
+        r->linha = olhar.linha;
+        const int linha_else = r->linha;
+        avancar(r, 4);
+        pularEspacosEComentarios(r);
+
+        std::string cabeca = "else";
+        if (comecaCom(r, "if")) {
+            const size_t par = r->s.find('(', r->i);
+            avancar(r, par - r->i);
+            cabeca = "else if " + lerAte(r, ')');
+        }
+
+        c.cabecas.push_back(cabeca);
+        c.linhas_cabeca.push_back(linha_else);
+        c.ramos.push_back(lerCorpo(r));
+
+        if (cabeca == "else") {
+            break;
+        }
+    }
+
+    return c;
+}
+
+// Comandos até o '}' que fecha o bloco (não consumido)
+static std::vector<comando_t> lerBloco(leitor_t *r) {
+    std::vector<comando_t> cmds;
+
+    for (;;) {
+        pularEspacosEComentarios(r);
+
+        if (r->i >= r->s.size() || r->s[r->i] == '}') {
+            return cmds;
+        }
+
+        cmds.push_back(lerComando(r));
+    }
+}
+
+// ================== DEPENDÊNCIAS ==================
+
+static bool ehVariavel(const std::string &s, size_t ini, size_t fim) {
+    const std::string id = s.substr(ini, fim - ini);
+
+    if (PALAVRAS_RESERVADAS.count(id)) {
+        return false;
+    }
+
+    // Tipos do repositório: uint8_t, gps_dump_s, gps_dump_comm_mode_t
+    if (id.size() > 2 && id[id.size() - 2] == '_' && (id.back() == 't' || id.back() == 's')) {
+        return false;
+    }
+
+    // Constantes/macros em maiúsculas (GPS_DUMP_DATA_SIZE, INT16_MIN, ...)
+    if (std::none_of(id.begin(), id.end(), [](char c) { return islower((unsigned char)c); })) {
+        return false;
+    }
+
+    size_t depois = fim;
+    while (depois < s.size() && isspace((unsigned char)s[depois])) {
+        depois++;
+    }
+
+    if (depois < s.size() && s[depois] == '(') {
+        return false;       // Chamada de função
+    }
+
+    if ((ini >= 1 && s[ini - 1] == '.') || (ini >= 2 && s.compare(ini - 2, 2, "->") == 0) ||
+        (ini >= 2 && s.compare(ini - 2, 2, "::") == 0)) {
+        return false;       // Membro ou enumerador
+    }
+
+    return true;
+}
+
+struct identificador_t {
+    std::string nome;
+    size_t pos;
+};
+
+static std::vector<identificador_t> variaveisDe(const std::string &s) {
+    std::vector<identificador_t> r;
+
+    for (size_t i = 0; i < s.size();) {
+        if (isalpha((unsigned char)s[i]) || s[i] == '_') {
+            size_t j = i;
+            while (j < s.size() && (isalnum((unsigned char)s[j]) || s[j] == '_')) {
+                j++;
+            }
+
+            if ((i == 0 || !isdigit((unsigned char)s[i - 1])) && ehVariavel(s, i, j)) {
+                r.push_back({s.substr(i, j - i), i});
+            }
+            i = j;
+        } else {
+            i++;
+        }
+    }
+
+    return r;
+}
+
+static bool ehAssert(const std::string &t) { return t.compare(0, 7, "assert(") == 0 || t.compare(0, 8, "assert (") == 0; }
+static bool ehAssume(const std::string &t) { return t.compare(0, 15, "__ESBMC_assume(") == 0; }
+
+static bool chamaFuncaoPx4(const std::string &t) {
+    for (const std::string &f : FUNCOES_PX4) {
+        size_t p = t.find(f);
+
+        while (p != std::string::npos) {
+            const size_t fim = p + f.size();
+            const bool inicio_ok = p == 0 || !(isalnum((unsigned char)t[p - 1]) || t[p - 1] == '_');
+            size_t q = fim;
+            while (q < t.size() && isspace((unsigned char)t[q])) {
+                q++;
+            }
+
+            if (inicio_ok && q < t.size() && t[q] == '(') {
+                return true;
+            }
+            p = t.find(f, fim);
+        }
+    }
+
+    return false;
+}
+
+/**
+ * FUNÇÃO 2: analisarFolha()
+ * ESPECIFICAÇÃO: defs = variáveis declaradas, lado esquerdo de atribuição
+ * e argumentos passados por endereço (&x) ou arrays (x[] decai para
+ * ponteiro) em chamadas; usos = todas as variáveis do comando.
+ */
+static void analisarFolha(comando_t *c, const std::set<std::string> &arrays) {
+    const std::string &t = c->texto;
+    const std::vector<identificador_t> vars = variaveisDe(t);
+
+    for (const identificador_t &v : vars) {
+        c->usos.insert(v.nome);
+    }
+
+    if (ehAssert(t) || ehAssume(t)) {
+        return;
+    }
+
+    // Declaração: começa com tipo (primeiro identificador não é variável)
+    size_t k = 0;
+    while (k < t.size() && (isalnum((unsigned char)t[k]) || t[k] == '_')) {
+        k++;
+    }
+
+    const bool declaracao = k > 0 && (vars.empty() || vars.front().pos > 0) && !chamaFuncaoPx4(t.substr(0, k + 1));
+
+    if (declaracao) {
+        // Declaradores separados por vírgula no nível 0: nome = primeira variável de cada um
+        int prof = 0;
+        bool esperando_nome = true;
+
+        for (const identificador_t &v : vars) {
+            for (size_t p = k; p < v.pos; p++) {
+                prof += (t[p] == '(' || t[p] == '[') ? 1 : ((t[p] == ')' || t[p] == ']') ? -1 : 0);
+                esperando_nome = esperando_nome || (prof == 0 && t[p] == ',');
+            }
+            k = v.pos;
+
+            if (esperando_nome && prof == 0) {
+                c->defs.insert(v.nome);
+                c->usos.erase(v.nome);      // Declarado aqui, não lido
+                esperando_nome = false;
+            }
+        }
+    }
+
+    // Atribuição: '=' no nível 0 que não é comparação
+    for (size_t p = 0; p < t.size(); p++) {
+        if (t[p] != '=' || (p + 1 < t.size() && t[p + 1] == '=') ||
+            (p > 0 && (t[p - 1] == '=' || t[p - 1] == '!' || ((t[p - 1] == '<' || t[p - 1] == '>') &&
+                                                               !(p > 1 && t[p - 2] == t[p - 1]))))) {
+            continue;
+        }
+
+        const std::vector<identificador_t> lhs = variaveisDe(t.substr(0, p));
+        if (!lhs.empty()) {
+            c->defs.insert(declaracao ? lhs.back().nome : lhs.front().nome);
+        }
+        break;
+    }
+
+    if (t.find("++") != std::string::npos || t.find("--") != std::string::npos) {
+        if (!vars.empty()) {
+            c->defs.insert(vars.front().nome);
+        }
+    }
+
+    // Chamadas: &x e arrays podem ser escritos pela função
+    if (t.find('(') != std::string::npos) {
+        for (const identificador_t &v : vars) {
+            if ((v.pos > 0 && t[v.pos - 1] == '&') || arrays.count(v.nome)) {
+                c->defs.insert(v.nome);
+            }
+        }
+    }
+}
+
+static void coletarArrays(const std::vector<comando_t> &cmds, std::set<std::string> *arrays) {
+    for (const comando_t &c : cmds) {
+        if (c.composto) {
+            for (const auto &r : c.ramos) {
+                coletarArrays(r, arrays);
+            }
+            continue;
+        }
+
+        for (const identificador_t &v : variaveisDe(c.texto)) {
+            size_t p = v.pos + v.nome.size();
+            if (p < c.texto.size() && c.texto[p] == '[' && c.texto.find('=') == std::string::npos) {
+                arrays->insert(v.nome);
+            }
+        }
+    }
+}
+
+// ================== FATIAMENTO ==================
+
+struct alvo_t {
+    std::vector<size_t> caminho;    // Índices alternados: comando, ramo, comando, ramo, ..., comando
+    char tipo;                      // 'a' assert, 'c' chamada PX4
+    int linha;
+    std::string texto;
+};
+
+static void encontrarAlvos(const std::vector<comando_t> &cmds, std::vector<size_t> prefixo, std::vector<alvo_t> *alvos) {
+    for (size_t i = 0; i < cmds.size(); i++) {
+        std::vector<size_t> caminho = prefixo;
+        caminho.push_back(i);
+
+        if (cmds[i].composto) {
+            for (size_t r = 0; r < cmds[i].ramos.size(); r++) {
+                std::vector<size_t> sub = caminho;
+                sub.push_back(r);
+                encontrarAlvos(cmds[i].ramos[r], sub, alvos);
+            }
+        } else if (ehAssert(cmds[i].texto)) {
+            alvos->push_back({caminho, 'a', cmds[i].linha, cmds[i].texto});
+        } else if (chamaFuncaoPx4(cmds[i].texto)) {
+            alvos->push_back({caminho, 'c', cmds[i].linha, cmds[i].texto});
+        }
+    }
+}
+
+// Folhas na ordem de execução, até o alvo (laços que contêm o alvo entram inteiros)
+static void folhasAte(std::vector<comando_t> *cmds, const std::vector<size_t> &caminho, size_t nivel, bool em_laco,
+                      std::vector<comando_t *> *folhas);
+
+static void todasFolhas(std::vector<comando_t> *cmds, std::vector<comando_t *> *folhas) {
+    for (comando_t &c : *cmds) {
+        if (c.composto) {
+            for (auto &r : c.ramos) {
+                todasFolhas(&r, folhas);
+            }
+        } else {
+            folhas->push_back(&c);
+        }
+    }
+}
+
+static void folhasAte(std::vector<comando_t> *cmds, const std::vector<size_t> &caminho, size_t nivel, bool em_laco,
+                      std::vector<comando_t *> *folhas) {
+    const size_t alvo = caminho[nivel];
+    const size_t fim = em_laco ? cmds->size() : alvo + 1;
+
+    for (size_t i = 0; i < fim; i++) {
+        comando_t &c = (*cmds)[i];
+
+        if (i == alvo && nivel + 1 < caminho.size()) {
+            for (size_t r = 0; r < c.ramos.size(); r++) {
+                if (r == caminho[nivel + 1]) {
+                    folhasAte(&c.ramos[r], caminho, nivel + 2, em_laco || c.laco, folhas);
+                }
+            }
+        } else if (c.composto) {
+            todasFolhas(&c.ramos.front(), folhas);
+            for (size_t r = 1; r < c.ramos.size(); r++) {
+                todasFolhas(&c.ramos[r], folhas);
+            }
+        } else {
+            folhas->push_back(&c);
+        }
+    }
+}
+
+static bool contemManter(const std::vector<comando_t> &cmds) {
+    for (const comando_t &c : cmds) {
+        if (c.composto ? std::any_of(c.ramos.begin(), c.ramos.end(), contemManter) : c.manter) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool contemFolha(const std::vector<comando_t> &cmds, const comando_t *folha) {
+    for (const comando_t &c : cmds) {
+        if (&c == folha || std::any_of(c.ramos.begin(), c.ramos.end(),
+                                       [&](const std::vector<comando_t> &r) { return contemFolha(r, folha); })) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void limparMarcas(std::vector<comando_t> *cmds) {
+    for (comando_t &c : *cmds) {
+        c.manter = false;
+        for (auto &r : c.ramos) {
+            limparMarcas(&r);
+        }
+    }
+}
+
+// Laço mais externo no caminho até o alvo (nullptr se o alvo não está em laço)
+static comando_t *lacoDoAlvo(std::vector<comando_t> *cmds, const std::vector<size_t> &caminho) {
+    for (size_t n = 0; n + 1 < caminho.size(); n += 2) {
+        comando_t &c = (*cmds)[caminho[n]];
+        if (c.laco) {
+            return &c;
+        }
+        cmds = &c.ramos[caminho[n + 1]];
+    }
+    return nullptr;
+}
+
+/**
+ * FUNÇÃO 3: marcarFatia()
+ * ESPECIFICAÇÃO: Ponto fixo sobre as folhas anteriores ao alvo. Uma folha
+ * fica se define variável relevante, se é assume/assert que restringe
+ * variável relevante, ou se é ESTREITO_CHECAR(). Cabeçalhos de compostos
+ * com folha mantida (e os do caminho até o alvo) tornam suas variáveis
+ * relevantes (dependência de controle). O corpo do laço que contém o
+ * alvo fica inteiro: o que vem depois do alvo roda antes da próxima
+ * iteração (inclusive break/continue).
+ */
+static void marcarFatia(std::vector<comando_t> *corpo, const alvo_t &alvo, comando_t *folha_alvo) {
+    limparMarcas(corpo);
+
+    std::vector<comando_t *> folhas;
+    folhasAte(corpo, alvo.caminho, 0, false, &folhas);
+
+    std::set<std::string> relevantes = folha_alvo->usos;
+    folha_alvo->manter = true;
+
+    comando_t *laco = lacoDoAlvo(corpo, alvo.caminho);
+    if (laco) {
+        std::vector<comando_t *> corpo_laco;
+        todasFolhas(&laco->ramos.front(), &corpo_laco);
+
+        for (comando_t *f : corpo_laco) {
+            f->manter = true;
+            relevantes.insert(f->usos.begin(), f->usos.end());
+            relevantes.insert(f->defs.begin(), f->defs.end());
+        }
+    }
+
+    for (bool mudou = true; mudou;) {
+        mudou = false;
+
+        for (comando_t *f : folhas) {
+            if (f->manter) {
+                continue;
+            }
+
+            const bool restricao = ehAssume(f->texto) || ehAssert(f->texto);
+            bool toca = f->texto.compare(0, 15, "ESTREITO_CHECAR") == 0;
+
+            for (const std::string &v : restricao ? f->usos : f->defs) {
+                toca = toca || relevantes.count(v);
+            }
+
+            if (toca) {
+                f->manter = true;
+                relevantes.insert(f->usos.begin(), f->usos.end());
+                relevantes.insert(f->defs.begin(), f->defs.end());
+                mudou = true;
+            }
+        }
+
+        // Controle: cabeçalhos dos compostos com algo mantido
+        std::vector<comando_t> *nivel = corpo;
+        std::vector<std::vector<comando_t> *> pilha = {corpo};
+
+        while (!pilha.empty()) {
+            nivel = pilha.back();
+            pilha.pop_back();
+
+            for (comando_t &c : *nivel) {
+                if (!c.composto || !std::any_of(c.ramos.begin(), c.ramos.end(), contemManter)) {
+                    continue;
+                }
+
+                for (const std::string &cab : c.cabecas) {
+                    for (const identificador_t &v : variaveisDe(cab)) {
+                        mudou = relevantes.insert(v.nome).second || mudou;
+                    }
+                }
+
+                for (auto &r : c.ramos) {
+                    pilha.push_back(&r);
+                }
+            }
+        }
+    }
+}
+
+// ================== EMISSÃO ==================
+
+static std::string aparar(const std::string &s) {
+    const size_t a = s.find_first_not_of(" \t\r\n");
+    const size_t b = s.find_last_not_of(" \t\r\n");
+    return a == std::string::npos ? "" : s.substr(a, b - a + 1);
+}
+
+static void emitirLinha(std::ostringstream &o, const std::string &arquivo, int linha, int recuo, const std::string &t) {
+    o << "#line " << linha << " \"" << arquivo << "\"\n" << std::string(recuo * 4, ' ') << t << "\n";
+}
+
+/**
+ * FUNÇÃO 4: emitir()
+ * ESPECIFICAÇÃO: Reescrever só o que foi marcado. No caminho do alvo os
+ * ramos que não levam a ele ficam vazios (a condição continua decidindo
+ * qual ramo executa); asserts mantidos que não são o alvo saem como
+ * __ESBMC_assume. Dentro do laço que contém o alvo a emissão segue até
+ * o fim do corpo; só depois do laço não há mais nada.
+ */
+static void emitir(const std::vector<comando_t> &cmds, const comando_t *folha_alvo, const std::string &arquivo,
+                   int recuo, bool em_laco, std::ostringstream &o, int *linhas) {
+    for (const comando_t &c : cmds) {
+        if (!c.composto) {
+            if (!c.manter) {
+                continue;
+            }
+
+            std::string t = aparar(c.texto);
+            if (&c != folha_alvo && ehAssert(t)) {
+                t = "__ESBMC_assume" + t.substr(t.find('('));
+            }
+
+            emitirLinha(o, arquivo, c.linha, recuo, t);
+            (*linhas)++;
+
+            if (&c == folha_alvo && !em_laco) {
+                return;
+            }
+            continue;
+        }
+
+        if (!std::any_of(c.ramos.begin(), c.ramos.end(), contemManter)) {
+            continue;
+        }
+
+        const bool contem_alvo = std::any_of(c.ramos.begin(), c.ramos.end(),
+                                             [&](const std::vector<comando_t> &r) { return contemFolha(r, folha_alvo); });
+
+        for (size_t r = 0; r < c.ramos.size(); r++) {
+            const std::string cab = c.cabecas[r].empty() ? "{" : (r > 0 ? "} " : "") + aparar(c.cabecas[r]) + " {";
+            emitirLinha(o, arquivo, c.linhas_cabeca[r], recuo, cab);
+            (*linhas)++;
+            emitir(c.ramos[r], folha_alvo, arquivo, recuo + 1, em_laco || (contem_alvo && c.laco), o, linhas);
+        }
+
+        o << std::string(recuo * 4, ' ') << "}\n";
+
+        // Depois do composto que contém o alvo não há mais nada (salvo dentro do laço do alvo)
+        if (contem_alvo && !em_laco) {
+            return;
+        }
+    }
+}
+
+static comando_t *folhaNoCaminho(std::vector<comando_t> *cmds, const std::vector<size_t> &caminho) {
+    comando_t *c = nullptr;
+
+    for (size_t n = 0; n < caminho.size(); n += 2) {
+        c = &(*cmds)[caminho[n]];
+        if (n + 1 < caminho.size()) {
+            cmds = &c->ramos[caminho[n + 1]];
+        }
+    }
+
+    return c;
+}
+
+static uint64_t fnv1a(const std::string &s) {
+    uint64_t h = 1469598103934665603ULL;
+    for (unsigned char c : s) {
+        h ^= c;
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+static void analisarTudo(std::vector<comando_t> *cmds, const std::set<std::string> &arrays) {
+    for (comando_t &c : *cmds) {
+        if (c.composto) {
+            for (auto &r : c.ramos) {
+                analisarTudo(&r, arrays);
+            }
+        } else {
+            analisarFolha(&c, arrays);
+        }
+    }
+}
+
+// ================== INCLUDES DA FATIA ==================
+
+/**
+ * Caminho de 'de' até 'para' (diretórios), com '/' no fim; "" se forem o
+ * mesmo ou se algum não existir.
+ */
+static std::string caminhoRelativo(const std::string &de, const std::string &para) {
+    char *a = realpath(de.c_str(), nullptr);
+    char *b = realpath(para.c_str(), nullptr);
+    std::string ra = a ? a : "", rb = b ? b : "";
+    free(a);
+    free(b);
+
+    if (ra.empty() || rb.empty() || ra == rb) {
+        return "";
+    }
+
+    auto partes = [](const std::string &c) {
+        std::vector<std::string> v;
+        std::istringstream ss(c);
+        for (std::string p; std::getline(ss, p, '/');) {
+            if (!p.empty()) {
+                v.push_back(p);
+            }
+        }
+        return v;
+    };
+
+    const std::vector<std::string> pa = partes(ra), pb = partes(rb);
+    size_t comum = 0;
+    while (comum < pa.size() && comum < pb.size() && pa[comum] == pb[comum]) {
+        comum++;
+    }
+
+    std::string rel;
+    for (size_t i = comum; i < pa.size(); i++) {
+        rel += "../";
+    }
+    for (size_t i = comum; i < pb.size(); i++) {
+        rel += pb[i] + "/";
+    }
+
+    return rel;
+}
+
+/**
+ * #include "x.h" do prelúdio resolve a partir do diretório do harness; na
+ * fatia, em outro diretório, vira #include "<prefixo>x.h" (mesma busca,
+ * sem depender de -I).
+ */
+static std::string reescreverIncludes(const std::string &preludio, const std::string &prefixo) {
+    if (prefixo.empty()) {
+        return preludio;
+    }
+
+    std::istringstream linhas(preludio);
+    std::string saida;
+
+    for (std::string linha; std::getline(linhas, linha);) {
+        const size_t inc = linha.find("#include \"");
+
+        if (inc != std::string::npos && linha.compare(inc + 10, 1, "/") != 0) {
+            linha.insert(inc + 10, prefixo);
+        }
+
+        saida += linha + "\n";
+    }
+
+    return saida;
+}
+
+// ================== MAIN ==================
+
+struct teste_t {
+    std::string nome;
+    int linha;
+    std::vector<comando_t> corpo;
+    int linhas_originais;
+};
+
+/**
+ * FUNÇÃO 5: fatiarHarness()
+ * ESPECIFICAÇÃO: Prelúdio = tudo antes do banner de testes (includes,
+ * nondet, cópias das funções ou px4_funcoes.h). Cada alvo de cada teste
+ * vira um arquivo; retorna o número de fatias escritas.
+ */
+static int fatiarHarness(const std::string &arquivo, const std::string &dir, FILE *indice) {
+    std::ifstream in(arquivo, std::ios::binary);
+    if (!in) {
+        fprintf(stderr, "nao consegui ler %s\n", arquivo.c_str());
+        return 0;
+    }
+
+    std::ostringstream ss;
+    ss << in.rdbuf();
+    std::string fonte = ss.str();
+    fonte.erase(std::remove(fonte.begin(), fonte.end(), '\r'), fonte.end());
+
+    size_t fim_preludio = fonte.find("// ================== TESTES");
+    if (fim_preludio == std::string::npos) {
+        fim_preludio = fonte.find("\nvoid test_");
+    }
+
+    const size_t barra = arquivo.rfind('/');
+    const std::string base = arquivo.substr(barra == std::string::npos ? 0 : barra + 1);
+    const std::string dir_harness = barra == std::string::npos ? "." : arquivo.substr(0, barra + 1);
+    const std::string preludio = reescreverIncludes(fonte.substr(0, fim_preludio), caminhoRelativo(dir, dir_harness));
+    int escritas = 0;
+
+    for (size_t p = fonte.find("\nvoid test_", fim_preludio); p != std::string::npos;
+         p = fonte.find("\nvoid test_", p + 1)) {
+        teste_t t;
+        t.linha = (int)std::count(fonte.begin(), fonte.begin() + p + 1, '\n') + 1;
+        t.nome = fonte.substr(p + 6, fonte.find('(', p) - p - 6);
+
+        leitor_t r = {fonte, fonte.find('{', p), t.linha};
+        while (fonte.compare(r.i, 1, "{") != 0) {
+            avancar(&r, 1);
+        }
+        avancar(&r, 1);
+
+        const int linha_ini = r.linha;
+        t.corpo = lerBloco(&r);
+        t.linhas_originais = r.linha - linha_ini;
+
+        std::set<std::string> arrays;
+        coletarArrays(t.corpo, &arrays);
+        analisarTudo(&t.corpo, arrays);
+
+        std::vector<alvo_t> alvos;
+        encontrarAlvos(t.corpo, {}, &alvos);
+        int n_assert = 0, n_chamada = 0;
+
+        for (const alvo_t &a : alvos) {
+            comando_t *folha = folhaNoCaminho(&t.corpo, a.caminho);
+            marcarFatia(&t.corpo, a, folha);
+
+            const std::string sufixo = std::string(1, a.tipo) + std::to_string(a.tipo == 'a' ? ++n_assert : ++n_chamada);
+
+            std::ostringstream corpo;
+            int linhas = 0;
+            emitir(t.corpo, folha, base, 1, false, corpo, &linhas);
+
+            char hex[9];
+            snprintf(hex, sizeof(hex), "%08x", (unsigned)(fnv1a(preludio + corpo.str()) & 0xFFFFFFFFu));
+            const std::string funcao = t.nome + "__" + sufixo;
+            const std::string saida = dir + "/" + funcao + "_" + hex + ".cpp";
+
+            std::ofstream out(saida, std::ios::binary | std::ios::trunc);
+            out << "// Fatia gerada por fatiador.cpp de " << base << ":" << a.linha << " (" << t.nome << ")\n"
+                << "// Alvo: " << aparar(a.texto.substr(0, a.texto.find('\n'))) << "\n"
+                << "// Não editar: regenerar com ./fatiador " << base << "\n\n"
+                << preludio << "// ================== FATIA ==================\n\n"
+                << "void " << funcao << "() {\n" << corpo.str() << "}\n\n"
+                << "#ifndef PX4_BIBLIOTECA\nint main() {\n    " << funcao << "();\n    return 0;\n}\n#endif\n";
+
+            fprintf(indice, "%s\t%s\t%s\t%c\t%d\t%d\t%d\t%s\n", saida.c_str(), base.c_str(), t.nome.c_str(), a.tipo,
+                    a.linha, t.linhas_originais, linhas, aparar(a.texto.substr(0, a.texto.find('\n'))).c_str());
+            escritas++;
+        }
+    }
+
+    return escritas;
+}
+
+/**
+ * FUNÇÃO 6: autoteste()
+ * ESPECIFICAÇÃO: Regressões do fatiamento sobre corpos de teste conhecidos;
+ * devolve o número de fatias que perderam um comando obrigatório.
+ */
+static int autoteste() {
+    static const struct {
+        const char *corpo;
+        size_t alvo;
+        const char *obrigatorio;
+    } casos[] = {
+        // Alvo dentro do laço: x++ depois do assert alimenta a próxima iteração
+        {"int x = nondet_int();\n__ESBMC_assume(x < 3);\nfor (int i = 0; i < 5; i++) {\n    assert(x < 8);\n"
+         "    x++;\n}\n",
+         0, "x++;"},
+        // Laço aninhado: o corpo do laço externo entra inteiro
+        {"int x = 0;\nfor (int i = 0; i < 3; i++) {\n    if (i > 0) {\n        assert(x < 3);\n    }\n"
+         "    x = x + 1;\n}\n",
+         0, "x = x + 1;"},
+        // Depois do laço que contém o alvo não há mais nada
+        {"int x = 0;\nfor (int i = 0; i < 3; i++) {\n    assert(x < 3);\n    x++;\n}\nx = 7;\n", 0, "x++;"},
+    };
+
+    int falhas = 0;
+    for (const auto &c : casos) {
+        const std::string fonte = c.corpo;
+        leitor_t r = {fonte, 0, 1};
+        std::vector<comando_t> corpo = lerBloco(&r);
+
+        std::set<std::string> arrays;
+        coletarArrays(corpo, &arrays);
+        analisarTudo(&corpo, arrays);
+
+        std::vector<alvo_t> alvos;
+        encontrarAlvos(corpo, {}, &alvos);
+
+        const alvo_t &a = alvos.at(c.alvo);
+        comando_t *folha = folhaNoCaminho(&corpo, a.caminho);
+        marcarFatia(&corpo, a, folha);
+
+        std::ostringstream fatia;
+        int linhas = 0;
+        emitir(corpo, folha, "autoteste.cpp", 1, false, fatia, &linhas);
+
+        if (fatia.str().find(c.obrigatorio) == std::string::npos || fatia.str().find("x = 7;") != std::string::npos) {
+            printf("FALHA fatia de '%s' sem '%s':\n%s\n", a.texto.c_str(), c.obrigatorio, fatia.str().c_str());
+            falhas++;
+        }
+    }
+
+    printf("autoteste: %d falha(s)\n", falhas);
+    return falhas;
+}
+
+int main(int argc, char **argv) {
+    std::string dir = "fatias";
+    std::vector<std::string> harnesses;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string a = argv[i];
+
+        if (a == "--saida" && i + 1 < argc) {
+            dir = argv[++i];
+        } else if (a == "--autoteste") {
+            return autoteste() == 0 ? 0 : 1;
+        } else if (a[0] != '-') {
+            harnesses.push_back(a);
+        } else {
+            fprintf(stderr, "uso: %s [--saida DIR] [--autoteste] [harness.cpp ...]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    if (harnesses.empty()) {
+        harnesses = {"gpsdrive.cpp", "imu.cpp", "Flight.cpp"};
+    }
+
+    mkdir(dir.c_str(), 0755);
+    FILE *indice = fopen((dir + "/fatias.tsv").c_str(), "w");
+    if (!indice) {
+        perror(dir.c_str());
+        return 1;
+    }
+
+    fprintf(indice, "arquivo\tharness\tteste\ttipo\tlinha\tlinhas_teste\tlinhas_fatia\talvo\n");
+
+    int total = 0;
+    for (const std::string &h : harnesses) {
+        const int n = fatiarHarness(h, dir, indice);
+        printf("%-14s %3d fatias\n", h.c_str(), n);
+        total += n;
+    }
+
+    fclose(indice);
+    printf("%d fatias em %s/ (indice em %s/fatias.tsv)\n", total, dir.c_str(), dir.c_str());
+    return 0;
+}
+
+/*
+ * ================================================================
+ * DOCUMENTAÇÃO
+ * ================================================================
+ *
+ * FATIAMENTO POR ASSERTIVA:
+ *
+ * 1. ALVOS:
+ *    - Cada assert() de cada test_*: uma fatia __a<k>
+ *    - Cada chamada de função de px4_funcoes.h: uma fatia __c<k>; os
+ *      claims de --overflow-check e limites dentro da função ficam nela
+ *
+ * 2. O QUE FICA NA FATIA:
+ *    - Dados: comandos que definem variável usada pelo alvo (declaração,
+ *      atribuição, &x ou array passado a função), transitivamente
+ *    - Restrições: __ESBMC_assume que menciona variável relevante
+ *    - Controle: cabeçalhos de if/for que levam ao alvo ou a comando
+ *      mantido; ramos que não levam ao alvo ficam vazios
+ *    - Asserts anteriores mantidos viram __ESBMC_assume: a fatia do alvo
+ *      supõe as anteriores, que são provadas nas próprias fatias
+ *      (solidez exige verificar todas as fatias de um teste)
+ *
+ * 3. RASTREABILIDADE E CACHE:
+ *    - #line leva os claims de volta a <harness>:<linha> original: o
+ *      diff_resultados compara fatias com a rodada sem fatiamento
+ *    - Nome com hash do conteúdo: editar outro teste não muda a fatia
+ *
+ * 4. INCLUDES:
+ *    - #include "..." do prelúdio ganha o caminho do diretório da fatia
+ *      até o do harness (fatias/ -> "../px4_funcoes.h"): a fatia compila
+ *      sem -I e o esbmc_runner acha os headers para a chave do cache
+ *
+ * 5. LAÇOS:
+ *    - Alvo dentro de laço: o corpo do laço mais externo que o contém
+ *      entra inteiro, inclusive o que vem depois do alvo (x++ depois de
+ *      assert(x < 8) muda a próxima iteração); os outros asserts do
+ *      corpo viram __ESBMC_assume
+ *    - ./fatiador --autoteste confere essas fatias de regressão
+ *
+ * 6. LIMITES:
+ *    - Análise sintática no estilo dos harnesses (um comando por ';',
+ *      chaves nos if/for); ponteiros e aliasing além de &x não são
+ *      rastreados, então harness com alias deve ser verificado inteiro
+ *
+ * COMANDOS DE EXECUÇÃO:
+ * g++ -O2 -std=c++17 fatiador.cpp -o fatiador
+ * ./fatiador gpsdrive.cpp imu.cpp Flight.cpp
+ * ./fatiador --autoteste                            (regressões do fatiamento)
+ * esbmc fatias/test_gps_real_bit_operation__a1_*.cpp --unwind 8 --overflow-check
+ * ./esbmc_runner --por-teste fatias/test_*.cpp -- --unwind 8   (todas em paralelo, GOTO único)
+ *
+ * ================================================================
+ */
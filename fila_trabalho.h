@@ -0,0 +1,435 @@
+/**
+ * @file fila_trabalho.h
+ * @author Dissertação Mestrado - Verificação Formal PX4 v1.16
+ *
+ * OBJETIVO: Emulação do WorkQueueManager do PX4 para as tarefas extraídas
+ *           (dumpGpsData, processAccelData/processGyroData, telemetria)
+ * MÓDULO: Escalonamento por prioridade sobre poucos workers
+ *
+ * Cada tarefa é um WorkItem: periódica (ScheduleOnInterval) ou disparada
+ * por publicação de outra (ScheduleNow a partir do callback uORB). Workers
+ * executam um item até o fim, sem preempção, como uma thread de work queue.
+ * A escolha do próximo item (wqEscolher) é a mesma nos dois relógios:
+ *   - SIMULADO: eventos discretos, custo declarado por tarefa, resultado
+ *     idêntico a cada execução (comparação reprodutível de políticas)
+ *   - REAL: threads + steady_clock, custo medido (só com -DMODO_NATIVO)
+ */
+
+#pragma once
+
+#include <cstdint>
+
+// ================== CONSTANTES ==================
+static constexpr int WQ_MAX_TAREFAS = 16;
+static constexpr int WQ_MAX_FILAS = 8;
+static constexpr int WQ_MAX_WORKERS = 8;
+
+enum class wq_politica_t : uint8_t {
+    PRIORIDADE = 0,   // Fila global: maior prioridade, depois mais antiga
+    FIFO,             // Fila global por ordem de liberação
+    FILAS_PX4         // Uma work queue por grupo (wq:SPI0, wq:rate_ctrl, ...), fila i no worker i % workers
+};
+
+enum class wq_relogio_t : uint8_t {
+    SIMULADO = 0,
+    REAL
+};
+
+// ================== ESTRUTURAS ==================
+
+struct wq_estatistica_t {
+    uint64_t liberacoes;
+    uint64_t execucoes;
+    uint64_t coalescidas;        // ScheduleNow com o item já pendente (ignorado, como no PX4)
+    uint64_t perdas_prazo;       // fim - liberação > prazo_us
+    uint64_t latencia_soma_us;   // Espera na fila: início - liberação
+    uint64_t latencia_max_us;
+    uint64_t exec_soma_us;
+    uint64_t exec_max_us;
+    uint64_t e2e_soma_us;        // Fim de cadeia: fim - liberação da tarefa raiz (amostra do sensor)
+    uint64_t e2e_max_us;
+    uint64_t e2e_amostras;
+};
+
+/**
+ * Corpo da tarefa: recebe o contexto e o instante de início. Retorna true
+ * se publicou (dispara a tarefa encadeada, se houver).
+ */
+typedef bool (*wq_corpo_t)(void *ctx, uint64_t agora_us);
+
+struct wq_tarefa_t {
+    const char *nome;
+    wq_corpo_t corpo;
+    void *ctx;
+    uint8_t prioridade;          // Maior = mais urgente (SCHED_FIFO do PX4)
+    uint8_t fila;                // Work queue do item (FILAS_PX4)
+    uint32_t periodo_us;         // 0 = só por encadeamento
+    uint32_t prazo_us;
+    uint32_t custo_us;           // Custo no relógio simulado (REAL: carga emulada)
+    uint32_t jitter_us;          // Variação determinística de custo no SIMULADO
+    int8_t encadeia;             // Índice da tarefa disparada ao publicar (-1 = fim de cadeia)
+
+    // Estado (inicializado aqui: a tabela de tarefas lista só a configuração)
+    bool pendente = false;
+    bool executando = false;
+    uint64_t liberacao_us = 0;       // Da ativação pendente
+    uint64_t origem_us = 0;          // Liberação da raiz da cadeia
+    uint64_t liberacao_exec_us = 0;  // Da ativação em execução (pode haver outra pendente)
+    uint64_t origem_exec_us = 0;
+    uint64_t proxima_us = 0;         // Próxima liberação periódica
+    wq_estatistica_t est = {};
+};
+
+struct wq_t {
+    wq_tarefa_t tarefas[WQ_MAX_TAREFAS];
+    uint8_t num_tarefas;
+    uint8_t workers;
+    wq_politica_t politica;
+    uint32_t semente;            // Jitter determinístico
+};
+
+// ================== OPERAÇÕES ==================
+
+inline void wqReset(wq_t *wq, uint8_t workers, wq_politica_t politica) {
+    wq->num_tarefas = 0;
+    wq->workers = workers;
+    wq->politica = politica;
+    wq->semente = 2463534242u;
+}
+
+// Estado e estatísticas zerados, fila/prioridade/custo preservados
+inline void wqReiniciar(wq_t *wq, uint8_t workers, wq_politica_t politica) {
+    wq->workers = workers;
+    wq->politica = politica;
+    wq->semente = 2463534242u;
+
+    for (int i = 0; i < wq->num_tarefas; i++) {
+        wq_tarefa_t *t = &wq->tarefas[i];
+        t->pendente = false;
+        t->executando = false;
+        t->liberacao_us = 0;
+        t->origem_us = 0;
+        t->liberacao_exec_us = 0;
+        t->origem_exec_us = 0;
+        t->proxima_us = 0;
+        t->est = wq_estatistica_t{};
+    }
+}
+
+inline int wqAdicionar(wq_t *wq, const wq_tarefa_t &t) {
+    if (wq->num_tarefas >= WQ_MAX_TAREFAS || t.fila >= WQ_MAX_FILAS) {
+        return -1;
+    }
+
+    wq_tarefa_t *n = &wq->tarefas[wq->num_tarefas];
+    *n = t;
+    n->pendente = false;
+    n->executando = false;
+    n->proxima_us = 0;
+    n->est = wq_estatistica_t{};
+    return wq->num_tarefas++;
+}
+
+/**
+ * FUNÇÃO 1: wqAgendarAgora()
+ * ESPECIFICAÇÃO: ScheduleNow(): marca a tarefa pendente com liberação
+ * agora_us. Item já pendente não é enfileirado de novo (coalesce) e
+ * mantém a liberação mais antiga.
+ */
+inline void wqAgendarAgora(wq_t *wq, int i, uint64_t agora_us, uint64_t origem_us) {
+    wq_tarefa_t *t = &wq->tarefas[i];
+
+    if (t->pendente) {
+        t->est.coalescidas++;
+        return;
+    }
+
+    t->pendente = true;
+    t->liberacao_us = agora_us;
+    t->origem_us = origem_us;
+    t->est.liberacoes++;
+}
+
+/**
+ * FUNÇÃO 2: wqLiberarPeriodicas()
+ * ESPECIFICAÇÃO: Libera as periódicas vencidas até agora_us e devolve o
+ * próximo instante de liberação (UINT64_MAX se não há periódicas).
+ */
+inline uint64_t wqLiberarPeriodicas(wq_t *wq, uint64_t agora_us) {
+    uint64_t proxima = UINT64_MAX;
+
+    for (int i = 0; i < wq->num_tarefas; i++) {
+        wq_tarefa_t *t = &wq->tarefas[i];
+        if (t->periodo_us == 0) {
+            continue;
+        }
+
+        if (t->proxima_us <= agora_us) {
+            wqAgendarAgora(wq, i, t->proxima_us, t->proxima_us);
+            t->proxima_us += t->periodo_us;
+        }
+
+        proxima = t->proxima_us < proxima ? t->proxima_us : proxima;
+    }
+
+    return proxima;
+}
+
+/**
+ * FUNÇÃO 3: wqEscolher()
+ * ESPECIFICAÇÃO: Índice da próxima tarefa para o worker, ou -1. Elegível:
+ * pendente, liberada até agora_us, sem execução em curso e, em FILAS_PX4,
+ * de uma fila atendida pelo worker. Desempate final pelo índice: a escolha
+ * é determinística.
+ */
+inline int wqEscolher(const wq_t *wq, int worker, uint64_t agora_us) {
+    int melhor = -1;
+
+    for (int i = 0; i < wq->num_tarefas; i++) {
+        const wq_tarefa_t *t = &wq->tarefas[i];
+
+        if (!t->pendente || t->executando || t->liberacao_us > agora_us) {
+            continue;
+        }
+
+        if (wq->politica == wq_politica_t::FILAS_PX4 && t->fila % wq->workers != worker) {
+            continue;
+        }
+
+        if (melhor < 0) {
+            melhor = i;
+            continue;
+        }
+
+        const wq_tarefa_t *m = &wq->tarefas[melhor];
+        const bool mais_antiga = t->liberacao_us < m->liberacao_us;
+
+        if (wq->politica == wq_politica_t::FIFO) {
+            melhor = mais_antiga ? i : melhor;
+        } else if (t->prioridade != m->prioridade) {
+            melhor = t->prioridade > m->prioridade ? i : melhor;
+        } else {
+            melhor = mais_antiga ? i : melhor;
+        }
+    }
+
+    return melhor;
+}
+
+inline void wqIniciar(wq_t *wq, int i) {
+    wq_tarefa_t *t = &wq->tarefas[i];
+    t->pendente = false;
+    t->executando = true;
+    t->liberacao_exec_us = t->liberacao_us;
+    t->origem_exec_us = t->origem_us;
+}
+
+/**
+ * FUNÇÃO 4: wqConcluir()
+ * ESPECIFICAÇÃO: Registra latência de fila, execução, prazo e (fim de
+ * cadeia) latência sensor-publicação; se publicou, dispara a encadeada
+ * herdando a origem da cadeia.
+ */
+inline void wqConcluir(wq_t *wq, int i, uint64_t inicio_us, uint64_t fim_us, bool publicou) {
+    wq_tarefa_t *t = &wq->tarefas[i];
+    wq_estatistica_t *e = &t->est;
+    const uint64_t latencia = inicio_us - t->liberacao_exec_us;
+    const uint64_t exec = fim_us - inicio_us;
+
+    t->executando = false;
+    e->execucoes++;
+    e->latencia_soma_us += latencia;
+    e->latencia_max_us = latencia > e->latencia_max_us ? latencia : e->latencia_max_us;
+    e->exec_soma_us += exec;
+    e->exec_max_us = exec > e->exec_max_us ? exec : e->exec_max_us;
+
+    if (t->prazo_us > 0 && fim_us - t->liberacao_exec_us > t->prazo_us) {
+        e->perdas_prazo++;
+    }
+
+    if (!publicou) {
+        return;
+    }
+
+    if (t->encadeia >= 0 && t->encadeia < wq->num_tarefas) {
+        wqAgendarAgora(wq, t->encadeia, fim_us, t->origem_exec_us);
+    } else {
+        const uint64_t e2e = fim_us - t->origem_exec_us;
+        e->e2e_amostras++;
+        e->e2e_soma_us += e2e;
+        e->e2e_max_us = e2e > e->e2e_max_us ? e2e : e->e2e_max_us;
+    }
+}
+
+// Custo simulado: custo_us + jitter uniforme determinístico (xorshift32)
+inline uint32_t wqCustoSimulado(wq_t *wq, const wq_tarefa_t *t) {
+    if (t->jitter_us == 0) {
+        return t->custo_us;
+    }
+
+    wq->semente ^= wq->semente << 13;
+    wq->semente ^= wq->semente >> 17;
+    wq->semente ^= wq->semente << 5;
+    return t->custo_us + wq->semente % (t->jitter_us + 1);
+}
+
+/**
+ * FUNÇÃO 5: wqSimular()
+ * ESPECIFICAÇÃO: Eventos discretos até duracao_us. Em cada instante:
+ * conclusões primeiro (publicações liberam encadeadas no mesmo instante),
+ * depois periódicas vencidas, depois workers livres escolhem. O corpo da
+ * tarefa roda de verdade no início; só o tempo é simulado.
+ */
+inline void wqSimular(wq_t *wq, uint64_t duracao_us) {
+    int em_execucao[WQ_MAX_WORKERS];
+    uint64_t inicio[WQ_MAX_WORKERS];
+    uint64_t fim[WQ_MAX_WORKERS];
+    bool publicou[WQ_MAX_WORKERS];
+    const int workers = wq->workers < WQ_MAX_WORKERS ? wq->workers : WQ_MAX_WORKERS;
+
+    for (int w = 0; w < workers; w++) {
+        em_execucao[w] = -1;
+    }
+
+    uint64_t agora = 0;
+    uint64_t proxima_liberacao = wqLiberarPeriodicas(wq, agora);
+
+    while (agora < duracao_us) {
+        for (int w = 0; w < workers; w++) {
+            if (em_execucao[w] >= 0 && fim[w] <= agora) {
+                wqConcluir(wq, em_execucao[w], inicio[w], fim[w], publicou[w]);
+                em_execucao[w] = -1;
+            }
+        }
+
+        if (proxima_liberacao <= agora) {
+            proxima_liberacao = wqLiberarPeriodicas(wq, agora);
+        }
+
+        for (int w = 0; w < workers; w++) {
+            if (em_execucao[w] >= 0) {
+                continue;
+            }
+
+            const int i = wqEscolher(wq, w, agora);
+            if (i < 0) {
+                continue;
+            }
+
+            wq_tarefa_t *t = &wq->tarefas[i];
+            wqIniciar(wq, i);
+            em_execucao[w] = i;
+            inicio[w] = agora;
+            fim[w] = agora + wqCustoSimulado(wq, t);
+            publicou[w] = t->corpo ? t->corpo(t->ctx, agora) : true;
+        }
+
+        // Próximo evento: conclusão mais cedo ou próxima liberação
+        uint64_t proximo = proxima_liberacao;
+        for (int w = 0; w < workers; w++) {
+            if (em_execucao[w] >= 0 && fim[w] < proximo) {
+                proximo = fim[w];
+            }
+        }
+
+        if (proximo == UINT64_MAX) {
+            break;
+        }
+
+        agora = proximo > agora ? proximo : agora;
+    }
+}
+
+#ifdef MODO_NATIVO
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * FUNÇÃO 6: wqExecutarReal()
+ * ESPECIFICAÇÃO: Mesmo escalonamento com threads reais: a thread chamadora
+ * é o temporizador (hrt) das periódicas, cada worker é uma thread que
+ * escolhe sob a trava e executa fora dela. custo_us vira carga ocupada
+ * após o corpo (emular_custo), para comparar com o SIMULADO.
+ */
+inline void wqExecutarReal(wq_t *wq, uint64_t duracao_us, bool emular_custo) {
+    typedef std::chrono::steady_clock relogio;
+    const relogio::time_point t0 = relogio::now();
+    std::mutex trava;
+    std::condition_variable acordar;
+    bool parar = false;
+
+    auto agoraUs = [&]() {
+        return (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(relogio::now() - t0).count();
+    };
+
+    auto worker = [&](int w) {
+        std::unique_lock<std::mutex> lk(trava);
+
+        while (!parar) {
+            const int i = wqEscolher(wq, w, agoraUs());
+            if (i < 0) {
+                acordar.wait(lk);
+                continue;
+            }
+
+            wq_tarefa_t *t = &wq->tarefas[i];
+            wqIniciar(wq, i);
+            lk.unlock();
+
+            const uint64_t inicio = agoraUs();
+            const bool publicou = t->corpo ? t->corpo(t->ctx, inicio) : true;
+            while (emular_custo && agoraUs() - inicio < t->custo_us) {
+            }
+            const uint64_t fim = agoraUs();
+
+            lk.lock();
+            wqConcluir(wq, i, inicio, fim, publicou);
+            if (publicou && t->encadeia >= 0) {
+                acordar.notify_all();
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int w = 0; w < wq->workers; w++) {
+        threads.emplace_back(worker, w);
+    }
+
+    {
+        std::unique_lock<std::mutex> lk(trava);
+        while (true) {
+            const uint64_t proxima = wqLiberarPeriodicas(wq, agoraUs());
+            acordar.notify_all();
+
+            if (proxima >= duracao_us) {
+                break;
+            }
+
+            lk.unlock();
+            std::this_thread::sleep_until(t0 + std::chrono::microseconds(proxima));
+            lk.lock();
+        }
+
+        parar = true;
+        acordar.notify_all();
+    }
+
+    for (std::thread &t : threads) {
+        t.join();
+    }
+}
+
+// Relógio escolhido em tempo de execução: mesmo cenário, mesmas métricas
+inline void wqRodar(wq_t *wq, wq_relogio_t relogio, uint64_t duracao_us) {
+    if (relogio == wq_relogio_t::REAL) {
+        wqExecutarReal(wq, duracao_us, true);
+    } else {
+        wqSimular(wq, duracao_us);
+    }
+}
+
+#endif // MODO_NATIVO
@@ -0,0 +1,556 @@
+/**
+ * @file gps_blending.cpp
+ * @author Dissertação Mestrado - Verificação Formal PX4 v1.16
+ *
+ * OBJETIVO: Verificar e medir o estágio de blending de receptores (gps_blending.h)
+ * CENÁRIO: Dois receptores RTK, instâncias 0 e 1 de dumpGpsData()
+ * MÉTODO: Bounded Model Checking com ESBMC + benchmark nativo (-DMODO_NATIVO)
+ */
+
+#include <assert.h>
+#include <cstdint>
+
+#include "gps_blending.h"
+
+#ifndef MODO_NATIVO
+
+// ================== FUNÇÕES ESBMC ==================
+extern int nondet_int();
+extern uint8_t nondet_uint8();
+extern float nondet_float();
+extern void __ESBMC_assume(int condition);
+
+// ================== TESTES DE VERIFICAÇÃO FORMAL ==================
+
+static gps_blending_t blending;
+
+static gps_solucao_t solucaoBase(uint8_t instance, uint64_t t_us) {
+    gps_solucao_t s = {};
+    s.timestamp_us = t_us;
+    s.instance = instance;
+    s.fix_type = GPS_FIX_3D;
+    s.satelites = 12;
+    s.lat_e7 = -235000000;
+    s.lon_e7 = -466333333;
+    s.alt_mm = 760000;
+    s.eph = 0.02f;
+    s.epv = 0.04f;
+    s.s_acc = 0.05f;
+    return s;
+}
+
+/**
+ * TESTE 1: Verificar instância arbitrária
+ * PROPRIEDADE: Instâncias >= GPS_MAX_RECEPTORES nunca indexam ultima[]
+ */
+void test_blending_instance_bounds() {
+    gpsBlendingInit(&blending, 500000, 50000);
+
+    gps_solucao_t s = solucaoBase(nondet_uint8(), 1000);
+    bool aceita = gpsBlendingUpdate(&blending, &s);
+
+    if (aceita) {
+        assert(s.instance < GPS_MAX_RECEPTORES);
+        assert(blending.recebida[s.instance]);
+    } else {
+        assert(s.instance >= GPS_MAX_RECEPTORES);
+    }
+}
+
+/**
+ * TESTE 2: Verificar combinação convexa
+ * PROPRIEDADE: Com soluções simultâneas, a latitude combinada fica entre as
+ * latitudes dos receptores, os pesos somam 1 e os satélites saturam
+ */
+void test_blending_convex_combination() {
+    gpsBlendingInit(&blending, 500000, 50000);
+
+    gps_solucao_t a = solucaoBase(0, 1000);
+    gps_solucao_t b = solucaoBase(1, 1000);
+
+    int delta = nondet_int();
+    __ESBMC_assume(delta >= -1000 && delta <= 1000);
+    b.lat_e7 = a.lat_e7 + delta;
+
+    a.satelites = nondet_uint8();
+    b.satelites = nondet_uint8();
+
+    a.eph = nondet_float();
+    b.eph = nondet_float();
+    __ESBMC_assume(a.eph >= 0.01f && a.eph <= 10.0f);
+    __ESBMC_assume(b.eph >= 0.01f && b.eph <= 10.0f);
+
+    gpsBlendingUpdate(&blending, &a);
+    gpsBlendingUpdate(&blending, &b);
+
+    gps_solucao_t saida;
+    bool ok = gpsBlendingRun(&blending, 1000, &saida);
+    assert(ok);
+
+    const int32_t lo = delta < 0 ? b.lat_e7 : a.lat_e7;
+    const int32_t hi = delta < 0 ? a.lat_e7 : b.lat_e7;
+    assert(saida.lat_e7 >= lo && saida.lat_e7 <= hi);
+
+    const float soma = blending.peso[0] + blending.peso[1];
+    assert(soma > 0.9999f && soma < 1.0001f);
+
+    // Satélites somados saturam em 255 (nunca dão a volta em uint8_t)
+    const int sats = a.satelites + b.satelites;
+    assert(saida.satelites == (sats < 255 ? sats : 255));
+
+    // Receptor mais preciso recebe peso maior (ou igual)
+    if (a.eph < b.eph) {
+        assert(blending.peso[0] >= blending.peso[1]);
+    }
+}
+
+/**
+ * TESTE 3: Verificar dropout de um receptor
+ * PROPRIEDADE: Receptor sem solução há mais que o timeout não influencia a
+ * saída, que passa a ser a solução do receptor restante
+ */
+void test_blending_dropout() {
+    gpsBlendingInit(&blending, 500000, 50000);
+
+    gps_solucao_t a = solucaoBase(0, 1000);
+    gps_solucao_t b = solucaoBase(1, 1000);
+    b.lat_e7 += 5000;
+
+    gpsBlendingUpdate(&blending, &a);
+    gpsBlendingUpdate(&blending, &b);
+
+    uint8_t sobrevivente = nondet_uint8();
+    __ESBMC_assume(sobrevivente < GPS_MAX_RECEPTORES);
+
+    gps_solucao_t nova = (sobrevivente == 0) ? a : b;
+    nova.timestamp_us = 900000;
+    gpsBlendingUpdate(&blending, &nova);
+
+    gps_solucao_t saida;
+    bool ok = gpsBlendingRun(&blending, 900000, &saida);
+
+    assert(ok);
+    assert(saida.lat_e7 == nova.lat_e7);
+    assert(blending.peso[sobrevivente] > 0.9999f);
+    assert(blending.peso[1 - sobrevivente] == 0.0f);
+}
+
+/**
+ * TESTE 4: Verificar alinhamento temporal
+ * PROPRIEDADE: Com um só receptor atualizado, o blending espera a janela
+ */
+void test_blending_time_alignment() {
+    gpsBlendingInit(&blending, 500000, 50000);
+
+    gps_solucao_t a = solucaoBase(0, 1000);
+    gps_solucao_t b = solucaoBase(1, 1000);
+    gpsBlendingUpdate(&blending, &a);
+    gpsBlendingUpdate(&blending, &b);
+
+    gps_solucao_t saida;
+    gpsBlendingRun(&blending, 1000, &saida);
+
+    a.timestamp_us = 101000;
+    gpsBlendingUpdate(&blending, &a);
+
+    uint64_t agora = 101000 + (uint64_t)nondet_uint8() * 1000;
+    bool ok = gpsBlendingRun(&blending, agora, &saida);
+
+    assert(ok == (agora >= 101000 + blending.janela_us));
+}
+
+// ================== MAIN PARA ESBMC ==================
+int main() {
+    int test_choice = nondet_int();
+    __ESBMC_assume(test_choice >= 0 && test_choice < 4);
+
+    switch(test_choice) {
+        case 0:
+            test_blending_instance_bounds();
+            break;
+        case 1:
+            test_blending_convex_combination();
+            break;
+        case 2:
+            test_blending_dropout();
+            break;
+        case 3:
+            test_blending_time_alignment();
+            break;
+    }
+
+    return 0;
+}
+
+#else // MODO_NATIVO
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+// ================== TRAÇOS DE DOIS RECEPTORES ==================
+
+struct amostra_t {
+    gps_solucao_t sol;
+    double n_real;     // Posição verdadeira (m) no instante da solução
+    double e_real;
+    bool com_verdade;  // Traço gravado sem colunas de verdade: n_real/e_real não valem nada
+};
+
+static const int32_t LAT0_E7 = -235000000;
+static const int32_t LON0_E7 = -466333333;
+
+static void paraLatLon(double n, double e, int32_t *lat_e7, int32_t *lon_e7) {
+    const double rad_e7 = 1e-7 * M_PI / 180.0;
+    *lat_e7 = LAT0_E7 + (int32_t)lround(n / (rad_e7 * GPS_RAIO_TERRA_M));
+    *lon_e7 = LON0_E7 + (int32_t)lround(e / (rad_e7 * GPS_RAIO_TERRA_M * cos(LAT0_E7 * rad_e7)));
+}
+
+static void paraNE(int32_t lat_e7, int32_t lon_e7, double *n, double *e) {
+    const double rad_e7 = 1e-7 * M_PI / 180.0;
+    *n = (lat_e7 - LAT0_E7) * rad_e7 * GPS_RAIO_TERRA_M;
+    *e = (lon_e7 - LON0_E7) * rad_e7 * GPS_RAIO_TERRA_M * cos(LAT0_E7 * rad_e7);
+}
+
+/**
+ * Traço sintético de dois receptores RTK em um círculo de 50 m a 5 m/s:
+ * instância 0 (RTK fixed, eph 2 cm) e instância 1 (RTK float, eph 8 cm),
+ * taxas e fases diferentes e janelas de dropout em cada receptor.
+ */
+static std::vector<amostra_t> gerarTraco(double duracao_s, double hz, uint32_t semente) {
+    std::vector<amostra_t> traco;
+    std::mt19937 rng(semente);
+    std::normal_distribution<double> ruido(0.0, 1.0);
+
+    const double periodo_us[2] = {1e6 / hz, 1e6 / (hz * 0.8)};
+    const double fase_us[2] = {0.0, 37000.0};
+    const float eph[2] = {0.02f, 0.08f};
+    double prox[2] = {fase_us[0], fase_us[1]};
+
+    while (true) {
+        int i = prox[0] <= prox[1] ? 0 : 1;
+        double t_us = prox[i];
+        prox[i] += periodo_us[i];
+
+        if (t_us > duracao_s * 1e6) {
+            break;
+        }
+
+        // Dropouts: receptor 1 entre 20-25 s, receptor 0 entre 40-42 s
+        const double t_s = t_us * 1e-6;
+        if ((i == 1 && t_s > 20 && t_s < 25) || (i == 0 && t_s > 40 && t_s < 42)) {
+            continue;
+        }
+
+        const double w = 5.0 / 50.0;
+        amostra_t a;
+        a.n_real = 50.0 * sin(w * t_s);
+        a.e_real = 50.0 * (1.0 - cos(w * t_s));
+        a.com_verdade = true;
+
+        gps_solucao_t &s = a.sol;
+        s = {};
+        s.timestamp_us = (uint64_t)t_us;
+        s.instance = (uint8_t)i;
+        s.fix_type = 6;
+        s.satelites = (uint8_t)(20 + i);
+        s.eph = eph[i];
+        s.epv = 2.0f * eph[i];
+        s.s_acc = 0.05f * (i + 1);
+        paraLatLon(a.n_real + eph[i] * ruido(rng), a.e_real + eph[i] * ruido(rng), &s.lat_e7, &s.lon_e7);
+        s.alt_mm = 760000 + (int32_t)lround(1000.0 * s.epv * ruido(rng));
+        s.vel_n = (float)(5.0 * cos(w * t_s) + s.s_acc * ruido(rng));
+        s.vel_e = (float)(5.0 * sin(w * t_s) + s.s_acc * ruido(rng));
+        s.vel_d = 0.0f;
+        traco.push_back(a);
+    }
+
+    return traco;
+}
+
+/**
+ * Traço gravado em CSV (uma solução por linha; '#' comenta):
+ * instance,timestamp_us,fix_type,lat_e7,lon_e7,alt_mm,eph,epv,s_acc,vel_n,vel_e,vel_d,satelites[,lat_real_e7,lon_real_e7]
+ * A verdade (lat_real_e7, lon_real_e7) tem de vir de fonte independente dos
+ * dois receptores (ex.: pós-processado); sem ela, só as propriedades são
+ * conferidas, nenhum erro é calculado.
+ */
+static std::vector<amostra_t> lerTraco(const char *caminho) {
+    std::vector<amostra_t> traco;
+    FILE *f = fopen(caminho, "r");
+
+    if (!f) {
+        perror(caminho);
+        exit(1);
+    }
+
+    char linha[512];
+    while (fgets(linha, sizeof(linha), f)) {
+        amostra_t a = {};
+        gps_solucao_t &s = a.sol;
+        unsigned inst, fix, sats;
+        unsigned long long t;
+        int32_t lat_real_e7, lon_real_e7;
+
+        const int campos = sscanf(linha, "%u,%llu,%u,%d,%d,%d,%f,%f,%f,%f,%f,%f,%u,%d,%d", &inst, &t, &fix,
+                                  &s.lat_e7, &s.lon_e7, &s.alt_mm, &s.eph, &s.epv, &s.s_acc,
+                                  &s.vel_n, &s.vel_e, &s.vel_d, &sats, &lat_real_e7, &lon_real_e7);
+        if (campos != 13 && campos != 15) {
+            continue;
+        }
+
+        s.instance = (uint8_t)inst;
+        s.timestamp_us = t;
+        s.fix_type = (uint8_t)fix;
+        s.satelites = (uint8_t)sats;
+        a.com_verdade = campos == 15;
+        if (a.com_verdade) {
+            paraNE(lat_real_e7, lon_real_e7, &a.n_real, &a.e_real);
+        }
+        traco.push_back(a);
+    }
+
+    fclose(f);
+    return traco;
+}
+
+// Traço no formato de lerTraco(), com as colunas de verdade
+static bool exportarTraco(const char *caminho, const std::vector<amostra_t> &traco) {
+    FILE *f = fopen(caminho, "w");
+    if (!f) {
+        perror(caminho);
+        return false;
+    }
+
+    fprintf(f, "# Traco SINTETICO de gerarTraco() (gps_blending_bench --exportar), nao e gravacao real\n");
+    fprintf(f, "# instance,timestamp_us,fix_type,lat_e7,lon_e7,alt_mm,eph,epv,s_acc,vel_n,vel_e,vel_d,satelites,"
+               "lat_real_e7,lon_real_e7\n");
+    for (const amostra_t &a : traco) {
+        const gps_solucao_t &s = a.sol;
+        int32_t lat_real_e7, lon_real_e7;
+        paraLatLon(a.n_real, a.e_real, &lat_real_e7, &lon_real_e7);
+        fprintf(f, "%u,%llu,%u,%d,%d,%d,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%u,%d,%d\n", s.instance,
+                (unsigned long long)s.timestamp_us, s.fix_type, s.lat_e7, s.lon_e7, s.alt_mm, s.eph, s.epv, s.s_acc,
+                s.vel_n, s.vel_e, s.vel_d, s.satelites, lat_real_e7, lon_real_e7);
+    }
+
+    return fclose(f) == 0;
+}
+
+struct estatistica_t {
+    double soma_erro2[2] = {0, 0};      // Por solução recebida: instância 0, instância 1
+    uint64_t n[2] = {0, 0};
+
+    // Nos instantes de saída do blending: só instância 0, só instância 1, blended
+    double saida_erro2[3] = {0, 0, 0};
+    uint64_t saida_n[3] = {0, 0, 0};
+    uint64_t saidas = 0;
+
+    // Instantes com os dois receptores ativos: só instância 0 x blended
+    double comum_erro2[2] = {0, 0};
+    uint64_t comum_n = 0;
+
+    uint64_t violacoes_convexas = 0;
+};
+
+/**
+ * Um receptor sozinho no instante t_ref: última solução extrapolada pela
+ * própria velocidade, o mesmo alinhamento que o blending usa. Compara os
+ * dois nos mesmos instantes (e mostra a disponibilidade perdida em dropout).
+ */
+static double erroSozinho(const gps_solucao_t &s, uint64_t t_ref, const double *real) {
+    double n, e;
+    paraNE(s.lat_e7, s.lon_e7, &n, &e);
+    const double dt = ((double)t_ref - (double)s.timestamp_us) * 1e-6;
+    n += s.vel_n * dt - real[0];
+    e += s.vel_e * dt - real[1];
+    return n * n + e * e;
+}
+
+static estatistica_t avaliar(const std::vector<amostra_t> &traco, bool com_verdade) {
+    static gps_blending_t b;
+    gpsBlendingInit(&b, 300000, 60000);
+    estatistica_t est;
+    double ultimo_real[2][2] = {{0, 0}, {0, 0}};
+
+    for (const amostra_t &a : traco) {
+        gpsBlendingUpdate(&b, &a.sol);
+        const int i = a.sol.instance < 2 ? a.sol.instance : 0;
+        ultimo_real[i][0] = a.n_real;
+        ultimo_real[i][1] = a.e_real;
+
+        if (com_verdade) {
+            double n, e;
+            paraNE(a.sol.lat_e7, a.sol.lon_e7, &n, &e);
+            est.soma_erro2[i] += (n - a.n_real) * (n - a.n_real) + (e - a.e_real) * (e - a.e_real);
+            est.n[i]++;
+        }
+
+        gps_solucao_t saida;
+        if (!gpsBlendingRun(&b, a.sol.timestamp_us, &saida)) {
+            continue;
+        }
+
+        double n, e;
+        paraNE(saida.lat_e7, saida.lon_e7, &n, &e);
+        const double *ref = ultimo_real[i];
+        const double erro_blended = (n - ref[0]) * (n - ref[0]) + (e - ref[1]) * (e - ref[1]);
+        est.saida_erro2[2] += erro_blended;
+        est.saida_n[2]++;
+        est.saidas++;
+
+        double erro[GPS_MAX_RECEPTORES];
+        bool ativo[GPS_MAX_RECEPTORES];
+
+        for (int k = 0; k < GPS_MAX_RECEPTORES; k++) {
+            ativo[k] = gpsReceptorAtivo(&b, k, saida.timestamp_us);
+            if (ativo[k] && com_verdade) {
+                erro[k] = erroSozinho(b.ultima[k], saida.timestamp_us, ref);
+                est.saida_erro2[k] += erro[k];
+                est.saida_n[k]++;
+            }
+
+            // eph combinado nunca pode ser pior que o melhor receptor ativo, já alinhado no tempo
+            const double dt = ((double)saida.timestamp_us - (double)b.ultima[k].timestamp_us) * 1e-6;
+            if (b.peso[k] > 0.0f &&
+                saida.eph > sqrt(gpsVarianciaAlinhada(b.ultima[k].eph, b.ultima[k].s_acc, dt)) + 1e-6) {
+                est.violacoes_convexas++;
+            }
+        }
+
+        if (ativo[0] && ativo[1] && com_verdade) {
+            est.comum_erro2[0] += erro[0];
+            est.comum_erro2[1] += erro_blended;
+            est.comum_n++;
+        }
+    }
+
+    printf("blendings=%u dropouts=%u\n", b.blendings, b.dropouts);
+    return est;
+}
+
+static double rms(double soma, uint64_t n) {
+    return n ? sqrt(soma / n) : 0.0;
+}
+
+int main(int argc, char **argv) {
+    if (argc >= 3 && strcmp(argv[1], "--exportar") == 0) {
+        const double duracao_s = argc > 3 ? atof(argv[3]) : 60.0;
+        return exportarTraco(argv[2], gerarTraco(duracao_s, 10.0, 2026)) ? 0 : 1;
+    }
+
+    std::vector<amostra_t> traco;
+    const bool sintetico = (argc < 2);
+    bool com_verdade = true;
+
+    if (sintetico) {
+        traco = gerarTraco(60.0, 10.0, 2026);
+        printf("traco sintetico: %zu solucoes (2 receptores RTK, 10/8 Hz, 60 s)\n", traco.size());
+    } else {
+        traco = lerTraco(argv[1]);
+        for (const amostra_t &a : traco) {
+            com_verdade = com_verdade && a.com_verdade;
+        }
+        printf("traco %s: %zu solucoes, %s\n", argv[1], traco.size(),
+               com_verdade ? "com verdade de referencia" : "sem verdade de referencia (erros nao calculados)");
+    }
+
+    estatistica_t est = avaliar(traco, com_verdade);
+    const char *nomes[3] = {"so inst. 0", "so inst. 1", "blended"};
+
+    for (int k = 0; k < 2; k++) {
+        if (est.n[k] > 0) {
+            printf("instancia %d  rms_horizontal=%.4f m por solucao (n=%llu)\n", k, rms(est.soma_erro2[k], est.n[k]),
+                   (unsigned long long)est.n[k]);
+        }
+    }
+
+    if (com_verdade) {
+        printf("nos %llu instantes de saida:\n", (unsigned long long)est.saidas);
+
+        for (int k = 0; k < 3; k++) {
+            printf("  %-11s rms_horizontal=%.4f m  disponivel=%5.1f%%\n", nomes[k],
+                   rms(est.saida_erro2[k], est.saida_n[k]), 100.0 * est.saida_n[k] / (est.saidas ? est.saidas : 1));
+        }
+
+        printf("  com os dois ativos (n=%llu): so inst. 0 %.4f m, blended %.4f m\n",
+               (unsigned long long)est.comum_n, rms(est.comum_erro2[0], est.comum_n),
+               rms(est.comum_erro2[1], est.comum_n));
+    }
+
+    printf("violacoes eph: %llu\n", (unsigned long long)est.violacoes_convexas);
+
+    // Benchmark em alta taxa: dois receptores a 1 kHz simulados por 1000 s
+    std::vector<amostra_t> rapido = gerarTraco(1000.0, 1000.0, 7);
+    static gps_blending_t b;
+    gpsBlendingInit(&b, 300000, 600);
+    gps_solucao_t saida;
+    uint64_t saidas = 0;
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (const amostra_t &a : rapido) {
+        gpsBlendingUpdate(&b, &a.sol);
+        saidas += gpsBlendingRun(&b, a.sol.timestamp_us, &saida) ? 1 : 0;
+    }
+    auto t1 = std::chrono::steady_clock::now();
+
+    double ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / rapido.size();
+    printf("benchmark: %zu solucoes, %llu saidas, %.1f ns/solucao (%.2f M solucoes/s)\n",
+           rapido.size(), (unsigned long long)saidas, ns, 1e3 / ns);
+
+    return est.violacoes_convexas == 0 ? 0 : 1;
+}
+
+#endif // MODO_NATIVO
+
+/*
+ * ================================================================
+ * DOCUMENTAÇÃO
+ * ================================================================
+ *
+ * ESTÁGIO DE BLENDING:
+ *
+ * 1. ENTRADA:
+ *    - Soluções por instância (dump_data->instance de dumpGpsData())
+ *    - Receptor ativo: fix 3D e solução mais nova que timeout_us
+ *
+ * 2. ALINHAMENTO TEMPORAL:
+ *    - Espera todos os ativos atualizarem, no máximo janela_us
+ *    - Cada solução é extrapolada pela própria velocidade até o instante
+ *      da solução mais recente antes de combinar
+ *
+ * 3. PONDERAÇÃO:
+ *    - Posição horizontal por 1/(eph² + (s_acc·dt)²), vertical idem com
+ *      epv: a extrapolação de dt segundos soma o erro de velocidade
+ *    - Velocidade por 1/s_acc²
+ *    - Satélites somados sem volta (saturam em 255)
+ *    - Combinação feita em offsets NED locais (sem perda de precisão em int32)
+ *
+ * 4. TRAÇO EM CSV (formato em lerTraco()):
+ *    - Erros RMS só com as colunas lat_real_e7/lon_real_e7 de uma fonte
+ *      independente dos receptores; sem elas só as violações de eph
+ *      são conferidas (a posição de um receptor não serve de verdade)
+ *    - traco_gps_exemplo.csv é o sintético exportado por --exportar (30 s,
+ *      com o dropout do receptor 1), não uma gravação real: serve para
+ *      exercitar o leitor, não para medir o blending
+ *
+ * 5. PROPRIEDADES VERIFICADAS (ESBMC):
+ *    - Instância arbitrária não indexa fora de ultima[]
+ *    - Saída é combinação convexa das entradas, pesos somam 1, satélites
+ *      saturam em 255
+ *    - Dropout: receptor expirado não influencia a saída
+ *    - Janela de alinhamento respeitada
+ *
+ * COMANDOS DE EXECUÇÃO:
+ * esbmc gps_blending.cpp --unwind 3 --overflow-check
+ * g++ -O2 -DMODO_NATIVO gps_blending.cpp -o gps_blending_bench
+ * ./gps_blending_bench                  (traço sintético de dois receptores RTK)
+ * ./gps_blending_bench traco_rtk.csv    (traço gravado, formato em lerTraco())
+ * ./gps_blending_bench --exportar traco_gps_exemplo.csv 30   (sintético no formato CSV)
+ * ./gps_blending_bench traco_gps_exemplo.csv
+ *
+ * ================================================================
+ */
@@ -0,0 +1,229 @@
+/**
+ * @file gps_blending.h
+ * @author Dissertação Mestrado - Verificação Formal PX4 v1.16
+ *
+ * OBJETIVO: Blending de múltiplos receptores GPS ponderado pela acurácia
+ * REFERÊNCIA: src/modules/sensors/vehicle_gps_position/gps_blending.cpp (PX4)
+ *
+ * Cada solução chega marcada com a instância do receptor (o mesmo
+ * dump_data->instance de dumpGpsData()). As soluções são alinhadas no tempo
+ * (extrapolação pela velocidade até o instante da solução mais recente),
+ * combinadas com pesos 1/variância e, se um receptor some, o estágio passa a
+ * usar só os restantes. Todo o estado é fixo: nenhuma alocação.
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+// ================== CONSTANTES ==================
+static constexpr int GPS_MAX_RECEPTORES = 2;
+static constexpr uint8_t GPS_FIX_3D = 3;
+static constexpr double GPS_RAIO_TERRA_M = 6371000.0;
+static constexpr float GPS_ACURACIA_MIN = 0.001f;   // Evita peso infinito (eph = 0)
+
+// ================== ESTRUTURAS ==================
+
+struct gps_solucao_t {
+    uint64_t timestamp_us;
+    uint8_t instance;
+    uint8_t fix_type;
+    uint8_t satelites;
+    int32_t lat_e7;          // Graus * 1e7
+    int32_t lon_e7;          // Graus * 1e7
+    int32_t alt_mm;
+    float eph;               // Acurácia horizontal (m, 1 sigma)
+    float epv;               // Acurácia vertical (m)
+    float s_acc;             // Acurácia de velocidade (m/s)
+    float vel_n;
+    float vel_e;
+    float vel_d;
+};
+
+struct gps_blending_t {
+    gps_solucao_t ultima[GPS_MAX_RECEPTORES];
+    bool recebida[GPS_MAX_RECEPTORES];     // Já recebeu alguma solução
+    bool nova[GPS_MAX_RECEPTORES];         // Atualizou desde o último blending
+    float peso[GPS_MAX_RECEPTORES];        // Pesos horizontais do último blending
+
+    uint64_t timeout_us;                   // Sem solução por mais que isso = dropout
+    uint64_t janela_us;                    // Espera máxima pelos demais receptores
+    uint64_t primeira_nova_us;             // Chegada da solução nova mais antiga
+
+    uint32_t blendings;
+    uint32_t dropouts;
+    uint8_t ativos_anterior;
+};
+
+// ================== FUNÇÕES ==================
+
+inline void gpsBlendingInit(gps_blending_t *b, uint64_t timeout_us, uint64_t janela_us) {
+    memset(b, 0, sizeof(*b));
+    b->timeout_us = timeout_us;
+    b->janela_us = janela_us;
+}
+
+/**
+ * FUNÇÃO 1: gpsBlendingUpdate()
+ * ESPECIFICAÇÃO: Registrar a solução de uma instância. Instância fora do
+ * range ou timestamp regredindo são rejeitados.
+ */
+inline bool gpsBlendingUpdate(gps_blending_t *b, const gps_solucao_t *s) {
+    if (s->instance >= GPS_MAX_RECEPTORES) {
+        return false;
+    }
+
+    const int i = s->instance;
+
+    if (b->recebida[i] && s->timestamp_us <= b->ultima[i].timestamp_us) {
+        return false;
+    }
+
+    bool alguma_nova = false;
+    for (int k = 0; k < GPS_MAX_RECEPTORES; k++) {
+        alguma_nova = alguma_nova || b->nova[k];
+    }
+
+    if (!alguma_nova) {
+        b->primeira_nova_us = s->timestamp_us;
+    }
+
+    b->ultima[i] = *s;
+    b->recebida[i] = true;
+    b->nova[i] = true;
+    return true;
+}
+
+inline bool gpsReceptorAtivo(const gps_blending_t *b, int i, uint64_t agora_us) {
+    return b->recebida[i] && b->ultima[i].fix_type >= GPS_FIX_3D &&
+           agora_us >= b->ultima[i].timestamp_us &&
+           agora_us - b->ultima[i].timestamp_us <= b->timeout_us;
+}
+
+inline float gpsVariancia(float acuracia) {
+    const float a = acuracia > GPS_ACURACIA_MIN ? acuracia : GPS_ACURACIA_MIN;
+    return a * a;
+}
+
+/**
+ * Variância de posição depois de extrapolar dt segundos pela velocidade
+ * medida: o erro de velocidade (s_acc) cresce com dt e se soma ao da posição.
+ * Sem isso, uma solução precisa mas atrasada pesa como se fosse atual.
+ */
+inline double gpsVarianciaAlinhada(float acuracia, float s_acc, double dt) {
+    const double e = (double)s_acc * dt;
+    return (double)gpsVariancia(acuracia) + e * e;
+}
+
+/**
+ * FUNÇÃO 2: gpsBlendingRun()
+ * ESPECIFICAÇÃO: Produzir a solução combinada quando todos os receptores
+ * ativos atualizaram, ou quando a janela de espera expirou. Retorna false se
+ * ainda deve esperar ou se nenhum receptor está ativo.
+ */
+inline bool gpsBlendingRun(gps_blending_t *b, uint64_t agora_us, gps_solucao_t *saida) {
+    int ativos = 0;
+    int novos = 0;
+    int ref = -1;
+
+    for (int i = 0; i < GPS_MAX_RECEPTORES; i++) {
+        if (gpsReceptorAtivo(b, i, agora_us)) {
+            ativos++;
+            novos += b->nova[i] ? 1 : 0;
+
+            // Referência de tempo/posição: solução ativa mais recente
+            if (ref < 0 || b->ultima[i].timestamp_us > b->ultima[ref].timestamp_us) {
+                ref = i;
+            }
+        }
+    }
+
+    if (ativos < b->ativos_anterior) {
+        b->dropouts++;
+    }
+
+    b->ativos_anterior = (uint8_t)ativos;
+
+    if (ativos == 0 || novos == 0) {
+        return false;
+    }
+
+    // Alinhamento temporal: esperar todos os ativos ou a janela expirar
+    if (novos < ativos && agora_us < b->primeira_nova_us + b->janela_us) {
+        return false;
+    }
+
+    const gps_solucao_t &r = b->ultima[ref];
+    const double t_ref = (double)r.timestamp_us;
+    const double rad_e7 = 1e-7 * M_PI / 180.0;
+    const double cos_lat = cos(r.lat_e7 * rad_e7);
+
+    double soma_wh = 0.0, soma_wv = 0.0, soma_ws = 0.0;
+    double dn = 0.0, de = 0.0, dd = 0.0;
+    double vn = 0.0, ve = 0.0, vd = 0.0;
+    float inv_eph2 = 0.0f, inv_epv2 = 0.0f, inv_sacc2 = 0.0f;
+    uint32_t satelites = 0;
+
+    for (int i = 0; i < GPS_MAX_RECEPTORES; i++) {
+        b->peso[i] = 0.0f;
+
+        if (!gpsReceptorAtivo(b, i, agora_us)) {
+            continue;
+        }
+
+        const gps_solucao_t &s = b->ultima[i];
+
+        // Offset local (NED) em relação à referência, extrapolado até t_ref
+        const double dt = (t_ref - (double)s.timestamp_us) * 1e-6;
+        const double wh = 1.0 / gpsVarianciaAlinhada(s.eph, s.s_acc, dt);
+        const double wv = 1.0 / gpsVarianciaAlinhada(s.epv, s.s_acc, dt);
+        const double ws = 1.0 / gpsVariancia(s.s_acc);
+        const double n_i = (double)((int64_t)s.lat_e7 - r.lat_e7) * rad_e7 * GPS_RAIO_TERRA_M + s.vel_n * dt;
+        const double e_i = (double)((int64_t)s.lon_e7 - r.lon_e7) * rad_e7 * GPS_RAIO_TERRA_M * cos_lat + s.vel_e * dt;
+        const double d_i = -(double)((int64_t)s.alt_mm - r.alt_mm) * 1e-3 + s.vel_d * dt;
+
+        dn += wh * n_i;
+        de += wh * e_i;
+        dd += wv * d_i;
+        vn += ws * s.vel_n;
+        ve += ws * s.vel_e;
+        vd += ws * s.vel_d;
+        soma_wh += wh;
+        soma_wv += wv;
+        soma_ws += ws;
+        inv_eph2 += (float)wh;
+        inv_epv2 += (float)wv;
+        inv_sacc2 += (float)ws;
+        satelites += s.satelites;
+        b->peso[i] = (float)wh;
+    }
+
+    for (int i = 0; i < GPS_MAX_RECEPTORES; i++) {
+        b->peso[i] = (float)(b->peso[i] / soma_wh);
+        b->nova[i] = false;
+    }
+
+    dn /= soma_wh;
+    de /= soma_wh;
+    dd /= soma_wv;
+
+    *saida = r;
+    saida->instance = GPS_MAX_RECEPTORES;   // Instância "blended", como no PX4
+    saida->lat_e7 = r.lat_e7 + (int32_t)lround(dn / (rad_e7 * GPS_RAIO_TERRA_M));
+    saida->lon_e7 = r.lon_e7 + (int32_t)lround(de / (rad_e7 * GPS_RAIO_TERRA_M * cos_lat));
+    saida->alt_mm = r.alt_mm - (int32_t)lround(dd * 1e3);
+    saida->vel_n = (float)(vn / soma_ws);
+    saida->vel_e = (float)(ve / soma_ws);
+    saida->vel_d = (float)(vd / soma_ws);
+
+    // Variância combinada de estimativas independentes (já alinhadas): 1 / soma(1/var_i)
+    saida->eph = sqrtf(1.0f / inv_eph2);
+    saida->epv = sqrtf(1.0f / inv_epv2);
+    saida->s_acc = sqrtf(1.0f / inv_sacc2);
+    saida->satelites = (uint8_t)(satelites < 255 ? satelites : 255);    // Satura, não dá a volta
+
+    b->blendings++;
+    return true;
+}
@@ -12,6 +12,9 @@
 #include <cstring>
 #include <cstdint>
 
+#include "conteudo_abstrato.h"
+#include "entradas_estreitas.h"
+
 // ================== FUNÇÕES ESBMC ==================
 extern int nondet_int();
 extern uint8_t nondet_uint8();
@@ -19,6 +22,8 @@ extern size_t nondet_size_t();
 extern bool nondet_bool();
 extern void __ESBMC_assume(int condition);
 
+#ifndef PX4_BIBLIOTECA
+
 // ================== ESTRUTURAS REAIS EXTRAÍDAS DO PX4 ==================
 /**
  * ESTRUTURA REAL baseada no USO no gps.cpp:
@@ -51,16 +56,17 @@ enum class gps_dump_comm_mode_t : int32_t {
 /**
  * FUNÇÃO ORIGINAL dumpGpsData() extraída EXATAMENTE do gps.cpp linha ~643
  * Lógica preservada: while loop, memcpy, aritmética de ponteiros, bit operations
+ * instance: recebido por parâmetro no lugar do membro _instance do driver
  */
 void dumpGpsData(uint8_t *data, size_t len, gps_dump_comm_mode_t mode, bool msg_to_gps_device, 
-                 gps_dump_s *dump_data, gps_dump_comm_mode_t active_mode)
+                 gps_dump_s *dump_data, gps_dump_comm_mode_t active_mode, uint8_t instance = 0)
 {
     // Verificação de modo (do código original)
     if (active_mode != mode || !dump_data) {
         return;
     }
 
-    dump_data->instance = 0; // Simular: dump_data->instance = (uint8_t)_instance;
+    dump_data->instance = instance; // Do código real: dump_data->instance = (uint8_t)_instance;
 
     // LOOP CRÍTICO REAL DO PX4
     while (len > 0) {
@@ -72,7 +78,8 @@ void dumpGpsData(uint8_t *data, size_t len, gps_dump_comm_mode_t mode, bool msg_
         }
 
         // OPERAÇÃO CRÍTICA: memcpy com aritmética de ponteiros (do código real)
-        memcpy(dump_data->data + dump_data->len, data, write_len);
+        // (COPIAR_BYTES = memcpy; com -DABSTRAIR_CONTEUDO só checa os limites)
+        COPIAR_BYTES(dump_data->data + dump_data->len, data, write_len);
         
         // ATUALIZAÇÕES (exatamente como no gps.cpp)
         data += write_len;
@@ -96,6 +103,10 @@ void dumpGpsData(uint8_t *data, size_t len, gps_dump_comm_mode_t mode, bool msg_
     }
 }
 
+#else
+#include "px4_funcoes.h"   // Definições ligadas do GOTO compartilhado
+#endif // PX4_BIBLIOTECA
+
 // ================== TESTES DE VERIFICAÇÃO FORMAL ==================
 
 /**
@@ -103,11 +114,12 @@ void dumpGpsData(uint8_t *data, size_t len, gps_dump_comm_mode_t mode, bool msg_
  * PROPRIEDADE: memcpy nunca deve escrever além do buffer data[]
  */
 void test_gps_real_buffer_bounds() {
-    size_t input_len = nondet_size_t();
+    size_t input_len = NONDET_ESTREITO_U(size_t, nondet_size_t(), 300);
     bool msg_to_device = nondet_bool();
     
     // Entrada realista mas potencialmente perigosa
-    __ESBMC_assume(input_len > 0 && input_len <= 300);
+    __ESBMC_assume(input_len > 0);
+    ESTREITO_CHECAR();
     
     uint8_t input_data[300];
     gps_dump_s dump_buffer;
@@ -130,9 +142,10 @@ void test_gps_real_buffer_bounds() {
  * PROPRIEDADE: Subtração deve ser segura mesmo se len estiver corrompido
  */
 void test_gps_real_underflow_protection() {
-    size_t input_len = nondet_size_t();
+    size_t input_len = NONDET_ESTREITO_U(size_t, nondet_size_t(), 50);
     
-    __ESBMC_assume(input_len > 0 && input_len <= 50);
+    __ESBMC_assume(input_len > 0);
+    ESTREITO_CHECAR();
     
     uint8_t input_data[50];
     gps_dump_s dump_buffer;
@@ -154,9 +167,10 @@ void test_gps_real_underflow_protection() {
  * PROPRIEDADE: Loop deve sempre terminar, mesmo com inputs extremos
  */
 void test_gps_real_loop_termination() {
-    size_t input_len = nondet_size_t();
+    size_t input_len = NONDET_ESTREITO_U(size_t, nondet_size_t(), 100);
     
-    __ESBMC_assume(input_len > 0 && input_len <= 100);
+    __ESBMC_assume(input_len > 0);
+    ESTREITO_CHECAR();
     
     uint8_t input_data[100];
     gps_dump_s dump_buffer;
@@ -176,9 +190,10 @@ void test_gps_real_loop_termination() {
  * PROPRIEDADE: dump_data->len |= 1 << 7 deve ser segura
  */
 void test_gps_real_bit_operation() {
-    size_t input_len = nondet_size_t();
+    size_t input_len = NONDET_ESTREITO_U(size_t, nondet_size_t(), GPS_DUMP_DATA_SIZE + 10);
     
-    __ESBMC_assume(input_len > 0 && input_len <= GPS_DUMP_DATA_SIZE + 10);
+    __ESBMC_assume(input_len > 0);
+    ESTREITO_CHECAR();
     
     uint8_t input_data[GPS_DUMP_DATA_SIZE + 10];
     gps_dump_s dump_buffer;
@@ -201,9 +216,10 @@ void test_gps_real_bit_operation() {
  * PROPRIEDADE: Função deve lidar corretamente com buffer no limite
  */
 void test_gps_real_full_buffer_edge_case() {
-    size_t input_len = nondet_size_t();
+    size_t input_len = NONDET_ESTREITO_U(size_t, nondet_size_t(), 20);
     
-    __ESBMC_assume(input_len > 0 && input_len <= 20);
+    __ESBMC_assume(input_len > 0);
+    ESTREITO_CHECAR();
     
     uint8_t input_data[20];
     gps_dump_s dump_buffer;
@@ -219,10 +235,75 @@ void test_gps_real_full_buffer_edge_case() {
     assert(dump_buffer.len <= GPS_DUMP_DATA_SIZE);
 }
 
+/**
+ * TESTE 6: Verificar identificação da instância do receptor
+ * PROPRIEDADE: Dados publicados carregam a instância de origem (usada pelo
+ * estágio de blending de múltiplos receptores)
+ */
+void test_gps_real_instance_tag() {
+    size_t input_len = NONDET_ESTREITO_U(size_t, nondet_size_t(), 20);
+    uint8_t instance = nondet_uint8();
+
+    __ESBMC_assume(input_len > 0);
+    ESTREITO_CHECAR();
+    __ESBMC_assume(instance < 2);
+
+    uint8_t input_data[20];
+    gps_dump_s dump_buffer;
+    dump_buffer.len = nondet_uint8();
+    __ESBMC_assume(dump_buffer.len < GPS_DUMP_DATA_SIZE);
+
+    // Chamar função REAL
+    dumpGpsData(input_data, input_len, gps_dump_comm_mode_t::Full, false,
+                &dump_buffer, gps_dump_comm_mode_t::Full, instance);
+
+    // PROPRIEDADE: Instância gravada é a do receptor que gerou os dados
+    assert(dump_buffer.instance == instance);
+}
+
+/**
+ * TESTE 7: Verificar independência do conteúdo (autocomposição)
+ * PROPRIEDADE: Duas execuções com os mesmos comprimentos e bytes de entrada
+ * arbitrários produzem o mesmo len/instance/timestamp. Justifica
+ * -DABSTRAIR_CONTEUDO; rodar sem a flag (com ela nada é copiado).
+ * Domínio: input_len até 300, o maior usado com a flag (TESTE 1; TESTE 4
+ * vai até GPS_DUMP_DATA_SIZE + 10), com vários fechamentos de bloco
+ */
+void test_gps_conteudo_independente() {
+    size_t input_len = NONDET_ESTREITO_U(size_t, nondet_size_t(), 300);
+    bool msg_to_device = nondet_bool();
+
+    __ESBMC_assume(input_len > 0);
+    ESTREITO_CHECAR();
+
+    // Mesmo comprimento, conteúdos independentes (não inicializados = livres)
+    uint8_t input_a[300];
+    uint8_t input_b[300];
+    gps_dump_s dump_a;
+    gps_dump_s dump_b;
+    dump_a.len = nondet_uint8();
+    __ESBMC_assume(dump_a.len < GPS_DUMP_DATA_SIZE);
+    dump_b.len = dump_a.len;
+    dump_a.timestamp = 0;
+    dump_b.timestamp = 0;
+
+    dumpGpsData(input_a, input_len, gps_dump_comm_mode_t::Full, msg_to_device,
+                &dump_a, gps_dump_comm_mode_t::Full);
+    dumpGpsData(input_b, input_len, gps_dump_comm_mode_t::Full, msg_to_device,
+                &dump_b, gps_dump_comm_mode_t::Full);
+
+    // PROPRIEDADE: Tudo que os testes GPS observam é igual nas duas execuções
+    assert(dump_a.len == dump_b.len);
+    assert(dump_a.instance == dump_b.instance);
+    assert(dump_a.timestamp == dump_b.timestamp);
+}
+
 // ================== MAIN PARA ESBMC ==================
+// Com -DPX4_BIBLIOTECA cada test_* é ponto de entrada próprio (--function)
+#ifndef PX4_BIBLIOTECA
 int main() {
     int test_choice = nondet_int();
-    __ESBMC_assume(test_choice >= 0 && test_choice < 5);
+    __ESBMC_assume(test_choice >= 0 && test_choice < 7);
     
     switch(test_choice) {
         case 0:
@@ -240,10 +321,17 @@ int main() {
         case 4:
             test_gps_real_full_buffer_edge_case();
             break;
+        case 5:
+            test_gps_real_instance_tag();
+            break;
+        case 6:
+            test_gps_conteudo_independente();
+            break;
     }
     
     return 0;
 }
+#endif // PX4_BIBLIOTECA
 
 /* 
  * ================================================================
@@ -268,6 +356,8 @@ int main() {
  *    - Integer underflow em GPS_DUMP_DATA_SIZE - dump_data->len
  *    - Loop infinito se write_len não decrementar len corretamente
  *    - Bit operation safety em len |= 1 << 7
+ *    - Instância do receptor propagada em dump_data->instance
+ *    - len/instance/timestamp independentes dos bytes copiados
  * 
  * 4. TÉCNICA DE VERIFICAÇÃO:
  *    - Bounded Model Checking com ESBMC
@@ -278,6 +368,10 @@ int main() {
  * COMANDOS DE EXECUÇÃO:
  * esbmc teste_gps_driver_real_esbmc.cpp --unwind 8 --timeout 300s
  * esbmc teste_gps_driver_real_esbmc.cpp --overflow-check --unwind 5
+ * esbmc gpsdrive.cpp -DENTRADAS_ESTREITAS --unwind 8        (input_len em 8/16 bits)
+ * esbmc gpsdrive.cpp -DVERIFICAR_ESTREITAMENTO --unwind 8    (solidez do modo acima)
+ * esbmc gpsdrive.cpp -DABSTRAIR_CONTEUDO --unwind 8          (só extensões e offsets)
+ * esbmc gpsdrive.cpp --function test_gps_conteudo_independente --unwind 8  (solidez do modo acima)
  * 
  * VULNERABILIDADES ALVO:
  * - Buffer overflow se dump_data->len corrompido
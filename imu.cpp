@@ -16,8 +16,11 @@ extern int nondet_int();
 extern float nondet_float();
 extern uint8_t nondet_uint8();
 extern uint16_t nondet_uint16();
+extern int16_t nondet_int16();
 extern void __ESBMC_assume(int condition);
 
+#ifndef PX4_BIBLIOTECA
+
 // ================== CONSTANTES REAIS DO BMI088 ==================
 static constexpr int32_t FIFO_MAX_SAMPLES = 32;
 static constexpr size_t FIFO_SIZE = 1024;
@@ -90,6 +93,10 @@ bool processGyroData(int16_t gyro_x, int16_t gyro_y, int16_t gyro_z,
     return true;
 }
 
+#else
+#include "px4_funcoes.h"   // Definições ligadas do GOTO compartilhado
+#endif // PX4_BIBLIOTECA
+
 // ================== TESTES DE VERIFICAÇÃO FORMAL ==================
 
 /**
@@ -152,8 +159,8 @@ void test_fifo_count_calculation() {
  * ESPECIFICAÇÃO: "Flip de eixos deve preservar magnitude e tratar INT16_MIN"
  */
 void test_accel_data_processing() {
-    int16_t accel_y_raw = nondet_int();
-    int16_t accel_z_raw = nondet_int();
+    int16_t accel_y_raw = nondet_int16();   // Registro de 16 bits inteiro: sorteio já na largura do dado
+    int16_t accel_z_raw = nondet_int16();
     
     __ESBMC_assume(accel_y_raw >= INT16_MIN && accel_y_raw <= INT16_MAX);
     __ESBMC_assume(accel_z_raw >= INT16_MIN && accel_z_raw <= INT16_MAX);
@@ -184,9 +191,9 @@ void test_accel_data_processing() {
  * ESPECIFICAÇÃO: "Detectar dados inválidos e processar dados válidos"
  */
 void test_gyro_data_processing() {
-    int16_t gyro_x = nondet_int();
-    int16_t gyro_y = nondet_int(); 
-    int16_t gyro_z = nondet_int();
+    int16_t gyro_x = nondet_int16();   // Registro de 16 bits inteiro: sorteio já na largura do dado
+    int16_t gyro_y = nondet_int16();
+    int16_t gyro_z = nondet_int16();
     
     __ESBMC_assume(gyro_x >= INT16_MIN && gyro_x <= INT16_MAX);
     __ESBMC_assume(gyro_y >= INT16_MIN && gyro_y <= INT16_MAX);
@@ -241,6 +248,8 @@ void test_arithmetic_safety() {
 }
 
 // ================== MAIN PARA ESBMC ==================
+// Com -DPX4_BIBLIOTECA cada test_* é ponto de entrada próprio (--function)
+#ifndef PX4_BIBLIOTECA
 int main() {
     int test_choice = nondet_int();
     __ESBMC_assume(test_choice >= 0 && test_choice < 6);
@@ -268,6 +277,7 @@ int main() {
     
     return 0;
 }
+#endif // PX4_BIBLIOTECA
 
 /* 
  * ================================================================
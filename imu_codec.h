@@ -0,0 +1,344 @@
+/**
+ * @file imu_codec.h
+ * @author Dissertação Mestrado - Verificação Formal PX4 v1.16
+ *
+ * OBJETIVO: Compressão sem perda de séries int16_t de IMU (saídas de
+ *           processAccelData()/processGyroData()) para log em kHz
+ * USO: compressao.cpp (verificação e benchmark); um eixo por série
+ *
+ * FORMATO (no espírito dos codecs frame-of-reference / SIMD-BP128):
+ * - Blocos de 128 amostras; delta em relação à amostra anterior (a
+ *   primeira do bloco usa a última do bloco anterior, 0 no início), em
+ *   aritmética de 16 bits com volta (sem perda para quaisquer int16)
+ * - Zig-zag: delta pequeno de qualquer sinal vira inteiro pequeno
+ * - Largura b = bits do maior valor do bloco (0..16); bloco = 1 byte de b
+ *   + 16·b bytes
+ * - Layout vertical: amostra i vai para a lane i % 8 de um registrador de
+ *   8 x 16 bits, cada lane empacota suas 16 amostras em b palavras. A
+ *   versão SSE2 empacota 8 amostras por instrução; a escalar gera os
+ *   mesmos bytes (referência verificada pelo ESBMC)
+ * - Último bloco parcial completado com deltas zero
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// ================== CONSTANTES ==================
+static constexpr size_t IMU_BLOCO = 128;
+static constexpr size_t IMU_LANES = 8;
+static constexpr size_t IMU_LINHAS = IMU_BLOCO / IMU_LANES;
+static constexpr size_t IMU_BLOCO_MAX_BYTES = 1 + 16 * 16;
+
+// ================== PRIMITIVAS ==================
+
+inline uint16_t imuZigZag(int16_t d) {
+    return (uint16_t)(((uint16_t)d << 1) ^ (uint16_t)(d >> 15));
+}
+
+inline int16_t imuDesZigZag(uint16_t z) {
+    return (int16_t)((z >> 1) ^ (uint16_t)(0u - (z & 1u)));
+}
+
+inline int imuLargura(uint16_t ou) {
+    int b = 0;
+
+    while (b < 16 && (ou >> b) != 0) {
+        b++;
+    }
+
+    return b;
+}
+
+inline size_t imuTamanhoBloco(int b) {
+    return 1 + 16 * (size_t)b;
+}
+
+// ================== REFERÊNCIA ESCALAR ==================
+
+/**
+ * FUNÇÃO 1: imuCodificarBlocoEscalar()
+ * ESPECIFICAÇÃO: Codifica v[0..128) continuando de 'anterior'; escreve
+ * imuTamanhoBloco(b) bytes em out e retorna esse tamanho.
+ */
+inline size_t imuCodificarBlocoEscalar(int16_t anterior, const int16_t *v, uint8_t *out) {
+    uint16_t zz[IMU_BLOCO];
+    uint16_t ou = 0;
+
+    for (size_t i = 0; i < IMU_BLOCO; i++) {
+        zz[i] = imuZigZag((int16_t)(uint16_t)((uint16_t)v[i] - (uint16_t)anterior));
+        anterior = v[i];
+        ou |= zz[i];
+    }
+
+    const int b = imuLargura(ou);
+    uint16_t palavras[16 * IMU_LANES] = {};
+
+    for (size_t lane = 0; lane < IMU_LANES; lane++) {
+        for (size_t k = 0; k < IMU_LINHAS; k++) {
+            const uint16_t x = zz[k * IMU_LANES + lane];
+            const size_t bit = k * (size_t)b, w = bit / 16, s = bit % 16;
+
+            if (b == 0) {
+                continue;
+            }
+
+            palavras[w * IMU_LANES + lane] |= (uint16_t)(x << s);
+            if (s + (size_t)b > 16) {
+                palavras[(w + 1) * IMU_LANES + lane] |= (uint16_t)(x >> (16 - s));
+            }
+        }
+    }
+
+    out[0] = (uint8_t)b;
+    for (size_t i = 0; i < (size_t)b * IMU_LANES; i++) {
+        out[1 + 2 * i] = (uint8_t)palavras[i];
+        out[2 + 2 * i] = (uint8_t)(palavras[i] >> 8);
+    }
+
+    return imuTamanhoBloco(b);
+}
+
+/**
+ * FUNÇÃO 2: imuDecodificarBlocoEscalar()
+ * ESPECIFICAÇÃO: Decodifica um bloco de in[0..disponivel) em v[0..128).
+ * Retorna os bytes consumidos, ou 0 se a largura passa de 16 ou o bloco
+ * não cabe em 'disponivel' (nunca lê além).
+ */
+inline size_t imuDecodificarBlocoEscalar(int16_t anterior, const uint8_t *in, size_t disponivel, int16_t *v) {
+    if (disponivel < 1 || in[0] > 16 || disponivel < imuTamanhoBloco(in[0])) {
+        return 0;
+    }
+
+    const int b = in[0];
+    const uint16_t mascara = (uint16_t)((1u << b) - 1);
+
+    for (size_t k = 0; k < IMU_LINHAS; k++) {
+        for (size_t lane = 0; lane < IMU_LANES; lane++) {
+            uint16_t x = 0;
+
+            if (b > 0) {
+                const size_t bit = k * (size_t)b, w = bit / 16, s = bit % 16;
+                const size_t p = 1 + 2 * (w * IMU_LANES + lane);
+                x = (uint16_t)((in[p] | in[p + 1] << 8) >> s);
+
+                if (s + (size_t)b > 16) {
+                    const size_t q = p + 2 * IMU_LANES;
+                    x |= (uint16_t)((in[q] | in[q + 1] << 8) << (16 - s));
+                }
+            }
+
+            anterior = (int16_t)(uint16_t)((uint16_t)anterior + (uint16_t)imuDesZigZag(x & mascara));
+            v[k * IMU_LANES + lane] = anterior;
+        }
+    }
+
+    return imuTamanhoBloco(b);
+}
+
+// ================== VERSÃO SSE2 ==================
+
+#if defined(MODO_NATIVO) && defined(__SSE2__)
+#include <emmintrin.h>
+
+#define IMU_CODEC_SIMD 1
+
+template <int B>
+inline void imuEmpacotar(const __m128i *zz, __m128i *out) {
+    __m128i acc = _mm_setzero_si128();
+    int shift = 0, w = 0;
+
+    if (B == 0) {
+        return;
+    }
+
+#pragma GCC unroll 16
+    for (size_t k = 0; k < IMU_LINHAS; k++) {
+        acc = _mm_or_si128(acc, _mm_slli_epi16(zz[k], shift));
+        shift += B;
+
+        if (shift >= 16) {
+            _mm_storeu_si128(out + w++, acc);
+            shift -= 16;
+            acc = shift ? _mm_srli_epi16(zz[k], B - shift) : _mm_setzero_si128();
+        }
+    }
+}
+
+template <int B>
+inline void imuDesempacotar(const __m128i *in, __m128i *zz) {
+    const __m128i mascara = _mm_set1_epi16((short)((1u << B) - 1));
+    __m128i atual = B ? _mm_loadu_si128(in) : _mm_setzero_si128();
+    int shift = 0, w = 0;
+
+#pragma GCC unroll 16
+    for (size_t k = 0; k < IMU_LINHAS; k++) {
+        __m128i x = _mm_srli_epi16(atual, shift);
+        shift += B;
+
+        if (shift >= 16) {
+            shift -= 16;
+            if (++w < B) {
+                atual = _mm_loadu_si128(in + w);
+                if (shift) {
+                    x = _mm_or_si128(x, _mm_slli_epi16(atual, B - shift));
+                }
+            }
+        }
+
+        zz[k] = _mm_and_si128(x, mascara);
+    }
+}
+
+typedef void (*imu_empacotar_t)(const __m128i *, __m128i *);
+
+static const imu_empacotar_t imu_empacotadores[17] = {
+    imuEmpacotar<0>, imuEmpacotar<1>, imuEmpacotar<2>, imuEmpacotar<3>, imuEmpacotar<4>, imuEmpacotar<5>,
+    imuEmpacotar<6>, imuEmpacotar<7>, imuEmpacotar<8>, imuEmpacotar<9>, imuEmpacotar<10>, imuEmpacotar<11>,
+    imuEmpacotar<12>, imuEmpacotar<13>, imuEmpacotar<14>, imuEmpacotar<15>, imuEmpacotar<16>};
+
+static const imu_empacotar_t imu_desempacotadores[17] = {
+    imuDesempacotar<0>, imuDesempacotar<1>, imuDesempacotar<2>, imuDesempacotar<3>, imuDesempacotar<4>,
+    imuDesempacotar<5>, imuDesempacotar<6>, imuDesempacotar<7>, imuDesempacotar<8>, imuDesempacotar<9>,
+    imuDesempacotar<10>, imuDesempacotar<11>, imuDesempacotar<12>, imuDesempacotar<13>, imuDesempacotar<14>,
+    imuDesempacotar<15>, imuDesempacotar<16>};
+
+/**
+ * FUNÇÃO 3: imuCodificarBloco()
+ * ESPECIFICAÇÃO: Mesmos bytes de imuCodificarBlocoEscalar(). Linha j de 8
+ * amostras menos a mesma linha deslocada de uma amostra (carga não
+ * alinhada em v - 1), zig-zag e OU em registrador, empacotamento da
+ * largura por tabela de instâncias.
+ */
+inline size_t imuCodificarBloco(int16_t anterior, const int16_t *v, uint8_t *out) {
+    __m128i zz[IMU_LINHAS];
+    __m128i ou = _mm_setzero_si128();
+
+    for (size_t k = 0; k < IMU_LINHAS; k++) {
+        const __m128i x = _mm_loadu_si128((const __m128i *)(v + k * IMU_LANES));
+        const __m128i p = k ? _mm_loadu_si128((const __m128i *)(v + k * IMU_LANES - 1))
+                            : _mm_insert_epi16(_mm_slli_si128(x, 2), anterior, 0);
+        const __m128i d = _mm_sub_epi16(x, p);
+        zz[k] = _mm_xor_si128(_mm_slli_epi16(d, 1), _mm_srai_epi16(d, 15));
+        ou = _mm_or_si128(ou, zz[k]);
+    }
+
+    ou = _mm_or_si128(ou, _mm_srli_si128(ou, 8));
+    ou = _mm_or_si128(ou, _mm_srli_si128(ou, 4));
+    ou = _mm_or_si128(ou, _mm_srli_si128(ou, 2));
+    const unsigned r = (unsigned)_mm_extract_epi16(ou, 0);
+    const int b = r ? 32 - __builtin_clz(r) : 0;
+
+    out[0] = (uint8_t)b;
+    imu_empacotadores[b](zz, (__m128i *)(out + 1));
+    return imuTamanhoBloco(b);
+}
+
+/**
+ * FUNÇÃO 4: imuDecodificarBloco()
+ * ESPECIFICAÇÃO: Mesmo contrato de imuDecodificarBlocoEscalar(). Soma de
+ * prefixos dentro da linha em 3 passos (deslocamentos de 1, 2 e 4 lanes)
+ * mais a última amostra da linha anterior replicada.
+ */
+inline size_t imuDecodificarBloco(int16_t anterior, const uint8_t *in, size_t disponivel, int16_t *v) {
+    if (disponivel < 1 || in[0] > 16 || disponivel < imuTamanhoBloco(in[0])) {
+        return 0;
+    }
+
+    const int b = in[0];
+    __m128i zz[IMU_LINHAS];
+    imu_desempacotadores[b]((const __m128i *)(in + 1), zz);
+
+    const __m128i um = _mm_set1_epi16(1);
+    __m128i base = _mm_set1_epi16(anterior);
+
+    for (size_t k = 0; k < IMU_LINHAS; k++) {
+        __m128i d = _mm_xor_si128(_mm_srli_epi16(zz[k], 1), _mm_sub_epi16(_mm_setzero_si128(), _mm_and_si128(zz[k], um)));
+        d = _mm_add_epi16(d, _mm_slli_si128(d, 2));
+        d = _mm_add_epi16(d, _mm_slli_si128(d, 4));
+        d = _mm_add_epi16(d, _mm_slli_si128(d, 8));
+
+        const __m128i x = _mm_add_epi16(d, base);
+        _mm_storeu_si128((__m128i *)(v + k * IMU_LANES), x);
+
+        const __m128i alto = _mm_shufflehi_epi16(x, 0xFF);
+        base = _mm_unpackhi_epi64(alto, alto);
+    }
+
+    return imuTamanhoBloco(b);
+}
+#else
+inline size_t imuCodificarBloco(int16_t anterior, const int16_t *v, uint8_t *out) {
+    return imuCodificarBlocoEscalar(anterior, v, out);
+}
+
+inline size_t imuDecodificarBloco(int16_t anterior, const uint8_t *in, size_t disponivel, int16_t *v) {
+    return imuDecodificarBlocoEscalar(anterior, in, disponivel, v);
+}
+#endif
+
+// ================== SÉRIES ==================
+
+inline size_t imuComprimidoMax(size_t n) {
+    return (n + IMU_BLOCO - 1) / IMU_BLOCO * IMU_BLOCO_MAX_BYTES;
+}
+
+/**
+ * FUNÇÃO 5: imuComprimir()
+ * ESPECIFICAÇÃO: Codifica v[0..n) em out (capacidade imuComprimidoMax(n))
+ * e retorna os bytes escritos. O número de amostras fica com o chamador
+ * (cabeçalho do registro de log).
+ */
+inline size_t imuComprimir(const int16_t *v, size_t n, uint8_t *out) {
+    size_t escritos = 0;
+    int16_t anterior = 0;
+    size_t i = 0;
+
+    for (; i + IMU_BLOCO <= n; i += IMU_BLOCO) {
+        escritos += imuCodificarBloco(anterior, v + i, out + escritos);
+        anterior = v[i + IMU_BLOCO - 1];
+    }
+
+    if (i < n) {
+        int16_t resto[IMU_BLOCO];
+        for (size_t k = 0; k < IMU_BLOCO; k++) {
+            resto[k] = i + k < n ? v[i + k] : v[n - 1];
+        }
+        escritos += imuCodificarBloco(anterior, resto, out + escritos);
+    }
+
+    return escritos;
+}
+
+/**
+ * FUNÇÃO 6: imuDescomprimir()
+ * ESPECIFICAÇÃO: Decodifica n amostras de in[0..len) em v. Retorna false
+ * se a entrada estiver corrompida ou curta (nada é lido além de len).
+ */
+inline bool imuDescomprimir(const uint8_t *in, size_t len, int16_t *v, size_t n) {
+    size_t lidos = 0;
+    int16_t anterior = 0;
+    size_t i = 0;
+
+    for (; i + IMU_BLOCO <= n; i += IMU_BLOCO) {
+        const size_t c = imuDecodificarBloco(anterior, in + lidos, len - lidos, v + i);
+        if (c == 0) {
+            return false;
+        }
+        lidos += c;
+        anterior = v[i + IMU_BLOCO - 1];
+    }
+
+    if (i < n) {
+        int16_t resto[IMU_BLOCO];
+        if (imuDecodificarBloco(anterior, in + lidos, len - lidos, resto) == 0) {
+            return false;
+        }
+        for (size_t k = 0; i + k < n; k++) {
+            v[i + k] = resto[k];
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,698 @@
+/**
+ * @file log_analyzer.cpp
+ * @author Dissertação Mestrado - Verificação Formal PX4 v1.16
+ *
+ * OBJETIVO: Análise offline de logs de IMU/GPS (formato ulog_formato.h)
+ * MÓDULO: Estatísticas pós-voo em uma única passada sobre o arquivo mapeado
+ * MÉTODO: Bounded Model Checking com ESBMC + ferramenta nativa (-DMODO_NATIVO)
+ *
+ * AGREGADOS:
+ * - Clipping: amostras de accel/gyro saturadas em INT16_MIN/INT16_MAX
+ * - Tendência de temperatura: regressão linear de updateTemperature() x tempo
+ * - Histograma de ocupação do FIFO a partir de fifoReadCount()
+ * - Taxa de publicação de dumpGpsData() por instância de receptor
+ *
+ * O arquivo é mapeado com mmap e dividido em faixas de blocos (cada bloco
+ * começa em fronteira de registro), uma por thread; cada thread acumula em
+ * estado próprio e os resultados são somados no final.
+ */
+
+#include <assert.h>
+#include <cstdint>
+#include <cstring>
+
+#include "px4_funcoes.h"   // updateTemperature(), fifoReadCount() e FIFO_SIZE (px4_funcoes.cpp)
+#include "ulog_formato.h"
+
+// ================== AGREGADOS ==================
+
+static constexpr int FIFO_BIN_BYTES = 64;
+static constexpr int FIFO_NUM_BINS = FIFO_SIZE / FIFO_BIN_BYTES + 1;   // Último = acima de FIFO_SIZE
+static constexpr int GPS_MAX_INSTANCIAS = 4;
+static constexpr int LOTE_AMOSTRAS = 4096;                              // Amostras por redução vetorial
+
+struct agregados_t {
+    // Clipping: [0] = accel, [1] = gyro; por eixo
+    uint64_t clipping[2][3];
+    uint64_t amostras[2];
+    uint64_t gyro_invalidos;
+
+    // Regressão temperatura x tempo (t em s relativo a t0)
+    uint64_t temp_n;
+    double temp_t0;
+    double temp_st, temp_sy, temp_stt, temp_sty;
+    float temp_min, temp_max;
+
+    uint64_t fifo_hist[FIFO_NUM_BINS];
+
+    uint64_t gps_publicacoes[GPS_MAX_INSTANCIAS];
+    uint64_t gps_primeiro_us[GPS_MAX_INSTANCIAS];
+    uint64_t gps_ultimo_us[GPS_MAX_INSTANCIAS];
+
+    uint64_t registros;
+    uint64_t blocos;
+    uint64_t blocos_invalidos;
+    uint64_t registros_desconhecidos;
+};
+
+void agregadosInit(agregados_t *a, double temp_t0) {
+    memset(a, 0, sizeof(*a));
+    a->temp_t0 = temp_t0;
+    a->temp_min = 1e9f;
+    a->temp_max = -1e9f;
+
+    for (int i = 0; i < GPS_MAX_INSTANCIAS; i++) {
+        a->gps_primeiro_us[i] = UINT64_MAX;
+    }
+}
+
+/**
+ * FUNÇÃO 1: fifoBin()
+ * ESPECIFICAÇÃO: Índice do histograma para qualquer par de registradores;
+ * contagens acima de FIFO_SIZE caem no último bin.
+ */
+int fifoBin(uint8_t fifo_length_0, uint8_t fifo_length_1) {
+    const uint16_t count = fifoReadCount(fifo_length_0, fifo_length_1);
+
+    if (count > FIFO_SIZE) {
+        return FIFO_NUM_BINS - 1;
+    }
+
+    int bin = count / FIFO_BIN_BYTES;
+    return bin < FIFO_NUM_BINS - 1 ? bin : FIFO_NUM_BINS - 2;
+}
+
+/**
+ * FUNÇÃO 2: contarSaturados()
+ * ESPECIFICAÇÃO: Quantas amostras de v[0..n) valem INT16_MIN ou INT16_MAX.
+ * Versão SSE2 processa 8 amostras por instrução; resto escalar. A escalar
+ * é a que o ESBMC verifica; a SSE2 é conferida contra ela no nativo
+ * (log_analyzer --autoteste).
+ */
+uint64_t contarSaturadosEscalar(const int16_t *v, int n) {
+    uint64_t total = 0;
+
+    for (int i = 0; i < n; i++) {
+        total += (v[i] == INT16_MIN || v[i] == INT16_MAX) ? 1 : 0;
+    }
+
+    return total;
+}
+
+#if defined(__SSE2__) && defined(MODO_NATIVO)
+#include <emmintrin.h>
+
+uint64_t contarSaturados(const int16_t *v, int n) {
+    const __m128i vmin = _mm_set1_epi16(INT16_MIN);
+    const __m128i vmax = _mm_set1_epi16(INT16_MAX);
+    __m128i acc = _mm_setzero_si128();
+    uint64_t total = 0;
+    int i = 0;
+
+    // Acumuladores de 16 bits: esvaziar antes de 32767 iterações
+    while (i + 8 <= n) {
+        int limite = i + 8 * 32767;
+        limite = limite < n ? limite : n;
+
+        for (; i + 8 <= limite; i += 8) {
+            const __m128i x = _mm_loadu_si128((const __m128i *)(v + i));
+            const __m128i m = _mm_or_si128(_mm_cmpeq_epi16(x, vmin), _mm_cmpeq_epi16(x, vmax));
+            acc = _mm_sub_epi16(acc, m);
+        }
+
+        uint16_t lanes[8];
+        _mm_storeu_si128((__m128i *)lanes, acc);
+        for (int k = 0; k < 8; k++) {
+            total += lanes[k];
+        }
+
+        acc = _mm_setzero_si128();
+    }
+
+    return total + contarSaturadosEscalar(v + i, n - i);
+}
+#else
+uint64_t contarSaturados(const int16_t *v, int n) {
+    return contarSaturadosEscalar(v, n);
+}
+#endif
+
+/**
+ * Lote SoA de amostras de um sensor: os registros chegam intercalados por
+ * tópico, então as amostras são separadas por eixo e reduzidas em lote.
+ */
+struct lote_t {
+    int16_t eixo[3][LOTE_AMOSTRAS];
+    int n;
+};
+
+static void reduzirLote(agregados_t *a, lote_t *l, int sensor) {
+    for (int e = 0; e < 3; e++) {
+        a->clipping[sensor][e] += contarSaturados(l->eixo[e], l->n);
+    }
+
+    a->amostras[sensor] += (uint64_t)l->n;
+    l->n = 0;
+}
+
+static inline void loteAdicionar(agregados_t *a, lote_t *l, int sensor, int16_t x, int16_t y, int16_t z) {
+    l->eixo[0][l->n] = x;
+    l->eixo[1][l->n] = y;
+    l->eixo[2][l->n] = z;
+
+    if (++l->n == LOTE_AMOSTRAS) {
+        reduzirLote(a, l, sensor);
+    }
+}
+
+/**
+ * FUNÇÃO 3: analisarBloco()
+ * ESPECIFICAÇÃO: Percorrer os registros de um bloco de dados. Blocos com
+ * magic/bytes_usados inválidos são contados e ignorados inteiros.
+ */
+void analisarBloco(agregados_t *a, lote_t lotes[2], const uint8_t *bloco, uint32_t tamanho_bloco) {
+    ulog_bloco_t cab;
+    memcpy(&cab, bloco, sizeof(cab));
+
+    if (cab.magic != ULOG_BLOCO_MAGIC || cab.bytes_usados < sizeof(ulog_bloco_t) ||
+        cab.bytes_usados > tamanho_bloco) {
+        a->blocos_invalidos++;
+        return;
+    }
+
+    a->blocos++;
+    uint32_t offset = sizeof(ulog_bloco_t);
+    const ulog_registro_t *reg = nullptr;
+
+    while (offset < cab.bytes_usados) {
+        uint32_t proximo = ulogProximoRegistro(bloco, cab.bytes_usados, offset, &reg);
+
+        if (proximo == 0) {
+            a->blocos_invalidos++;
+            break;
+        }
+
+        const uint8_t *payload = bloco + offset + sizeof(ulog_registro_t);
+        a->registros++;
+
+        switch (reg->msg_id) {
+        case ULOG_MSG_IMU_ACCEL:
+            if (reg->tamanho == sizeof(ulog_imu_accel_t)) {
+                ulog_imu_accel_t r;
+                memcpy(&r, payload, sizeof(r));
+                loteAdicionar(a, &lotes[0], 0, r.x, r.y, r.z);
+            }
+            break;
+
+        case ULOG_MSG_IMU_GYRO:
+            if (reg->tamanho == sizeof(ulog_imu_gyro_t)) {
+                ulog_imu_gyro_t r;
+                memcpy(&r, payload, sizeof(r));
+                loteAdicionar(a, &lotes[1], 1, r.x, r.y, r.z);
+                a->gyro_invalidos += r.valido ? 0 : 1;
+            }
+            break;
+
+        case ULOG_MSG_IMU_TEMP:
+            if (reg->tamanho == sizeof(ulog_imu_temp_t)) {
+                ulog_imu_temp_t r;
+                memcpy(&r, payload, sizeof(r));
+                const float temp = updateTemperature(r.temp_msb, r.temp_lsb);
+                const double t = (double)r.timestamp_us * 1e-6 - a->temp_t0;
+                a->temp_n++;
+                a->temp_st += t;
+                a->temp_sy += temp;
+                a->temp_stt += t * t;
+                a->temp_sty += t * temp;
+                a->temp_min = temp < a->temp_min ? temp : a->temp_min;
+                a->temp_max = temp > a->temp_max ? temp : a->temp_max;
+            }
+            break;
+
+        case ULOG_MSG_IMU_FIFO:
+            if (reg->tamanho == sizeof(ulog_imu_fifo_t)) {
+                ulog_imu_fifo_t r;
+                memcpy(&r, payload, sizeof(r));
+                a->fifo_hist[fifoBin(r.fifo_length_0, r.fifo_length_1)]++;
+            }
+            break;
+
+        case ULOG_MSG_GPS_DUMP:
+            if (reg->tamanho == sizeof(ulog_gps_dump_t)) {
+                ulog_gps_dump_t r;
+                memcpy(&r, payload, 10);    // timestamp + instance + len
+                const int i = r.instance < GPS_MAX_INSTANCIAS ? r.instance : GPS_MAX_INSTANCIAS - 1;
+                a->gps_publicacoes[i]++;
+                a->gps_primeiro_us[i] = r.timestamp_us < a->gps_primeiro_us[i] ? r.timestamp_us : a->gps_primeiro_us[i];
+                a->gps_ultimo_us[i] = r.timestamp_us > a->gps_ultimo_us[i] ? r.timestamp_us : a->gps_ultimo_us[i];
+            }
+            break;
+
+        default:
+            a->registros_desconhecidos++;
+            break;
+        }
+
+        offset = proximo;
+    }
+}
+
+/**
+ * FUNÇÃO 4: faixaDaThread()
+ * ESPECIFICAÇÃO: Dividir num_blocos entre num_threads em faixas contíguas
+ * [inicio, fim) que cobrem todos os blocos exatamente uma vez.
+ */
+void faixaDaThread(uint64_t num_blocos, int num_threads, int t, uint64_t *inicio, uint64_t *fim) {
+    const uint64_t base = num_blocos / (uint64_t)num_threads;
+    const uint64_t resto = num_blocos % (uint64_t)num_threads;
+    const uint64_t ut = (uint64_t)t;
+
+    *inicio = ut * base + (ut < resto ? ut : resto);
+    *fim = *inicio + base + (ut < resto ? 1 : 0);
+}
+
+void agregadosSomar(agregados_t *dst, const agregados_t *src) {
+    for (int s = 0; s < 2; s++) {
+        for (int e = 0; e < 3; e++) {
+            dst->clipping[s][e] += src->clipping[s][e];
+        }
+
+        dst->amostras[s] += src->amostras[s];
+    }
+
+    dst->gyro_invalidos += src->gyro_invalidos;
+    dst->temp_n += src->temp_n;
+    dst->temp_st += src->temp_st;
+    dst->temp_sy += src->temp_sy;
+    dst->temp_stt += src->temp_stt;
+    dst->temp_sty += src->temp_sty;
+    dst->temp_min = src->temp_min < dst->temp_min ? src->temp_min : dst->temp_min;
+    dst->temp_max = src->temp_max > dst->temp_max ? src->temp_max : dst->temp_max;
+
+    for (int i = 0; i < FIFO_NUM_BINS; i++) {
+        dst->fifo_hist[i] += src->fifo_hist[i];
+    }
+
+    for (int i = 0; i < GPS_MAX_INSTANCIAS; i++) {
+        dst->gps_publicacoes[i] += src->gps_publicacoes[i];
+        dst->gps_primeiro_us[i] = src->gps_primeiro_us[i] < dst->gps_primeiro_us[i] ? src->gps_primeiro_us[i] : dst->gps_primeiro_us[i];
+        dst->gps_ultimo_us[i] = src->gps_ultimo_us[i] > dst->gps_ultimo_us[i] ? src->gps_ultimo_us[i] : dst->gps_ultimo_us[i];
+    }
+
+    dst->registros += src->registros;
+    dst->blocos += src->blocos;
+    dst->blocos_invalidos += src->blocos_invalidos;
+    dst->registros_desconhecidos += src->registros_desconhecidos;
+}
+
+#ifndef MODO_NATIVO
+
+// ================== FUNÇÕES ESBMC ==================
+extern int nondet_int();
+extern uint8_t nondet_uint8();
+extern uint16_t nondet_uint16();
+extern void __ESBMC_assume(int condition);
+
+// ================== TESTES DE VERIFICAÇÃO FORMAL ==================
+
+/**
+ * TESTE 1: Verificar índice do histograma de FIFO
+ * PROPRIEDADE: Qualquer par de registradores produz bin em [0, FIFO_NUM_BINS)
+ */
+void test_fifo_bin_bounds() {
+    uint8_t l0 = nondet_uint8();
+    uint8_t l1 = nondet_uint8();
+
+    int bin = fifoBin(l0, l1);
+
+    assert(bin >= 0 && bin < FIFO_NUM_BINS);
+
+    if (fifoReadCount(l0, l1) > FIFO_SIZE) {
+        assert(bin == FIFO_NUM_BINS - 1);
+    }
+}
+
+/**
+ * TESTE 2: Verificar partição de blocos entre threads
+ * PROPRIEDADE: Faixas contíguas, sem sobreposição, cobrindo todos os blocos
+ */
+void test_faixas_particao() {
+    uint64_t num_blocos = nondet_uint16();
+    int num_threads = nondet_int();
+    __ESBMC_assume(num_threads >= 1 && num_threads <= 4);
+
+    uint64_t fim_anterior = 0;
+
+    for (int t = 0; t < num_threads; t++) {
+        uint64_t inicio, fim;
+        faixaDaThread(num_blocos, num_threads, t, &inicio, &fim);
+
+        assert(inicio == fim_anterior);
+        assert(fim >= inicio && fim <= num_blocos);
+        fim_anterior = fim;
+    }
+
+    assert(fim_anterior == num_blocos);
+}
+
+/**
+ * TESTE 3: Verificar contagem de saturação
+ * PROPRIEDADE: Resultado igual à definição amostra a amostra
+ */
+void test_contar_saturados() {
+    int16_t v[9];
+    uint64_t esperado = 0;
+
+    for (int i = 0; i < 9; i++) {
+        int x = nondet_int();
+        __ESBMC_assume(x >= INT16_MIN && x <= INT16_MAX);
+        v[i] = (int16_t)x;
+        esperado += (v[i] == INT16_MIN || v[i] == INT16_MAX) ? 1 : 0;
+    }
+
+    assert(contarSaturados(v, 9) == esperado);
+}
+
+/**
+ * TESTE 4: Verificar análise de bloco com conteúdo arbitrário
+ * PROPRIEDADE: Nenhum acesso fora do bloco e contadores coerentes
+ */
+void test_analisar_bloco_arbitrario() {
+    static agregados_t a;
+    static lote_t lotes[2];
+    uint8_t bloco[48];
+
+    for (int i = 0; i < 48; i++) {
+        bloco[i] = nondet_uint8();
+    }
+
+    agregadosInit(&a, 0.0);
+    lotes[0].n = 0;
+    lotes[1].n = 0;
+
+    analisarBloco(&a, lotes, bloco, sizeof(bloco));
+
+    assert(a.blocos + a.blocos_invalidos >= 1);
+    assert(a.registros <= (sizeof(bloco) - sizeof(ulog_bloco_t)) / sizeof(ulog_registro_t));
+    assert(lotes[0].n <= 1 && lotes[1].n <= 1);
+}
+
+// ================== MAIN PARA ESBMC ==================
+int main() {
+    int test_choice = nondet_int();
+    __ESBMC_assume(test_choice >= 0 && test_choice < 4);
+
+    switch(test_choice) {
+        case 0:
+            test_fifo_bin_bounds();
+            break;
+        case 1:
+            test_faixas_particao();
+            break;
+        case 2:
+            test_contar_saturados();
+            break;
+        case 3:
+            test_analisar_bloco_arbitrario();
+            break;
+    }
+
+    return 0;
+}
+
+#else // MODO_NATIVO
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+struct trabalho_t {
+    const uint8_t *base;
+    uint32_t tamanho_bloco;
+    uint64_t inicio;
+    uint64_t fim;
+    agregados_t agregados;
+    lote_t lotes[2];
+};
+
+static void analisarFaixa(trabalho_t *w) {
+    w->lotes[0].n = 0;
+    w->lotes[1].n = 0;
+
+    for (uint64_t b = w->inicio; b < w->fim; b++) {
+        const uint8_t *bloco = w->base + (b + 1) * w->tamanho_bloco;   // +1: bloco 0 é o cabeçalho
+        analisarBloco(&w->agregados, w->lotes, bloco, w->tamanho_bloco);
+
+        // Devolver páginas já lidas: mantém o RSS baixo em logs de vários GB
+        if ((b - w->inicio) % 256 == 255) {
+            madvise((void *)(w->base + (b - 254) * (uint64_t)w->tamanho_bloco),
+                    256 * (size_t)w->tamanho_bloco, MADV_DONTNEED);
+        }
+    }
+
+    reduzirLote(&w->agregados, &w->lotes[0], 0);
+    reduzirLote(&w->agregados, &w->lotes[1], 1);
+}
+
+static void imprimir(const agregados_t &a, const ulog_cabecalho_t &cab, const ulog_formato_def_t *defs) {
+    printf("formatos:\n");
+    for (uint32_t i = 0; i < cab.num_formatos; i++) {
+        printf("  [%u] %-10s %3u B  %s\n", defs[i].msg_id, defs[i].nome, defs[i].tamanho, defs[i].campos);
+    }
+
+    printf("blocos=%llu invalidos=%llu registros=%llu desconhecidos=%llu\n",
+           (unsigned long long)a.blocos, (unsigned long long)a.blocos_invalidos,
+           (unsigned long long)a.registros, (unsigned long long)a.registros_desconhecidos);
+
+    const char *sensores[2] = {"accel", "gyro"};
+    for (int s = 0; s < 2; s++) {
+        printf("clipping %-5s: x=%llu y=%llu z=%llu de %llu amostras\n", sensores[s],
+               (unsigned long long)a.clipping[s][0], (unsigned long long)a.clipping[s][1],
+               (unsigned long long)a.clipping[s][2], (unsigned long long)a.amostras[s]);
+    }
+
+    printf("gyro invalidos (processGyroData=false): %llu\n", (unsigned long long)a.gyro_invalidos);
+
+    if (a.temp_n >= 2) {
+        const double n = (double)a.temp_n;
+        const double den = n * a.temp_stt - a.temp_st * a.temp_st;
+        const double incl = den != 0.0 ? (n * a.temp_sty - a.temp_st * a.temp_sy) / den : 0.0;
+        printf("temperatura: n=%llu min=%.3f max=%.3f media=%.3f C tendencia=%.4f C/min\n",
+               (unsigned long long)a.temp_n, a.temp_min, a.temp_max, a.temp_sy / n, incl * 60.0);
+    }
+
+    uint64_t fifo_total = 0;
+    for (int i = 0; i < FIFO_NUM_BINS; i++) {
+        fifo_total += a.fifo_hist[i];
+    }
+
+    printf("FIFO (fifoReadCount, bins de %d B):\n", FIFO_BIN_BYTES);
+    for (int i = 0; i < FIFO_NUM_BINS && fifo_total > 0; i++) {
+        if (i == FIFO_NUM_BINS - 1) {
+            printf("  >%4zu      : %6.2f%%\n", FIFO_SIZE, 100.0 * a.fifo_hist[i] / fifo_total);
+        } else {
+            printf("  %4d-%4d  : %6.2f%%\n", i * FIFO_BIN_BYTES, (i + 1) * FIFO_BIN_BYTES - 1,
+                   100.0 * a.fifo_hist[i] / fifo_total);
+        }
+    }
+
+    for (int i = 0; i < GPS_MAX_INSTANCIAS; i++) {
+        if (a.gps_publicacoes[i] == 0) {
+            continue;
+        }
+
+        const double dur = (a.gps_ultimo_us[i] - a.gps_primeiro_us[i]) * 1e-6;
+        printf("gps instancia %d: %llu publicacoes, %.2f Hz, %.1f B/s\n", i,
+               (unsigned long long)a.gps_publicacoes[i],
+               dur > 0 ? a.gps_publicacoes[i] / dur : 0.0,
+               dur > 0 ? a.gps_publicacoes[i] * 200.0 / dur : 0.0);
+    }
+}
+
+/**
+ * Teste diferencial: contarSaturados() (SSE2 quando compilada) contra a
+ * escalar, em buffers aleatórios com saturados frequentes, nas bordas de
+ * tamanho e alinhamento e acima de 8 * 32767 amostras (esvaziamento dos
+ * acumuladores de 16 bits). Retorna o número de divergências.
+ */
+static int autotesteSaturados() {
+    const int n_max = 8 * 32767 * 2 + 37;
+    std::vector<int16_t> v(n_max + 8);
+    int falhas = 0;
+
+    auto conferir = [&](const int16_t *p, int n) {
+        const uint64_t vetorial = contarSaturados(p, n);
+        const uint64_t escalar = contarSaturadosEscalar(p, n);
+        if (vetorial != escalar) {
+            fprintf(stderr, "divergencia n=%d: vetorial %llu, escalar %llu\n", n, (unsigned long long)vetorial,
+                    (unsigned long long)escalar);
+            falhas++;
+        }
+    };
+
+    // Bordas: tudo saturado (cada lane no máximo) e vizinhos dos extremos
+    const int16_t bordas[] = {INT16_MIN, INT16_MAX, INT16_MIN + 1, INT16_MAX - 1, 0, -1};
+    for (int16_t b : bordas) {
+        std::fill(v.begin(), v.end(), b);
+        for (int n : {0, 1, 7, 8, 9, 15, 16, 17, 8 * 32767 - 1, 8 * 32767, 8 * 32767 + 1, n_max}) {
+            conferir(v.data(), n);
+            conferir(v.data() + 1, n);      // Desalinhado
+        }
+    }
+
+    // Aleatório: ~1/4 saturados, tamanhos e deslocamentos variados
+    srand(12345);
+    for (int rodada = 0; rodada < 2000; rodada++) {
+        const int n = rodada < 1990 ? rand() % 300 : n_max;
+        const int desloc = rand() % 8;
+        for (int i = 0; i < n + desloc; i++) {
+            const int r = rand();
+            v[i] = (r & 3) == 0 ? ((r & 4) ? INT16_MIN : INT16_MAX) : (int16_t)(r >> 3);
+        }
+        conferir(v.data() + desloc, n);
+    }
+
+    return falhas;
+}
+
+int main(int argc, char **argv) {
+    if (argc == 2 && strcmp(argv[1], "--autoteste") == 0) {
+        const int falhas = autotesteSaturados();
+        printf("autoteste contarSaturados (%s): %d divergencia(s)\n",
+#if defined(__SSE2__)
+               "SSE2",
+#else
+               "escalar",
+#endif
+               falhas);
+        return falhas == 0 ? 0 : 1;
+    }
+
+    if (argc < 2) {
+        fprintf(stderr, "uso: %s arquivo.ulg [threads] | --autoteste\n", argv[0]);
+        return 1;
+    }
+
+    int num_threads = (argc > 2) ? atoi(argv[2]) : (int)std::thread::hardware_concurrency();
+    num_threads = num_threads > 0 ? num_threads : 1;
+
+    int fd = open(argv[1], O_RDONLY);
+    struct stat st;
+
+    if (fd < 0 || fstat(fd, &st) != 0) {
+        perror(argv[1]);
+        return 1;
+    }
+
+    if ((size_t)st.st_size < sizeof(ulog_cabecalho_t)) {
+        fprintf(stderr, "arquivo curto demais\n");
+        return 1;
+    }
+
+    const uint8_t *base = (const uint8_t *)mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+
+    if (base == MAP_FAILED) {
+        perror("mmap");
+        return 1;
+    }
+
+    madvise((void *)base, (size_t)st.st_size, MADV_SEQUENTIAL);
+
+    ulog_cabecalho_t cab;
+    memcpy(&cab, base, sizeof(cab));
+
+    if (!ulogValidarCabecalho(&cab) || (uint64_t)st.st_size < cab.tamanho_bloco) {
+        fprintf(stderr, "cabecalho invalido\n");
+        return 1;
+    }
+
+    ulog_formato_def_t defs[ULOG_MAX_FORMATOS];
+    memcpy(defs, base + sizeof(cab), cab.num_formatos * sizeof(ulog_formato_def_t));
+
+    const uint64_t num_blocos = (uint64_t)st.st_size / cab.tamanho_bloco - 1;
+    const double t0_s = cab.timestamp_inicio_us * 1e-6;
+
+    auto t0 = std::chrono::steady_clock::now();
+
+    std::vector<trabalho_t *> trabalhos;
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < num_threads; t++) {
+        trabalho_t *w = new trabalho_t;
+        w->base = base;
+        w->tamanho_bloco = cab.tamanho_bloco;
+        faixaDaThread(num_blocos, num_threads, t, &w->inicio, &w->fim);
+        agregadosInit(&w->agregados, t0_s);
+        trabalhos.push_back(w);
+        threads.emplace_back(analisarFaixa, w);
+    }
+
+    agregados_t total;
+    agregadosInit(&total, t0_s);
+
+    for (int t = 0; t < num_threads; t++) {
+        threads[t].join();
+        agregadosSomar(&total, &trabalhos[t]->agregados);
+        delete trabalhos[t];
+    }
+
+    auto t1 = std::chrono::steady_clock::now();
+    const double dt = std::chrono::duration<double>(t1 - t0).count();
+
+    imprimir(total, cab, defs);
+    printf("analise: %.2f GiB em %.3f s com %d threads -> %.2f GiB/s\n",
+           st.st_size / 1073741824.0, dt, num_threads, st.st_size / 1073741824.0 / dt);
+
+    munmap((void *)base, (size_t)st.st_size);
+    close(fd);
+    return 0;
+}
+
+#endif // MODO_NATIVO
+
+/*
+ * ================================================================
+ * DOCUMENTAÇÃO
+ * ================================================================
+ *
+ * ANALISADOR OFFLINE:
+ *
+ * 1. LEITURA:
+ *    - mmap do arquivo inteiro + MADV_SEQUENTIAL; páginas já processadas
+ *      são devolvidas com MADV_DONTNEED
+ *    - Blocos de tamanho fixo e alinhados: cada thread recebe uma faixa
+ *      contígua de blocos (faixaDaThread) sem precisar sincronizar registros
+ *
+ * 2. PASSADA ÚNICA:
+ *    - Cada registro é despachado pelo msg_id; amostras de accel/gyro vão
+ *      para lotes SoA por eixo reduzidos com SSE2 (contarSaturados)
+ *    - Temperatura via updateTemperature() e FIFO via fifoReadCount(),
+ *      as mesmas funções extraídas verificadas em imu.cpp
+ *    - Agregados por thread somados no final (regressão por somas parciais)
+ *
+ * 3. PROPRIEDADES VERIFICADAS (ESBMC):
+ *    - Bin do histograma de FIFO sempre válido
+ *    - Partição de blocos cobre o arquivo sem sobreposição
+ *    - Contagem escalar igual à definição amostra a amostra; a versão
+ *      SSE2 só existe no nativo e é conferida contra a escalar pelo teste
+ *      diferencial (--autoteste: bordas, desalinhamento, > 8 * 32767
+ *      amostras e buffers aleatórios), não pelo ESBMC
+ *    - Bloco com bytes arbitrários não causa acesso fora dos limites
+ *
+ * COMANDOS DE EXECUÇÃO:
+ * esbmc log_analyzer.cpp px4_funcoes.cpp --unwind 10 --overflow-check --bounds-check
+ * g++ -O2 -pthread -DMODO_NATIVO log_analyzer.cpp px4_funcoes.cpp -o log_analyzer
+ * ./ulog_writer_bench --segundos 30 --arquivo voo.ulg   (gera log de vários GB)
+ * ./log_analyzer voo.ulg 8
+ * ./log_analyzer --autoteste                           (SSE2 x escalar)
+ *
+ * ================================================================
+ */
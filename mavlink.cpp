@@ -1 +1,783 @@
+/**
+ * @file mavlink.cpp
+ * @author Dissertação Mestrado - Verificação Formal PX4 v1.16
+ *
+ * OBJETIVO: Serviço de parâmetros MAVLink com transferência em rajada
+ * MÓDULO: Protocolo de parâmetros (PARAM_REQUEST_LIST / PARAM_VALUE / PARAM_REQUEST_READ)
+ * MÉTODO: Bounded Model Checking com ESBMC + benchmark nativo (-DMODO_NATIVO)
+ *
+ * MOTIVAÇÃO: Carregar 1000+ parâmetros tratando e confirmando cada PARAM_VALUE
+ * individualmente custa um RTT por parâmetro. Aqui a lista inteira é enviada
+ * em rajada com cadência controlada pela banda do enlace, e apenas as lacunas
+ * (índices perdidos) são retransmitidas, em lote, ao final.
+ */
 
+#include <assert.h>
+#include <cstring>
+#include <cstdint>
+
+// ================== CONSTANTES DO PROTOCOLO ==================
+static constexpr int PARAM_ID_LEN = 16;          // param_id[16] do MAVLink (sem '\0' se cheio)
+static constexpr int PARAM_MAX = 1536;           // Capacidade máxima do armazenamento
+static constexpr int PARAM_BITMAP_WORDS = PARAM_MAX / 32;
+static constexpr int PARAM_RETX_MAX = 256;       // Fila circular de retransmissão
+
+// MAVLink v2: 10 bytes de cabeçalho + 25 de payload PARAM_VALUE + 2 de CRC
+static constexpr uint32_t PARAM_VALUE_FRAME_LEN = 10 + 25 + 2;
+// PARAM_REQUEST_READ: 10 + 20 + 2
+static constexpr uint32_t PARAM_REQUEST_READ_FRAME_LEN = 10 + 20 + 2;
+
+enum class mav_param_type_t : uint8_t {
+    UINT8 = 1,
+    INT32 = 6,
+    REAL32 = 9
+};
+
+// ================== ESTRUTURAS ==================
+
+/**
+ * Mensagem PARAM_VALUE (campos do XML common.xml do MAVLink)
+ */
+struct param_value_msg_t {
+    char param_id[PARAM_ID_LEN];
+    float param_value;
+    uint8_t param_type;
+    uint16_t param_count;
+    uint16_t param_index;
+};
+
+/**
+ * Armazenamento de parâmetros ordenado por nome.
+ * Layout em vetores separados: a busca binária percorre apenas ids[],
+ * 16 bytes por entrada (4 entradas por linha de cache de 64 bytes).
+ * O índice MAVLink de cada parâmetro é a sua posição na ordem de nomes,
+ * como no PX4 (param_get_index() segue a ordem ordenada).
+ */
+struct param_store_t {
+    char ids[PARAM_MAX][PARAM_ID_LEN];
+    float values[PARAM_MAX];
+    uint8_t types[PARAM_MAX];
+    uint16_t count;
+};
+
+/**
+ * Estado do transmissor: fluxo sequencial + fila de retransmissão por índice,
+ * cadenciado por um balde de fichas (bytes) na taxa do enlace.
+ */
+struct param_stream_t {
+    uint16_t proximo;                    // Próximo índice sequencial a enviar
+    uint16_t retx[PARAM_RETX_MAX];       // Índices pedidos via PARAM_REQUEST_READ
+    uint16_t retx_head;
+    uint16_t retx_count;
+    uint32_t tokens;                     // Bytes disponíveis para envio
+    uint32_t tokens_max;                 // Tamanho máximo da rajada em bytes
+    uint32_t bytes_por_s;
+    uint64_t ultimo_us;
+    bool ativo;
+};
+
+/**
+ * Estado do receptor: bitmap de índices recebidos + cópia dos valores.
+ */
+struct param_receiver_t {
+    uint32_t recebidos[PARAM_BITMAP_WORDS];
+    float values[PARAM_MAX];
+    uint16_t total;                      // param_count anunciado (0 = desconhecido)
+    uint16_t contagem;                   // Quantos índices distintos chegaram
+};
+
+// ================== ARMAZENAMENTO ORDENADO ==================
+
+static inline int compararId(const char *a, const char *b) {
+    return memcmp(a, b, PARAM_ID_LEN);
+}
+
+static inline void copiarId(char *dst, const char *nome) {
+    // Semântica do param_id: preenchido com '\0' até 16 bytes
+    size_t n = strlen(nome);
+    if (n > PARAM_ID_LEN) {
+        n = PARAM_ID_LEN;
+    }
+    memset(dst, 0, PARAM_ID_LEN);
+    memcpy(dst, nome, n);
+}
+
+/**
+ * FUNÇÃO 1: paramStoreBuild()
+ * ESPECIFICAÇÃO: Ordenar as entradas inseridas por nome (inserção binária,
+ * executada uma única vez na carga). Retorna false se houver nomes repetidos.
+ */
+bool paramStoreBuild(param_store_t *store) {
+    for (int i = 1; i < store->count; i++) {
+        char id[PARAM_ID_LEN];
+        memcpy(id, store->ids[i], PARAM_ID_LEN);
+        float value = store->values[i];
+        uint8_t type = store->types[i];
+
+        int lo = 0;
+        int hi = i;
+        while (lo < hi) {
+            int mid = lo + (hi - lo) / 2;
+            if (compararId(store->ids[mid], id) <= 0) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+
+        if (lo < i) {
+            memmove(store->ids[lo + 1], store->ids[lo], (size_t)(i - lo) * PARAM_ID_LEN);
+            memmove(&store->values[lo + 1], &store->values[lo], (size_t)(i - lo) * sizeof(float));
+            memmove(&store->types[lo + 1], &store->types[lo], (size_t)(i - lo));
+            memcpy(store->ids[lo], id, PARAM_ID_LEN);
+            store->values[lo] = value;
+            store->types[lo] = type;
+        }
+    }
+
+    for (int i = 1; i < store->count; i++) {
+        if (compararId(store->ids[i - 1], store->ids[i]) == 0) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool paramStoreAdd(param_store_t *store, const char *nome, float value, mav_param_type_t type) {
+    if (store->count >= PARAM_MAX) {
+        return false;
+    }
+
+    copiarId(store->ids[store->count], nome);
+    store->values[store->count] = value;
+    store->types[store->count] = (uint8_t)type;
+    store->count++;
+    return true;
+}
+
+/**
+ * FUNÇÃO 2: paramFind()
+ * ESPECIFICAÇÃO: Busca binária pelo param_id (16 bytes). Retorna o índice
+ * MAVLink ou -1 se não existir.
+ */
+int paramFind(const param_store_t *store, const char *param_id) {
+    int lo = 0;
+    int hi = (int)store->count - 1;
+
+    while (lo <= hi) {
+        int mid = lo + (hi - lo) / 2;
+        int c = compararId(store->ids[mid], param_id);
+
+        if (c == 0) {
+            return mid;
+        }
+
+        if (c < 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid - 1;
+        }
+    }
+
+    return -1;
+}
+
+/**
+ * FUNÇÃO 3: paramEncode()
+ * ESPECIFICAÇÃO: Montar PARAM_VALUE para um índice. Retorna false se fora do range.
+ */
+bool paramEncode(const param_store_t *store, uint16_t index, param_value_msg_t *msg) {
+    if (index >= store->count) {
+        return false;
+    }
+
+    memcpy(msg->param_id, store->ids[index], PARAM_ID_LEN);
+    msg->param_value = store->values[index];
+    msg->param_type = store->types[index];
+    msg->param_count = store->count;
+    msg->param_index = index;
+    return true;
+}
+
+// ================== TRANSMISSOR EM RAJADA ==================
+
+void paramStreamStart(param_stream_t *s, uint32_t bytes_por_s, uint32_t rajada_max_bytes, uint64_t agora_us) {
+    s->proximo = 0;
+    s->retx_head = 0;
+    s->retx_count = 0;
+    s->bytes_por_s = bytes_por_s;
+    s->tokens_max = rajada_max_bytes;
+    s->tokens = rajada_max_bytes;
+    s->ultimo_us = agora_us;
+    s->ativo = true;
+}
+
+/**
+ * FUNÇÃO 4: paramStreamRequest()
+ * ESPECIFICAÇÃO: Enfileirar retransmissão de um índice (PARAM_REQUEST_READ).
+ * Índices inválidos ou fila cheia são descartados (o receptor pedirá de novo).
+ */
+bool paramStreamRequest(param_stream_t *s, const param_store_t *store, uint16_t index) {
+    if (index >= store->count || s->retx_count >= PARAM_RETX_MAX) {
+        return false;
+    }
+
+    uint16_t pos = (uint16_t)((s->retx_head + s->retx_count) % PARAM_RETX_MAX);
+    s->retx[pos] = index;
+    s->retx_count++;
+    s->ativo = true;
+    return true;
+}
+
+/**
+ * FUNÇÃO 5: paramStreamNext()
+ * ESPECIFICAÇÃO: Reabastecer fichas pelo tempo decorrido e, se houver fichas
+ * para um quadro inteiro, produzir o próximo PARAM_VALUE (retransmissões
+ * têm prioridade sobre o fluxo sequencial). Retorna false quando deve esperar.
+ */
+bool paramStreamNext(param_stream_t *s, const param_store_t *store, uint64_t agora_us,
+                     param_value_msg_t *msg) {
+    if (agora_us > s->ultimo_us) {
+        uint64_t novos = (agora_us - s->ultimo_us) * s->bytes_por_s / 1000000u;
+
+        if (novos > 0) {
+            uint64_t t = s->tokens + novos;
+            s->tokens = (t > s->tokens_max) ? s->tokens_max : (uint32_t)t;
+            s->ultimo_us = agora_us;
+        }
+    }
+
+    if (!s->ativo || s->tokens < PARAM_VALUE_FRAME_LEN) {
+        return false;
+    }
+
+    uint16_t index;
+
+    if (s->retx_count > 0) {
+        index = s->retx[s->retx_head];
+        s->retx_head = (uint16_t)((s->retx_head + 1) % PARAM_RETX_MAX);
+        s->retx_count--;
+
+    } else if (s->proximo < store->count) {
+        index = s->proximo++;
+
+    } else {
+        s->ativo = false;
+        return false;
+    }
+
+    s->tokens -= PARAM_VALUE_FRAME_LEN;
+    return paramEncode(store, index, msg);
+}
+
+// ================== RECEPTOR COM DETECÇÃO DE LACUNAS ==================
+
+void paramReceiverReset(param_receiver_t *r) {
+    memset(r->recebidos, 0, sizeof(r->recebidos));
+    r->total = 0;
+    r->contagem = 0;
+}
+
+/**
+ * FUNÇÃO 6: paramReceiverHandle()
+ * ESPECIFICAÇÃO: Registrar um PARAM_VALUE no bitmap. Mensagens com
+ * param_count inconsistente ou param_index fora do range são rejeitadas.
+ */
+bool paramReceiverHandle(param_receiver_t *r, const param_value_msg_t *msg) {
+    if (msg->param_count == 0 || msg->param_count > PARAM_MAX) {
+        return false;
+    }
+
+    if (r->total == 0) {
+        r->total = msg->param_count;
+
+    } else if (r->total != msg->param_count) {
+        return false;
+    }
+
+    if (msg->param_index >= r->total) {
+        return false;
+    }
+
+    uint32_t word = msg->param_index / 32u;
+    uint32_t bit = 1u << (msg->param_index % 32u);
+
+    if ((r->recebidos[word] & bit) == 0) {
+        r->recebidos[word] |= bit;
+        r->contagem++;
+    }
+
+    r->values[msg->param_index] = msg->param_value;
+    return true;
+}
+
+bool paramReceiverComplete(const param_receiver_t *r) {
+    return r->total != 0 && r->contagem == r->total;
+}
+
+/**
+ * FUNÇÃO 7: paramReceiverGaps()
+ * ESPECIFICAÇÃO: Listar até max_out índices ainda não recebidos, varrendo o
+ * bitmap 32 índices por vez. Retorna o número de índices escritos em out[].
+ */
+int paramReceiverGaps(const param_receiver_t *r, uint16_t *out, int max_out) {
+    int n = 0;
+    int words = (r->total + 31) / 32;
+
+    for (int w = 0; w < words && n < max_out; w++) {
+        uint32_t faltando = ~r->recebidos[w];
+
+        // Última palavra: ignorar bits além de total
+        if (w == words - 1 && (r->total % 32u) != 0) {
+            faltando &= (1u << (r->total % 32u)) - 1u;
+        }
+
+        while (faltando != 0 && n < max_out) {
+            int b = __builtin_ctz(faltando);
+            out[n++] = (uint16_t)(w * 32 + b);
+            faltando &= faltando - 1u;
+        }
+    }
+
+    return n;
+}
+
+#ifndef MODO_NATIVO
+
+// ================== FUNÇÕES ESBMC ==================
+extern int nondet_int();
+extern uint8_t nondet_uint8();
+extern uint16_t nondet_uint16();
+extern float nondet_float();
+extern void __ESBMC_assume(int condition);
+
+// ================== TESTES DE VERIFICAÇÃO FORMAL ==================
+
+static param_store_t store;
+static param_receiver_t receiver;
+static param_stream_t stream;
+
+static void montarStorePequeno() {
+    store.count = 0;
+    paramStoreAdd(&store, "SYS_AUTOSTART", 4001.0f, mav_param_type_t::INT32);
+    paramStoreAdd(&store, "GPS_DUMP_COMM", 0.0f, mav_param_type_t::INT32);
+    paramStoreAdd(&store, "IMU_GYRO_CUTOFF", 40.0f, mav_param_type_t::REAL32);
+    paramStoreAdd(&store, "MPC_XY_VEL_MAX", 12.0f, mav_param_type_t::REAL32);
+    paramStoreBuild(&store);
+}
+
+/**
+ * TESTE 1: Verificar busca binária
+ * PROPRIEDADE: Resultado é -1 ou um índice válido cujo id é igual ao procurado
+ */
+void test_param_find_bounds() {
+    montarStorePequeno();
+
+    char query[PARAM_ID_LEN];
+    int escolha = nondet_int();
+    __ESBMC_assume(escolha >= 0 && escolha < 5);
+
+    if (escolha < 4) {
+        memcpy(query, store.ids[escolha], PARAM_ID_LEN);
+    } else {
+        copiarId(query, "NAO_EXISTE");
+    }
+
+    int idx = paramFind(&store, query);
+
+    assert(idx >= -1 && idx < store.count);
+
+    if (escolha < 4) {
+        assert(idx == escolha);
+    } else {
+        assert(idx == -1);
+    }
+}
+
+/**
+ * TESTE 2: Verificar tratamento de PARAM_VALUE recebido
+ * PROPRIEDADE: param_index/param_count arbitrários nunca escrevem fora do bitmap
+ */
+void test_param_receiver_index_bounds() {
+    paramReceiverReset(&receiver);
+
+    param_value_msg_t msg;
+    msg.param_count = nondet_uint16();
+    msg.param_index = nondet_uint16();
+    msg.param_value = nondet_float();
+
+    bool aceito = paramReceiverHandle(&receiver, &msg);
+
+    if (aceito) {
+        assert(msg.param_index < receiver.total);
+        assert(receiver.total <= PARAM_MAX);
+        assert(receiver.contagem == 1);
+    } else {
+        assert(receiver.contagem == 0);
+    }
+}
+
+/**
+ * TESTE 3: Verificar coleta de lacunas
+ * PROPRIEDADE: Nunca excede max_out e todo índice retornado é < total e ausente
+ */
+void test_param_gaps_bounds() {
+    paramReceiverReset(&receiver);
+    receiver.total = nondet_uint16();
+    __ESBMC_assume(receiver.total > 0 && receiver.total <= 64);
+    receiver.recebidos[0] = nondet_int();
+    receiver.recebidos[1] = nondet_int();
+
+    uint16_t out[8];
+    int max_out = nondet_int();
+    __ESBMC_assume(max_out >= 0 && max_out <= 8);
+
+    int n = paramReceiverGaps(&receiver, out, max_out);
+
+    assert(n >= 0 && n <= max_out);
+
+    for (int i = 0; i < n; i++) {
+        assert(out[i] < receiver.total);
+        assert((receiver.recebidos[out[i] / 32] & (1u << (out[i] % 32))) == 0);
+    }
+}
+
+/**
+ * TESTE 4: Verificar cadência do transmissor
+ * PROPRIEDADE: Fichas nunca excedem a rajada máxima e só há envio com fichas
+ */
+void test_param_stream_pacing() {
+    montarStorePequeno();
+
+    uint32_t bps = nondet_uint16();
+    __ESBMC_assume(bps > 0);
+    paramStreamStart(&stream, bps, 4 * PARAM_VALUE_FRAME_LEN, 0);
+    stream.tokens = nondet_uint8();
+    __ESBMC_assume(stream.tokens <= stream.tokens_max);
+
+    uint64_t agora = nondet_uint16();
+    param_value_msg_t msg;
+    bool enviou = paramStreamNext(&stream, &store, agora, &msg);
+
+    assert(stream.tokens <= stream.tokens_max);
+
+    if (enviou) {
+        assert(msg.param_index < store.count);
+        assert(msg.param_count == store.count);
+    } else {
+        // Ainda há parâmetros a enviar: só espera por falta de fichas
+        assert(stream.tokens < PARAM_VALUE_FRAME_LEN);
+    }
+}
+
+// ================== MAIN PARA ESBMC ==================
+int main() {
+    int test_choice = nondet_int();
+    __ESBMC_assume(test_choice >= 0 && test_choice < 4);
+
+    switch(test_choice) {
+        case 0:
+            test_param_find_bounds();
+            break;
+        case 1:
+            test_param_receiver_index_bounds();
+            break;
+        case 2:
+            test_param_gaps_bounds();
+            break;
+        case 3:
+            test_param_stream_pacing();
+            break;
+    }
+
+    return 0;
+}
+
+#else // MODO_NATIVO
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+
+// ================== ENLACE SIMULADO COM PERDAS ==================
+
+/**
+ * Enlace half-duplex por sentido: serialização na taxa nominal, latência fixa
+ * e perda independente por quadro (PRNG xorshift determinístico).
+ */
+struct link_simulado_t {
+    struct quadro_t {
+        uint64_t chegada_us;
+        bool pedido;                 // true = PARAM_REQUEST_READ, false = PARAM_VALUE
+        uint16_t index;
+        param_value_msg_t msg;
+    };
+
+    std::deque<quadro_t> em_voo;
+    uint64_t livre_us = 0;           // Instante em que o meio fica livre
+    uint32_t bytes_por_s;
+    uint32_t latencia_us;
+    uint32_t perda_ppm;
+    uint64_t estado_prng;
+    uint64_t enviados = 0;
+    uint64_t perdidos = 0;
+
+    link_simulado_t(uint32_t bps, uint32_t lat_us, uint32_t perda, uint64_t semente)
+        : bytes_por_s(bps), latencia_us(lat_us), perda_ppm(perda), estado_prng(semente | 1) {}
+
+    uint32_t aleatorio() {
+        estado_prng ^= estado_prng << 13;
+        estado_prng ^= estado_prng >> 7;
+        estado_prng ^= estado_prng << 17;
+        return (uint32_t)(estado_prng >> 32);
+    }
+
+    // Retorna o instante em que o quadro termina de ser serializado
+    uint64_t enviar(uint64_t agora_us, uint32_t bytes, const quadro_t &q) {
+        uint64_t inicio = agora_us > livre_us ? agora_us : livre_us;
+        livre_us = inicio + (uint64_t)bytes * 1000000u / bytes_por_s;
+        enviados++;
+
+        if (aleatorio() % 1000000u < perda_ppm) {
+            perdidos++;
+            return livre_us;
+        }
+
+        quadro_t copia = q;
+        copia.chegada_us = livre_us + latencia_us;
+        em_voo.push_back(copia);
+        return livre_us;
+    }
+};
+
+struct resultado_t {
+    uint64_t tempo_us;
+    uint64_t quadros;
+    uint64_t pedidos;
+    bool completo;
+};
+
+static param_store_t g_store;
+static param_receiver_t g_receiver;
+static param_stream_t g_stream;
+
+static void montarStore(int n) {
+    g_store.count = 0;
+    char nome[32];
+
+    for (int i = 0; i < n; i++) {
+        // Nomes no formato PX4 (prefixo de módulo + sufixo), em ordem embaralhada
+        int k = (i * 7919) % n;
+        snprintf(nome, sizeof(nome), "MOD%02d_PARAM_%04d", k % 37, k);
+        paramStoreAdd(&g_store, nome, (float)k * 0.5f, mav_param_type_t::REAL32);
+    }
+
+    if (!paramStoreBuild(&g_store)) {
+        fprintf(stderr, "nomes duplicados\n");
+        exit(1);
+    }
+}
+
+/**
+ * Transferência completa em rajada: PARAM_REQUEST_LIST implícito em t=0,
+ * fluxo sequencial cadenciado e pedidos em lote das lacunas quando o
+ * receptor fica ocioso por mais de 2 RTTs.
+ */
+static resultado_t transferirRajada(uint32_t bps, uint32_t lat_us, uint32_t perda_ppm, uint64_t semente) {
+    link_simulado_t desce(bps, lat_us, perda_ppm, semente);
+    link_simulado_t sobe(bps, lat_us, perda_ppm, semente * 31 + 7);
+
+    paramReceiverReset(&g_receiver);
+    paramStreamStart(&g_stream, bps, 8 * PARAM_VALUE_FRAME_LEN, 0);
+
+    const uint64_t ocioso_us = 2 * (2 * (uint64_t)lat_us + 2 * PARAM_VALUE_FRAME_LEN * 1000000ull / bps);
+    const uint64_t limite_us = 600ull * 1000000ull;
+    uint64_t agora = 0;
+    uint64_t ultima_atividade = 0;
+    uint64_t pedidos = 0;
+
+    while (!paramReceiverComplete(&g_receiver) && agora < limite_us) {
+        // Transmissor: esvaziar o que as fichas permitem
+        param_value_msg_t msg;
+        while (desce.livre_us <= agora && paramStreamNext(&g_stream, &g_store, agora, &msg)) {
+            link_simulado_t::quadro_t q = {};
+            q.msg = msg;
+            desce.enviar(agora, PARAM_VALUE_FRAME_LEN, q);
+        }
+
+        // Entregas ao receptor
+        while (!desce.em_voo.empty() && desce.em_voo.front().chegada_us <= agora) {
+            paramReceiverHandle(&g_receiver, &desce.em_voo.front().msg);
+            desce.em_voo.pop_front();
+            ultima_atividade = agora;
+        }
+
+        // Pedidos de retransmissão chegando ao transmissor
+        while (!sobe.em_voo.empty() && sobe.em_voo.front().chegada_us <= agora) {
+            paramStreamRequest(&g_stream, &g_store, sobe.em_voo.front().index);
+            sobe.em_voo.pop_front();
+        }
+
+        // Receptor ocioso: pedir lacunas em lote
+        bool fluxo_parado = !g_stream.ativo && desce.em_voo.empty();
+        if ((fluxo_parado || agora - ultima_atividade > ocioso_us) && agora - ultima_atividade > ocioso_us / 2) {
+            uint16_t lacunas[64];
+            int n = (g_receiver.total == 0) ? 0 : paramReceiverGaps(&g_receiver, lacunas, 64);
+
+            if (g_receiver.total == 0) {
+                // Nem o primeiro quadro chegou: repetir PARAM_REQUEST_LIST
+                paramStreamStart(&g_stream, bps, 8 * PARAM_VALUE_FRAME_LEN, agora);
+                pedidos++;
+            }
+
+            for (int i = 0; i < n; i++) {
+                link_simulado_t::quadro_t q = {};
+                q.pedido = true;
+                q.index = lacunas[i];
+                sobe.enviar(agora, PARAM_REQUEST_READ_FRAME_LEN, q);
+                pedidos++;
+            }
+
+            ultima_atividade = agora;
+        }
+
+        agora += 100; // Passo de 100 us
+    }
+
+    return resultado_t{agora, desce.enviados, pedidos, paramReceiverComplete(&g_receiver)};
+}
+
+/**
+ * Referência: um PARAM_REQUEST_READ por índice, esperando a resposta (ou
+ * timeout de 3 RTTs) antes do próximo - o comportamento de um parâmetro por vez.
+ */
+static resultado_t transferirUmPorVez(uint32_t bps, uint32_t lat_us, uint32_t perda_ppm, uint64_t semente) {
+    link_simulado_t desce(bps, lat_us, perda_ppm, semente);
+    link_simulado_t sobe(bps, lat_us, perda_ppm, semente * 31 + 7);
+
+    paramReceiverReset(&g_receiver);
+    const uint64_t timeout_us = 3 * (2 * (uint64_t)lat_us +
+        (PARAM_VALUE_FRAME_LEN + PARAM_REQUEST_READ_FRAME_LEN) * 1000000ull / bps);
+    uint64_t agora = 0;
+    uint64_t pedidos = 0;
+
+    for (uint16_t i = 0; i < g_store.count && agora < 3600ull * 1000000ull; ) {
+        link_simulado_t::quadro_t q = {};
+        q.pedido = true;
+        q.index = i;
+        uint64_t fim = sobe.enviar(agora, PARAM_REQUEST_READ_FRAME_LEN, q);
+        pedidos++;
+
+        bool respondido = false;
+        if (!sobe.em_voo.empty()) {
+            uint64_t chegada = sobe.em_voo.front().chegada_us;
+            sobe.em_voo.pop_front();
+            param_value_msg_t msg;
+            paramEncode(&g_store, i, &msg);
+            q.pedido = false;
+            q.msg = msg;
+            desce.enviar(chegada, PARAM_VALUE_FRAME_LEN, q);
+
+            if (!desce.em_voo.empty()) {
+                agora = desce.em_voo.front().chegada_us;
+                paramReceiverHandle(&g_receiver, &desce.em_voo.front().msg);
+                desce.em_voo.pop_front();
+                respondido = true;
+            }
+        }
+
+        if (respondido) {
+            i++;
+        } else {
+            agora = fim + timeout_us;
+        }
+    }
+
+    return resultado_t{agora, desce.enviados, pedidos, paramReceiverComplete(&g_receiver)};
+}
+
+int main(int argc, char **argv) {
+    int n = (argc > 1) ? atoi(argv[1]) : 1200;
+    uint32_t bps = (argc > 2) ? (uint32_t)atoi(argv[2]) : 57600 / 10; // rádio telemetria 57600 8N1
+    uint32_t lat_us = 20000;
+
+    if (n <= 0 || n > PARAM_MAX) {
+        fprintf(stderr, "uso: %s [num_params<=%d] [bytes_por_s]\n", argv[0], PARAM_MAX);
+        return 1;
+    }
+
+    montarStore(n);
+    printf("params=%d enlace=%u B/s latencia=%u us quadro=%u B\n", n, bps, lat_us, PARAM_VALUE_FRAME_LEN);
+    printf("%-10s %-9s %12s %10s %10s %10s %s\n",
+           "modo", "perda", "tempo_sim_s", "quadros", "pedidos", "cpu_ms", "ok");
+
+    const uint32_t perdas_ppm[] = {0, 10000, 50000, 100000};
+
+    for (uint32_t perda : perdas_ppm) {
+        for (int modo = 0; modo < 2; modo++) {
+            auto t0 = std::chrono::steady_clock::now();
+            resultado_t r = (modo == 0) ? transferirRajada(bps, lat_us, perda, 12345)
+                                        : transferirUmPorVez(bps, lat_us, perda, 12345);
+            auto t1 = std::chrono::steady_clock::now();
+            double cpu_ms = std::chrono::duration<double, std::milli>(t1 - t0).count();
+
+            printf("%-10s %8.1f%% %12.2f %10llu %10llu %10.1f %s\n",
+                   modo == 0 ? "rajada" : "um-a-um", perda / 10000.0,
+                   r.tempo_us / 1e6, (unsigned long long)r.quadros,
+                   (unsigned long long)r.pedidos, cpu_ms, r.completo ? "sim" : "NAO");
+        }
+    }
+
+    // Custo de busca por nome no armazenamento ordenado
+    auto t0 = std::chrono::steady_clock::now();
+    long long soma = 0;
+    const int buscas = 1000000;
+    for (int i = 0; i < buscas; i++) {
+        soma += paramFind(&g_store, g_store.ids[(i * 2654435761u) % g_store.count]);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    printf("paramFind: %.1f ns/busca (checksum %lld)\n",
+           std::chrono::duration<double, std::nano>(t1 - t0).count() / buscas, soma);
+
+    return 0;
+}
+
+#endif // MODO_NATIVO
+
+/*
+ * ================================================================
+ * DOCUMENTAÇÃO
+ * ================================================================
+ *
+ * PROTOCOLO:
+ *
+ * 1. ARMAZENAMENTO:
+ *    - Vetores separados (ids/values/types) ordenados por nome uma única vez
+ *    - paramFind(): busca binária sobre ids[] de 16 bytes (memcmp)
+ *    - Índice MAVLink = posição na ordem de nomes (igual ao PX4)
+ *
+ * 2. TRANSFERÊNCIA:
+ *    - Transmissor envia a lista inteira em rajada, cadenciado por balde de
+ *      fichas na taxa do enlace (sem esperar confirmação por parâmetro)
+ *    - Receptor marca índices num bitmap; ao ficar ocioso pede em lote as
+ *      lacunas (PARAM_REQUEST_READ por índice), que têm prioridade no envio
+ *
+ * 3. PROPRIEDADES VERIFICADAS (ESBMC):
+ *    - Busca binária retorna -1 ou índice válido correspondente
+ *    - param_index/param_count arbitrários não escrevem fora do bitmap
+ *    - Coleta de lacunas respeita max_out e total
+ *    - Balde de fichas nunca excede a rajada máxima
+ *
+ * COMANDOS DE EXECUÇÃO:
+ * esbmc mavlink.cpp --unwind 70 --overflow-check --bounds-check
+ * g++ -O2 -DMODO_NATIVO mavlink.cpp -o mavlink_bench && ./mavlink_bench 1200 5760
+ *
+ * BENCHMARK:
+ * - Tempo simulado de transferência completa (rajada x um-a-um) com perdas
+ *   de 0%, 1%, 5% e 10% por quadro, em ambos os sentidos do enlace
+ * - Custo de CPU da simulação e custo médio de paramFind()
+ *
+ * ================================================================
+ */
@@ -0,0 +1,1073 @@
+/**
+ * @file mcdc.cpp
+ * @author Dissertação Mestrado - Verificação Formal PX4 v1.16
+ *
+ * OBJETIVO: Gerar, com uma única execução do ESBMC, uma suíte de regressão
+ *           nativa que cobre MC/DC das funções extraídas do PX4
+ *           (processGyroData, dumpGpsData, constrain, ...)
+ * MÉTODO: 1. Decisões (if, while, ternário) da biblioteca e do header são
+ *            instrumentadas: cada condição registra T/F/não avaliada e a
+ *            decisão registra o vetor + resultado
+ *         2. Cada vetor possível (curto-circuito enumerado) é uma obrigação
+ *            __ESBMC_assert(vetor != k); com --multi-property o ESBMC
+ *            responde todas de uma vez, contraexemplo = entradas que atingem
+ *         3. Pares MC/DC (condição i muda sozinha, resultado muda; as
+ *            demais iguais ou não avaliadas) escolhidos entre os atingidos
+ *         4. Os contraexemplos dos pares viram casos de mcdc_suite.cpp:
+ *            reprodução das entradas nondet pelos test_* dos harnesses,
+ *            sem solver, em milissegundos
+ *
+ * SAÍDA (--dir, padrão mcdc_saida/; "mcdc" é o executável):
+ *   px4_funcoes.cpp/.h instrumentados, cópias dos harnesses, mcdc_sondas.h,
+ *   mcdc_alvo.cpp (entrada do ESBMC), mcdc_suite.cpp, obrigacoes.tsv
+ *
+ * Ferramenta nativa (não é alvo de verificação):
+ * g++ -O2 -std=c++17 mcdc.cpp -o mcdc
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "esbmc_processo.h"
+
+// Tipos das funções nondet dos harnesses (mesma lista do falsificador.cpp)
+static const std::vector<std::pair<std::string, std::string>> TIPOS_NONDET = {
+    {"int", "int"},         {"uint", "unsigned"},   {"int8", "int8_t"},     {"int16", "int16_t"},
+    {"int32", "int32_t"},   {"int64", "int64_t"},   {"uint8", "uint8_t"},   {"uint16", "uint16_t"},
+    {"uint32", "uint32_t"}, {"uint64", "uint64_t"}, {"size_t", "size_t"},   {"bool", "bool"},
+    {"float", "float"},     {"double", "double"},
+};
+
+static constexpr int MAX_CONDICOES = 10;    // 2 bits por condição; bit 30 = resultado
+static constexpr uint32_t BIT_RESULTADO = 1u << 30;
+
+// ================== DECISÕES ==================
+
+struct no_t {
+    char tipo;                 // '|', '&', '!' ou 'a' (condição)
+    std::vector<no_t> filhos;
+    int condicao;
+    size_t ini, fim;           // Posição da condição no texto original
+};
+
+struct decisao_t {
+    int id;
+    std::string arquivo;
+    int linha;
+    std::string funcao;
+    std::string texto;
+    size_t ini, fim;           // Expressão inteira da decisão
+    no_t arvore;
+    std::vector<std::string> condicoes;
+    std::vector<std::pair<size_t, size_t>> faixas;
+    std::vector<uint32_t> vetores;   // Todos os vetores de curto-circuito possíveis
+};
+
+// Comentários, literais e diretivas viram espaços (posições preservadas)
+static std::string mascarar(const std::string &s) {
+    std::string m = s;
+    size_t i = 0;
+
+    while (i < s.size()) {
+        if (s.compare(i, 2, "//") == 0 || (s[i] == '#' && (i == 0 || s[i - 1] == '\n'))) {
+            while (i < s.size() && s[i] != '\n') {
+                m[i++] = ' ';
+            }
+        } else if (s.compare(i, 2, "/*") == 0) {
+            const size_t fim = std::min(s.find("*/", i + 2), s.size() - 2) + 2;
+            for (; i < fim; i++) {
+                m[i] = s[i] == '\n' ? '\n' : ' ';
+            }
+        } else if (s[i] == '"' || s[i] == '\'') {
+            const char q = s[i];
+            m[i++] = ' ';
+            while (i < s.size() && s[i] != q) {
+                m[i] = ' ';
+                i += s[i] == '\\' ? 2 : 1;
+            }
+            if (i < s.size()) {
+                m[i++] = ' ';
+            }
+        } else {
+            i++;
+        }
+    }
+
+    return m;
+}
+
+// #if[n]def X, #if/#elif [!]defined(X) e #if 0/1: 1 ou 0; -1 = condição não entendida
+static int condicaoPre(const std::string &diretiva, std::string expr, const std::set<std::string> &definidos) {
+    const auto aparado = [](std::string t) {
+        const size_t a = t.find_first_not_of(" \t\r");
+        const size_t b = t.find_last_not_of(" \t\r");
+        return a == std::string::npos ? std::string() : t.substr(a, b - a + 1);
+    };
+
+    expr = aparado(expr.substr(0, expr.find("//")));
+    if (diretiva == "ifdef" || diretiva == "ifndef") {
+        return (definidos.count(expr) > 0) == (diretiva == "ifdef") ? 1 : 0;
+    }
+
+    bool negar = false;
+    if (!expr.empty() && expr[0] == '!') {
+        negar = true;
+        expr = aparado(expr.substr(1));
+    }
+
+    if (expr == "0" || expr == "1") {
+        return (expr == "1") != negar ? 1 : 0;
+    }
+
+    if (expr.compare(0, 7, "defined") != 0) {
+        return -1;
+    }
+
+    std::string nome = aparado(expr.substr(7));
+    if (!nome.empty() && nome[0] == '(' && nome.back() == ')') {
+        nome = aparado(nome.substr(1, nome.size() - 2));
+    }
+
+    for (char c : nome) {
+        if (!isalnum((unsigned char)c) && c != '_') {
+            return -1;
+        }
+    }
+
+    return (definidos.count(nome) > 0) != negar ? 1 : 0;
+}
+
+/**
+ * Linhas que o pré-processador exclui com as macros da verificação também
+ * viram espaços: decisão que o ESBMC não vê (ex.: #ifdef MODO_NATIVO) nunca
+ * teria par MC/DC. Condição não entendida conta como ativa.
+ */
+static void mascararInativas(const std::string &fonte, const std::set<std::string> &definidos, std::string *m) {
+    struct nivel_t {
+        bool pai_ativo;
+        bool ramo_tomado;
+        bool ativo;
+    };
+    std::vector<nivel_t> pilha;
+    bool ativo = true;
+
+    for (size_t ini = 0; ini < fonte.size();) {
+        const size_t fim = std::min(fonte.find('\n', ini), fonte.size());
+        const size_t p = fonte.find_first_not_of(" \t", ini);
+
+        if (p < fim && fonte[p] == '#') {
+            std::istringstream linha(fonte.substr(p + 1, fim - p - 1));
+            std::string diretiva, resto;
+            linha >> diretiva;
+            std::getline(linha, resto);
+
+            if (diretiva == "if" || diretiva == "ifdef" || diretiva == "ifndef") {
+                const bool c = condicaoPre(diretiva, resto, definidos) != 0;
+                pilha.push_back({ativo, c, ativo && c});
+            } else if ((diretiva == "elif" || diretiva == "else") && !pilha.empty()) {
+                nivel_t &n = pilha.back();
+                const bool c = diretiva == "else" || condicaoPre("if", resto, definidos) != 0;
+                n.ativo = n.pai_ativo && !n.ramo_tomado && c;
+                n.ramo_tomado = n.ramo_tomado || c;
+            } else if (diretiva == "endif" && !pilha.empty()) {
+                pilha.pop_back();
+            }
+
+            ativo = pilha.empty() || pilha.back().ativo;
+        } else if (!ativo) {
+            for (size_t i = ini; i < fim; i++) {
+                (*m)[i] = ' ';
+            }
+        }
+
+        ini = fim + 1;
+    }
+}
+
+static size_t fecharParentese(const std::string &m, size_t abre) {
+    int prof = 0;
+
+    for (size_t i = abre; i < m.size(); i++) {
+        prof += m[i] == '(' ? 1 : (m[i] == ')' ? -1 : 0);
+        if (prof == 0) {
+            return i;
+        }
+    }
+
+    return std::string::npos;
+}
+
+static size_t abrirParentese(const std::string &m, size_t fecha) {
+    int prof = 0;
+
+    for (size_t i = fecha + 1; i-- > 0;) {
+        prof += m[i] == ')' ? 1 : (m[i] == '(' ? -1 : 0);
+        if (prof == 0) {
+            return i;
+        }
+    }
+
+    return std::string::npos;
+}
+
+// Posições de um operador lógico em nível 0 dentro de [ini, fim)
+static std::vector<size_t> separadores(const std::string &m, size_t ini, size_t fim, const char *op) {
+    std::vector<size_t> r;
+    int prof = 0;
+
+    for (size_t i = ini; i + 1 < fim; i++) {
+        prof += m[i] == '(' ? 1 : (m[i] == ')' ? -1 : 0);
+        if (prof == 0 && m[i] == op[0] && m[i + 1] == op[1]) {
+            r.push_back(i);
+            i++;
+        }
+    }
+
+    return r;
+}
+
+static void aparar(const std::string &m, size_t *ini, size_t *fim) {
+    while (*ini < *fim && isspace((unsigned char)m[*ini])) {
+        (*ini)++;
+    }
+    while (*fim > *ini && isspace((unsigned char)m[*fim - 1])) {
+        (*fim)--;
+    }
+}
+
+static bool temLogico(const std::string &m, size_t ini, size_t fim) {
+    return !separadores(m, ini, fim, "||").empty() || !separadores(m, ini, fim, "&&").empty();
+}
+
+/**
+ * FUNÇÃO 1: lerExpressao()
+ * ESPECIFICAÇÃO: Árvore de || / && / ! sobre condições. Parênteses e ! só
+ * viram nós quando envolvem operador lógico; o resto (comparações,
+ * ponteiros, !dump_data) é uma condição.
+ */
+static no_t lerExpressao(const std::string &m, size_t ini, size_t fim, decisao_t *d) {
+    aparar(m, &ini, &fim);
+
+    for (const char *op : {"||", "&&"}) {
+        const std::vector<size_t> sep = separadores(m, ini, fim, op);
+        if (sep.empty()) {
+            continue;
+        }
+
+        no_t n = {op[0], {}, -1, ini, fim};
+        size_t a = ini;
+        for (size_t s : sep) {
+            n.filhos.push_back(lerExpressao(m, a, s, d));
+            a = s + 2;
+        }
+        n.filhos.push_back(lerExpressao(m, a, fim, d));
+        return n;
+    }
+
+    if (m[ini] == '!' && m[ini + 1] != '=') {
+        size_t i = ini + 1;
+        aparar(m, &i, &fim);
+        if (m[i] == '(' && fecharParentese(m, i) == fim - 1 && temLogico(m, i + 1, fim - 1)) {
+            return {'!', {lerExpressao(m, i + 1, fim - 1, d)}, -1, ini, fim};
+        }
+    }
+
+    if (m[ini] == '(' && fecharParentese(m, ini) == fim - 1 && temLogico(m, ini + 1, fim - 1)) {
+        return lerExpressao(m, ini + 1, fim - 1, d);
+    }
+
+    d->faixas.push_back({ini, fim});
+    return {'a', {}, (int)d->faixas.size() - 1, ini, fim};
+}
+
+// Curto-circuito: condições não avaliadas ficam com código 0 no vetor
+static bool avaliar(const no_t &n, uint32_t valores, uint32_t *vetor) {
+    switch (n.tipo) {
+    case 'a': {
+        const bool v = (valores >> n.condicao) & 1u;
+        *vetor |= (v ? 2u : 1u) << (2 * n.condicao);
+        return v;
+    }
+    case '!':
+        return !avaliar(n.filhos[0], valores, vetor);
+    case '&':
+        for (const no_t &f : n.filhos) {
+            if (!avaliar(f, valores, vetor)) {
+                return false;
+            }
+        }
+        return true;
+    default:
+        for (const no_t &f : n.filhos) {
+            if (avaliar(f, valores, vetor)) {
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+static int estado(uint32_t vetor, int i) { return (vetor >> (2 * i)) & 3u; }     // 0 = X, 1 = F, 2 = T
+
+static std::string vetorTexto(uint32_t vetor, int n) {
+    std::string s;
+    for (int i = 0; i < n; i++) {
+        s += "XFT"[estado(vetor, i)];
+    }
+    return s + ((vetor & BIT_RESULTADO) ? "->T" : "->F");
+}
+
+// Função que contém a posição: identificador antes do '(' que precede o '{' de nível 0
+static std::map<size_t, std::string> corposDeFuncao(const std::string &m) {
+    std::map<size_t, std::string> corpos;
+    int prof = 0;
+
+    for (size_t i = 0; i < m.size(); i++) {
+        if (m[i] == '{' && prof++ == 0) {
+            size_t j = i;
+            while (j > 0 && isspace((unsigned char)m[j - 1])) {
+                j--;
+            }
+            // const/override/noexcept depois da lista de parâmetros não ocorrem nas nossas fontes
+            if (j > 0 && m[j - 1] == ')') {
+                size_t k = abrirParentese(m, j - 1);
+                while (k > 0 && isspace((unsigned char)m[k - 1])) {
+                    k--;
+                }
+                size_t n = k;
+                while (n > 0 && (isalnum((unsigned char)m[n - 1]) || m[n - 1] == '_')) {
+                    n--;
+                }
+                corpos[i] = m.substr(n, k - n);
+            } else {
+                corpos[i] = "";
+            }
+        } else if (m[i] == '}') {
+            prof--;
+        }
+    }
+
+    return corpos;
+}
+
+/**
+ * FUNÇÃO 2: encontrarDecisoes()
+ * ESPECIFICAÇÃO: if (...), while (...) e (...) ? dentro de corpos de
+ * função e fora de regiões excluídas com as macros 'definidos'. Uma
+ * decisão dentro da condição de outra é ignorada (as condições da
+ * externa já a envolvem).
+ */
+static std::vector<decisao_t> encontrarDecisoes(const std::string &fonte, const std::string &arquivo,
+                                                const std::set<std::string> &definidos, int *proximo_id) {
+    std::string m = mascarar(fonte);
+    mascararInativas(fonte, definidos, &m);
+    const std::map<size_t, std::string> corpos = corposDeFuncao(m);
+    std::vector<decisao_t> ds;
+    size_t fim_anterior = 0;
+
+    for (size_t i = 0; i < m.size(); i++) {
+        size_t abre = std::string::npos;
+        const bool inicio_palavra = i == 0 || !(isalnum((unsigned char)m[i - 1]) || m[i - 1] == '_');
+
+        for (const std::string kw : {"if", "while"}) {
+            if (inicio_palavra && m.compare(i, kw.size(), kw) == 0 &&
+                !(isalnum((unsigned char)m[i + kw.size()]) || m[i + kw.size()] == '_')) {
+                size_t j = i + kw.size();
+                while (j < m.size() && isspace((unsigned char)m[j])) {
+                    j++;
+                }
+                abre = m[j] == '(' ? j : abre;
+            }
+        }
+
+        if (m[i] == '?') {
+            size_t j = i;
+            while (j > 0 && isspace((unsigned char)m[j - 1])) {
+                j--;
+            }
+            abre = j > 0 && m[j - 1] == ')' ? abrirParentese(m, j - 1) : abre;
+        }
+
+        if (abre == std::string::npos || abre < fim_anterior) {
+            continue;
+        }
+
+        const size_t fecha = fecharParentese(m, abre);
+        auto corpo = corpos.upper_bound(abre);
+        if (fecha == std::string::npos || corpo == corpos.begin() || (--corpo)->second.empty()) {
+            continue;
+        }
+
+        decisao_t d;
+        d.arquivo = arquivo;
+        d.linha = (int)std::count(fonte.begin(), fonte.begin() + abre, '\n') + 1;
+        d.funcao = corpo->second;
+        d.ini = abre + 1;
+        d.fim = fecha;
+        aparar(m, &d.ini, &d.fim);
+        d.arvore = lerExpressao(m, d.ini, d.fim, &d);
+        d.texto = fonte.substr(d.ini, d.fim - d.ini);
+
+        if (d.faixas.size() > (size_t)MAX_CONDICOES) {
+            fprintf(stderr, "%s:%d: %zu condicoes, acima do limite de %d; decisao ignorada\n", arquivo.c_str(),
+                    d.linha, d.faixas.size(), MAX_CONDICOES);
+            continue;
+        }
+
+        for (const auto &f : d.faixas) {
+            d.condicoes.push_back(fonte.substr(f.first, f.second - f.first));
+        }
+
+        std::set<uint32_t> vetores;
+        for (uint32_t valores = 0; valores < (1u << d.faixas.size()); valores++) {
+            uint32_t v = 0;
+            v |= avaliar(d.arvore, valores, &v) ? BIT_RESULTADO : 0u;
+            vetores.insert(v);
+        }
+
+        d.vetores.assign(vetores.begin(), vetores.end());
+        d.id = (*proximo_id)++;
+        fim_anterior = fecha;
+        ds.push_back(d);
+    }
+
+    return ds;
+}
+
+/**
+ * FUNÇÃO 3: instrumentar()
+ * ESPECIFICAÇÃO: Inserções de MCDC_D(d, ...) em volta da decisão e
+ * MCDC_C(d, i, ...) em volta de cada condição, aplicadas do fim para o
+ * começo; #line mantém arquivo:linha originais nos claims.
+ */
+static std::string instrumentar(const std::string &fonte, const std::string &arquivo,
+                                const std::vector<decisao_t> &ds) {
+    std::vector<std::pair<size_t, std::string>> insercoes;
+
+    for (const decisao_t &d : ds) {
+        for (size_t i = 0; i < d.faixas.size(); i++) {
+            insercoes.push_back({d.faixas[i].first, "MCDC_C(" + std::to_string(d.id) + ", " + std::to_string(i) + ", "});
+            insercoes.push_back({d.faixas[i].second, ")"});
+        }
+        insercoes.push_back({d.ini, "MCDC_D(" + std::to_string(d.id) + ", "});
+        insercoes.push_back({d.fim, ")"});
+    }
+
+    // Mesma posição: a inserção aplicada por último fica à frente (MCDC_D por fora de MCDC_C)
+    std::stable_sort(insercoes.begin(), insercoes.end(),
+                     [](const std::pair<size_t, std::string> &a, const std::pair<size_t, std::string> &b) {
+                         return a.first > b.first;
+                     });
+
+    std::string r = fonte;
+    for (const auto &ins : insercoes) {
+        r.insert(ins.first, ins.second);
+    }
+
+    return "#include \"mcdc_sondas.h\"\n#line 1 \"" + arquivo + "\"\n" + r;
+}
+
+// ================== ARQUIVOS GERADOS ==================
+
+// Falha (diretório sem permissão, disco cheio) vai para stderr: quem chama só encerra
+static bool gravar(const std::string &caminho, const std::string &conteudo) {
+    std::ofstream out(caminho, std::ios::binary | std::ios::trunc);
+    out << conteudo;
+    out.close();
+
+    if (!out) {
+        fprintf(stderr, "nao consegui gravar %s\n", caminho.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+static std::string nomeBase(const std::string &caminho) {
+    const size_t barra = caminho.rfind('/');
+    return barra == std::string::npos ? caminho : caminho.substr(barra + 1);
+}
+
+static std::string sondas(const std::vector<decisao_t> &ds) {
+    std::ostringstream o;
+
+    o << "// Gerado por mcdc.cpp: sondas MC/DC das decisões da biblioteca. Não editar.\n"
+      << "#pragma once\n\n#include <cstdint>\n\n"
+      << "#define MCDC_NUM_DECISOES " << ds.size() << "\n\n"
+      << "static uint32_t mcdc_vetor[MCDC_NUM_DECISOES];\n\n"
+      << "inline int mcdcInicio(int d) {\n    mcdc_vetor[d] = 0;\n    return 0;\n}\n\n"
+      << "// 2 bits por condição: 0 = não avaliada, 1 = falsa, 2 = verdadeira\n"
+      << "inline bool mcdcCondicao(int d, int i, bool c) {\n"
+      << "    mcdc_vetor[d] |= (c ? 2u : 1u) << (2 * i);\n    return c;\n}\n\n"
+      << "#ifdef MODO_NATIVO\n"
+      << "void mcdcRegistrar(int d, uint32_t vetor);      // mcdc_suite.cpp\n"
+      << "#else\n"
+      << "extern void __ESBMC_assert(bool condicao, const char *descricao);\n\n"
+      << "// Uma obrigação por vetor possível: violada = atingível, contraexemplo = entradas\n"
+      << "inline void mcdcRegistrar(int d, uint32_t vetor) {\n    switch (d) {\n";
+
+    for (const decisao_t &d : ds) {
+        o << "    case " << d.id << ":      // " << d.arquivo << ":" << d.linha << " " << d.funcao << "\n";
+        for (size_t k = 0; k < d.vetores.size(); k++) {
+            char hex[16];
+            snprintf(hex, sizeof(hex), "0x%08xu", d.vetores[k]);
+            o << "        __ESBMC_assert(vetor != " << hex << ", \"mcdc d" << d.id << " v" << k << " "
+              << vetorTexto(d.vetores[k], (int)d.condicoes.size()) << "\");\n";
+        }
+        o << "        break;\n";
+    }
+
+    o << "    }\n}\n#endif\n\n"
+      << "inline bool mcdcDecisao(int d, bool resultado) {\n"
+      << "    mcdcRegistrar(d, mcdc_vetor[d] | (resultado ? 0x" << std::hex << BIT_RESULTADO << std::dec
+      << "u : 0u));\n    return resultado;\n}\n\n"
+      << "#define MCDC_D(d, e) mcdcDecisao((d), (mcdcInicio(d), (e)))\n"
+      << "#define MCDC_C(d, i, c) mcdcCondicao((d), (i), (c))\n";
+
+    return o.str();
+}
+
+/**
+ * FUNÇÃO 4: alvoEsbmc()
+ * ESPECIFICAÇÃO: main() que sorteia um test_* e nondet_*() que passam o
+ * valor por uma variável mcdc_valor: no contraexemplo, as linhas
+ * "mcdc_valor = ..." são as entradas na ordem de consumo.
+ */
+static std::string alvoEsbmc(const std::vector<std::string> &testes) {
+    std::ostringstream o;
+
+    o << "// Gerado por mcdc.cpp: entrada única do ESBMC para as obrigações MC/DC. Não editar.\n"
+      << "#include <cstddef>\n#include <cstdint>\n\n"
+      << "extern void __ESBMC_assume(int condition);\n\n";
+
+    for (const std::string &t : testes) {
+        o << "void " << t << "();\n";
+    }
+
+    o << "\n";
+    for (const auto &t : TIPOS_NONDET) {
+        o << t.second << " nondet_mcdc_" << t.first << "();\n"
+          << t.second << " nondet_" << t.first << "() {\n    " << t.second << " mcdc_valor = nondet_mcdc_" << t.first
+          << "();\n    return mcdc_valor;\n}\n\n";
+    }
+
+    o << "int main() {\n    unsigned mcdc_teste = nondet_mcdc_uint();\n\n    switch (mcdc_teste) {\n";
+    for (size_t i = 0; i < testes.size(); i++) {
+        o << "    case " << i << ": " << testes[i] << "(); break;\n";
+    }
+    o << "    default: __ESBMC_assume(0);\n    }\n\n    return 0;\n}\n";
+
+    return o.str();
+}
+
+// ================== CONTRAEXEMPLOS ==================
+
+struct caso_t {
+    int decisao;
+    uint32_t vetor;
+    int teste;
+    std::vector<std::string> valores;
+};
+
+/**
+ * FUNÇÃO 5: lerContraexemplos()
+ * ESPECIFICAÇÃO: Saída de --multi-property: cada "Counterexample" traz os
+ * estados (mcdc_teste, mcdc_valor em ordem) e termina em "Violated
+ * property" com a descrição "mcdc d<D> v<K>". Propriedades dos próprios
+ * harnesses (asserts) são ignoradas.
+ */
+static std::map<std::pair<int, uint32_t>, caso_t> lerContraexemplos(const std::string &saida,
+                                                                     const std::vector<decisao_t> &ds) {
+    std::map<std::pair<int, uint32_t>, caso_t> casos;
+    std::istringstream linhas(saida);
+    std::string linha;
+    caso_t atual = {-1, 0, -1, {}};
+    bool violada = false;
+
+    while (std::getline(linhas, linha)) {
+        if (linha.find("Counterexample") != std::string::npos) {
+            atual = {-1, 0, -1, {}};
+            violada = false;
+            continue;
+        }
+
+        char valor[128];
+        unsigned teste;
+        int d, k;
+
+        if (sscanf(linha.c_str(), " mcdc_teste = %u", &teste) == 1) {
+            atual.teste = (int)teste;
+        } else if (sscanf(linha.c_str(), " mcdc_valor = %127s", valor) == 1) {
+            atual.valores.push_back(valor);
+        } else if (linha.find("Violated property") != std::string::npos) {
+            violada = true;
+        } else if (violada && sscanf(linha.c_str(), " mcdc d%d v%d", &d, &k) == 2 && d >= 0 && d < (int)ds.size() &&
+                   k >= 0 && k < (int)ds[d].vetores.size() && atual.teste >= 0) {
+            atual.decisao = d;
+            atual.vetor = ds[d].vetores[k];
+            casos.insert({{d, atual.vetor}, atual});
+            violada = false;
+        }
+    }
+
+    return casos;
+}
+
+struct par_t {
+    int decisao;
+    int condicao;
+    uint32_t u, v;
+};
+
+/**
+ * FUNÇÃO 6: escolherPares()
+ * ESPECIFICAÇÃO: Para cada condição, um par de vetores atingidos com a
+ * condição avaliada T num e F no outro, resultados diferentes e as
+ * demais condições iguais ou não avaliadas (MC/DC com mascaramento por
+ * curto-circuito). Preferência por vetores já escolhidos: suíte menor.
+ */
+static std::vector<par_t> escolherPares(const std::vector<decisao_t> &ds,
+                                        const std::map<std::pair<int, uint32_t>, caso_t> &casos,
+                                        std::set<std::pair<int, uint32_t>> *escolhidos, std::vector<par_t> *sem_par) {
+    std::vector<par_t> pares;
+
+    for (const decisao_t &d : ds) {
+        std::vector<uint32_t> atingidos;
+        for (uint32_t v : d.vetores) {
+            if (casos.count({d.id, v})) {
+                atingidos.push_back(v);
+            }
+        }
+
+        for (int i = 0; i < (int)d.condicoes.size(); i++) {
+            par_t melhor = {d.id, i, 0, 0};
+            int menor_custo = 3;
+
+            for (uint32_t u : atingidos) {
+                for (uint32_t v : atingidos) {
+                    if (estado(u, i) != 2 || estado(v, i) != 1 || (u & BIT_RESULTADO) == (v & BIT_RESULTADO)) {
+                        continue;
+                    }
+
+                    bool independente = true;
+                    for (int j = 0; j < (int)d.condicoes.size() && independente; j++) {
+                        independente = j == i || estado(u, j) == estado(v, j) || !estado(u, j) || !estado(v, j);
+                    }
+
+                    const int custo = (escolhidos->count({d.id, u}) ? 0 : 1) + (escolhidos->count({d.id, v}) ? 0 : 1);
+                    if (independente && custo < menor_custo) {
+                        melhor = {d.id, i, u, v};
+                        menor_custo = custo;
+                    }
+                }
+            }
+
+            if (menor_custo == 3) {
+                sem_par->push_back(melhor);
+                continue;
+            }
+
+            escolhidos->insert({d.id, melhor.u});
+            escolhidos->insert({d.id, melhor.v});
+            pares.push_back(melhor);
+        }
+    }
+
+    return pares;
+}
+
+// Valor do contraexemplo como literal C: TRUE/FALSE, sufixo f de float, NaN e infinito por builtin
+static std::string literal(const std::string &v) {
+    if (v == "TRUE" || v == "true") {
+        return "1";
+    }
+    if (v == "FALSE" || v == "false") {
+        return "0";
+    }
+
+    std::string minusculo = v;
+    std::transform(minusculo.begin(), minusculo.end(), minusculo.begin(), [](unsigned char c) { return tolower(c); });
+    const std::string sinal = minusculo[0] == '-' ? "-" : "";
+
+    if (minusculo.find("nan") != std::string::npos) {
+        return sinal + "__builtin_nan(\"\")";
+    }
+    if (minusculo.find("inf") != std::string::npos) {
+        return sinal + "__builtin_inf()";
+    }
+
+    std::string r = v;
+    while (!r.empty() && (r.back() == 'f' || r.back() == 'F' || r.back() == 'u' || r.back() == 'U' ||
+                          r.back() == 'l' || r.back() == 'L')) {
+        r.pop_back();
+    }
+    return r.empty() ? "0" : r + "L";
+}
+
+/**
+ * FUNÇÃO 7: suite()
+ * ESPECIFICAÇÃO: Um caso por vetor escolhido (teste + entradas; um mesmo
+ * contraexemplo que atinge vetores de várias decisões entra uma vez), a tabela
+ * de pares e um main() que reproduz tudo e confere que cada par continua
+ * sendo atingido. Assert do harness (SIGABRT) é contado, não derruba a
+ * suíte; com --estrito também reprova.
+ */
+static std::string suite(const std::vector<decisao_t> &ds, const std::vector<std::string> &testes,
+                         const std::map<std::pair<int, uint32_t>, caso_t> &casos,
+                         const std::set<std::pair<int, uint32_t>> &escolhidos, const std::vector<par_t> &pares,
+                         size_t *n_casos) {
+    std::ostringstream o;
+    std::set<std::pair<int, std::vector<std::string>>> emitidos;
+    size_t max_valores = 1;
+
+    for (const auto &e : escolhidos) {
+        max_valores = std::max(max_valores, casos.at(e).valores.size());
+    }
+
+    o << "// Gerado por mcdc.cpp: suíte de regressão MC/DC, sem solver. Não editar; regenerar com ./mcdc\n"
+      << "//\n// g++ -O1 -std=c++17 -DMODO_NATIVO -DPX4_BIBLIOTECA mcdc_suite.cpp <harnesses> px4_funcoes.cpp\n\n"
+      << "#include <csetjmp>\n#include <csignal>\n#include <cstdint>\n#include <cstdio>\n#include <cstring>\n"
+      << "#include <set>\n#include <utility>\n\n";
+
+    for (const std::string &t : testes) {
+        o << "void " << t << "();\n";
+    }
+
+    o << "\nstatic void (*const TESTES[])() = {";
+    for (size_t i = 0; i < testes.size(); i++) {
+        o << (i ? ", " : "") << testes[i];
+    }
+    o << "};\nstatic const char *const NOMES[] = {";
+    for (size_t i = 0; i < testes.size(); i++) {
+        o << (i ? ", " : "") << "\"" << testes[i] << "\"";
+    }
+
+    o << "};\n\nstruct caso_t {\n    int decisao;\n    uint32_t vetor;\n    int teste;\n    int n;\n"
+      << "    long double valores[" << max_valores << "];\n};\n\nstatic const caso_t CASOS[] = {\n";
+
+    for (const auto &e : escolhidos) {
+        const caso_t &c = casos.at(e);
+        const decisao_t &d = ds[c.decisao];
+        if (!emitidos.insert({c.teste, c.valores}).second) {
+            continue;
+        }
+
+        char hex[16];
+        snprintf(hex, sizeof(hex), "0x%08xu", c.vetor);
+
+        o << "    {" << c.decisao << ", " << hex << ", " << c.teste << ", " << c.valores.size() << ", {";
+        for (size_t i = 0; i < c.valores.size(); i++) {
+            o << (i ? ", " : "") << literal(c.valores[i]);
+        }
+        o << "}},      // " << d.arquivo << ":" << d.linha << " " << vetorTexto(c.vetor, (int)d.condicoes.size())
+          << "\n";
+    }
+
+    o << "};\n\nstruct par_t {\n    int decisao;\n    int condicao;\n    uint32_t u, v;\n    const char *onde;\n};\n\n"
+      << "static const par_t PARES[] = {\n";
+
+    for (const par_t &p : pares) {
+        const decisao_t &d = ds[p.decisao];
+        std::string cond = d.condicoes[p.condicao];
+        std::replace(cond.begin(), cond.end(), '"', '\'');
+        char hex[40];
+        snprintf(hex, sizeof(hex), "0x%08xu, 0x%08xu", p.u, p.v);
+        o << "    {" << p.decisao << ", " << p.condicao << ", " << hex << ", \"" << d.arquivo << ":" << d.linha << " "
+          << d.funcao << ": " << cond << "\"},\n";
+    }
+
+    o << "};\n\n"
+      << "// ================== REPRODUÇÃO ==================\n\n"
+      << "static const caso_t *atual = nullptr;\nstatic int consumidas = 0;\n"
+      << "static std::set<std::pair<int, uint32_t>> atingidos;\n\n"
+      << "void mcdcRegistrar(int d, uint32_t vetor) { atingidos.insert({d, vetor}); }\n\n"
+      << "template<typename T>\nstatic T proximo() {\n"
+      << "    const long double v = consumidas < atual->n ? atual->valores[consumidas] : 0.0L;\n"
+      << "    consumidas++;\n"
+      << "    return (T)0.5 == 0 ? (T)(__int128)v : (T)v;      // inteiros com a volta do tipo\n}\n\n";
+
+    for (const auto &t : TIPOS_NONDET) {
+        o << t.second << " nondet_" << t.first << "() { return proximo<" << t.second << ">(); }\n";
+    }
+
+    o << "\nstruct assume_rejeitada_t {};\n\n"
+      << "void __ESBMC_assume(int condition) {\n    if (!condition) {\n        throw assume_rejeitada_t();\n    }\n}\n\n"
+      << "static sigjmp_buf retorno;\n\nstatic void assertDoHarness(int) { siglongjmp(retorno, 1); }\n\n"
+      << "int main(int argc, char **argv) {\n"
+      << "    const bool estrito = argc > 1 && strcmp(argv[1], \"--estrito\") == 0;\n"
+      << "    const size_t n_casos = sizeof(CASOS) / sizeof(CASOS[0]);\n"
+      << "    int asserts = 0, rejeitados = 0, faltando = 0;\n\n"
+      << "    signal(SIGABRT, assertDoHarness);\n\n"
+      << "    for (size_t i = 0; i < n_casos; i++) {\n"
+      << "        atual = &CASOS[i];\n        consumidas = 0;\n\n"
+      << "        if (sigsetjmp(retorno, 1) != 0) {\n"
+      << "            printf(\"assert do harness falhou: caso %zu (%s)\\n\", i, NOMES[atual->teste]);\n"
+      << "            asserts++;\n            signal(SIGABRT, assertDoHarness);\n            continue;\n        }\n\n"
+      << "        try {\n            TESTES[atual->teste]();\n"
+      << "        } catch (const assume_rejeitada_t &) {\n            rejeitados++;\n        }\n\n"
+      << "        if (!atingidos.count({atual->decisao, atual->vetor})) {\n"
+      << "            printf(\"caso %zu (%s) nao atinge mais o vetor esperado da decisao %d\\n\", i, "
+         "NOMES[atual->teste], atual->decisao);\n"
+      << "        }\n    }\n\n"
+      << "    for (const par_t &p : PARES) {\n"
+      << "        if (!atingidos.count({p.decisao, p.u}) || !atingidos.count({p.decisao, p.v})) {\n"
+      << "            printf(\"MC/DC perdido: %s\\n\", p.onde);\n            faltando++;\n        }\n    }\n\n"
+      << "    const size_t n_pares = sizeof(PARES) / sizeof(PARES[0]);\n"
+      << "    printf(\"MC/DC: %zu de %zu condicoes com par independente, %zu casos (%d rejeitados por assume, \"\n"
+      << "           \"%d asserts do harness)\\n\", n_pares - faltando, n_pares, n_casos, rejeitados, asserts);\n"
+      << "    return faltando > 0 || rejeitados > 0 || (estrito && asserts > 0) ? 1 : 0;\n}\n";
+
+    *n_casos = emitidos.size();
+    return o.str();
+}
+
+// ================== MAIN ==================
+
+static void uso(const char *prog) {
+    fprintf(stderr,
+            "uso: %s [opcoes] [harness.cpp ...] [-- flags do ESBMC]\n"
+            "  --esbmc BIN        executavel do ESBMC (padrao: esbmc)\n"
+            "  --biblioteca F     funcoes extraidas (padrao: px4_funcoes.cpp; o .h junto)\n"
+            "  --dir DIR          arquivos gerados e suite (padrao: mcdc_saida)\n"
+            "  --timeout S        limite da execucao unica do ESBMC (padrao: 3600)\n"
+            "  --sem-esbmc        so instrumenta e gera mcdc_alvo.cpp\n",
+            prog);
+}
+
+int main(int argc, char **argv) {
+    std::string esbmc = "esbmc", biblioteca = "px4_funcoes.cpp", dir = "mcdc_saida";
+    std::vector<std::string> harnesses, flags;
+    double timeout_s = 3600.0;
+    bool rodar = true, depois_separador = false;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string a = argv[i];
+
+        if (depois_separador) {
+            flags.push_back(a);
+        } else if (a == "--") {
+            depois_separador = true;
+        } else if (a == "--esbmc" && i + 1 < argc) {
+            esbmc = argv[++i];
+        } else if (a == "--biblioteca" && i + 1 < argc) {
+            biblioteca = argv[++i];
+        } else if (a == "--dir" && i + 1 < argc) {
+            dir = argv[++i];
+        } else if (a == "--timeout" && i + 1 < argc) {
+            timeout_s = atof(argv[++i]);
+        } else if (a == "--sem-esbmc") {
+            rodar = false;
+        } else if (a == "-h" || a == "--help") {
+            uso(argv[0]);
+            return 0;
+        } else if (a[0] != '-') {
+            harnesses.push_back(a);
+        } else {
+            uso(argv[0]);
+            return 1;
+        }
+    }
+
+    if (harnesses.empty()) {
+        harnesses = {"gpsdrive.cpp", "imu.cpp", "Flight.cpp"};
+    }
+
+    if (flags.empty()) {
+        flags = {"--unwind", "8", "--no-unwinding-assertions"};
+    }
+
+    if (!criarDiretorios(dir)) {
+        fprintf(stderr, "nao consegui criar o diretorio %s\n", dir.c_str());
+        return 1;
+    }
+
+    // Macros da execução do ESBMC: regiões que ela exclui não têm decisões
+    std::set<std::string> definidos = {"PX4_BIBLIOTECA"};
+    for (const std::string &f : flags) {
+        if (f.compare(0, 2, "-D") == 0 && f.size() > 2) {
+            definidos.insert(f.substr(2, f.find('=') - 2));
+        }
+    }
+
+    // Biblioteca e header instrumentados; harnesses e headers auxiliares copiados
+    const std::string header = biblioteca.substr(0, biblioteca.rfind('.')) + ".h";
+    std::vector<decisao_t> ds;
+    int proximo_id = 0;
+
+    for (const std::string &f : {header, biblioteca}) {
+        std::string fonte;
+        if (!lerArquivo(f, &fonte)) {
+            fprintf(stderr, "nao consegui ler %s\n", f.c_str());
+            return 1;
+        }
+
+        const std::vector<decisao_t> da = encontrarDecisoes(fonte, nomeBase(f), definidos, &proximo_id);
+        ds.insert(ds.end(), da.begin(), da.end());
+        if (!gravar(dir + "/" + nomeBase(f), instrumentar(fonte, nomeBase(f), da))) {
+            return 1;
+        }
+    }
+
+    std::vector<std::string> testes;
+    std::set<std::string> copiados = {nomeBase(header), nomeBase(biblioteca)};
+    std::vector<std::string> a_copiar = harnesses;
+
+    while (!a_copiar.empty()) {
+        const std::string f = a_copiar.back();
+        a_copiar.pop_back();
+
+        std::string fonte;
+        if (!copiados.insert(nomeBase(f)).second || !lerArquivo(f, &fonte)) {
+            continue;
+        }
+
+        if (!gravar(dir + "/" + nomeBase(f), fonte)) {
+            return 1;
+        }
+
+        std::istringstream linhas(fonte);
+        std::string linha;
+        const std::string pasta = f.find('/') == std::string::npos ? "" : f.substr(0, f.rfind('/') + 1);
+
+        while (std::getline(linhas, linha)) {
+            char nome[128];
+            if (sscanf(linha.c_str(), "void %127[A-Za-z0-9_]()", nome) == 1 && strncmp(nome, "test_", 5) == 0) {
+                testes.push_back(nome);
+            } else if (sscanf(linha.c_str(), "#include \"%127[^\"]\"", nome) == 1) {
+                a_copiar.push_back(pasta + nome);
+            }
+        }
+    }
+
+    if (!gravar(dir + "/mcdc_sondas.h", sondas(ds)) || !gravar(dir + "/mcdc_alvo.cpp", alvoEsbmc(testes))) {
+        return 1;
+    }
+
+    size_t n_condicoes = 0, n_vetores = 0;
+    for (const decisao_t &d : ds) {
+        n_condicoes += d.condicoes.size();
+        n_vetores += d.vetores.size();
+    }
+
+    printf("%zu decisoes, %zu condicoes, %zu obrigacoes (vetores) em %zu testes\n", ds.size(), n_condicoes, n_vetores,
+           testes.size());
+
+    if (!rodar) {
+        return 0;
+    }
+
+    // A execução única: todas as obrigações como propriedades independentes
+    std::vector<std::string> args = {esbmc, dir + "/mcdc_alvo.cpp"};
+    for (const std::string &h : harnesses) {
+        args.push_back(dir + "/" + nomeBase(h));
+    }
+    args.insert(args.end(), {dir + "/" + nomeBase(biblioteca), "-DPX4_BIBLIOTECA", "--multi-property"});
+    args.insert(args.end(), flags.begin(), flags.end());
+
+    const std::string log = dir + "/esbmc.log";
+    const processo_t p = executarProcesso(args, timeout_s, log);
+    printf("ESBMC: %.1f s%s, log em %s\n", p.tempo_s, p.timeout ? " (TIMEOUT, resultado parcial)" : "", log.c_str());
+
+    std::string saida;
+    lerArquivo(log, &saida);
+    const std::map<std::pair<int, uint32_t>, caso_t> casos = lerContraexemplos(saida, ds);
+
+    std::set<std::pair<int, uint32_t>> escolhidos;
+    std::vector<par_t> sem_par;
+    const std::vector<par_t> pares = escolherPares(ds, casos, &escolhidos, &sem_par);
+
+    size_t n_casos = 0;
+    if (!gravar(dir + "/mcdc_suite.cpp", suite(ds, testes, casos, escolhidos, pares, &n_casos))) {
+        return 1;
+    }
+
+    FILE *tsv = fopen((dir + "/obrigacoes.tsv").c_str(), "w");
+    if (!tsv) {
+        perror((dir + "/obrigacoes.tsv").c_str());
+        return 1;
+    }
+
+    fprintf(tsv, "decisao\tarquivo\tlinha\tfuncao\tcondicao\ttexto\tpar\n");
+    for (const par_t &pr : pares) {
+        const decisao_t &d = ds[pr.decisao];
+        const int n = (int)d.condicoes.size();
+        fprintf(tsv, "%d\t%s\t%d\t%s\t%d\t%s\t%s / %s\n", d.id, d.arquivo.c_str(), d.linha, d.funcao.c_str(),
+                pr.condicao, d.condicoes[pr.condicao].c_str(), vetorTexto(pr.u, n).c_str(),
+                vetorTexto(pr.v, n).c_str());
+    }
+    for (const par_t &pr : sem_par) {
+        const decisao_t &d = ds[pr.decisao];
+        fprintf(tsv, "%d\t%s\t%d\t%s\t%d\t%s\tSEM PAR\n", d.id, d.arquivo.c_str(), d.linha, d.funcao.c_str(),
+                pr.condicao, d.condicoes[pr.condicao].c_str());
+    }
+
+    if (fclose(tsv) != 0) {
+        perror((dir + "/obrigacoes.tsv").c_str());
+        return 1;
+    }
+
+    for (const par_t &pr : sem_par) {
+        const decisao_t &d = ds[pr.decisao];
+        printf("  sem par: %s:%d %s: %s\n", d.arquivo.c_str(), d.linha, d.funcao.c_str(),
+               d.condicoes[pr.condicao].c_str());
+    }
+
+    printf("%zu de %zu obrigacoes atingidas; MC/DC em %zu de %zu condicoes; suite com %zu casos -> %s/mcdc_suite.cpp\n",
+           casos.size(), n_vetores, pares.size(), n_condicoes, n_casos, dir.c_str());
+    return sem_par.empty() ? 0 : 2;
+}
+
+/*
+ * ================================================================
+ * DOCUMENTAÇÃO
+ * ================================================================
+ *
+ * GERAÇÃO DE SUÍTE MC/DC:
+ *
+ * 1. OBRIGAÇÕES:
+ *    - Vetor = estado de cada condição (T, F ou não avaliada pelo
+ *      curto-circuito) + resultado; todos os vetores possíveis de cada
+ *      decisão são enumerados a partir da árvore de && / || / !
+ *    - processGyroData: gyro_x == INT16_MIN && gyro_y == ... && gyro_z
+ *      == ... tem 4 vetores (FXX->F, TFX->F, TTF->F, TTT->T) e precisa
+ *      dos 4 para os 3 pares
+ *    - dumpGpsData: active_mode != mode || !dump_data
+ *    - Só o código que a execução do ESBMC compila: regiões excluídas
+ *      com -DPX4_BIBLIOTECA e os -D depois de -- (ex.: o gancho nativo
+ *      px4PublicarGpsDump em #ifdef MODO_NATIVO) não viram obrigações
+ *
+ * 2. UMA EXECUÇÃO DO ESBMC:
+ *    - --multi-property: cada __ESBMC_assert(vetor != k) é verificado
+ *      separadamente; os violados trazem contraexemplo próprio
+ *    - O ponto de entrada sorteia o test_*: os assumes dos harnesses dão
+ *      o contexto válido de cada função
+ *    - Vetor sem contraexemplo é inatingível dentro do limite (--unwind)
+ *      ou nos contextos dos harnesses: condição sem par sai em
+ *      obrigacoes.tsv como SEM PAR
+ *
+ * 3. SUÍTE:
+ *    - mcdc_suite.cpp reproduz cada caso (nondet devolve os valores do
+ *      contraexemplo, em ordem) contra a biblioteca instrumentada
+ *    - Sai 1 se algum par deixou de ser atingido (mudança no código da
+ *      biblioteca ou nos harnesses): regerar com ./mcdc
+ *    - Asserts dos harnesses que falham (bugs conhecidos) são contados;
+ *      --estrito reprova também por eles
+ *
+ * COMANDOS DE EXECUÇÃO:
+ * g++ -O2 -std=c++17 mcdc.cpp -o mcdc
+ * ./mcdc -- --unwind 8 --no-unwinding-assertions
+ * cd mcdc_saida && g++ -O1 -std=c++17 -DMODO_NATIVO -DPX4_BIBLIOTECA mcdc_suite.cpp gpsdrive.cpp imu.cpp \
+ *     Flight.cpp px4_funcoes.cpp -o mcdc_suite && ./mcdc_suite
+ *
+ * ================================================================
+ */
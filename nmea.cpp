@@ -0,0 +1,436 @@
+/**
+ * @file nmea.cpp
+ * @author Dissertação Mestrado - Verificação Formal PX4 v1.16
+ *
+ * OBJETIVO: Verificar e medir o parser NMEA 0183 (nmea_parser.h)
+ * MÓDULO TESTADO: Estágio de entrada NMEA sobre o fluxo de dumpGpsData()
+ * MÉTODO: Bounded Model Checking com ESBMC + benchmark nativo (-DMODO_NATIVO)
+ */
+
+#include <assert.h>
+#include <cstring>
+#include <cstdint>
+
+#include "nmea_parser.h"
+
+#ifndef MODO_NATIVO
+
+// ================== FUNÇÕES ESBMC ==================
+extern int nondet_int();
+extern uint8_t nondet_uint8();
+extern size_t nondet_size_t();
+extern void __ESBMC_assume(int condition);
+
+// ================== TESTES DE VERIFICAÇÃO FORMAL ==================
+
+static nmea_parser_t parser;
+
+/**
+ * TESTE 1: Verificar enquadramento com bytes arbitrários em dois pedaços
+ * PROPRIEDADE: len, num_campos e offsets de campos nunca saem dos buffers,
+ * qualquer que seja o ponto de corte entre os pedaços
+ */
+void test_nmea_framing_bounds() {
+    uint8_t entrada[12];
+    for (int i = 0; i < 12; i++) {
+        entrada[i] = nondet_uint8();
+    }
+
+    size_t corte = nondet_size_t();
+    __ESBMC_assume(corte <= 12);
+
+    nmeaReset(&parser);
+
+    const uint8_t *pedacos[2] = {entrada, entrada + corte};
+    size_t tamanhos[2] = {corte, 12 - corte};
+
+    for (int k = 0; k < 2; k++) {
+        size_t pos = 0;
+
+        while (pos < tamanhos[k]) {
+            nmea_sentenca_t s;
+            bool completa = false;
+            size_t usados = nmeaFeed(&parser, pedacos[k] + pos, tamanhos[k] - pos, &s, &completa);
+
+            // PROPRIEDADE 1: Progresso - sempre consome ao menos um byte
+            assert(usados > 0 && usados <= tamanhos[k] - pos);
+            pos += usados;
+
+            // PROPRIEDADE 2: Estado interno dentro dos limites
+            assert(parser.len <= NMEA_MAX_LEN - 6);
+            assert(parser.num_campos <= NMEA_MAX_CAMPOS);
+
+            if (completa) {
+                // PROPRIEDADE 3: Todo campo começa dentro da sentença
+                for (int i = 0; i < s.num_campos; i++) {
+                    assert(s.campos[i] <= parser.len);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * TESTE 2: Verificar índice de campo arbitrário
+ * PROPRIEDADE: nmeaCampo() nunca devolve ponteiro fora de buf[]
+ */
+void test_nmea_field_index_bounds() {
+    const uint8_t sentenca[] = "$GPGGA,1,2,,3*66";
+
+    nmeaReset(&parser);
+    nmea_sentenca_t s;
+    bool completa = false;
+    nmeaFeed(&parser, sentenca, sizeof(sentenca) - 1, &s, &completa);
+    __ESBMC_assume(completa);
+
+    int idx = nondet_int();
+    const char *campo = nullptr;
+    bool existe = nmeaCampo(&s, idx, &campo);
+
+    if (existe) {
+        assert(idx >= 0 && idx < s.num_campos);
+        assert(campo >= parser.buf && campo <= parser.buf + parser.len);
+    } else {
+        assert(campo[0] == '\0');
+    }
+
+    assert(s.num_campos == 5);
+}
+
+/**
+ * TESTE 3: Verificar conversão para ponto fixo
+ * PROPRIEDADE: Sem overflow aritmético para qualquer texto de até 11 caracteres;
+ * o sinal do resultado é o do texto e, no mesmo texto lido como coordenada,
+ * |latitude| <= 90e7 e |longitude| <= 180e7
+ */
+void test_nmea_fixed_point_overflow() {
+    char texto[12];
+    for (int i = 0; i < 11; i++) {
+        texto[i] = (char)nondet_uint8();
+    }
+    texto[11] = '\0';
+
+    int32_t valor = 0;
+    if (nmeaParseFixo(texto, 2, &valor)) {
+        assert(texto[0] == '-' ? valor <= 0 : valor >= 0);
+    }
+
+    int32_t lat_e7 = 0, lon_e7 = 0;
+    if (nmeaParseCoordenada(texto, nondet_uint8() % 2 ? "N" : "S", &lat_e7)) {
+        assert(lat_e7 >= -900000000 && lat_e7 <= 900000000);
+    }
+
+    if (nmeaParseCoordenada(texto, nondet_uint8() % 2 ? "E" : "W", &lon_e7)) {
+        assert(lon_e7 >= -1800000000 && lon_e7 <= 1800000000);
+    }
+}
+
+/**
+ * TESTE 4: Verificar conversão de coordenada
+ * PROPRIEDADE: Hemisfério arbitrário: N/S aceitas ficam em [-90, 90] graus,
+ * E/W em [-180, 180], qualquer outro é recusado
+ */
+void test_nmea_coordinate_range() {
+    char texto[11];
+    for (int i = 0; i < 10; i++) {
+        texto[i] = (char)nondet_uint8();
+    }
+    texto[10] = '\0';
+
+    char hemisferio[2] = {(char)nondet_uint8(), '\0'};
+    int32_t valor_e7 = 0;
+
+    if (nmeaParseCoordenada(texto, hemisferio, &valor_e7)) {
+        const int32_t limite = (hemisferio[0] == 'N' || hemisferio[0] == 'S') ? 900000000 : 1800000000;
+        assert(hemisferio[0] == 'N' || hemisferio[0] == 'S' || hemisferio[0] == 'E' || hemisferio[0] == 'W');
+        assert(valor_e7 >= -limite && valor_e7 <= limite);
+    }
+}
+
+// ================== MAIN PARA ESBMC ==================
+int main() {
+    int test_choice = nondet_int();
+    __ESBMC_assume(test_choice >= 0 && test_choice < 4);
+
+    switch(test_choice) {
+        case 0:
+            test_nmea_framing_bounds();
+            break;
+        case 1:
+            test_nmea_field_index_bounds();
+            break;
+        case 2:
+            test_nmea_fixed_point_overflow();
+            break;
+        case 3:
+            test_nmea_coordinate_range();
+            break;
+    }
+
+    return 0;
+}
+
+#else // MODO_NATIVO
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "px4_funcoes.h"   // dumpGpsData() da biblioteca compartilhada (px4_funcoes.cpp)
+
+static uint64_t publicacoes = 0;
+
+// _dump_communication_pub.publish(*dump_data), ligado por px4PublicarGpsDump
+static void publicarDump(const gps_dump_s *) {
+    publicacoes++;
+}
+
+// ================== GERAÇÃO DO FLUXO ==================
+
+static void anexarSentenca(std::vector<uint8_t> &fluxo, const char *corpo) {
+    uint8_t cs = 0;
+    for (const char *c = corpo; *c; c++) {
+        cs ^= (uint8_t)*c;
+    }
+
+    char linha[128];
+    int n = snprintf(linha, sizeof(linha), "$%s*%02X\r\n", corpo, cs);
+    fluxo.insert(fluxo.end(), linha, linha + n);
+}
+
+static std::vector<uint8_t> gerarFluxo(size_t bytes_alvo, uint32_t semente) {
+    std::vector<uint8_t> fluxo;
+    fluxo.reserve(bytes_alvo + 256);
+    uint32_t x = semente;
+    uint32_t t = 0;
+
+    while (fluxo.size() < bytes_alvo) {
+        x = x * 1664525u + 1013904223u;
+        char corpo[100];
+        const unsigned hh = (t / 3600) % 24, mm = (t / 60) % 60, ss = t % 60;
+        const unsigned frac_lat = x % 100000, frac_lon = (x >> 8) % 100000;
+
+        snprintf(corpo, sizeof(corpo), "GPGGA,%02u%02u%02u.%02u,2330.%05u,S,04638.%05u,W,1,%02u,0.%u,%u.%u,M,-5.1,M,,",
+                 hh, mm, ss, x % 100, frac_lat, frac_lon, 8 + x % 10, 6 + x % 4, 700 + x % 50, x % 10);
+        anexarSentenca(fluxo, corpo);
+
+        snprintf(corpo, sizeof(corpo), "GPRMC,%02u%02u%02u.%02u,A,2330.%05u,S,04638.%05u,W,%u.%03u,%u.%02u,181026,,,A",
+                 hh, mm, ss, x % 100, frac_lat, frac_lon, x % 20, x % 1000, x % 360, x % 100);
+        anexarSentenca(fluxo, corpo);
+
+        // Sentenças que o estágio deve ignorar/descartar
+        if (x % 7 == 0) {
+            anexarSentenca(fluxo, "GPGSV,3,1,11,03,03,111,00,04,15,270,00,06,01,010,00,13,06,292,00");
+        }
+
+        if (x % 97 == 0) {
+            const char lixo[] = "$GPGGA,corrompida*00\r\n\xB5\x62\x01\x07";
+            fluxo.insert(fluxo.end(), lixo, lixo + sizeof(lixo) - 1);
+        }
+
+        t++;
+    }
+
+    return fluxo;
+}
+
+// ================== REFERÊNCIA COM strtok/strtod ==================
+
+struct contagem_t {
+    uint64_t gga = 0;
+    uint64_t rmc = 0;
+    int64_t soma_lat = 0;
+};
+
+static contagem_t parseReferencia(const std::vector<uint8_t> &fluxo, const std::vector<size_t> &cortes) {
+    contagem_t c;
+    std::string linha;
+    size_t inicio = 0;
+
+    for (size_t fim : cortes) {
+        for (size_t i = inicio; i < fim; i++) {
+            char ch = (char)fluxo[i];
+
+            if (ch == '$') {
+                linha.clear();
+            }
+
+            linha.push_back(ch);
+
+            if (ch != '\n' || linha.size() < 6 || linha[0] != '$') {
+                continue;
+            }
+
+            size_t asterisco = linha.find('*');
+            if (asterisco == std::string::npos) {
+                continue;
+            }
+
+            uint8_t cs = 0;
+            for (size_t k = 1; k < asterisco; k++) {
+                cs ^= (uint8_t)linha[k];
+            }
+
+            if (strtol(linha.c_str() + asterisco + 1, nullptr, 16) != cs) {
+                continue;
+            }
+
+            std::vector<char> copia(linha.begin() + 1, linha.begin() + asterisco);
+            copia.push_back('\0');
+            std::vector<char *> campos;
+            // strtok funde campos vazios; aceitável para contar GGA/RMC com fix
+            for (char *tok = strtok(copia.data(), ","); tok; tok = strtok(nullptr, ",")) {
+                campos.push_back(tok);
+            }
+
+            if (campos.size() > 5 && strcmp(campos[0] + 2, "GGA") == 0) {
+                double v = strtod(campos[2], nullptr);
+                double graus = (int)(v / 100) + (v - 100 * (int)(v / 100)) / 60.0;
+                c.soma_lat += (int64_t)(graus * 1e7 * (campos[3][0] == 'S' ? -1 : 1));
+                c.gga++;
+
+            } else if (campos.size() > 5 && strcmp(campos[0] + 2, "RMC") == 0) {
+                c.rmc++;
+            }
+        }
+
+        inicio = fim;
+    }
+
+    return c;
+}
+
+// ================== BENCHMARK ==================
+
+int main(int argc, char **argv) {
+    size_t mb = (argc > 1) ? (size_t)atoi(argv[1]) : 64;
+    std::vector<uint8_t> fluxo = gerarFluxo(mb << 20, 2026);
+
+    // Pedaços de 1 a 256 bytes, como leituras de serial entregues a dumpGpsData()
+    std::vector<size_t> cortes;
+    uint32_t x = 7;
+    for (size_t pos = 0; pos < fluxo.size(); ) {
+        x = x * 1103515245u + 12345u;
+        pos += 1 + (x >> 16) % 256;
+        cortes.push_back(pos < fluxo.size() ? pos : fluxo.size());
+    }
+
+    printf("fluxo=%.1f MB pedacos=%zu (media %.1f B)\n",
+           fluxo.size() / 1048576.0, cortes.size(), (double)fluxo.size() / cortes.size());
+
+    // 1) Parser sem alocação
+    static nmea_parser_t parser;
+    nmeaReset(&parser);
+    contagem_t rapido;
+    auto t0 = std::chrono::steady_clock::now();
+    size_t inicio = 0;
+
+    for (size_t fim : cortes) {
+        const uint8_t *p = fluxo.data() + inicio;
+        size_t restante = fim - inicio;
+
+        while (restante > 0) {
+            nmea_sentenca_t s;
+            bool completa;
+            size_t usados = nmeaFeed(&parser, p, restante, &s, &completa);
+            p += usados;
+            restante -= usados;
+
+            if (!completa) {
+                continue;
+            }
+
+            nmea_gga_t gga;
+            nmea_rmc_t rmc;
+
+            if (nmeaDecodeGGA(&s, &gga)) {
+                rapido.gga++;
+                rapido.soma_lat += gga.lat_e7;
+
+            } else if (nmeaDecodeRMC(&s, &rmc)) {
+                rapido.rmc++;
+            }
+        }
+
+        inicio = fim;
+    }
+
+    auto t1 = std::chrono::steady_clock::now();
+
+    // 2) Referência strtok/strtod
+    contagem_t ref = parseReferencia(fluxo, cortes);
+    auto t2 = std::chrono::steady_clock::now();
+
+    // 3) dumpGpsData() sobre os mesmos pedaços
+    px4PublicarGpsDump = publicarDump;
+    static gps_dump_s dump;
+    dump.len = 0;
+    inicio = 0;
+    for (size_t fim : cortes) {
+        dumpGpsData(fluxo.data() + inicio, fim - inicio, gps_dump_comm_mode_t::Full, false,
+                    &dump, gps_dump_comm_mode_t::Full);
+        inicio = fim;
+    }
+    auto t3 = std::chrono::steady_clock::now();
+
+    auto mbs = [&](std::chrono::steady_clock::duration d) {
+        return fluxo.size() / 1048576.0 / std::chrono::duration<double>(d).count();
+    };
+
+    printf("%-14s %10s %10s %10s %14s\n", "estagio", "MB/s", "GGA", "RMC", "sentencas/s");
+    printf("%-14s %10.1f %10llu %10llu %14.0f\n", "nmea_parser", mbs(t1 - t0),
+           (unsigned long long)rapido.gga, (unsigned long long)rapido.rmc,
+           (rapido.gga + rapido.rmc) / std::chrono::duration<double>(t1 - t0).count());
+    printf("%-14s %10.1f %10llu %10llu %14.0f\n", "strtok/strtod", mbs(t2 - t1),
+           (unsigned long long)ref.gga, (unsigned long long)ref.rmc,
+           (ref.gga + ref.rmc) / std::chrono::duration<double>(t2 - t1).count());
+    printf("%-14s %10.1f %10s %10s %14s (publicacoes=%llu)\n", "dumpGpsData", mbs(t3 - t2),
+           "-", "-", "-", (unsigned long long)publicacoes);
+    printf("checksum: ok=%u erros=%u descartes=%u\n",
+           parser.sentencas_ok, parser.erros_checksum, parser.descartes_tamanho);
+
+    // Latitudes: ponto fixo exato x double da referência (diferença média em 1e-7 graus)
+    if (rapido.gga != ref.gga) {
+        printf("DIVERGENCIA: GGA %llu x %llu\n", (unsigned long long)rapido.gga, (unsigned long long)ref.gga);
+        return 1;
+    }
+
+    printf("diferenca media lat (1e-7 graus): %.3f\n",
+           (double)(rapido.soma_lat - ref.soma_lat) / (double)(rapido.gga ? rapido.gga : 1));
+    return 0;
+}
+
+#endif // MODO_NATIVO
+
+/*
+ * ================================================================
+ * DOCUMENTAÇÃO
+ * ================================================================
+ *
+ * ESTÁGIO NMEA:
+ *
+ * 1. ENQUADRAMENTO RETOMÁVEL:
+ *    - Máquina de estados ESPERA_INICIO -> CORPO -> CHECKSUM_ALTO -> CHECKSUM_BAIXO
+ *    - XOR calculado durante a leitura, sem segunda passada
+ *    - ',' trocada por '\0' e offsets de campos guardados no próprio parser
+ *    - Qualquer corte de pedaço é suportado (estado persiste entre chamadas)
+ *
+ * 2. NÚMEROS SEM strtod:
+ *    - Latitude/longitude em graus*1e7 (int32), tempo em ms do dia,
+ *      HDOP/altitude/velocidade em ponto fixo com escala decimal fixa
+ *
+ * 3. PROPRIEDADES VERIFICADAS (ESBMC):
+ *    - Limites de buf[]/campos[] para bytes arbitrários e corte arbitrário
+ *    - Índice de campo arbitrário nunca sai da sentença
+ *    - Ausência de overflow na conversão para ponto fixo
+ *    - Range de coordenadas aceitas: latitude (N/S) em ±90°, longitude
+ *      (E/W) em ±180°, sinal do ponto fixo igual ao do texto
+ *
+ * COMANDOS DE EXECUÇÃO:
+ * esbmc nmea.cpp --unwind 13 --overflow-check --bounds-check
+ * g++ -O2 -DMODO_NATIVO nmea.cpp px4_funcoes.cpp -o nmea_bench && ./nmea_bench 64
+ *
+ * ================================================================
+ */
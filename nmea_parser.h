@@ -0,0 +1,507 @@
+/**
+ * @file nmea_parser.h
+ * @author Dissertação Mestrado - Verificação Formal PX4 v1.16
+ *
+ * OBJETIVO: Parser NMEA 0183 sem alocação e retomável
+ * MÓDULO: Estágio alternativo de entrada GPS (receptores só-NMEA)
+ *
+ * O parser consome pedaços arbitrários do mesmo fluxo de bytes que
+ * dumpGpsData() recebe: o estado (sentença parcial, checksum parcial,
+ * offsets de campos) fica todo em nmea_parser_t, sem heap, sem strtok/strtod.
+ * Números são convertidos diretamente para ponto fixo inteiro.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+// ================== CONSTANTES NMEA 0183 ==================
+static constexpr int NMEA_MAX_LEN = 82;        // '$' até '\n' inclusive (norma NMEA 0183)
+static constexpr int NMEA_MAX_CAMPOS = 24;     // Campos separados por ','
+
+enum class nmea_estado_t : uint8_t {
+    ESPERA_INICIO = 0,   // Descartando bytes até '$' ou '!'
+    CORPO,               // Acumulando caracteres e calculando XOR
+    CHECKSUM_ALTO,       // Primeiro dígito hex após '*'
+    CHECKSUM_BAIXO       // Segundo dígito hex após '*'
+};
+
+/**
+ * Estado do parser. buf[] guarda o corpo da sentença (sem '$' e sem '*hh'),
+ * com cada ',' substituída por '\0'; campos[] guarda o offset de cada campo.
+ */
+struct nmea_parser_t {
+    char buf[NMEA_MAX_LEN + 1];
+    uint8_t len;
+    uint8_t campos[NMEA_MAX_CAMPOS];
+    uint8_t num_campos;
+    nmea_estado_t estado;
+    uint8_t checksum_calc;
+    uint8_t checksum_rx;
+
+    // Estatísticas
+    uint32_t sentencas_ok;
+    uint32_t erros_checksum;
+    uint32_t descartes_tamanho;
+};
+
+/**
+ * Sentença completa e validada. Aponta para o buffer interno do parser:
+ * válida até a próxima chamada de nmeaFeed().
+ */
+struct nmea_sentenca_t {
+    const char *buf;
+    const uint8_t *campos;
+    uint8_t num_campos;
+};
+
+struct nmea_gga_t {
+    uint32_t tempo_ms;       // Milissegundos desde 00:00 UTC
+    int32_t lat_e7;          // Graus * 1e7
+    int32_t lon_e7;          // Graus * 1e7
+    uint8_t qualidade;       // 0 = sem fix
+    uint8_t satelites;
+    int32_t hdop_e2;         // HDOP * 100
+    int32_t alt_mm;          // Altitude MSL em mm
+};
+
+struct nmea_rmc_t {
+    uint32_t tempo_ms;
+    bool valido;             // Status 'A'
+    int32_t lat_e7;
+    int32_t lon_e7;
+    int32_t velocidade_mm_s; // Convertido de nós
+    int32_t curso_e2;        // Graus * 100
+    uint32_t data_ddmmyy;
+};
+
+// ================== ENQUADRAMENTO ==================
+
+inline void nmeaReset(nmea_parser_t *p) {
+    p->len = 0;
+    p->num_campos = 0;
+    p->estado = nmea_estado_t::ESPERA_INICIO;
+    p->checksum_calc = 0;
+    p->checksum_rx = 0;
+    p->sentencas_ok = 0;
+    p->erros_checksum = 0;
+    p->descartes_tamanho = 0;
+}
+
+inline int nmeaHex(uint8_t c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+
+    return -1;
+}
+
+inline void nmeaIniciarSentenca(nmea_parser_t *p) {
+    p->len = 0;
+    p->num_campos = 1;
+    p->campos[0] = 0;
+    p->checksum_calc = 0;
+    p->estado = nmea_estado_t::CORPO;
+}
+
+/**
+ * FUNÇÃO 1: nmeaFeed()
+ * ESPECIFICAÇÃO: Consumir bytes de data[0..len) até completar uma sentença.
+ * Retorna o número de bytes consumidos; *completa indica se out foi preenchida.
+ * O chamador repete com data + consumidos até esgotar o pedaço, então qualquer
+ * fronteira de pedaço (inclusive no meio do checksum) é suportada.
+ */
+inline size_t nmeaFeed(nmea_parser_t *p, const uint8_t *data, size_t len,
+                       nmea_sentenca_t *out, bool *completa) {
+    *completa = false;
+
+    for (size_t i = 0; i < len; i++) {
+        const uint8_t c = data[i];
+
+        // '$' ou '!' sempre reinicia: ressincroniza após lixo ou sentença truncada
+        if (c == '$' || c == '!') {
+            if (p->estado != nmea_estado_t::ESPERA_INICIO) {
+                p->descartes_tamanho++;
+            }
+
+            nmeaIniciarSentenca(p);
+            continue;
+        }
+
+        switch (p->estado) {
+        case nmea_estado_t::ESPERA_INICIO:
+            break;
+
+        case nmea_estado_t::CORPO:
+            if (c == '*') {
+                p->estado = nmea_estado_t::CHECKSUM_ALTO;
+
+            } else if (c < 0x20 || c > 0x7E || p->len >= NMEA_MAX_LEN - 6) {
+                // Caractere inválido ou corpo maior que a norma permite
+                p->descartes_tamanho++;
+                p->estado = nmea_estado_t::ESPERA_INICIO;
+
+            } else {
+                p->checksum_calc ^= c;
+
+                if (c == ',') {
+                    p->buf[p->len++] = '\0';
+
+                    if (p->num_campos >= NMEA_MAX_CAMPOS) {
+                        p->descartes_tamanho++;
+                        p->estado = nmea_estado_t::ESPERA_INICIO;
+                        break;
+                    }
+
+                    p->campos[p->num_campos++] = p->len;
+
+                } else {
+                    p->buf[p->len++] = (char)c;
+                }
+            }
+
+            break;
+
+        case nmea_estado_t::CHECKSUM_ALTO: {
+                int h = nmeaHex(c);
+
+                if (h < 0) {
+                    p->erros_checksum++;
+                    p->estado = nmea_estado_t::ESPERA_INICIO;
+
+                } else {
+                    p->checksum_rx = (uint8_t)(h << 4);
+                    p->estado = nmea_estado_t::CHECKSUM_BAIXO;
+                }
+
+                break;
+            }
+
+        case nmea_estado_t::CHECKSUM_BAIXO: {
+                int h = nmeaHex(c);
+                p->estado = nmea_estado_t::ESPERA_INICIO;
+
+                if (h < 0 || (uint8_t)(p->checksum_rx | h) != p->checksum_calc) {
+                    p->erros_checksum++;
+                    break;
+                }
+
+                p->buf[p->len] = '\0';
+                p->sentencas_ok++;
+                out->buf = p->buf;
+                out->campos = p->campos;
+                out->num_campos = p->num_campos;
+                *completa = true;
+                return i + 1;
+            }
+        }
+    }
+
+    return len;
+}
+
+/**
+ * FUNÇÃO 2: nmeaCampo()
+ * ESPECIFICAÇÃO: Acesso limitado ao campo de índice idx. Retorna false
+ * (e campo vazio) se idx não existir na sentença.
+ */
+inline bool nmeaCampo(const nmea_sentenca_t *s, int idx, const char **campo) {
+    if (idx < 0 || idx >= s->num_campos) {
+        *campo = "";
+        return false;
+    }
+
+    *campo = s->buf + s->campos[idx];
+    return true;
+}
+
+// ================== NÚMEROS EM PONTO FIXO ==================
+
+/**
+ * FUNÇÃO 3: nmeaParseFixo()
+ * ESPECIFICAÇÃO: Converter "[-]ddd[.fff]" para inteiro escalado por 10^casas,
+ * truncando dígitos excedentes. Retorna false para campo vazio, caractere
+ * inválido ou valor fora de int32.
+ */
+inline bool nmeaParseFixo(const char *s, int casas, int32_t *out) {
+    bool negativo = false;
+
+    if (*s == '-') {
+        negativo = true;
+        s++;
+    }
+
+    int64_t valor = 0;
+    int frac = -1;        // -1 = ainda na parte inteira
+    bool algum_digito = false;
+
+    for (; *s != '\0'; s++) {
+        if (*s == '.') {
+            if (frac >= 0) {
+                return false;
+            }
+
+            frac = 0;
+            continue;
+        }
+
+        if (*s < '0' || *s > '9') {
+            return false;
+        }
+
+        algum_digito = true;
+
+        if (frac >= 0) {
+            if (frac >= casas) {
+                continue;
+            }
+
+            frac++;
+        }
+
+        valor = valor * 10 + (*s - '0');
+
+        if (valor > INT32_MAX) {
+            return false;
+        }
+    }
+
+    if (!algum_digito) {
+        return false;
+    }
+
+    for (int k = (frac < 0 ? 0 : frac); k < casas; k++) {
+        valor *= 10;
+
+        if (valor > INT32_MAX) {
+            return false;
+        }
+    }
+
+    *out = (int32_t)(negativo ? -valor : valor);
+    return true;
+}
+
+/**
+ * FUNÇÃO 4: nmeaParseCoordenada()
+ * ESPECIFICAÇÃO: Converter "dddmm.mmmmm" + hemisfério (N/S/E/W) para graus*1e7.
+ * N/S é latitude e fica em [-90, 90] graus; E/W é longitude, [-180, 180].
+ */
+inline bool nmeaParseCoordenada(const char *s, const char *hemisferio, int32_t *out_e7) {
+    // Minutos com 7 casas: dddmm.mmmmmmm -> dddmm * 1e7 + fração
+    int64_t graus_min = 0;
+    int64_t frac_e7 = 0;
+    int64_t escala = 1000000;
+    bool na_fracao = false;
+    int digitos = 0;
+
+    for (; *s != '\0'; s++) {
+        if (*s == '.') {
+            if (na_fracao) {
+                return false;
+            }
+
+            na_fracao = true;
+            continue;
+        }
+
+        if (*s < '0' || *s > '9') {
+            return false;
+        }
+
+        if (na_fracao) {
+            if (escala > 0) {
+                frac_e7 += (*s - '0') * escala;
+                escala /= 10;
+            }
+
+        } else {
+            if (++digitos > 5) {
+                return false;
+            }
+
+            graus_min = graus_min * 10 + (*s - '0');
+        }
+    }
+
+    if (digitos < 3) {
+        return false;
+    }
+
+    const bool latitude = hemisferio[0] == 'N' || hemisferio[0] == 'S';
+    if (!latitude && hemisferio[0] != 'E' && hemisferio[0] != 'W') {
+        return false;
+    }
+
+    const int64_t limite = latitude ? 90 : 180;
+    const int64_t graus = graus_min / 100;
+    const int64_t minutos_e7 = (graus_min % 100) * 10000000 + frac_e7;
+
+    if (graus > limite || minutos_e7 >= 600000000) {
+        return false;
+    }
+
+    int64_t valor = graus * 10000000 + (minutos_e7 + 30) / 60;
+
+    // 90°00.5'N passa no teste de graus mas não é latitude
+    if (valor > limite * 10000000) {
+        return false;
+    }
+
+    if (hemisferio[0] == 'S' || hemisferio[0] == 'W') {
+        valor = -valor;
+    }
+
+    *out_e7 = (int32_t)valor;
+    return true;
+}
+
+/**
+ * FUNÇÃO 5: nmeaParseTempo()
+ * ESPECIFICAÇÃO: Converter "hhmmss[.sss]" para milissegundos do dia.
+ */
+inline bool nmeaParseTempo(const char *s, uint32_t *out_ms) {
+    uint32_t d[6];
+
+    for (int i = 0; i < 6; i++) {
+        if (s[i] < '0' || s[i] > '9') {
+            return false;
+        }
+
+        d[i] = (uint32_t)(s[i] - '0');
+    }
+
+    const uint32_t hh = d[0] * 10 + d[1];
+    const uint32_t mm = d[2] * 10 + d[3];
+    const uint32_t ss = d[4] * 10 + d[5];
+
+    if (hh > 23 || mm > 59 || ss > 60) {
+        return false;
+    }
+
+    uint32_t ms = 0;
+
+    if (s[6] == '.') {
+        uint32_t escala = 100;
+
+        for (const char *f = s + 7; *f != '\0'; f++) {
+            if (*f < '0' || *f > '9') {
+                return false;
+            }
+
+            ms += (uint32_t)(*f - '0') * escala;
+            escala /= 10;
+        }
+
+    } else if (s[6] != '\0') {
+        return false;
+    }
+
+    *out_ms = ((hh * 60 + mm) * 60 + ss) * 1000 + ms;
+    return true;
+}
+
+// ================== DECODIFICAÇÃO DE SENTENÇAS ==================
+
+inline bool nmeaTipo(const nmea_sentenca_t *s, const char *tipo) {
+    // Ignora o talker ("GP", "GN", "GL"...): compara os 3 caracteres após ele
+    const char *id = s->buf;
+
+    if (id[0] == '\0' || id[1] == '\0') {
+        return false;
+    }
+
+    // tipo[] não tem '\0' nas 3 posições: a igualdade já garante que id não terminou
+    return id[2] == tipo[0] && id[3] == tipo[1] && id[4] == tipo[2] && id[5] == '\0';
+}
+
+/**
+ * FUNÇÃO 6: nmeaDecodeGGA()
+ * ESPECIFICAÇÃO: $xxGGA,hhmmss.ss,llll.ll,a,yyyyy.yy,a,q,nn,h.h,a.a,M,...
+ */
+inline bool nmeaDecodeGGA(const nmea_sentenca_t *s, nmea_gga_t *gga) {
+    const char *f[10];
+
+    if (!nmeaTipo(s, "GGA") || s->num_campos < 10) {
+        return false;
+    }
+
+    for (int i = 0; i < 10; i++) {
+        nmeaCampo(s, i, &f[i]);
+    }
+
+    int32_t q = 0;
+    int32_t sats = 0;
+
+    if (!nmeaParseTempo(f[1], &gga->tempo_ms) || !nmeaParseFixo(f[6], 0, &q)) {
+        return false;
+    }
+
+    gga->qualidade = (uint8_t)q;
+
+    if (q == 0) {
+        return true;
+    }
+
+    if (!nmeaParseCoordenada(f[2], f[3], &gga->lat_e7) ||
+        !nmeaParseCoordenada(f[4], f[5], &gga->lon_e7) ||
+        !nmeaParseFixo(f[7], 0, &sats) ||
+        !nmeaParseFixo(f[8], 2, &gga->hdop_e2) ||
+        !nmeaParseFixo(f[9], 3, &gga->alt_mm)) {
+        return false;
+    }
+
+    gga->satelites = (uint8_t)sats;
+    return true;
+}
+
+/**
+ * FUNÇÃO 7: nmeaDecodeRMC()
+ * ESPECIFICAÇÃO: $xxRMC,hhmmss.ss,A,llll.ll,a,yyyyy.yy,a,x.x,x.x,ddmmyy,...
+ */
+inline bool nmeaDecodeRMC(const nmea_sentenca_t *s, nmea_rmc_t *rmc) {
+    const char *f[10];
+
+    if (!nmeaTipo(s, "RMC") || s->num_campos < 10) {
+        return false;
+    }
+
+    for (int i = 0; i < 10; i++) {
+        nmeaCampo(s, i, &f[i]);
+    }
+
+    if (!nmeaParseTempo(f[1], &rmc->tempo_ms)) {
+        return false;
+    }
+
+    rmc->valido = (f[2][0] == 'A');
+
+    if (!rmc->valido) {
+        return true;
+    }
+
+    int32_t nos_e3 = 0;
+    int32_t data = 0;
+
+    if (!nmeaParseCoordenada(f[3], f[4], &rmc->lat_e7) ||
+        !nmeaParseCoordenada(f[5], f[6], &rmc->lon_e7) ||
+        !nmeaParseFixo(f[7], 3, &nos_e3) ||
+        !nmeaParseFixo(f[8], 2, &rmc->curso_e2) ||
+        !nmeaParseFixo(f[9], 0, &data)) {
+        return false;
+    }
+
+    // 1 nó = 1852/3600 m/s -> mm/s = nós_e3 * 1852 / 3600
+    rmc->velocidade_mm_s = (int32_t)((int64_t)nos_e3 * 1852 / 3600);
+    rmc->data_ddmmyy = (uint32_t)data;
+    return true;
+}
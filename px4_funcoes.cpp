@@ -0,0 +1,106 @@
+/**
+ * @file px4_funcoes.cpp
+ * @author Dissertação Mestrado - Verificação Formal PX4 v1.16
+ *
+ * OBJETIVO: Definições da biblioteca compartilhada (px4_funcoes.h)
+ * MÉTODO: Convertida para GOTO uma única vez junto com os harnesses
+ *         (esbmc ... --output-goto); cada teste roda depois com --binary
+ *
+ * CÓDIGO: mesma lógica das cópias em gpsdrive.cpp e imu.cpp, que documentam
+ * a origem linha a linha no PX4 v1.16. Diferenças em dumpGpsData(): o cast
+ * (size_t) explícito na comparação do espaço restante (a conversão que a
+ * comparação já fazia, sem -Wsign-compare) e o gancho px4PublicarGpsDump,
+ * só no nativo, fora do GOTO verificado.
+ */
+
+#include <cstring>
+
+#include "conteudo_abstrato.h"
+#include "px4_funcoes.h"
+
+// ================== GPS DRIVER (gps.cpp ~643) ==================
+
+#ifdef MODO_NATIVO
+void (*px4PublicarGpsDump)(const gps_dump_s *dump_data) = nullptr;
+#endif
+
+void dumpGpsData(uint8_t *data, size_t len, gps_dump_comm_mode_t mode, bool msg_to_gps_device,
+                 gps_dump_s *dump_data, gps_dump_comm_mode_t active_mode, uint8_t instance)
+{
+    if (active_mode != mode || !dump_data) {
+        return;
+    }
+
+    dump_data->instance = instance;
+
+    while (len > 0) {
+        size_t write_len = len;
+
+        if (write_len > (size_t)(GPS_DUMP_DATA_SIZE - dump_data->len)) {
+            write_len = GPS_DUMP_DATA_SIZE - dump_data->len;
+        }
+
+        COPIAR_BYTES(dump_data->data + dump_data->len, data, write_len);   // memcpy sem -DABSTRAIR_CONTEUDO
+
+        data += write_len;
+        dump_data->len += write_len;
+        len -= write_len;
+
+        if (dump_data->len >= GPS_DUMP_DATA_SIZE) {
+            if (msg_to_gps_device) {
+                dump_data->len |= 1 << 7;
+            }
+
+            dump_data->timestamp = 12345;
+#ifdef MODO_NATIVO
+            if (px4PublicarGpsDump) {
+                px4PublicarGpsDump(dump_data);
+            }
+#endif
+            dump_data->len = 0;
+        }
+    }
+}
+
+// ================== BMI088 ==================
+
+float updateTemperature(uint8_t temp_msb, uint8_t temp_lsb) {
+    uint16_t Temp_uint11 = (temp_msb * 8) + (temp_lsb / 32);
+    int16_t Temp_int11 = 0;
+
+    if (Temp_uint11 > 1023) {
+        Temp_int11 = Temp_uint11 - 2048;
+    } else {
+        Temp_int11 = Temp_uint11;
+    }
+
+    float temperature = (Temp_int11 * 0.125f) + 23.0f;
+    return temperature;
+}
+
+uint16_t fifoReadCount(uint8_t fifo_length_0, uint8_t fifo_length_1) {
+    const uint8_t FIFO_LENGTH_1_MASKED = fifo_length_1 & 0x3F;
+    return combine(FIFO_LENGTH_1_MASKED, fifo_length_0);
+}
+
+void processAccelData(int16_t accel_y_raw, int16_t accel_z_raw,
+                      int16_t *accel_y_out, int16_t *accel_z_out) {
+    *accel_y_out = (accel_y_raw == INT16_MIN) ? INT16_MAX : -accel_y_raw;
+    *accel_z_out = (accel_z_raw == INT16_MIN) ? INT16_MAX : -accel_z_raw;
+}
+
+bool processGyroData(int16_t gyro_x, int16_t gyro_y, int16_t gyro_z,
+                     int16_t *gyro_x_out, int16_t *gyro_y_out, int16_t *gyro_z_out) {
+    if (gyro_x == INT16_MIN && gyro_y == INT16_MIN && gyro_z == INT16_MIN) {
+        return false;
+    }
+
+    *gyro_x_out = gyro_x;
+    *gyro_y_out = (gyro_y == INT16_MIN) ? INT16_MAX : -gyro_y;
+    *gyro_z_out = (gyro_z == INT16_MIN) ? INT16_MAX : -gyro_z;
+    return true;
+}
+
+// ================== MATHLIB (Functions.hpp) ==================
+
+template float constrain<float>(const float &, const float &, const float &);
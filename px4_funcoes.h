@@ -0,0 +1,88 @@
+/**
+ * @file px4_funcoes.h
+ * @author Dissertação Mestrado - Verificação Formal PX4 v1.16
+ *
+ * OBJETIVO: Biblioteca compartilhada das funções REAIS extraídas do PX4
+ * USO: Compilada uma única vez para um programa GOTO (px4_funcoes.cpp) e
+ *      ligada aos harnesses gpsdrive.cpp, imu.cpp e Flight.cpp quando
+ *      compilados com -DPX4_BIBLIOTECA (ver esbmc_runner.cpp)
+ *
+ * As definições seguem as cópias dos harnesses (ver px4_funcoes.cpp);
+ * sem -DPX4_BIBLIOTECA cada harness continua autocontido, como antes.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#ifdef MODO_NATIVO
+#include <cmath>
+using std::isinf;      // g++ deixa isnan/isinf de <cmath> só em std (harnesses usam sem std::)
+using std::isnan;
+#endif
+
+// ================== CONSTANTES REAIS ==================
+#define GPS_DUMP_DATA_SIZE 200
+
+static constexpr int32_t FIFO_MAX_SAMPLES = 32;
+static constexpr size_t FIFO_SIZE = 1024;
+
+// ================== ESTRUTURAS REAIS EXTRAÍDAS DO PX4 ==================
+
+struct gps_dump_s {
+    uint8_t data[GPS_DUMP_DATA_SIZE];    // Buffer principal
+    uint8_t len;                         // Índice atual (usado com bitwise ops)
+    uint8_t instance;                    // Instância GPS
+    uint64_t timestamp;                  // hrt_absolute_time()
+};
+
+enum class gps_dump_comm_mode_t : int32_t {
+    Disabled = 0,
+    Full = 1,
+    RTCM = 2
+};
+
+// ================== FUNÇÕES REAIS EXTRAÍDAS DO PX4 ==================
+
+// BMI088.hpp: constexpr, precisa ficar no header
+static constexpr int16_t combine(uint8_t msb, uint8_t lsb) {
+    return (msb << 8u) | lsb;
+}
+
+// src/drivers/gps/gps.cpp
+void dumpGpsData(uint8_t *data, size_t len, gps_dump_comm_mode_t mode, bool msg_to_gps_device,
+                 gps_dump_s *dump_data, gps_dump_comm_mode_t active_mode, uint8_t instance = 0);
+
+#ifdef MODO_NATIVO
+// _dump_communication_pub.publish(*dump_data): ferramentas nativas (nmea.cpp, ulog_writer.cpp) observam as
+// publicações por aqui; nulo = ninguém assina (o GOTO verificado não tem o ponteiro)
+extern void (*px4PublicarGpsDump)(const gps_dump_s *dump_data);
+#endif
+
+// BMI088_Accelerometer.cpp / BMI088_Gyroscope.cpp
+float updateTemperature(uint8_t temp_msb, uint8_t temp_lsb);
+uint16_t fifoReadCount(uint8_t fifo_length_0, uint8_t fifo_length_1);
+void processAccelData(int16_t accel_y_raw, int16_t accel_z_raw,
+                      int16_t *accel_y_out, int16_t *accel_z_out);
+bool processGyroData(int16_t gyro_x, int16_t gyro_y, int16_t gyro_z,
+                     int16_t *gyro_x_out, int16_t *gyro_y_out, int16_t *gyro_z_out);
+
+// src/lib/mathlib/math/Functions.hpp
+template<typename T>
+T constrain(const T &val, const T &min_val, const T &max_val)
+{
+    return (val < min_val) ? min_val : ((val > max_val) ? max_val : val);
+}
+
+template<typename T>
+const T expo(const T &value, const T &e)
+{
+    T x = constrain(value, (T) - 1, (T) 1);
+    T ec = constrain(e, (T) 0, (T) 1);
+    return (1 - ec) * x + ec * x * x * x;
+}
+
+// Instanciada uma vez em px4_funcoes.cpp: os harnesses não repetem o corpo. expo() fica só no header: o
+// retorno 'const T' do PX4 faria a instanciação explícita repetir um const ignorado (-Wignored-qualifiers)
+extern template float constrain<float>(const float &, const float &, const float &);
@@ -0,0 +1,580 @@
+/**
+ * @file rtcm.cpp
+ * @author Dissertação Mestrado - Verificação Formal PX4 v1.16
+ *
+ * OBJETIVO: Verificar o CRC-24Q de crc24q.h e validar em lote capturas RTCM
+ * MÓDULO TESTADO: Fluxo de correções gravado por dumpGpsData() em
+ *                 gps_dump_comm_mode_t::RTCM
+ * MÉTODO: Bounded Model Checking com ESBMC + ferramenta/benchmark nativo (-DMODO_NATIVO)
+ *
+ * MOTIVAÇÃO: Capturas de correções RTCM de vários GB são conferidas
+ * offline; com CRC por tabela byte a byte, a validação fica muito abaixo
+ * da banda de memória. A ferramenta mapeia a captura e valida todos os
+ * quadros com a implementação mais rápida compilada, e o modo de teste
+ * confere as três implementações contra a referência bit a bit.
+ */
+
+#include <assert.h>
+#include <cstring>
+#include <cstdint>
+
+#include "crc24q.h"
+
+#ifndef MODO_NATIVO
+
+// ================== FUNÇÕES ESBMC ==================
+extern int nondet_int();
+extern uint8_t nondet_uint8();
+extern uint32_t nondet_uint32();
+extern size_t nondet_size_t();
+extern void __ESBMC_assume(int condition);
+
+static crc24q_tabelas_t tabelas;
+
+// ================== TESTES DE VERIFICAÇÃO FORMAL ==================
+
+/**
+ * TESTE 1: Verificar vetor conhecido
+ * PROPRIEDADE: CRC-24Q("123456789") = 0xCDE703 (valor de catálogo) e
+ * quadro RTCM vazio (D3 00 00) tem CRC 0x47EA4B
+ */
+void test_crc_vetor_conhecido() {
+    const uint8_t texto[9] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+    const uint8_t vazio[3] = {RTCM_PREAMBULO, 0x00, 0x00};
+
+    assert(crc24qBits(0, texto, sizeof(texto)) == 0xCDE703);
+    assert(crc24qBits(0, vazio, sizeof(vazio)) == 0x47EA4B);
+}
+
+/**
+ * TESTE 2: Verificar encadeamento
+ * PROPRIEDADE: Para quaisquer bytes e corte, continuar do CRC parcial dá o
+ * mesmo resultado que o CRC da mensagem inteira (validação por blocos)
+ */
+void test_crc_encadeado() {
+    uint8_t m[6];
+    for (int i = 0; i < 6; i++) {
+        m[i] = nondet_uint8();
+    }
+
+    size_t corte = nondet_size_t();
+    __ESBMC_assume(corte <= sizeof(m));
+
+    assert(crc24qBits(crc24qBits(0, m, corte), m + corte, sizeof(m) - corte) == crc24qBits(0, m, sizeof(m)));
+}
+
+/**
+ * TESTE 3: Verificar slice-by-8 contra a referência
+ * PROPRIEDADE: Para quaisquer 11 bytes (uma iteração de 8 + cauda de 3) e
+ * qualquer CRC inicial de 24 bits, crc24qFatias8() == crc24qBits()
+ */
+void test_crc_fatias8_equivalente() {
+    crc24qIniciarTabelas(&tabelas);
+
+    uint8_t m[11];
+    for (int i = 0; i < 11; i++) {
+        m[i] = nondet_uint8();
+    }
+
+    uint32_t inicial = nondet_uint32();
+    __ESBMC_assume(inicial <= CRC24Q_MASCARA);
+
+    assert(crc24qFatias8(&tabelas, inicial, m, sizeof(m)) == crc24qBits(inicial, m, sizeof(m)));
+}
+
+/**
+ * TESTE 4: Verificar detecção de erro de um bit
+ * PROPRIEDADE: Inverter qualquer bit de qualquer quadro curto muda o CRC
+ */
+void test_crc_erro_um_bit() {
+    uint8_t m[6];
+    for (int i = 0; i < 6; i++) {
+        m[i] = nondet_uint8();
+    }
+
+    const uint32_t original = crc24qBits(0, m, sizeof(m));
+    int bit = nondet_int();
+    __ESBMC_assume(bit >= 0 && bit < 48);
+
+    m[bit / 8] ^= (uint8_t)(1u << (bit % 8));
+    assert(crc24qBits(0, m, sizeof(m)) != original);
+}
+
+/**
+ * TESTE 5: Verificar varredura de quadros sobre bytes arbitrários
+ * PROPRIEDADE: Nenhum acesso fora de buf[]; sem quadro truncado, todo byte
+ * é contado uma vez como válido ou descartado; quadro válido tem pelo
+ * menos cabeçalho + CRC
+ */
+void test_rtcm_limites() {
+    uint8_t buf[10];
+    for (int i = 0; i < 10; i++) {
+        buf[i] = nondet_uint8();
+    }
+
+    size_t n = nondet_size_t();
+    __ESBMC_assume(n <= sizeof(buf));
+
+    rtcm_resultado_t r = {};
+    rtcmValidar(&tabelas, crc24qReferencia, buf, n, &r);
+
+    assert(r.bytes_validos + r.bytes_descartados <= n);
+    assert(r.quadros * (RTCM_CABECALHO + RTCM_CRC) <= r.bytes_validos);
+    assert(r.truncados <= 1);
+
+    if (r.truncados == 0) {
+        assert(r.bytes_validos + r.bytes_descartados == n);
+    }
+}
+
+// ================== MAIN PARA ESBMC ==================
+int main() {
+    int test_choice = nondet_int();
+    __ESBMC_assume(test_choice >= 0 && test_choice < 5);
+
+    switch(test_choice) {
+        case 0:
+            test_crc_vetor_conhecido();
+            break;
+        case 1:
+            test_crc_encadeado();
+            break;
+        case 2:
+            test_crc_fatias8_equivalente();
+            break;
+        case 3:
+            test_crc_erro_um_bit();
+            break;
+        case 4:
+            test_rtcm_limites();
+            break;
+    }
+
+    return 0;
+}
+
+#else // MODO_NATIVO
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "px4_funcoes.h"
+
+static crc24q_tabelas_t tabelas;
+
+struct implementacao_t {
+    const char *nome;
+    crc24q_fn_t fn;
+};
+
+static const implementacao_t implementacoes[] = {
+    {"bit a bit", crc24qReferencia},
+    {"byte (tabela)", crc24qBytes},
+    {"slice-by-8", crc24qFatias8},
+#ifdef CRC24Q_CLMUL
+    {"pclmul", crc24qClmul},
+#endif
+};
+static constexpr int NUM_IMPL = sizeof(implementacoes) / sizeof(implementacoes[0]);
+
+static uint64_t aleatorio(uint64_t *s) {
+    *s ^= *s << 13;
+    *s ^= *s >> 7;
+    *s ^= *s << 17;
+    return *s;
+}
+
+static double agoraS() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// ================== EQUIVALÊNCIA COM A REFERÊNCIA ==================
+
+static uint64_t falhas = 0;
+
+static void conferir(int impl, uint32_t inicial, const uint8_t *m, size_t n, const char *caso) {
+    const uint32_t ref = crc24qBits(inicial, m, n);
+    const uint32_t got = implementacoes[impl].fn(&tabelas, inicial, m, n);
+
+    if (got != ref && falhas++ < 10) {
+        printf("  DIVERGE %s: %s len=%zu inicial=%06X esperado=%06X obtido=%06X\n", implementacoes[impl].nome, caso,
+               n, inicial, ref, got);
+    }
+}
+
+/**
+ * Todas as mensagens de 1, 2 e 3 bytes (tabelas inteiras exercitadas),
+ * todos os comprimentos 0..2048 em todos os 16 alinhamentos, todo erro de
+ * um bit numa mensagem de 1 KB e cortes aleatórios de encadeamento.
+ */
+static bool testarEquivalencia() {
+    uint64_t s = 0x9E3779B97F4A7C15ull;
+    uint64_t casos = 0;
+    const double t0 = agoraS();
+
+    for (int impl = 1; impl < NUM_IMPL; impl++) {
+        for (uint32_t v = 0; v < (1u << 24); v++) {
+            const uint8_t m[3] = {(uint8_t)(v >> 16), (uint8_t)(v >> 8), (uint8_t)v};
+            if (v < 256) {
+                conferir(impl, 0xABCDEF, m + 2, 1, "1 byte");
+            }
+            if (v < 65536) {
+                conferir(impl, 0, m + 1, 2, "2 bytes");
+            }
+            conferir(impl, 0, m, 3, "3 bytes");
+            casos++;
+        }
+    }
+
+    std::vector<uint8_t> buf(2048 + 16 + 64);
+    for (uint8_t &b : buf) {
+        b = (uint8_t)aleatorio(&s);
+    }
+
+    for (int impl = 1; impl < NUM_IMPL; impl++) {
+        for (size_t desl = 0; desl < 16; desl++) {
+            for (size_t n = 0; n <= 2048; n++) {
+                conferir(impl, (uint32_t)aleatorio(&s) & CRC24Q_MASCARA, buf.data() + desl, n, "comprimento/alinhamento");
+                casos++;
+            }
+        }
+
+        std::vector<uint8_t> m(buf.begin(), buf.begin() + 1024);
+        for (size_t bit = 0; bit < 8 * m.size(); bit++) {
+            m[bit / 8] ^= (uint8_t)(0x80u >> (bit % 8));
+            conferir(impl, 0, m.data(), m.size(), "erro de um bit");
+            m[bit / 8] ^= (uint8_t)(0x80u >> (bit % 8));
+            casos++;
+        }
+
+        for (int k = 0; k < 20000; k++) {
+            const size_t n = (size_t)(aleatorio(&s) % 2048), corte = n ? (size_t)(aleatorio(&s) % n) : 0;
+            const uint32_t ini = (uint32_t)aleatorio(&s) & CRC24Q_MASCARA;
+            const uint32_t parte = implementacoes[impl].fn(&tabelas, ini, buf.data(), corte);
+            const uint32_t total = implementacoes[impl].fn(&tabelas, parte, buf.data() + corte, n - corte);
+
+            if (total != crc24qBits(ini, buf.data(), n) && falhas++ < 10) {
+                printf("  DIVERGE %s: encadeamento len=%zu corte=%zu\n", implementacoes[impl].nome, n, corte);
+            }
+            casos++;
+        }
+    }
+
+    printf("equivalencia com a referencia: %llu casos, %llu divergencias (%.1f s)\n", (unsigned long long)casos,
+           (unsigned long long)falhas, agoraS() - t0);
+    return falhas == 0;
+}
+
+// ================== CAPTURA RTCM SINTÉTICA ==================
+
+struct captura_t {
+    uint64_t quadros;             // Quadros íntegros gravados
+    uint64_t corrompidos;         // Quadros com um bit invertido depois do CRC
+    uint64_t bytes_quadros;
+};
+
+static void anexarQuadro(std::vector<uint8_t> &q, uint16_t msg, size_t payload, uint64_t *s) {
+    q.clear();
+    q.push_back(RTCM_PREAMBULO);
+    q.push_back((uint8_t)(payload >> 8));
+    q.push_back((uint8_t)payload);
+    q.push_back((uint8_t)(msg >> 4));
+    q.push_back((uint8_t)(msg << 4 | (aleatorio(s) & 0x0F)));
+
+    while (q.size() < RTCM_CABECALHO + payload) {
+        q.push_back((uint8_t)aleatorio(s));
+    }
+
+    const uint32_t crc = crc24qFatias8(&tabelas, 0, q.data(), q.size());
+    q.push_back((uint8_t)(crc >> 16));
+    q.push_back((uint8_t)(crc >> 8));
+    q.push_back((uint8_t)crc);
+}
+
+/**
+ * Preâmbulo falso perto do fim declarando 1023 bytes de payload, seguido
+ * de dois quadros íntegros: os dois são aceitos e nada fica truncado.
+ */
+static bool testarRessincronizacao() {
+    std::vector<uint8_t> cap, q;
+    uint64_t s = 7;
+
+    anexarQuadro(q, 1005, 19, &s);
+    cap.insert(cap.end(), q.begin(), q.end());
+    cap.insert(cap.end(), {RTCM_PREAMBULO, 0x03, 0xFF});
+    for (int k = 0; k < 2; k++) {
+        anexarQuadro(q, 1230, 6 + k, &s);
+        cap.insert(cap.end(), q.begin(), q.end());
+    }
+
+    rtcm_resultado_t r = {};
+    rtcmValidar(&tabelas, crc24qFatias8, cap.data(), cap.size(), &r);
+
+    const bool ok = r.quadros == 3 && r.truncados == 0 && r.bytes_descartados == 3;
+    printf("preambulo falso no fim da captura: %llu quadros, %llu truncados: %s\n", (unsigned long long)r.quadros,
+           (unsigned long long)r.truncados, ok ? "ok" : "FALHA");
+    return ok;
+}
+
+/**
+ * Estação base típica a 1 Hz: 1005 (posição da antena), MSM7 de GPS,
+ * GLONASS, Galileo e BeiDou (1077/1087/1097/1127) e 1230. Os bytes passam
+ * por dumpGpsData() em modo RTCM e a captura é a sequência de blocos de
+ * gps_dump_s.data, como gravada a bordo. Um quadro em 1000 tem um bit
+ * invertido e um em 500 é precedido de lixo de enlace.
+ */
+static bool gerarCaptura(const char *caminho, uint64_t bytes_alvo, captura_t *c) {
+    FILE *f = fopen(caminho, "wb");
+    if (!f) {
+        perror(caminho);
+        return false;
+    }
+
+    const uint16_t mensagens[] = {1005, 1077, 1087, 1097, 1127, 1230};
+    const size_t tamanhos[][2] = {{19, 19}, {180, 720}, {150, 560}, {150, 600}, {120, 500}, {6, 12}};
+    std::vector<uint8_t> q;
+    gps_dump_s dump = {};
+    uint64_t s = 2026, escritos = 0;
+    *c = captura_t{};
+
+    while (escritos < bytes_alvo) {
+        for (int m = 0; m < 6 && escritos < bytes_alvo; m++) {
+            const size_t payload = tamanhos[m][0] + (size_t)(aleatorio(&s) % (tamanhos[m][1] - tamanhos[m][0] + 1));
+            anexarQuadro(q, mensagens[m], payload, &s);
+
+            const uint64_t sorteio = aleatorio(&s) % 1000;
+            if (sorteio == 0) {
+                q[RTCM_CABECALHO + (size_t)(aleatorio(&s) % payload)] ^= (uint8_t)(1u << (aleatorio(&s) % 8));
+                c->corrompidos++;
+            } else {
+                c->quadros++;
+                c->bytes_quadros += q.size();
+            }
+
+            if (sorteio == 1 || sorteio == 2) {
+                for (int k = 0; k < 7; k++) {
+                    q.insert(q.begin(), (uint8_t)(aleatorio(&s) & 0x7F));      // Lixo sem 0xD3
+                }
+            }
+
+            const uint8_t *p = q.data();
+            size_t len = q.size();
+
+            while (len > 0) {
+                const size_t bloco = len < (size_t)(GPS_DUMP_DATA_SIZE - dump.len) ? len : GPS_DUMP_DATA_SIZE - dump.len;
+                dumpGpsData(const_cast<uint8_t *>(p), bloco, gps_dump_comm_mode_t::RTCM, false, &dump,
+                            gps_dump_comm_mode_t::RTCM);
+                p += bloco;
+                len -= bloco;
+
+                if (dump.len == 0) {       // Bloco cheio: publicado no uORB, gravado no log
+                    fwrite(dump.data, 1, GPS_DUMP_DATA_SIZE, f);
+                    escritos += GPS_DUMP_DATA_SIZE;
+                }
+            }
+        }
+    }
+
+    fwrite(dump.data, 1, dump.len, f);
+    return fclose(f) == 0;
+}
+
+// ================== BENCHMARKS ==================
+
+static volatile uint32_t sumidouro;
+
+static void benchCrc(size_t bytes) {
+    std::vector<uint8_t> buf(bytes);
+    uint64_t s = 42;
+    for (size_t i = 0; i < bytes; i += 8) {
+        const uint64_t v = aleatorio(&s);
+        memcpy(buf.data() + i, &v, bytes - i < 8 ? bytes - i : 8);
+    }
+
+    std::vector<uint8_t> quente(16 * 1024);
+    memcpy(quente.data(), buf.data(), quente.size());
+
+    printf("\n%-14s %14s %14s %8s\n", "CRC-24Q", "GB/s (memoria)", "GB/s (cache)", "crc");
+
+    for (int impl = 0; impl < NUM_IMPL; impl++) {
+        // A referência é lenta demais para o buffer inteiro: mede 1/16
+        const size_t n = impl == 0 ? bytes / 16 : bytes;
+        double t0 = agoraS();
+        const uint32_t crc = implementacoes[impl].fn(&tabelas, 0, buf.data(), n);
+        const double mem = n / (agoraS() - t0) / 1e9;
+
+        uint32_t acc = 0;
+        const int voltas = impl == 0 ? 64 : 4096;
+        t0 = agoraS();
+        for (int v = 0; v < voltas; v++) {
+            acc ^= implementacoes[impl].fn(&tabelas, acc, quente.data(), quente.size());
+        }
+        const double cache = (double)voltas * quente.size() / (agoraS() - t0) / 1e9;
+
+        sumidouro = acc;
+        printf("%-14s %14.2f %14.2f %06X\n", implementacoes[impl].nome, mem, cache, crc);
+    }
+}
+
+static bool mapear(const char *caminho, const uint8_t **base, size_t *tam) {
+    const int fd = open(caminho, O_RDONLY);
+    struct stat st;
+
+    if (fd < 0 || fstat(fd, &st) != 0) {
+        perror(caminho);
+        return false;
+    }
+
+    *tam = (size_t)st.st_size;
+    *base = (const uint8_t *)mmap(nullptr, *tam ? *tam : 1, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+
+    if (*base == MAP_FAILED) {
+        perror("mmap");
+        return false;
+    }
+
+    madvise((void *)*base, *tam, MADV_SEQUENTIAL);
+    return true;
+}
+
+static void imprimirResultado(const char *nome, const rtcm_resultado_t &r, double s, size_t tam) {
+    printf("%-14s %10llu %9llu %12llu %10llu %8.2f\n", nome, (unsigned long long)r.quadros,
+           (unsigned long long)r.crc_invalidos, (unsigned long long)r.bytes_descartados,
+           (unsigned long long)r.truncados, tam / s / 1e9);
+}
+
+int main(int argc, char **argv) {
+    crc24qIniciarTabelas(&tabelas);
+
+#ifndef CRC24Q_CLMUL
+    printf("(sem PCLMUL: compile com -mpclmul -mssse3 para o dobramento)\n");
+#endif
+
+    // Modo ferramenta: valida uma captura existente com a implementação mais rápida
+    if (argc == 2 && argv[1][0] != '-') {
+        const uint8_t *base;
+        size_t tam;
+        if (!mapear(argv[1], &base, &tam)) {
+            return 1;
+        }
+
+        rtcm_resultado_t r = {};
+        const double t0 = agoraS();
+        rtcmValidar(&tabelas, crc24qRapido, base, tam, &r);
+        const double dt = agoraS() - t0;
+
+        printf("%s: %zu bytes\n%-14s %10s %9s %12s %10s %8s\n", argv[1], tam, "", "quadros", "crc ruim", "descartados",
+               "truncados", "GB/s");
+        imprimirResultado("validacao", r, dt, tam);
+        return r.crc_invalidos == 0 && r.truncados == 0 ? 0 : 2;
+    }
+
+    const uint64_t mb = argc > 2 && strcmp(argv[1], "--mb") == 0 ? strtoull(argv[2], nullptr, 10) : 256;
+
+    const bool equivalente = testarEquivalencia() && testarRessincronizacao();
+    benchCrc((size_t)mb << 20);
+
+    const char *caminho = "/tmp/captura_rtcm.bin";
+    captura_t c;
+    if (!gerarCaptura(caminho, mb << 20, &c)) {
+        return 1;
+    }
+
+    const uint8_t *base;
+    size_t tam;
+    if (!mapear(caminho, &base, &tam)) {
+        return 1;
+    }
+
+    printf("\ncaptura %s: %.1f MB, %llu quadros integros, %llu corrompidos\n", caminho, tam / 1048576.0,
+           (unsigned long long)c.quadros, (unsigned long long)c.corrompidos);
+    printf("%-14s %10s %9s %12s %10s %8s\n", "validacao", "quadros", "crc ruim", "descartados", "truncados", "GB/s");
+
+    bool consistente = true;
+    rtcm_resultado_t primeiro = {};
+
+    for (int impl = 1; impl < NUM_IMPL; impl++) {
+        rtcm_resultado_t r = {};
+        const double t0 = agoraS();
+        rtcmValidar(&tabelas, implementacoes[impl].fn, base, tam, &r);
+        imprimirResultado(implementacoes[impl].nome, r, agoraS() - t0, tam);
+
+        if (impl == 1) {
+            primeiro = r;
+        }
+
+        consistente = consistente && r.quadros == c.quadros && r.bytes_validos == c.bytes_quadros &&
+                      r.quadros == primeiro.quadros && r.crc_invalidos == primeiro.crc_invalidos &&
+                      r.bytes_descartados == primeiro.bytes_descartados;
+    }
+
+    munmap((void *)base, tam);
+    unlink(caminho);
+
+    printf("todos os quadros integros aceitos, todas as implementacoes concordam: %s\n", consistente ? "sim" : "NAO");
+    return equivalente && consistente ? 0 : 1;
+}
+
+#endif // MODO_NATIVO
+
+/*
+ * ================================================================
+ * DOCUMENTAÇÃO
+ * ================================================================
+ *
+ * CRC-24Q E VALIDAÇÃO DE CAPTURAS RTCM (crc24q.h):
+ *
+ * 1. REFERÊNCIA BIT A BIT:
+ *    - Definição direta, base de todas as comparações
+ *
+ * 2. SLICE-BY-8:
+ *    - 8 tabelas de 256 entradas (8 KB), CRC nos 24 bits altos de um
+ *      registrador de 32: 8 consultas independentes por 8 bytes
+ *
+ * 3. DOBRAMENTO COM PCLMULQDQ:
+ *    - Mesma técnica dos CRC-32 acelerados, para CRC não refletido:
+ *      bytes invertidos na carga, constantes x^n mod P de 24 bits
+ *      calculadas por crc24qPotencia() (nenhuma constante mágica)
+ *    - 4 acumuladores (64 bytes por iteração) escondem a latência do
+ *      PCLMULQDQ; os 16 bytes finais e a cauda vão para o slice-by-8
+ *    - Abaixo de 64 bytes usa slice-by-8 (quadros RTCM curtos)
+ *
+ * 4. VALIDAÇÃO EM LOTE:
+ *    - rtcmValidar() percorre a captura mapeada: quadro com CRC certo é
+ *      pulado inteiro, preâmbulo falso ressincroniza no byte seguinte
+ *    - Comprimento que passa do fim: truncado só se nenhum quadro íntegro
+ *      começa depois; senão é preâmbulo falso (não perde os quadros finais)
+ *
+ * 5. PROPRIEDADES VERIFICADAS (ESBMC):
+ *    - Vetores de catálogo ("123456789" = 0xCDE703)
+ *    - Encadeamento em qualquer corte
+ *    - Slice-by-8 == bit a bit para quaisquer 11 bytes e CRC inicial
+ *    - Todo erro de um bit é detectado
+ *    - Varredura de quadros sem acesso fora do buffer e com contagem exata
+ *
+ * 6. EQUIVALÊNCIA NATIVA (exaustiva):
+ *    - Todas as mensagens de 1, 2 e 3 bytes; comprimentos 0..2048 em 16
+ *      alinhamentos; todo erro de um bit em 1 KB; cortes de encadeamento
+ *
+ * COMANDOS DE EXECUÇÃO:
+ * esbmc rtcm.cpp --unwind 257 --overflow-check --bounds-check
+ * g++ -O2 -mpclmul -mssse3 -DMODO_NATIVO rtcm.cpp px4_funcoes.cpp -o rtcm_crc && ./rtcm_crc --mb 256
+ * ./rtcm_crc captura.rtcm      (valida uma captura existente)
+ *
+ * BENCHMARK:
+ * - GB/s de cada implementação em buffer maior que a cache e em 16 KB
+ *   quentes
+ * - Captura sintética de estação base passando por dumpGpsData() (modo
+ *   RTCM) com quadros corrompidos e lixo: GB/s de validação e conferência
+ *   de que todos os quadros íntegros foram aceitos
+ *
+ * ================================================================
+ */
@@ -0,0 +1,417 @@
+/**
+ * @file serial.cpp
+ * @author Dissertação Mestrado - Verificação Formal PX4 v1.16
+ *
+ * OBJETIVO: Verificar e medir a leitura serial com epoll (serial_epoll.h)
+ * MÓDULO TESTADO: Entrada do caminho GPS: serial -> dumpGpsData() + nmea_parser.h
+ * MÉTODO: Bounded Model Checking com ESBMC + benchmark nativo (-DMODO_NATIVO)
+ *
+ * MOTIVAÇÃO: dumpGpsData() recebe o que o driver leu; quantas chamadas de
+ * sistema e quanto CPU custa cada KB depende da estratégia de leitura a
+ * montante. O benchmark usa um pseudo-terminal local no lugar do receptor:
+ * o lado mestre emite NMEA na taxa do enlace simulado, o lado escravo é a
+ * "serial" lida pelo driver.
+ */
+
+#include <assert.h>
+#include <cstring>
+#include <cstdint>
+
+#include "serial_epoll.h"
+
+#ifndef MODO_NATIVO
+
+// ================== FUNÇÕES ESBMC ==================
+extern int nondet_int();
+extern uint32_t nondet_uint32();
+extern size_t nondet_size_t();
+extern void __ESBMC_assume(int condition);
+
+// ================== TESTES DE VERIFICAÇÃO FORMAL ==================
+
+/**
+ * TESTE 1: Verificar ajuste do tamanho de leitura
+ * PROPRIEDADE: Resultado em [min, max]; leitura cheia nunca reduz o
+ * pedido e leitura muito curta nunca o aumenta
+ */
+void test_serial_ajuste_limites() {
+    uint32_t atual = nondet_uint32();
+    size_t lidos = nondet_size_t();
+    __ESBMC_assume(atual >= SERIAL_LEITURA_MIN && atual <= SERIAL_LEITURA_MAX);
+    __ESBMC_assume(lidos <= atual);
+
+    uint32_t novo = serialAjustarLeitura(atual, lidos, SERIAL_LEITURA_MIN, SERIAL_LEITURA_MAX);
+
+    assert(novo >= SERIAL_LEITURA_MIN && novo <= SERIAL_LEITURA_MAX);
+
+    if (lidos == atual) {
+        assert(novo >= atual);
+    }
+
+    if (lidos < atual / 4) {
+        assert(novo <= atual);
+    }
+}
+
+/**
+ * TESTE 2: Verificar sequência de leituras sobre o buffer
+ * PROPRIEDADE: Qualquer sequência de resultados de read() mantém o pedido
+ * dentro de buf[] (read(fd, buf, tamanho_leitura) nunca passa do buffer)
+ */
+void test_serial_sequencia_buffer() {
+    uint32_t tamanho = SERIAL_LEITURA_MIN;
+
+    for (int i = 0; i < 12; i++) {
+        size_t lidos = nondet_size_t();
+        __ESBMC_assume(lidos <= tamanho);
+
+        tamanho = serialAjustarLeitura(tamanho, lidos, SERIAL_LEITURA_MIN, SERIAL_LEITURA_MAX);
+        assert(tamanho <= SERIAL_BUFFER);
+        assert(tamanho >= SERIAL_LEITURA_MIN);
+    }
+}
+
+/**
+ * TESTE 3: Verificar espera de agrupamento
+ * PROPRIEDADE: Sem overflow para quaisquer entradas de 32 bits, nunca
+ * passa do limite de latência e é zero com taxa desconhecida
+ */
+void test_serial_atraso_lote() {
+    uint32_t faltam = nondet_uint32();
+    uint32_t bytes_por_s = nondet_uint32();
+    uint32_t atraso_max = nondet_uint32();
+
+    uint32_t atraso = serialAtrasoLote(faltam, bytes_por_s, atraso_max);
+
+    assert(atraso <= atraso_max);
+
+    if (bytes_por_s == 0) {
+        assert(atraso == 0);
+    }
+
+    // 921600 baud: 92160 B/s, 184 bytes chegam em ~2 ms
+    if (faltam == 184 && bytes_por_s == 92160 && atraso_max >= 2000) {
+        assert(atraso == 1996);
+    }
+}
+
+// ================== MAIN PARA ESBMC ==================
+int main() {
+    int test_choice = nondet_int();
+    __ESBMC_assume(test_choice >= 0 && test_choice < 3);
+
+    switch(test_choice) {
+        case 0:
+            test_serial_ajuste_limites();
+            break;
+        case 1:
+            test_serial_sequencia_buffer();
+            break;
+        case 2:
+            test_serial_atraso_lote();
+            break;
+    }
+
+    return 0;
+}
+
+#else // MODO_NATIVO
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include <poll.h>
+#include <sys/resource.h>
+
+#include "nmea_parser.h"
+#include "px4_funcoes.h"
+
+// ================== RECEPTOR SIMULADO (LADO MESTRE DO PTY) ==================
+
+static void anexarSentenca(std::vector<uint8_t> &fluxo, const char *corpo) {
+    uint8_t cs = 0;
+    for (const char *c = corpo; *c; c++) {
+        cs ^= (uint8_t)*c;
+    }
+
+    char linha[128];
+    int n = snprintf(linha, sizeof(linha), "$%s*%02X\r\n", corpo, cs);
+    fluxo.insert(fluxo.end(), linha, linha + n);
+}
+
+// GGA + RMC por época, como um receptor só-NMEA (mesmo formato de nmea.cpp)
+static std::vector<uint8_t> gerarFluxo(size_t bytes_alvo, uint64_t *sentencas) {
+    std::vector<uint8_t> fluxo;
+    fluxo.reserve(bytes_alvo + 256);
+    uint32_t x = 2026;
+    uint32_t t = 0;
+    *sentencas = 0;
+
+    while (fluxo.size() < bytes_alvo) {
+        x = x * 1664525u + 1013904223u;
+        char corpo[100];
+        const unsigned hh = (t / 3600) % 24, mm = (t / 60) % 60, ss = t % 60;
+
+        snprintf(corpo, sizeof(corpo), "GPGGA,%02u%02u%02u.00,2330.%05u,S,04638.%05u,W,1,%02u,0.9,%u.%u,M,-5.1,M,,",
+                 hh, mm, ss, x % 100000, (x >> 8) % 100000, 8 + x % 10, 700 + x % 50, x % 10);
+        anexarSentenca(fluxo, corpo);
+
+        snprintf(corpo, sizeof(corpo), "GPRMC,%02u%02u%02u.00,A,2330.%05u,S,04638.%05u,W,%u.%03u,%u.%02u,181026,,,A",
+                 hh, mm, ss, x % 100000, (x >> 8) % 100000, x % 20, x % 1000, x % 360, x % 100);
+        anexarSentenca(fluxo, corpo);
+
+        *sentencas += 2;
+        t++;
+    }
+
+    return fluxo;
+}
+
+/**
+ * Escreve o fluxo no lado mestre na taxa do enlace: a cada 1 ms, os bytes
+ * que a UART teria entregue nesse intervalo. O mestre só é fechado depois
+ * que o leitor recebeu tudo (o pty descarta o que não foi lido no HUP).
+ */
+static void emitir(int mestre, const std::vector<uint8_t> *fluxo, uint32_t bytes_por_s) {
+    typedef std::chrono::steady_clock relogio;
+    const relogio::time_point t0 = relogio::now();
+    size_t enviados = 0;
+
+    for (uint64_t tick = 1; enviados < fluxo->size(); tick++) {
+        std::this_thread::sleep_until(t0 + std::chrono::microseconds(tick * 1000));
+        size_t alvo = (size_t)((uint64_t)bytes_por_s * tick / 1000);
+        alvo = alvo < fluxo->size() ? alvo : fluxo->size();
+
+        while (enviados < alvo) {
+            ssize_t w = write(mestre, fluxo->data() + enviados, alvo - enviados);
+            if (w <= 0) {
+                if (w < 0 && errno == EINTR) {
+                    continue;
+                }
+                struct pollfd p = {mestre, POLLOUT, 0};
+                poll(&p, 1, 10);      // Buffer do pty cheio: leitor atrasado
+                continue;
+            }
+            enviados += (size_t)w;
+        }
+    }
+}
+
+// ================== CONSUMIDOR (DRIVER GPS) ==================
+
+struct driver_ctx_t {
+    gps_dump_s dump;
+    nmea_parser_t parser;
+    uint64_t sentencas;
+};
+
+static void consumir(const uint8_t *data, size_t len, void *ctx) {
+    driver_ctx_t *d = (driver_ctx_t *)ctx;
+
+    // Cópia crua para o uORB gps_dump (dumpGpsData não altera os bytes)
+    dumpGpsData(const_cast<uint8_t *>(data), len, gps_dump_comm_mode_t::Full, false, &d->dump,
+                gps_dump_comm_mode_t::Full);
+
+    while (len > 0) {
+        nmea_sentenca_t s;
+        bool completa;
+        size_t usados = nmeaFeed(&d->parser, data, len, &s, &completa);
+        data += usados;
+        len -= usados;
+        d->sentencas += completa ? 1 : 0;
+    }
+}
+
+// ================== ESTRATÉGIAS DE LEITURA ==================
+
+enum class estrategia_t { POLL_PEQUENO, EPOLL, EPOLL_LOTE };
+
+struct medida_t {
+    uint64_t bytes;
+    uint64_t syscalls;
+    uint64_t entregas;
+    uint64_t sentencas;
+    double cpu_ms;
+    double parede_s;
+};
+
+static double cpuThreadMs() {
+    struct rusage r;
+    getrusage(RUSAGE_THREAD, &r);
+    return (r.ru_utime.tv_sec + r.ru_stime.tv_sec) * 1e3 + (r.ru_utime.tv_usec + r.ru_stime.tv_usec) / 1e3;
+}
+
+/**
+ * Referência: poll() + read() de 64 bytes por evento, o laço típico de um
+ * driver com buffer pequeno (uma chamada de sistema por evento e por leitura)
+ */
+static void lerPollPequeno(int fd, driver_ctx_t *d, medida_t *m, size_t total) {
+    uint8_t buf[64];
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+    while (m->bytes < total) {
+        struct pollfd p = {fd, POLLIN, 0};
+        m->syscalls++;
+        if (poll(&p, 1, 1000) <= 0) {
+            continue;
+        }
+
+        m->syscalls++;
+        ssize_t r = read(fd, buf, sizeof(buf));
+        if (r > 0) {
+            m->bytes += (uint64_t)r;
+            m->entregas++;
+            consumir(buf, (size_t)r, d);
+        } else if (r == 0 || (errno != EAGAIN && errno != EINTR)) {
+            return;
+        }
+    }
+}
+
+static void lerEpoll(int fd, driver_ctx_t *d, medida_t *m, size_t total, uint32_t bytes_por_s,
+                     uint32_t atraso_max_us) {
+    static serial_leitor_t leitor;
+
+    if (!serialAbrir(&leitor, fd, bytes_por_s, atraso_max_us)) {
+        perror("serialAbrir");
+        return;
+    }
+
+    while (leitor.est.bytes < total && serialProcessar(&leitor, 1000, consumir, d) >= 0) {
+    }
+
+    m->bytes = leitor.est.bytes;
+    m->entregas = leitor.est.entregas;
+    m->syscalls = leitor.est.esperas + leitor.est.leituras + leitor.est.leituras_vazias + leitor.est.lotes;
+    serialFechar(&leitor);
+}
+
+static bool abrirPty(int *mestre, int *escravo) {
+    *mestre = posix_openpt(O_RDWR | O_NOCTTY);
+    if (*mestre < 0 || grantpt(*mestre) != 0 || unlockpt(*mestre) != 0) {
+        return false;
+    }
+
+    *escravo = open(ptsname(*mestre), O_RDWR | O_NOCTTY);
+    if (*escravo < 0) {
+        return false;
+    }
+
+    // Os dois lados brutos: sem eco, sem tradução de \r\n
+    return serialConfigurarBruto(*escravo, B921600) && serialConfigurarBruto(*mestre, B921600);
+}
+
+static medida_t medir(estrategia_t e, const std::vector<uint8_t> &fluxo, uint32_t bytes_por_s) {
+    medida_t m = {0, 0, 0, 0, 0.0, 0.0};
+    int mestre, escravo;
+
+    if (!abrirPty(&mestre, &escravo)) {
+        perror("pty");
+        exit(1);
+    }
+
+    static driver_ctx_t d;
+    memset(&d, 0, sizeof(d));
+    nmeaReset(&d.parser);
+
+    const double cpu0 = cpuThreadMs();
+    auto t0 = std::chrono::steady_clock::now();
+    std::thread emissor(emitir, mestre, &fluxo, bytes_por_s);
+
+    if (e == estrategia_t::POLL_PEQUENO) {
+        lerPollPequeno(escravo, &d, &m, fluxo.size());
+    } else {
+        // Lote: até 2 ms de atraso extra, ~1/4 de uma época NMEA de 10 Hz
+        lerEpoll(escravo, &d, &m, fluxo.size(), bytes_por_s, e == estrategia_t::EPOLL_LOTE ? 2000 : 0);
+    }
+
+    emissor.join();
+    m.parede_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    m.cpu_ms = cpuThreadMs() - cpu0;
+    m.sentencas = d.sentencas;
+    close(escravo);
+    close(mestre);
+    return m;
+}
+
+// ================== BENCHMARK ==================
+
+int main(int argc, char **argv) {
+    const double segundos = (argc > 1) ? atof(argv[1]) : 1.0;
+
+    if (segundos <= 0.0) {
+        fprintf(stderr, "uso: %s [segundos_por_taxa]\n", argv[0]);
+        return 1;
+    }
+
+    const uint32_t bauds[] = {921600, 2000000, 4000000, 8000000};
+    const char *nomes[] = {"poll+read64", "epoll", "epoll+lote"};
+    bool sem_perda = true;
+
+    printf("%-10s %-12s %10s %10s %10s %12s %10s %12s\n", "baud", "estrategia", "KB", "syscalls", "sys/KB",
+           "B/entrega", "CPU%", "sentencas");
+
+    for (uint32_t baud : bauds) {
+        const uint32_t bytes_por_s = baud / 10;      // 8N1: 10 bits por byte
+        uint64_t esperadas = 0;
+        const std::vector<uint8_t> fluxo = gerarFluxo((size_t)(bytes_por_s * segundos), &esperadas);
+
+        for (int e = 0; e < 3; e++) {
+            medida_t m = medir((estrategia_t)e, fluxo, bytes_por_s);
+            const double kb = m.bytes / 1024.0;
+
+            printf("%-10u %-12s %10.1f %10llu %10.2f %12.1f %9.2f%% %5llu/%-6llu\n", baud, nomes[e], kb,
+                   (unsigned long long)m.syscalls, m.syscalls / (kb > 0 ? kb : 1.0),
+                   m.entregas ? (double)m.bytes / m.entregas : 0.0, 100.0 * m.cpu_ms / 1e3 / m.parede_s,
+                   (unsigned long long)m.sentencas, (unsigned long long)esperadas);
+
+            sem_perda = sem_perda && m.sentencas == esperadas && m.bytes == fluxo.size();
+        }
+    }
+
+    printf("fluxo integro em todas as medidas: %s\n", sem_perda ? "sim" : "NAO");
+    return sem_perda ? 0 : 1;
+}
+
+#endif // MODO_NATIVO
+
+/*
+ * ================================================================
+ * DOCUMENTAÇÃO
+ * ================================================================
+ *
+ * LEITURA SERIAL ORIENTADA A EVENTOS:
+ *
+ * 1. EPOLL + LEITURAS GRANDES:
+ *    - Descritor não bloqueante, um evento drena o que houver
+ *    - Leitura curta encerra o evento sem o read() extra que daria EAGAIN
+ *    - Cada leitura vai inteira para dumpGpsData() e nmeaFeed()
+ *
+ * 2. TAMANHO ADAPTATIVO:
+ *    - Leitura cheia dobra o pedido, leitura < 1/4 reduz à metade,
+ *      sempre em [SERIAL_LEITURA_MIN, SERIAL_BUFFER]
+ *
+ * 3. AGRUPAMENTO POR TAXA:
+ *    - Com a taxa do enlace conhecida, espera o tempo de chegada de meio
+ *      pedido antes de ler (limitado a atraso_max_us): menos eventos por KB
+ *
+ * 4. PROPRIEDADES VERIFICADAS (ESBMC):
+ *    - Ajuste sempre em [min, max] e monotônico nos extremos
+ *    - Qualquer sequência de leituras mantém read() dentro de buf[]
+ *    - Espera de agrupamento sem overflow e limitada
+ *
+ * COMANDOS DE EXECUÇÃO:
+ * esbmc serial.cpp --unwind 13 --overflow-check --bounds-check
+ * g++ -O2 -DMODO_NATIVO -pthread serial.cpp px4_funcoes.cpp -o serial_bench && ./serial_bench 1
+ *
+ * BENCHMARK:
+ * - Pseudo-terminal local: mestre emite GGA+RMC a 921600, 2M, 4M e 8M baud
+ *   (taxa simulada em passos de 1 ms), escravo lido por cada estratégia
+ * - Chamadas de sistema por KB, bytes por entrega, CPU da thread leitora
+ *   e conferência de que nenhuma sentença se perdeu
+ *
+ * ================================================================
+ */
@@ -0,0 +1,213 @@
+/**
+ * @file serial_epoll.h
+ * @author Dissertação Mestrado - Verificação Formal PX4 v1.16
+ *
+ * OBJETIVO: Camada de leitura serial orientada a eventos para o caminho
+ *           GPS (a montante de dumpGpsData() e dos parsers)
+ * MÓDULO: Entrada de bytes do receptor (tty real ou pseudo-terminal)
+ *
+ * O descritor fica não bloqueante e registrado num epoll. A cada evento a
+ * camada drena o descritor com leituras grandes (até uma leitura curta ou
+ * EAGAIN) e entrega cada leitura inteira ao consumidor. O tamanho de
+ * leitura se adapta ao fluxo (dobra quando a leitura enche, cai pela metade
+ * quando vem pouco) e, com a taxa do enlace conhecida, a espera antes de
+ * ler agrupa bytes em lotes: menos chamadas de sistema por KB, latência
+ * limitada por atraso_max_us.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// ================== CONSTANTES ==================
+static constexpr uint32_t SERIAL_BUFFER = 65536;
+static constexpr uint32_t SERIAL_LEITURA_MIN = 64;
+static constexpr uint32_t SERIAL_LEITURA_MAX = SERIAL_BUFFER;
+
+// ================== ESTRUTURAS ==================
+
+struct serial_estatistica_t {
+    uint64_t bytes;
+    uint64_t leituras;           // read() com dados
+    uint64_t leituras_vazias;    // read() que devolveu EAGAIN
+    uint64_t esperas;            // epoll_wait()
+    uint64_t lotes;              // Esperas de agrupamento (nanosleep)
+    uint64_t entregas;           // Chamadas ao consumidor
+};
+
+/**
+ * Consumidor: recebe cada leitura inteira (o buffer só é válido durante a
+ * chamada), como dumpGpsData() recebe o que o driver GPS leu.
+ */
+typedef void (*serial_consumidor_t)(const uint8_t *data, size_t len, void *ctx);
+
+struct serial_leitor_t {
+    int fd;
+    int epfd;
+    uint32_t tamanho_leitura;    // Pedido atual de read()
+    uint32_t bytes_por_s;        // Taxa do enlace (baud / 10); 0 = sem agrupamento
+    uint32_t atraso_max_us;      // Limite de latência do agrupamento
+    uint8_t buf[SERIAL_BUFFER];
+    serial_estatistica_t est;
+};
+
+// ================== POLÍTICA DE LEITURA ==================
+
+/**
+ * FUNÇÃO 1: serialAjustarLeitura()
+ * ESPECIFICAÇÃO: Leitura cheia dobra o pedido; leitura abaixo de 1/4 do
+ * pedido o reduz à metade. Resultado sempre em [min, max].
+ */
+inline uint32_t serialAjustarLeitura(uint32_t atual, size_t lidos, uint32_t min, uint32_t max) {
+    uint32_t novo = atual;
+
+    if (lidos >= atual) {
+        novo = atual > max / 2 ? max : atual * 2;
+    } else if (lidos < atual / 4) {
+        novo = atual / 2;
+    }
+
+    if (novo < min) {
+        novo = min;
+    }
+
+    return novo > max ? max : novo;
+}
+
+/**
+ * FUNÇÃO 2: serialAtrasoLote()
+ * ESPECIFICAÇÃO: Tempo para chegar 'faltam' bytes na taxa do enlace,
+ * limitado a atraso_max_us (0 se a taxa é desconhecida). Calculado em 64
+ * bits: faltam * 1e6 não estoura para qualquer faltam de 32 bits.
+ */
+inline uint32_t serialAtrasoLote(uint32_t faltam, uint32_t bytes_por_s, uint32_t atraso_max_us) {
+    if (bytes_por_s == 0 || faltam == 0) {
+        return 0;
+    }
+
+    const uint64_t us = (uint64_t)faltam * 1000000ull / bytes_por_s;
+    return us > atraso_max_us ? atraso_max_us : (uint32_t)us;
+}
+
+#ifdef MODO_NATIVO
+
+#include <cerrno>
+#include <ctime>
+
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <termios.h>
+#include <unistd.h>
+
+// Modo bruto 8N1 (sem eco, sem modo canônico): vale para tty real e para o lado escravo do pty
+inline bool serialConfigurarBruto(int fd, speed_t velocidade) {
+    struct termios t;
+
+    if (tcgetattr(fd, &t) != 0) {
+        return false;
+    }
+
+    cfmakeraw(&t);
+    cfsetispeed(&t, velocidade);
+    cfsetospeed(&t, velocidade);
+    t.c_cc[VMIN] = 0;
+    t.c_cc[VTIME] = 0;
+    return tcsetattr(fd, TCSANOW, &t) == 0;
+}
+
+inline bool serialAbrir(serial_leitor_t *s, int fd, uint32_t bytes_por_s, uint32_t atraso_max_us) {
+    s->fd = fd;
+    s->tamanho_leitura = SERIAL_LEITURA_MIN;
+    s->bytes_por_s = bytes_por_s;
+    s->atraso_max_us = atraso_max_us;
+    s->est = serial_estatistica_t{};
+
+    const int flags = fcntl(fd, F_GETFL);
+    if (flags < 0 || fcntl(fd, F_SETFL, flags | O_NONBLOCK) != 0) {
+        return false;
+    }
+
+    s->epfd = epoll_create1(EPOLL_CLOEXEC);
+    if (s->epfd < 0) {
+        return false;
+    }
+
+    struct epoll_event ev = {};
+    ev.events = EPOLLIN;
+    ev.data.fd = fd;
+    return epoll_ctl(s->epfd, EPOLL_CTL_ADD, fd, &ev) == 0;
+}
+
+inline void serialFechar(serial_leitor_t *s) {
+    if (s->epfd >= 0) {
+        close(s->epfd);
+        s->epfd = -1;
+    }
+}
+
+/**
+ * FUNÇÃO 3: serialProcessar()
+ * ESPECIFICAÇÃO: Espera um evento (até timeout_ms), agrupa pelo tempo de
+ * chegada do restante do pedido e drena o descritor até uma leitura curta
+ * ou EAGAIN, entregando cada leitura ao consumidor. Retorna os bytes entregues, 0 em timeout e
+ * -1 em erro ou fim do fluxo (lado mestre do pty fechado: EIO/HUP).
+ */
+inline long serialProcessar(serial_leitor_t *s, int timeout_ms, serial_consumidor_t consumidor, void *ctx) {
+    struct epoll_event ev;
+    s->est.esperas++;
+    const int n = epoll_wait(s->epfd, &ev, 1, timeout_ms);
+
+    if (n < 0) {
+        return errno == EINTR ? 0 : -1;
+    }
+
+    if (n == 0) {
+        return 0;
+    }
+
+    // Evento com a leitura anterior pequena: o enlace entrega devagar, esperar o lote
+    const uint32_t atraso = serialAtrasoLote(s->tamanho_leitura / 2, s->bytes_por_s, s->atraso_max_us);
+    if (atraso > 0 && !(ev.events & (EPOLLHUP | EPOLLERR))) {
+        struct timespec ts = {0, (long)atraso * 1000};
+        nanosleep(&ts, nullptr);
+        s->est.lotes++;
+    }
+
+    long total = 0;
+
+    while (true) {
+        const uint32_t pedido = s->tamanho_leitura;
+        const ssize_t r = read(s->fd, s->buf, pedido);
+
+        if (r > 0) {
+            s->est.leituras++;
+            s->est.bytes += (uint64_t)r;
+            s->est.entregas++;
+            consumidor(s->buf, (size_t)r, ctx);
+            total += r;
+            s->tamanho_leitura = serialAjustarLeitura(s->tamanho_leitura, (size_t)r, SERIAL_LEITURA_MIN,
+                                                      SERIAL_LEITURA_MAX);
+
+            if ((size_t)r < pedido) {
+                break;      // Leitura curta: descritor vazio, dispensa o read() que daria EAGAIN
+            }
+            continue;
+        }
+
+        if (r < 0 && errno == EINTR) {
+            continue;
+        }
+
+        if (r < 0 && errno == EAGAIN) {
+            s->est.leituras_vazias++;
+            break;
+        }
+
+        return total > 0 ? total : -1;      // EOF ou EIO: escritor fechou
+    }
+
+    return total;
+}
+
+#endif // MODO_NATIVO
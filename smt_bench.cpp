@@ -0,0 +1,369 @@
+/**
+ * @file smt_bench.cpp
+ * @author Dissertação Mestrado - Verificação Formal PX4 v1.16
+ *
+ * OBJETIVO: Repetir o corpus SMT-LIB2 exportado pelo esbmc_runner
+ *           (--exportar-smt) contra solvers/configurações instalados,
+ *           sem reexecutar o ESBMC
+ * MÉTODO: Cada par (consulta, configuração) é um processo com timeout;
+ *         pares despachados entre workers, consultas maiores primeiro
+ *
+ * SAÍDA: TSV por par (teste, claim, origem, configuração, resultado,
+ *        tempo) e resumo por configuração: resolvidas, timeouts, PAR-2,
+ *        vitórias e divergências sat/unsat entre configurações
+ *
+ * Ferramenta nativa (não é alvo de verificação):
+ * g++ -O2 -std=c++17 -pthread smt_bench.cpp -o smt_bench
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "esbmc_processo.h"
+
+// ================== CONFIGURAÇÃO ==================
+
+struct solver_t {
+    std::string nome;
+    std::vector<std::string> args;      // "{}" = caminho da consulta
+};
+
+struct consulta_t {
+    std::string arquivo;
+    std::string teste;
+    std::string claim;
+    std::string origem;                 // funcao:linha:propriedade
+    long long bytes;
+};
+
+struct medida_t {
+    size_t consulta;
+    size_t solver;
+    std::string resultado;              // sat, unsat, unknown, timeout, erro
+    double tempo_s;
+};
+
+// ================== CORPUS ==================
+
+static std::vector<std::string> separarCampos(const std::string &linha, char sep) {
+    std::vector<std::string> campos;
+    std::istringstream ss(linha);
+    std::string c;
+
+    while (std::getline(ss, c, sep)) {
+        campos.push_back(c);
+    }
+
+    return campos;
+}
+
+/**
+ * FUNÇÃO 1: lerIndice()
+ * ESPECIFICAÇÃO: indice.tsv do esbmc_runner (mesmas colunas do TSV de
+ * resultados). Só entram as linhas EXPORTADO; a coluna log é o .smt2.
+ */
+static std::vector<consulta_t> lerIndice(const std::string &caminho) {
+    std::vector<consulta_t> consultas;
+    std::string conteudo;
+
+    if (!lerArquivo(caminho, &conteudo)) {
+        fprintf(stderr, "nao consegui ler %s\n", caminho.c_str());
+        return consultas;
+    }
+
+    std::istringstream linhas(conteudo);
+    std::string linha;
+    std::map<std::string, size_t> coluna;
+
+    while (std::getline(linhas, linha)) {
+        const std::vector<std::string> c = separarCampos(linha, '\t');
+
+        if (coluna.empty()) {
+            for (size_t i = 0; i < c.size(); i++) {
+                coluna[c[i]] = i;
+            }
+            continue;
+        }
+
+        if (c.size() < coluna.size() || c[coluna["veredito"]] != "EXPORTADO") {
+            continue;
+        }
+
+        consulta_t q;
+        q.arquivo = c[coluna["log"]];
+        q.teste = c[coluna["teste"]];
+        q.claim = c[coluna["claim"]];
+        q.origem = c[coluna["funcao"]] + ":" + c[coluna["linha"]] + ":" + c[coluna["propriedade"]];
+
+        struct stat st;
+        q.bytes = stat(q.arquivo.c_str(), &st) == 0 ? (long long)st.st_size : 0;
+        consultas.push_back(q);
+    }
+
+    return consultas;
+}
+
+/**
+ * FUNÇÃO 2: lerSolver()
+ * ESPECIFICAÇÃO: "nome=comando args" (ex.: "z3=z3 -smt2 {}"). Sem "{}" o
+ * caminho da consulta vai no fim. Sem "nome=" o nome é o comando inteiro.
+ */
+static solver_t lerSolver(const std::string &espec) {
+    solver_t s;
+    const size_t igual = espec.find('=');
+    const std::string comando = igual == std::string::npos ? espec : espec.substr(igual + 1);
+
+    s.nome = igual == std::string::npos ? espec : espec.substr(0, igual);
+
+    bool tem_arquivo = false;
+    for (const std::string &a : separarCampos(comando, ' ')) {
+        if (!a.empty()) {
+            s.args.push_back(a);
+            tem_arquivo = tem_arquivo || a == "{}";
+        }
+    }
+
+    if (!tem_arquivo) {
+        s.args.push_back("{}");
+    }
+
+    return s;
+}
+
+// ================== EXECUÇÃO ==================
+
+static std::string resultadoDaSaida(const processo_t &p, const std::string &saida) {
+    if (p.timeout) {
+        return "timeout";
+    }
+
+    // Primeira linha com resposta de check-sat
+    std::istringstream linhas(saida);
+    std::string linha;
+
+    while (std::getline(linhas, linha)) {
+        if (linha == "sat" || linha == "unsat" || linha == "unknown") {
+            return linha;
+        }
+    }
+
+    return "erro";
+}
+
+/**
+ * FUNÇÃO 3: medir()
+ * ESPECIFICAÇÃO: Um processo por par; saída descartada depois de
+ * classificada (a não ser com --manter-logs).
+ */
+static medida_t medir(const consulta_t &q, const solver_t &s, size_t iq, size_t is, double timeout_s,
+                      const std::string &dir_logs) {
+    std::vector<std::string> args;
+    for (const std::string &a : s.args) {
+        args.push_back(a == "{}" ? q.arquivo : a);
+    }
+
+    const std::string log = dir_logs.empty()
+                                ? "/tmp/smt_bench_" + std::to_string(getpid()) + "_" + std::to_string(iq) + "_" +
+                                      std::to_string(is) + ".log"
+                                : dir_logs + "/" + q.teste + "_c" + q.claim + "_" + s.nome + ".log";
+
+    const processo_t p = executarProcesso(args, timeout_s, log);
+    std::string saida;
+    lerArquivo(log, &saida);
+
+    if (dir_logs.empty()) {
+        unlink(log.c_str());
+    }
+
+    return {iq, is, resultadoDaSaida(p, saida), p.timeout ? timeout_s : p.tempo_s};
+}
+
+// ================== MAIN ==================
+
+static void uso(const char *prog) {
+    fprintf(stderr,
+            "uso: %s [opcoes] --solver NOME=CMD [--solver ...] corpus/indice.tsv\n"
+            "  --solver NOME=CMD  configuracao a medir; {} = arquivo .smt2\n"
+            "                     (ex.: \"z3=z3 -smt2 {}\", \"bz=boolector --smt2 {}\")\n"
+            "  --workers N        pares em paralelo (padrao: nucleos)\n"
+            "  --timeout S        timeout por par em segundos (padrao: 300)\n"
+            "  --filtro S         so consultas cujo teste contem S\n"
+            "  --manter-logs DIR  guardar a saida de cada par em DIR\n"
+            "  --saida F          TSV de medidas (padrao: smt_bench.tsv)\n",
+            prog);
+}
+
+int main(int argc, char **argv) {
+    std::vector<solver_t> solvers;
+    std::string indice, filtro, dir_logs;
+    std::string saida = "smt_bench.tsv";
+    int workers = 0;
+    double timeout_s = 300.0;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string a = argv[i];
+
+        if (a == "--solver" && i + 1 < argc) {
+            solvers.push_back(lerSolver(argv[++i]));
+        } else if (a == "--workers" && i + 1 < argc) {
+            workers = atoi(argv[++i]);
+        } else if (a == "--timeout" && i + 1 < argc) {
+            timeout_s = atof(argv[++i]);
+        } else if (a == "--filtro" && i + 1 < argc) {
+            filtro = argv[++i];
+        } else if (a == "--manter-logs" && i + 1 < argc) {
+            dir_logs = argv[++i];
+        } else if (a == "--saida" && i + 1 < argc) {
+            saida = argv[++i];
+        } else if (a == "-h" || a == "--help") {
+            uso(argv[0]);
+            return 0;
+        } else if (a[0] != '-' && indice.empty()) {
+            indice = a;
+        } else {
+            uso(argv[0]);
+            return 1;
+        }
+    }
+
+    if (indice.empty() || solvers.empty()) {
+        uso(argv[0]);
+        return 1;
+    }
+
+    if (workers <= 0) {
+        workers = (int)std::thread::hardware_concurrency();
+        workers = workers > 0 ? workers : 1;
+    }
+
+    if (!dir_logs.empty()) {
+        criarDiretorios(dir_logs);
+    }
+
+    std::vector<consulta_t> consultas;
+    for (const consulta_t &q : lerIndice(indice)) {
+        if (filtro.empty() || q.teste.find(filtro) != std::string::npos) {
+            consultas.push_back(q);
+        }
+    }
+
+    // Maiores primeiro: as consultas lentas não ficam para o fim
+    std::stable_sort(consultas.begin(), consultas.end(),
+                     [](const consulta_t &a, const consulta_t &b) { return a.bytes > b.bytes; });
+
+    printf("%zu consultas x %zu configuracoes, %d workers, timeout %.0f s\n", consultas.size(), solvers.size(),
+           workers, timeout_s);
+
+    std::vector<medida_t> medidas(consultas.size() * solvers.size());
+    std::mutex mtx;
+
+    paraCada(medidas.size(), workers, [&](size_t k) {
+        const size_t iq = k / solvers.size();
+        const size_t is = k % solvers.size();
+        medidas[k] = medir(consultas[iq], solvers[is], iq, is, timeout_s, dir_logs);
+
+        std::lock_guard<std::mutex> lock(mtx);
+        printf("  %-8s %8.2fs  %-12s %s\n", medidas[k].resultado.c_str(), medidas[k].tempo_s, solvers[is].nome.c_str(),
+               consultas[iq].arquivo.c_str());
+        fflush(stdout);
+    });
+
+    FILE *f = fopen(saida.c_str(), "w");
+    if (!f) {
+        perror(saida.c_str());
+        return 1;
+    }
+
+    fprintf(f, "arquivo\tteste\tclaim\torigem\tsolver\tresultado\ttempo_s\n");
+    for (const medida_t &m : medidas) {
+        const consulta_t &q = consultas[m.consulta];
+        fprintf(f, "%s\t%s\t%s\t%s\t%s\t%s\t%.3f\n", q.arquivo.c_str(), q.teste.c_str(), q.claim.c_str(),
+                q.origem.c_str(), solvers[m.solver].nome.c_str(), m.resultado.c_str(), m.tempo_s);
+    }
+    fclose(f);
+
+    // ================== RESUMO ==================
+
+    std::vector<int> resolvidas(solvers.size(), 0), timeouts(solvers.size(), 0), vitorias(solvers.size(), 0);
+    std::vector<double> par2(solvers.size(), 0.0);
+    int divergencias = 0;
+
+    for (size_t iq = 0; iq < consultas.size(); iq++) {
+        int melhor = -1;
+        bool viu_sat = false, viu_unsat = false;
+
+        for (size_t is = 0; is < solvers.size(); is++) {
+            const medida_t &m = medidas[iq * solvers.size() + is];
+            const bool ok = m.resultado == "sat" || m.resultado == "unsat";
+
+            resolvidas[is] += ok ? 1 : 0;
+            timeouts[is] += m.resultado == "timeout" ? 1 : 0;
+            par2[is] += ok ? m.tempo_s : 2.0 * timeout_s;          // PAR-2: não resolvida custa 2x timeout
+            viu_sat = viu_sat || m.resultado == "sat";
+            viu_unsat = viu_unsat || m.resultado == "unsat";
+
+            if (ok && (melhor < 0 || m.tempo_s < medidas[iq * solvers.size() + melhor].tempo_s)) {
+                melhor = (int)is;
+            }
+        }
+
+        if (melhor >= 0) {
+            vitorias[melhor]++;
+        }
+
+        if (viu_sat && viu_unsat) {
+            divergencias++;
+            printf("DIVERGENCIA sat/unsat: %s\n", consultas[iq].arquivo.c_str());
+        }
+    }
+
+    printf("\n%-12s %10s %9s %12s %9s\n", "solver", "resolvidas", "timeouts", "PAR-2 (s)", "vitorias");
+    for (size_t is = 0; is < solvers.size(); is++) {
+        printf("%-12s %10d %9d %12.1f %9d\n", solvers[is].nome.c_str(), resolvidas[is], timeouts[is], par2[is],
+               vitorias[is]);
+    }
+
+    printf("%d divergencias -> %s\n", divergencias, saida.c_str());
+    return divergencias == 0 ? 0 : 2;
+}
+
+/*
+ * ================================================================
+ * DOCUMENTAÇÃO
+ * ================================================================
+ *
+ * BENCHMARK OFFLINE DE SOLVERS:
+ *
+ * 1. CORPUS:
+ *    - esbmc_runner --exportar-smt DIR gera um .smt2 por claim e
+ *      DIR/indice.tsv com teste, claim e origem (função:linha:propriedade)
+ *    - O corpus é fixo: trocar solver ou flag não exige rodar o ESBMC
+ *
+ * 2. MEDIÇÃO:
+ *    - Cada par (consulta, configuração) em processo próprio, com o
+ *      mesmo isolamento do runner (esbmc_processo.h): timeout mata o grupo
+ *    - Resultado lido da primeira linha sat/unsat/unknown da saída
+ *
+ * 3. RESUMO:
+ *    - PAR-2: soma dos tempos, não resolvida conta 2x o timeout
+ *    - Vitórias: configuração mais rápida entre as que resolveram
+ *    - Divergência sat/unsat entre configurações = bug de solver ou de
+ *      tradução; código de saída 2
+ *
+ * COMANDOS DE EXECUÇÃO:
+ * ./esbmc_runner --exportar-smt corpus -- --unwind 8
+ * g++ -O2 -std=c++17 -pthread smt_bench.cpp -o smt_bench
+ * ./smt_bench --timeout 600 --solver "z3=z3 -smt2 {}" \
+ *     --solver "bitwuzla=bitwuzla {}" --solver "cvc5=cvc5 --lang smt2 {}" corpus/indice.tsv
+ *
+ * ================================================================
+ */
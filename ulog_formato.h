@@ -0,0 +1,185 @@
+/**
+ * @file ulog_formato.h
+ * @author Dissertação Mestrado - Verificação Formal PX4 v1.16
+ *
+ * OBJETIVO: Formato binário de log de sensores (inspirado no ULog do PX4)
+ * USO: ulog_writer.cpp (escrita) e log_analyzer.cpp (leitura)
+ *
+ * LAYOUT DO ARQUIVO:
+ *   [bloco 0]  ulog_cabecalho_t + seção de formatos (ulog_formato_def_t[])
+ *   [bloco 1..] ulog_bloco_t + registros (ulog_registro_t + payload) + padding
+ *
+ * Todos os blocos têm tamanho_bloco bytes (múltiplo de 4096), então o arquivo
+ * pode ser escrito com O_DIRECT e lido em paralelo: cada bloco começa em
+ * fronteira de registro e nenhum registro cruza blocos.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// ================== CONSTANTES DO FORMATO ==================
+static constexpr char ULOG_MAGIC[8] = {'U', 'L', 'o', 'g', 'T', 'C', 'C', '1'};
+static constexpr uint32_t ULOG_VERSAO = 1;
+static constexpr uint32_t ULOG_BLOCO_MAGIC = 0x304B4C42;    // "BLK0"
+static constexpr uint32_t ULOG_ALINHAMENTO = 4096;
+static constexpr uint32_t ULOG_TAMANHO_BLOCO_PADRAO = 256 * 1024;
+static constexpr int ULOG_MAX_FORMATOS = 16;
+
+enum ulog_msg_id_t : uint16_t {
+    ULOG_MSG_IMU_ACCEL = 1,
+    ULOG_MSG_IMU_GYRO = 2,
+    ULOG_MSG_IMU_TEMP = 3,
+    ULOG_MSG_IMU_FIFO = 4,
+    ULOG_MSG_GPS_DUMP = 5
+};
+
+// ================== ESTRUTURAS EM DISCO ==================
+
+#pragma pack(push, 1)
+
+struct ulog_cabecalho_t {
+    char magic[8];
+    uint32_t versao;
+    uint32_t tamanho_bloco;
+    uint64_t timestamp_inicio_us;
+    uint32_t num_formatos;
+    uint32_t reservado;
+};
+
+/**
+ * Definição autodescritiva de um tópico, como a mensagem FORMAT do ULog:
+ * campos = "tipo nome;tipo nome;..." na ordem exata do payload.
+ */
+struct ulog_formato_def_t {
+    uint16_t msg_id;
+    uint16_t tamanho;              // Bytes de payload de cada registro
+    char nome[28];
+    char campos[220];
+};
+
+struct ulog_bloco_t {
+    uint32_t magic;
+    uint32_t bytes_usados;         // Inclui este cabeçalho
+    uint64_t sequencia;
+};
+
+struct ulog_registro_t {
+    uint16_t msg_id;
+    uint16_t tamanho;              // Bytes de payload que seguem
+};
+
+// Payloads: timestamp sempre primeiro, como no ULog
+struct ulog_imu_accel_t {
+    uint64_t timestamp_us;
+    int16_t x;                     // Saída de processAccelData() (y, z já invertidos)
+    int16_t y;
+    int16_t z;
+};
+
+struct ulog_imu_gyro_t {
+    uint64_t timestamp_us;
+    int16_t x;                     // Saída de processGyroData()
+    int16_t y;
+    int16_t z;
+    uint8_t valido;                // Retorno de processGyroData()
+};
+
+struct ulog_imu_temp_t {
+    uint64_t timestamp_us;
+    uint8_t temp_msb;              // Registradores crus de updateTemperature()
+    uint8_t temp_lsb;
+};
+
+struct ulog_imu_fifo_t {
+    uint64_t timestamp_us;
+    uint8_t fifo_length_0;         // Registradores crus de fifoReadCount()
+    uint8_t fifo_length_1;
+};
+
+struct ulog_gps_dump_t {
+    uint64_t timestamp_us;
+    uint8_t instance;
+    uint8_t len;
+    uint8_t data[200];             // gps_dump_s::data (GPS_DUMP_DATA_SIZE)
+};
+
+#pragma pack(pop)
+
+static_assert(sizeof(ulog_cabecalho_t) == 32, "cabecalho deve ter 32 bytes");
+static_assert(sizeof(ulog_bloco_t) == 16, "bloco deve ter 16 bytes");
+
+// ================== TABELA DE FORMATOS ==================
+
+inline int ulogFormatosPadrao(ulog_formato_def_t *defs) {
+    struct entrada_t {
+        uint16_t id;
+        uint16_t tamanho;
+        const char *nome;
+        const char *campos;
+    };
+
+    static const entrada_t tabela[] = {
+        {ULOG_MSG_IMU_ACCEL, sizeof(ulog_imu_accel_t), "imu_accel",
+         "uint64_t timestamp;int16_t x;int16_t y;int16_t z;"},
+        {ULOG_MSG_IMU_GYRO, sizeof(ulog_imu_gyro_t), "imu_gyro",
+         "uint64_t timestamp;int16_t x;int16_t y;int16_t z;uint8_t valido;"},
+        {ULOG_MSG_IMU_TEMP, sizeof(ulog_imu_temp_t), "imu_temp",
+         "uint64_t timestamp;uint8_t temp_msb;uint8_t temp_lsb;"},
+        {ULOG_MSG_IMU_FIFO, sizeof(ulog_imu_fifo_t), "imu_fifo",
+         "uint64_t timestamp;uint8_t fifo_length_0;uint8_t fifo_length_1;"},
+        {ULOG_MSG_GPS_DUMP, sizeof(ulog_gps_dump_t), "gps_dump",
+         "uint64_t timestamp;uint8_t instance;uint8_t len;uint8_t[200] data;"},
+    };
+
+    const int n = (int)(sizeof(tabela) / sizeof(tabela[0]));
+
+    for (int i = 0; i < n; i++) {
+        memset(&defs[i], 0, sizeof(defs[i]));
+        defs[i].msg_id = tabela[i].id;
+        defs[i].tamanho = tabela[i].tamanho;
+        strncpy(defs[i].nome, tabela[i].nome, sizeof(defs[i].nome) - 1);
+        strncpy(defs[i].campos, tabela[i].campos, sizeof(defs[i].campos) - 1);
+    }
+
+    return n;
+}
+
+/**
+ * FUNÇÃO 1: ulogValidarCabecalho()
+ * ESPECIFICAÇÃO: Conferir magic, versão, tamanho de bloco (múltiplo de 4096)
+ * e que a seção de formatos cabe no bloco 0.
+ */
+inline bool ulogValidarCabecalho(const ulog_cabecalho_t *c) {
+    return memcmp(c->magic, ULOG_MAGIC, sizeof(ULOG_MAGIC)) == 0 &&
+           c->versao == ULOG_VERSAO &&
+           c->tamanho_bloco >= ULOG_ALINHAMENTO &&
+           c->tamanho_bloco % ULOG_ALINHAMENTO == 0 &&
+           c->num_formatos <= ULOG_MAX_FORMATOS &&
+           sizeof(ulog_cabecalho_t) + c->num_formatos * sizeof(ulog_formato_def_t) <= c->tamanho_bloco;
+}
+
+/**
+ * FUNÇÃO 2: ulogProximoRegistro()
+ * ESPECIFICAÇÃO: Avançar dentro de um bloco. Retorna o offset do próximo
+ * registro, ou 0 se o registro em 'offset' for inválido ou ultrapassar
+ * bytes_usados (bloco corrompido ou fim do bloco).
+ */
+inline uint32_t ulogProximoRegistro(const uint8_t *bloco, uint32_t bytes_usados, uint32_t offset,
+                                    const ulog_registro_t **reg) {
+    if (offset + sizeof(ulog_registro_t) > bytes_usados) {
+        return 0;
+    }
+
+    const ulog_registro_t *r = (const ulog_registro_t *)(bloco + offset);
+    const uint32_t fim = offset + (uint32_t)sizeof(ulog_registro_t) + r->tamanho;
+
+    if (fim > bytes_usados) {
+        return 0;
+    }
+
+    *reg = r;
+    return fim;
+}
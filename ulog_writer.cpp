@@ -0,0 +1,1030 @@
+/**
+ * @file ulog_writer.cpp
+ * @author Dissertação Mestrado - Verificação Formal PX4 v1.16
+ *
+ * OBJETIVO: Gravador binário de logs de IMU/GPS em taxa cheia (formato ulog_formato.h)
+ * MÓDULO: Filas lock-free por tópico + thread de escrita com E/S assíncrona
+ * MÉTODO: Bounded Model Checking com ESBMC + benchmark nativo (-DMODO_NATIVO)
+ *
+ * ARQUITETURA:
+ * - Produtores (threads de sensor) só copiam o registro para uma fila SPSC do
+ *   tópico; fila cheia descarta e conta, nunca bloqueia o sensor.
+ * - A thread de log drena as filas em blocos alinhados de tamanho_bloco bytes
+ *   e os entrega ao backend de E/S: io_uring (syscalls diretas, sem liburing)
+ *   ou, se indisponível, um pool de threads com pwrite().
+ */
+
+#include <assert.h>
+#include <cstdint>
+#include <cstring>
+
+#include "ulog_formato.h"
+
+#ifdef MODO_NATIVO
+#define ULOG_LER_ACQ(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define ULOG_ESCREVER_REL(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#else
+#define ULOG_LER_ACQ(p) (*(p))
+#define ULOG_ESCREVER_REL(p, v) (*(p) = (v))
+#endif
+
+// ================== FILA SPSC POR TÓPICO ==================
+
+/**
+ * Fila de registros de tamanho fixo, um produtor e um consumidor.
+ * Índices crescem livremente (uint32_t); slot = índice & mascara.
+ */
+struct ulog_fila_t {
+    uint8_t *slots;
+    uint32_t tamanho_slot;
+    uint32_t mascara;            // capacidade - 1 (capacidade potência de 2)
+    uint32_t cabeca;             // Escrito só pelo produtor
+    uint32_t cauda;              // Escrito só pelo consumidor
+    uint64_t descartes;          // Escrito só pelo produtor
+};
+
+void ulogFilaInit(ulog_fila_t *f, uint8_t *memoria, uint32_t tamanho_slot, uint32_t capacidade) {
+    f->slots = memoria;
+    f->tamanho_slot = tamanho_slot;
+    f->mascara = capacidade - 1;
+    f->cabeca = 0;
+    f->cauda = 0;
+    f->descartes = 0;
+}
+
+/**
+ * FUNÇÃO 1: ulogPublicar()
+ * ESPECIFICAÇÃO: Copiar um registro para a fila sem bloquear. Retorna false
+ * (e conta o descarte) se a fila estiver cheia.
+ */
+bool ulogPublicar(ulog_fila_t *f, const void *registro) {
+    const uint32_t cabeca = f->cabeca;
+    const uint32_t cauda = ULOG_LER_ACQ(&f->cauda);
+
+    if (cabeca - cauda > f->mascara) {
+        f->descartes++;
+        return false;
+    }
+
+    memcpy(f->slots + (size_t)(cabeca & f->mascara) * f->tamanho_slot, registro, f->tamanho_slot);
+    ULOG_ESCREVER_REL(&f->cabeca, cabeca + 1);
+    return true;
+}
+
+/**
+ * FUNÇÃO 2: ulogConsumir()
+ * ESPECIFICAÇÃO: Retornar ponteiro para o registro mais antigo (ou nullptr
+ * se vazia). O slot só é liberado em ulogLiberar().
+ */
+const uint8_t *ulogConsumir(const ulog_fila_t *f) {
+    const uint32_t cauda = f->cauda;
+
+    if (ULOG_LER_ACQ(&f->cabeca) == cauda) {
+        return nullptr;
+    }
+
+    return f->slots + (size_t)(cauda & f->mascara) * f->tamanho_slot;
+}
+
+void ulogLiberar(ulog_fila_t *f) {
+    ULOG_ESCREVER_REL(&f->cauda, f->cauda + 1);
+}
+
+// ================== MONTAGEM DE BLOCOS ==================
+
+/**
+ * FUNÇÃO 3: ulogBlocoAnexar()
+ * ESPECIFICAÇÃO: Anexar cabeçalho de registro + payload ao bloco. Retorna
+ * false, sem escrever nada, se o registro não couber inteiro no bloco.
+ */
+bool ulogBlocoAnexar(uint8_t *bloco, uint32_t tamanho_bloco, uint16_t msg_id,
+                     const uint8_t *payload, uint16_t tamanho) {
+    ulog_bloco_t *cab = (ulog_bloco_t *)bloco;
+    const uint32_t necessario = (uint32_t)sizeof(ulog_registro_t) + tamanho;
+
+    if (cab->bytes_usados > tamanho_bloco || tamanho_bloco - cab->bytes_usados < necessario) {
+        return false;
+    }
+
+    ulog_registro_t reg;
+    reg.msg_id = msg_id;
+    reg.tamanho = tamanho;
+    memcpy(bloco + cab->bytes_usados, &reg, sizeof(reg));
+    memcpy(bloco + cab->bytes_usados + sizeof(reg), payload, tamanho);
+    cab->bytes_usados += necessario;
+    return true;
+}
+
+void ulogBlocoIniciar(uint8_t *bloco, uint64_t sequencia) {
+    ulog_bloco_t cab;
+    cab.magic = ULOG_BLOCO_MAGIC;
+    cab.bytes_usados = sizeof(ulog_bloco_t);
+    cab.sequencia = sequencia;
+    memcpy(bloco, &cab, sizeof(cab));
+}
+
+#ifndef MODO_NATIVO
+
+// ================== FUNÇÕES ESBMC ==================
+extern int nondet_int();
+extern uint8_t nondet_uint8();
+extern uint16_t nondet_uint16();
+extern bool nondet_bool();
+extern void __ESBMC_assume(int condition);
+
+// ================== TESTES DE VERIFICAÇÃO FORMAL ==================
+
+/**
+ * TESTE 1: Verificar fila SPSC sob sequência arbitrária de operações
+ * PROPRIEDADE: Ocupação em [0, capacidade], slots dentro da memória e ordem FIFO
+ */
+void test_ulog_fila_fifo() {
+    uint8_t memoria[4 * 2];
+    ulog_fila_t fila;
+    ulogFilaInit(&fila, memoria, 2, 4);
+
+    // Índices perto do wrap de uint32_t
+    uint32_t inicio = 0xFFFFFFFEu;
+    fila.cabeca = inicio;
+    fila.cauda = inicio;
+
+    uint16_t proximo_pub = 0;
+    uint16_t proximo_con = 0;
+
+    for (int passo = 0; passo < 6; passo++) {
+        if (nondet_bool()) {
+            uint16_t valor = proximo_pub;
+            if (ulogPublicar(&fila, &valor)) {
+                proximo_pub++;
+            }
+        } else {
+            const uint8_t *slot = ulogConsumir(&fila);
+            if (slot != nullptr) {
+                assert(slot >= memoria && slot + 2 <= memoria + sizeof(memoria));
+                uint16_t valor;
+                memcpy(&valor, slot, 2);
+                assert(valor == proximo_con);
+                proximo_con++;
+                ulogLiberar(&fila);
+            }
+        }
+
+        assert(fila.cabeca - fila.cauda <= 4);
+        assert((uint16_t)(proximo_pub - proximo_con) == fila.cabeca - fila.cauda);
+    }
+}
+
+/**
+ * TESTE 2: Verificar montagem de bloco
+ * PROPRIEDADE: bytes_usados nunca excede o tamanho do bloco e registros
+ * rejeitados não alteram o bloco
+ */
+void test_ulog_bloco_limites() {
+    uint8_t bloco[64];
+    uint8_t payload[40];
+    ulogBlocoIniciar(bloco, 0);
+
+    for (int i = 0; i < 3; i++) {
+        uint16_t tamanho = nondet_uint16();
+        __ESBMC_assume(tamanho <= sizeof(payload));
+
+        uint32_t antes = ((ulog_bloco_t *)bloco)->bytes_usados;
+        bool ok = ulogBlocoAnexar(bloco, sizeof(bloco), ULOG_MSG_IMU_ACCEL, payload, tamanho);
+        uint32_t depois = ((ulog_bloco_t *)bloco)->bytes_usados;
+
+        assert(depois <= sizeof(bloco));
+
+        if (ok) {
+            assert(depois == antes + sizeof(ulog_registro_t) + tamanho);
+        } else {
+            assert(depois == antes);
+            assert(antes + sizeof(ulog_registro_t) + tamanho > sizeof(bloco));
+        }
+    }
+}
+
+/**
+ * TESTE 3: Verificar leitura de registro em bloco arbitrário
+ * PROPRIEDADE: ulogProximoRegistro() nunca aponta além de bytes_usados
+ */
+void test_ulog_leitura_limites() {
+    uint8_t bloco[32];
+    for (int i = 0; i < 32; i++) {
+        bloco[i] = nondet_uint8();
+    }
+
+    uint32_t bytes_usados = nondet_uint8();
+    __ESBMC_assume(bytes_usados <= sizeof(bloco));
+
+    uint32_t offset = sizeof(ulog_bloco_t);
+    for (int i = 0; i < 4 && offset != 0; i++) {
+        const ulog_registro_t *reg = nullptr;
+        uint32_t proximo = ulogProximoRegistro(bloco, bytes_usados, offset, &reg);
+
+        if (proximo != 0) {
+            assert(proximo > offset && proximo <= bytes_usados);
+            assert((const uint8_t *)reg + sizeof(ulog_registro_t) + reg->tamanho <= bloco + bytes_usados);
+        }
+
+        offset = proximo;
+    }
+}
+
+// ================== MAIN PARA ESBMC ==================
+int main() {
+    int test_choice = nondet_int();
+    __ESBMC_assume(test_choice >= 0 && test_choice < 3);
+
+    switch(test_choice) {
+        case 0:
+            test_ulog_fila_fifo();
+            break;
+        case 1:
+            test_ulog_bloco_limites();
+            break;
+        case 2:
+            test_ulog_leitura_limites();
+            break;
+    }
+
+    return 0;
+}
+
+#else // MODO_NATIVO
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "px4_funcoes.h"   // dumpGpsData() da biblioteca compartilhada (px4_funcoes.cpp)
+
+static uint64_t agoraNs() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+// ================== BACKENDS DE E/S ==================
+
+/**
+ * Interface mínima: submeter a escrita de um buffer (identificado por 'id')
+ * e colher ids concluídos. Retorno negativo de colher() = erro de escrita.
+ */
+class ulog_io_t {
+public:
+    virtual ~ulog_io_t() = default;
+    virtual const char *nome() const = 0;
+    virtual bool submeter(int id, const void *buf, uint32_t len, uint64_t offset) = 0;
+    virtual int colher(int *ids, int max, bool bloquear) = 0;
+};
+
+/**
+ * io_uring via syscalls diretas (io_uring_setup/io_uring_enter + mmap dos anéis).
+ */
+class ulog_io_uring_t : public ulog_io_t {
+public:
+    static ulog_io_uring_t *criar(int fd, unsigned entradas) {
+        ulog_io_uring_t *u = new ulog_io_uring_t(fd);
+
+        if (!u->iniciar(entradas)) {
+            delete u;
+            return nullptr;
+        }
+
+        return u;
+    }
+
+    ~ulog_io_uring_t() override {
+        if (sqes_ != MAP_FAILED) {
+            munmap(sqes_, sqes_tam_);
+        }
+
+        if (cq_ptr_ != MAP_FAILED && cq_ptr_ != sq_ptr_) {
+            munmap(cq_ptr_, cq_tam_);
+        }
+
+        if (sq_ptr_ != MAP_FAILED) {
+            munmap(sq_ptr_, sq_tam_);
+        }
+
+        if (ring_fd_ >= 0) {
+            close(ring_fd_);
+        }
+    }
+
+    const char *nome() const override { return "io_uring"; }
+
+    bool submeter(int id, const void *buf, uint32_t len, uint64_t offset) override {
+        const unsigned cauda = *sq_tail_;
+        const unsigned idx = cauda & *sq_mask_;
+        io_uring_sqe *sqe = &sqes_[idx];
+
+        memset(sqe, 0, sizeof(*sqe));
+        sqe->opcode = IORING_OP_WRITE;
+        sqe->fd = fd_;
+        sqe->addr = (uint64_t)(uintptr_t)buf;
+        sqe->len = len;
+        sqe->off = offset;
+        sqe->user_data = ((uint64_t)len << 32) | (uint32_t)id;
+        sq_array_[idx] = idx;
+        __atomic_store_n(sq_tail_, cauda + 1, __ATOMIC_RELEASE);
+
+        return syscall(__NR_io_uring_enter, ring_fd_, 1, 0, 0, nullptr, 0) == 1;
+    }
+
+    int colher(int *ids, int max, bool bloquear) override {
+        if (bloquear && __atomic_load_n(cq_head_, __ATOMIC_RELAXED) == __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE)) {
+            syscall(__NR_io_uring_enter, ring_fd_, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+        }
+
+        unsigned cabeca = __atomic_load_n(cq_head_, __ATOMIC_RELAXED);
+        const unsigned cauda = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+        int n = 0;
+
+        while (cabeca != cauda && n < max) {
+            const io_uring_cqe *cqe = &cqes_[cabeca & *cq_mask_];
+            const uint32_t len = (uint32_t)(cqe->user_data >> 32);
+
+            if (cqe->res < 0 || (uint32_t)cqe->res != len) {
+                return -1;
+            }
+
+            ids[n++] = (int)(uint32_t)cqe->user_data;
+            cabeca++;
+        }
+
+        __atomic_store_n(cq_head_, cabeca, __ATOMIC_RELEASE);
+        return n;
+    }
+
+private:
+    explicit ulog_io_uring_t(int fd) : fd_(fd) {}
+
+    bool iniciar(unsigned entradas) {
+        io_uring_params p;
+        memset(&p, 0, sizeof(p));
+        ring_fd_ = (int)syscall(__NR_io_uring_setup, entradas, &p);
+
+        if (ring_fd_ < 0) {
+            return false;
+        }
+
+        sq_tam_ = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+        cq_tam_ = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+
+        if (p.features & IORING_FEAT_SINGLE_MMAP) {
+            sq_tam_ = cq_tam_ = (sq_tam_ > cq_tam_) ? sq_tam_ : cq_tam_;
+        }
+
+        sq_ptr_ = mmap(nullptr, sq_tam_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                       ring_fd_, IORING_OFF_SQ_RING);
+
+        if (sq_ptr_ == MAP_FAILED) {
+            return false;
+        }
+
+        cq_ptr_ = (p.features & IORING_FEAT_SINGLE_MMAP) ? sq_ptr_ :
+                  mmap(nullptr, cq_tam_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                       ring_fd_, IORING_OFF_CQ_RING);
+
+        if (cq_ptr_ == MAP_FAILED) {
+            return false;
+        }
+
+        sqes_tam_ = p.sq_entries * sizeof(io_uring_sqe);
+        sqes_ = (io_uring_sqe *)mmap(nullptr, sqes_tam_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                     ring_fd_, IORING_OFF_SQES);
+
+        if (sqes_ == MAP_FAILED) {
+            return false;
+        }
+
+        uint8_t *sq = (uint8_t *)sq_ptr_;
+        uint8_t *cq = (uint8_t *)cq_ptr_;
+        sq_tail_ = (unsigned *)(sq + p.sq_off.tail);
+        sq_mask_ = (unsigned *)(sq + p.sq_off.ring_mask);
+        sq_array_ = (unsigned *)(sq + p.sq_off.array);
+        cq_head_ = (unsigned *)(cq + p.cq_off.head);
+        cq_tail_ = (unsigned *)(cq + p.cq_off.tail);
+        cq_mask_ = (unsigned *)(cq + p.cq_off.ring_mask);
+        cqes_ = (io_uring_cqe *)(cq + p.cq_off.cqes);
+        return true;
+    }
+
+    int fd_;
+    int ring_fd_ = -1;
+    void *sq_ptr_ = MAP_FAILED;
+    void *cq_ptr_ = MAP_FAILED;
+    io_uring_sqe *sqes_ = (io_uring_sqe *)MAP_FAILED;
+    size_t sq_tam_ = 0, cq_tam_ = 0, sqes_tam_ = 0;
+    unsigned *sq_tail_ = nullptr, *sq_mask_ = nullptr, *sq_array_ = nullptr;
+    unsigned *cq_head_ = nullptr, *cq_tail_ = nullptr, *cq_mask_ = nullptr;
+    io_uring_cqe *cqes_ = nullptr;
+};
+
+/**
+ * Alternativa portátil: pool de threads fazendo pwrite() de blocos inteiros.
+ */
+class ulog_io_pool_t : public ulog_io_t {
+public:
+    ulog_io_pool_t(int fd, int threads) : fd_(fd) {
+        for (int i = 0; i < threads; i++) {
+            threads_.emplace_back([this] { trabalhar(); });
+        }
+    }
+
+    ~ulog_io_pool_t() override {
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            parar_ = true;
+        }
+
+        cv_pedidos_.notify_all();
+
+        for (std::thread &t : threads_) {
+            t.join();
+        }
+    }
+
+    const char *nome() const override { return "pwrite-pool"; }
+
+    bool submeter(int id, const void *buf, uint32_t len, uint64_t offset) override {
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            pedidos_.push_back(pedido_t{id, buf, len, offset});
+        }
+
+        cv_pedidos_.notify_one();
+        return true;
+    }
+
+    int colher(int *ids, int max, bool bloquear) override {
+        std::unique_lock<std::mutex> lock(mtx_);
+
+        if (bloquear) {
+            cv_concluidos_.wait(lock, [this] { return !concluidos_.empty() || erro_; });
+        }
+
+        if (erro_) {
+            return -1;
+        }
+
+        int n = 0;
+        while (!concluidos_.empty() && n < max) {
+            ids[n++] = concluidos_.front();
+            concluidos_.pop_front();
+        }
+
+        return n;
+    }
+
+private:
+    struct pedido_t {
+        int id;
+        const void *buf;
+        uint32_t len;
+        uint64_t offset;
+    };
+
+    void trabalhar() {
+        for (;;) {
+            pedido_t p;
+            {
+                std::unique_lock<std::mutex> lock(mtx_);
+                cv_pedidos_.wait(lock, [this] { return parar_ || !pedidos_.empty(); });
+
+                if (pedidos_.empty()) {
+                    return;
+                }
+
+                p = pedidos_.front();
+                pedidos_.pop_front();
+            }
+
+            const uint8_t *buf = (const uint8_t *)p.buf;
+            uint32_t feito = 0;
+            bool ok = true;
+
+            while (feito < p.len) {
+                ssize_t r = pwrite(fd_, buf + feito, p.len - feito, (off_t)(p.offset + feito));
+
+                if (r <= 0) {
+                    ok = false;
+                    break;
+                }
+
+                feito += (uint32_t)r;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(mtx_);
+                erro_ = erro_ || !ok;
+                concluidos_.push_back(p.id);
+            }
+
+            cv_concluidos_.notify_one();
+        }
+    }
+
+    int fd_;
+    std::vector<std::thread> threads_;
+    std::mutex mtx_;
+    std::condition_variable cv_pedidos_;
+    std::condition_variable cv_concluidos_;
+    std::deque<pedido_t> pedidos_;
+    std::deque<int> concluidos_;
+    bool parar_ = false;
+    bool erro_ = false;
+};
+
+// ================== GRAVADOR ==================
+
+static constexpr int ULOG_BUFFERS = 8;        // Blocos em voo + bloco sendo montado
+static constexpr uint32_t ULOG_FILA_CAPACIDADE = 16384;
+
+struct ulog_writer_t {
+    int fd = -1;
+    uint32_t tamanho_bloco = ULOG_TAMANHO_BLOCO_PADRAO;
+    ulog_formato_def_t defs[ULOG_MAX_FORMATOS];
+    ulog_fila_t filas[ULOG_MAX_FORMATOS];
+    int num_formatos = 0;
+    uint8_t *memoria_filas = nullptr;
+
+    uint8_t *buffers[ULOG_BUFFERS] = {};
+    bool em_voo[ULOG_BUFFERS] = {};
+    int atual = -1;
+    uint64_t sequencia = 0;
+    uint64_t proximo_offset = 0;
+
+    ulog_io_t *io = nullptr;
+    std::thread thread;
+    std::atomic<bool> parar{false};
+    bool erro = false;
+
+    uint64_t registros = 0;
+    uint64_t blocos = 0;
+};
+
+static int ulogFilaDoTopico(const ulog_writer_t *w, uint16_t msg_id) {
+    for (int i = 0; i < w->num_formatos; i++) {
+        if (w->defs[i].msg_id == msg_id) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+static void ulogColher(ulog_writer_t *w, bool bloquear) {
+    int ids[ULOG_BUFFERS];
+    int n = w->io->colher(ids, ULOG_BUFFERS, bloquear);
+
+    if (n < 0) {
+        w->erro = true;
+        return;
+    }
+
+    for (int i = 0; i < n; i++) {
+        w->em_voo[ids[i]] = false;
+    }
+}
+
+static bool ulogNovoBloco(ulog_writer_t *w) {
+    for (;;) {
+        for (int i = 0; i < ULOG_BUFFERS; i++) {
+            if (!w->em_voo[i] && i != w->atual) {
+                w->atual = i;
+                ulogBlocoIniciar(w->buffers[i], w->sequencia++);
+                return true;
+            }
+        }
+
+        // Todos os buffers em voo: o disco é o gargalo, espera uma conclusão
+        ulogColher(w, true);
+
+        if (w->erro) {
+            return false;
+        }
+    }
+}
+
+static void ulogSubmeterAtual(ulog_writer_t *w) {
+    uint8_t *bloco = w->buffers[w->atual];
+    const uint32_t usados = ((ulog_bloco_t *)bloco)->bytes_usados;
+    memset(bloco + usados, 0, w->tamanho_bloco - usados);
+
+    w->em_voo[w->atual] = true;
+
+    if (!w->io->submeter(w->atual, bloco, w->tamanho_bloco, w->proximo_offset)) {
+        w->erro = true;
+    }
+
+    w->proximo_offset += w->tamanho_bloco;
+    w->blocos++;
+    w->atual = -1;
+}
+
+/**
+ * Laço da thread de log: drena cada fila em rodízio para o bloco atual;
+ * bloco cheio vai para o backend e um buffer livre assume.
+ */
+static void ulogLaco(ulog_writer_t *w) {
+    ulogNovoBloco(w);
+
+    for (;;) {
+        const bool encerrando = w->parar.load(std::memory_order_acquire);
+        bool trabalhou = false;
+
+        for (int t = 0; t < w->num_formatos && !w->erro; t++) {
+            ulog_fila_t *f = &w->filas[t];
+            const uint8_t *reg;
+
+            while ((reg = ulogConsumir(f)) != nullptr) {
+                if (!ulogBlocoAnexar(w->buffers[w->atual], w->tamanho_bloco, w->defs[t].msg_id,
+                                     reg, w->defs[t].tamanho)) {
+                    ulogSubmeterAtual(w);
+
+                    if (!ulogNovoBloco(w)) {
+                        break;
+                    }
+
+                    continue;
+                }
+
+                ulogLiberar(f);
+                w->registros++;
+                trabalhou = true;
+            }
+        }
+
+        ulogColher(w, false);
+
+        if (w->erro || (encerrando && !trabalhou)) {
+            break;
+        }
+
+        if (!trabalhou) {
+            timespec ts = {0, 100000};
+            nanosleep(&ts, nullptr);
+        }
+    }
+
+    if (!w->erro && ((ulog_bloco_t *)w->buffers[w->atual])->bytes_usados > sizeof(ulog_bloco_t)) {
+        ulogSubmeterAtual(w);
+    }
+
+    for (int i = 0; i < ULOG_BUFFERS; i++) {
+        while (w->em_voo[i] && !w->erro) {
+            ulogColher(w, true);
+        }
+    }
+}
+
+bool ulogAbrir(ulog_writer_t *w, const char *caminho, bool direto, bool forcar_pool) {
+    int flags = O_WRONLY | O_CREAT | O_TRUNC;
+
+    if (direto) {
+        flags |= O_DIRECT;
+    }
+
+    w->fd = open(caminho, flags, 0644);
+
+    if (w->fd < 0) {
+        perror(caminho);
+        return false;
+    }
+
+    w->num_formatos = ulogFormatosPadrao(w->defs);
+
+    // Filas: uma alocação na abertura, nenhuma depois
+    size_t total = 0;
+    for (int i = 0; i < w->num_formatos; i++) {
+        total += (size_t)w->defs[i].tamanho * ULOG_FILA_CAPACIDADE;
+    }
+
+    w->memoria_filas = (uint8_t *)aligned_alloc(64, (total + 63) & ~(size_t)63);
+    uint8_t *p = w->memoria_filas;
+
+    for (int i = 0; i < w->num_formatos; i++) {
+        ulogFilaInit(&w->filas[i], p, w->defs[i].tamanho, ULOG_FILA_CAPACIDADE);
+        p += (size_t)w->defs[i].tamanho * ULOG_FILA_CAPACIDADE;
+    }
+
+    for (int i = 0; i < ULOG_BUFFERS; i++) {
+        w->buffers[i] = (uint8_t *)aligned_alloc(ULOG_ALINHAMENTO, w->tamanho_bloco);
+        memset(w->buffers[i], 0, w->tamanho_bloco);
+    }
+
+    // Bloco 0: cabeçalho + seção de formatos, escrito de forma síncrona
+    uint8_t *b0 = w->buffers[0];
+    ulog_cabecalho_t cab;
+    memcpy(cab.magic, ULOG_MAGIC, sizeof(cab.magic));
+    cab.versao = ULOG_VERSAO;
+    cab.tamanho_bloco = w->tamanho_bloco;
+    cab.timestamp_inicio_us = agoraNs() / 1000;
+    cab.num_formatos = (uint32_t)w->num_formatos;
+    cab.reservado = 0;
+    memcpy(b0, &cab, sizeof(cab));
+    memcpy(b0 + sizeof(cab), w->defs, w->num_formatos * sizeof(ulog_formato_def_t));
+
+    if (pwrite(w->fd, b0, w->tamanho_bloco, 0) != (ssize_t)w->tamanho_bloco) {
+        perror("pwrite cabecalho");
+        return false;
+    }
+
+    memset(b0, 0, w->tamanho_bloco);
+    w->proximo_offset = w->tamanho_bloco;
+
+    if (!forcar_pool) {
+        w->io = ulog_io_uring_t::criar(w->fd, ULOG_BUFFERS * 2);
+    }
+
+    if (w->io == nullptr) {
+        w->io = new ulog_io_pool_t(w->fd, 2);
+    }
+
+    w->thread = std::thread(ulogLaco, w);
+    return true;
+}
+
+bool ulogFechar(ulog_writer_t *w) {
+    w->parar.store(true, std::memory_order_release);
+    w->thread.join();
+    delete w->io;
+    w->io = nullptr;
+
+    for (int i = 0; i < ULOG_BUFFERS; i++) {
+        free(w->buffers[i]);
+    }
+
+    free(w->memoria_filas);
+    close(w->fd);
+    return !w->erro;
+}
+
+// ================== PRODUTORES DO BENCHMARK ==================
+
+/**
+ * Histograma log2 da latência de cada publicação (ns), por produtor.
+ */
+struct latencia_t {
+    uint64_t baldes[40] = {};
+    uint64_t maximo = 0;
+    uint64_t total = 0;
+
+    void registrar(uint64_t ns) {
+        int b = ns == 0 ? 0 : 64 - __builtin_clzll(ns);
+        baldes[b < 40 ? b : 39]++;
+        maximo = ns > maximo ? ns : maximo;
+        total++;
+    }
+
+    uint64_t percentil(double p) const {
+        uint64_t alvo = (uint64_t)(p * total);
+        uint64_t acc = 0;
+
+        for (int b = 0; b < 40; b++) {
+            acc += baldes[b];
+            if (acc > alvo) {
+                return 1ull << b;
+            }
+        }
+
+        return maximo;
+    }
+};
+
+static ulog_writer_t g_writer;
+static latencia_t g_lat_gps;
+
+// _dump_communication_pub.publish(*dump_data) -> tópico gps_dump do log (via px4PublicarGpsDump)
+// A biblioteca grava timestamp fixo: o registro usa o relógio do log
+static void publicarDump(const gps_dump_s *dump_data) {
+    ulog_gps_dump_t reg;
+    reg.timestamp_us = agoraNs() / 1000;
+    reg.instance = dump_data->instance;
+    reg.len = dump_data->len;
+    memcpy(reg.data, dump_data->data, sizeof(reg.data));
+    uint64_t t0 = agoraNs();
+    ulogPublicar(&g_writer.filas[ulogFilaDoTopico(&g_writer, ULOG_MSG_GPS_DUMP)], &reg);
+    g_lat_gps.registrar(agoraNs() - t0);
+}
+
+static std::atomic<bool> g_parar{false};
+static latencia_t g_lat_imu;
+
+/**
+ * Produtor IMU: amostras de accel/gyro/FIFO por iteração e temperatura a cada
+ * 100 amostras. Vibração senoidal com saturação ocasional em INT16_MIN/MAX e
+ * temperatura subindo devagar (para o analisador ter o que medir).
+ */
+static void produtorImu(uint32_t hz) {
+    ulog_fila_t *f_acc = &g_writer.filas[ulogFilaDoTopico(&g_writer, ULOG_MSG_IMU_ACCEL)];
+    ulog_fila_t *f_gyr = &g_writer.filas[ulogFilaDoTopico(&g_writer, ULOG_MSG_IMU_GYRO)];
+    ulog_fila_t *f_tmp = &g_writer.filas[ulogFilaDoTopico(&g_writer, ULOG_MSG_IMU_TEMP)];
+    ulog_fila_t *f_fifo = &g_writer.filas[ulogFilaDoTopico(&g_writer, ULOG_MSG_IMU_FIFO)];
+
+    const uint64_t periodo_ns = hz ? 1000000000ull / hz : 0;
+    uint64_t proximo = agoraNs();
+    uint32_t x = 1;
+
+    for (uint64_t n = 0; !g_parar.load(std::memory_order_relaxed); n++) {
+        if (periodo_ns) {
+            proximo += periodo_ns;
+            while (agoraNs() < proximo) {
+            }
+        }
+
+        x = x * 1664525u + 1013904223u;
+        const uint64_t ts = agoraNs() / 1000;
+        const int32_t vib = (int32_t)((int64_t)((x >> 8) & 0xFFFF) - 32768);
+        const bool satura = (x % 1000) == 0;
+
+        ulog_imu_accel_t acc = {ts, (int16_t)(vib / 8), (int16_t)(satura ? INT16_MAX : -vib / 4),
+                                (int16_t)(-4096 + vib / 16)};
+        ulog_imu_gyro_t gyr = {ts, (int16_t)(vib / 32), (int16_t)(satura ? INT16_MIN : vib / 64),
+                               (int16_t)(vib / 128), 1};
+        ulog_imu_fifo_t fifo = {ts, (uint8_t)(x >> 3), (uint8_t)((x >> 11) & 0x03)};
+
+        uint64_t t0 = agoraNs();
+        ulogPublicar(f_acc, &acc);
+        ulogPublicar(f_gyr, &gyr);
+        ulogPublicar(f_fifo, &fifo);
+
+        if (n % 100 == 0) {
+            // Temp_uint11 sobe de 0 a 255 (23 °C a ~55 °C) ao longo da execução
+            const uint32_t t11 = (uint32_t)((n / 100000) % 256);
+            ulog_imu_temp_t tmp = {ts, (uint8_t)(t11 >> 3), (uint8_t)((t11 & 0x7) << 5)};
+            ulogPublicar(f_tmp, &tmp);
+        }
+
+        g_lat_imu.registrar(agoraNs() - t0);
+    }
+}
+
+/**
+ * Produtor GPS: dois receptores (instâncias 0 e 1) entregando pedaços de
+ * até 256 bytes a dumpGpsData(), que publica no log a cada 200 bytes.
+ */
+static void produtorGps(uint32_t bytes_por_s) {
+    static gps_dump_s dump[2];
+    uint8_t pedaco[256];
+    uint32_t x = 99;
+    const uint64_t inicio = agoraNs();
+    uint64_t enviados = 0;
+
+    for (size_t i = 0; i < sizeof(pedaco); i++) {
+        pedaco[i] = (uint8_t)i;
+    }
+
+    while (!g_parar.load(std::memory_order_relaxed)) {
+        x = x * 1103515245u + 12345u;
+        const size_t len = 1 + (x >> 16) % sizeof(pedaco);
+        const uint8_t inst = (uint8_t)(x & 1);
+
+        dumpGpsData(pedaco, len, gps_dump_comm_mode_t::Full, false, &dump[inst],
+                    gps_dump_comm_mode_t::Full, inst);
+        enviados += len;
+
+        if (bytes_por_s) {
+            const uint64_t alvo_ns = enviados * 1000000000ull / bytes_por_s;
+            while (agoraNs() - inicio < alvo_ns && !g_parar.load(std::memory_order_relaxed)) {
+                timespec ts = {0, 200000};
+                nanosleep(&ts, nullptr);
+            }
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    const char *caminho = "sensores.ulg";
+    double segundos = 5.0;
+    uint32_t imu_hz = 0;          // 0 = o mais rápido possível
+    uint32_t gps_bps = 921600 / 10;
+    bool direto = false;
+    bool pool = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--arquivo") && i + 1 < argc) {
+            caminho = argv[++i];
+        } else if (!strcmp(argv[i], "--segundos") && i + 1 < argc) {
+            segundos = atof(argv[++i]);
+        } else if (!strcmp(argv[i], "--imu-hz") && i + 1 < argc) {
+            imu_hz = (uint32_t)atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "--gps-bps") && i + 1 < argc) {
+            gps_bps = (uint32_t)atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "--bloco-kib") && i + 1 < argc) {
+            g_writer.tamanho_bloco = (uint32_t)atoi(argv[++i]) * 1024;
+        } else if (!strcmp(argv[i], "--direct")) {
+            direto = true;
+        } else if (!strcmp(argv[i], "--pool")) {
+            pool = true;
+        } else {
+            fprintf(stderr, "uso: %s [--arquivo f] [--segundos s] [--imu-hz n] [--gps-bps n]"
+                    " [--bloco-kib n] [--direct] [--pool]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    if (g_writer.tamanho_bloco < ULOG_ALINHAMENTO || g_writer.tamanho_bloco % ULOG_ALINHAMENTO) {
+        fprintf(stderr, "bloco deve ser multiplo de 4 KiB\n");
+        return 1;
+    }
+
+    if (!ulogAbrir(&g_writer, caminho, direto, pool)) {
+        return 1;
+    }
+
+    px4PublicarGpsDump = publicarDump;
+
+    printf("arquivo=%s backend=%s bloco=%u KiB direct=%d imu_hz=%s gps=%u B/s\n", caminho,
+           g_writer.io->nome(), g_writer.tamanho_bloco / 1024, direto,
+           imu_hz ? std::to_string(imu_hz).c_str() : "max", gps_bps);
+
+    const uint64_t t0 = agoraNs();
+    std::thread imu(produtorImu, imu_hz);
+    std::thread gps(produtorGps, gps_bps);
+
+    std::this_thread::sleep_for(std::chrono::duration<double>(segundos));
+    g_parar.store(true);
+    imu.join();
+    gps.join();
+
+    const bool ok = ulogFechar(&g_writer);
+    const double dt = (agoraNs() - t0) * 1e-9;
+    const double mb = (double)(g_writer.proximo_offset) / 1048576.0;
+
+    uint64_t descartes = 0;
+    for (int i = 0; i < g_writer.num_formatos; i++) {
+        descartes += g_writer.filas[i].descartes;
+    }
+
+    printf("escrito=%.1f MiB em %.2f s -> %.1f MiB/s (%llu blocos, %llu registros, %llu descartes)\n",
+           mb, dt, mb / dt, (unsigned long long)g_writer.blocos,
+           (unsigned long long)g_writer.registros, (unsigned long long)descartes);
+    printf("stall produtor IMU: p50<=%llu ns p99.99<=%llu ns max=%llu ns (n=%llu)\n",
+           (unsigned long long)g_lat_imu.percentil(0.5), (unsigned long long)g_lat_imu.percentil(0.9999),
+           (unsigned long long)g_lat_imu.maximo, (unsigned long long)g_lat_imu.total);
+    printf("stall produtor GPS: p50<=%llu ns p99.99<=%llu ns max=%llu ns (n=%llu)\n",
+           (unsigned long long)g_lat_gps.percentil(0.5), (unsigned long long)g_lat_gps.percentil(0.9999),
+           (unsigned long long)g_lat_gps.maximo, (unsigned long long)g_lat_gps.total);
+
+    return ok ? 0 : 1;
+}
+
+#endif // MODO_NATIVO
+
+/*
+ * ================================================================
+ * DOCUMENTAÇÃO
+ * ================================================================
+ *
+ * GRAVADOR DE LOG:
+ *
+ * 1. PRODUTORES:
+ *    - ulogPublicar(): memcpy para a fila SPSC do tópico + store-release
+ *    - Fila cheia descarta (contado em descartes): o custo de publicar é
+ *      limitado por uma cópia de registro, independente do disco
+ *
+ * 2. THREAD DE LOG:
+ *    - Drena filas em rodízio para blocos alinhados (ulog_bloco_t + registros)
+ *    - 8 buffers de bloco: um em montagem, os demais em voo no backend
+ *    - Só espera o disco quando todos os buffers estão em voo
+ *
+ * 3. BACKENDS:
+ *    - io_uring: IORING_OP_WRITE via syscalls diretas (kernel >= 5.6)
+ *    - pwrite-pool: usado se io_uring_setup falhar (ou com --pool)
+ *
+ * 4. PROPRIEDADES VERIFICADAS (ESBMC):
+ *    - Fila SPSC: ocupação limitada, slots em memória válida, ordem FIFO
+ *      inclusive no wrap dos índices uint32_t
+ *    - Blocos: bytes_usados nunca excede o bloco
+ *    - Leitura: registros arbitrários nunca apontam além de bytes_usados
+ *
+ * COMANDOS DE EXECUÇÃO:
+ * esbmc ulog_writer.cpp --unwind 7 --overflow-check --bounds-check
+ * g++ -O2 -pthread -DMODO_NATIVO ulog_writer.cpp px4_funcoes.cpp -o ulog_writer_bench
+ * ./ulog_writer_bench --segundos 10                 (taxa máxima, io_uring)
+ * ./ulog_writer_bench --segundos 10 --pool --direct (pwrite + O_DIRECT)
+ * ./ulog_writer_bench --imu-hz 2000 --segundos 3600 (log longo para log_analyzer)
+ *
+ * BENCHMARK:
+ * - MiB/s sustentados até o disco e descartes por fila cheia
+ * - Histograma da latência de publicação (stall) de cada produtor
+ *
+ * ================================================================
+ */